@@ -356,3 +356,18 @@
         result = reader.readStringChunk(buffer.data() + oldsize, size);
     } while (result.status() == QCborStreamReader::Ok);
 //! [29]
+
+//! [30]
+    QFile file("events.cbor");
+    file.open(QIODevice::ReadOnly);
+    const uchar *data = file.map(0, file.size());
+    QCborStreamReader reader(data, file.size());
+
+    // ...
+    qsizetype total = 0;
+    auto r = reader.readUtf8StringView();
+    while (r.status == QCborStreamReader::Ok) {
+        total += r.data.size();
+        r = reader.readUtf8StringView();
+    }
+//! [30]
@@ -822,16 +822,74 @@ size_t simdSwapLoop(const uchar *src, size_t bytes, uchar *dst) noexcept
     return bytes;
 }
 #elif defined(__SSE2__)
+#  if !defined(QT_BOOTSTRAPPED) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+// The baseline has no byte shuffle, but the CPU we're running on may: use
+// VPSHUFB when it's there. Returns the number of bytes swapped; the caller
+// finishes the tail.
+QT_FUNCTION_TARGET(AVX2)
+static size_t avx2SwapLoop(const uchar *src, size_t bytes, uchar *dst, int sizeIndex) noexcept
+{
+    alignas(16) static const uchar shuffleMasks[3][16] = {
+        // 16-bit
+        {1, 0, 3, 2,  5, 4, 7, 6,  9, 8, 11, 10,  13, 12, 15, 14},
+        // 32-bit
+        {3, 2, 1, 0,  7, 6, 5, 4,  11, 10, 9, 8,  15, 14, 13, 12},
+        // 64-bit
+        {7, 6, 5, 4, 3, 2, 1, 0,   15, 14, 13, 12, 11, 10, 9, 8}
+    };
+    const __m128i mask128 = _mm_load_si128(reinterpret_cast<const __m128i *>(shuffleMasks[sizeIndex]));
+    const __m256i mask = _mm256_broadcastsi128_si256(mask128);
+
+    size_t i = 0;
+    for ( ; i + 2 * sizeof(__m256i) <= bytes; i += 2 * sizeof(__m256i)) {
+        __m256i data1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+        __m256i data2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i) + 1);
+        data1 = _mm256_shuffle_epi8(data1, mask);
+        data2 = _mm256_shuffle_epi8(data2, mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), data1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i) + 1, data2);
+    }
+
+    if (i + sizeof(__m128i) <= bytes) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        data = _mm_shuffle_epi8(data, mask128);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), data);
+        i += sizeof(__m128i);
+    }
+    if (i + sizeof(__m128i) <= bytes) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        data = _mm_shuffle_epi8(data, mask128);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), data);
+        i += sizeof(__m128i);
+    }
+
+    return i;
+}
+#  endif
+
 template <typename T> static
-size_t simdSwapLoop(const uchar *, size_t, uchar *) noexcept
+size_t simdSwapLoop(const uchar *src, size_t bytes, uchar *dst) noexcept
 {
-    // no generic version: we can't do 32- and 64-bit swaps easily,
-    // so we won't try
+    // no generic SSE2 version: we can't do 32- and 64-bit swaps easily,
+    // so we only try if AVX2 is available at runtime
+#  if !defined(QT_BOOTSTRAPPED) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        return avx2SwapLoop(src, bytes, dst, qCountTrailingZeroBits(sizeof(T)) - 1);
+#  else
+    Q_UNUSED(src);
+    Q_UNUSED(bytes);
+    Q_UNUSED(dst);
+#  endif
     return 0;
 }
 
 template <> size_t simdSwapLoop<quint16>(const uchar *src, size_t bytes, uchar *dst) noexcept
 {
+#  if !defined(QT_BOOTSTRAPPED) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        return avx2SwapLoop(src, bytes, dst, 0);
+#  endif
+
     auto swapEndian = [](__m128i &data) {
         __m128i lows = _mm_srli_epi16(data, 8);
         __m128i highs = _mm_slli_epi16(data, 8);
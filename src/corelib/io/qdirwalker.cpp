@@ -0,0 +1,846 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+/*!
+    \since 6.3
+    \class QDirWalker
+    \inmodule QtCore
+    \brief The QDirWalker class walks a directory tree using several threads.
+
+    QDirWalker lists all entries below a directory, like QDirIterator with
+    the QDirIterator::Subdirectories flag, but is meant for very large trees.
+    Subdirectories are read in parallel by a private thread pool, and instead
+    of handing out one entry at a time to the caller, walk() calls a visitor
+    function for each entry that matches the filters:
+
+    \snippet code/src_corelib_io_qdirwalker.cpp 0
+
+    The visitor is called from several threads at the same time, so it must
+    be thread-safe. The order in which entries are visited is unspecified;
+    the entries of a directory are always visited before those of its
+    subdirectories.
+
+    QDirWalker::Entry only computes what the visitor asks for. The file name
+    and path of an entry are not built unless requested, and on Unix systems
+    the file type normally comes from the directory listing itself. When the
+    listing does not provide it, and for size() and lastModified(), the
+    walker queries the entry relative to its open directory instead of
+    resolving the full path again.
+
+    The filters and name filters are applied in the same way as by
+    QDirIterator, except that "." and ".." are never reported. Subdirectories
+    are walked whether or not they match the filters, with the same
+    exceptions as in QDirIterator: hidden directories are skipped unless
+    QDir::Hidden or QDir::AllDirs is passed, and symbolic links to
+    directories are only followed with the FollowSymlinks flag. Directories
+    that cannot be read are skipped.
+
+    \sa QDirIterator
+*/
+
+/*!
+    \enum QDirWalker::WalkerFlag
+
+    This enum describes flags that you can combine to configure the behavior
+    of QDirWalker.
+
+    \value NoWalkerFlags The default value, representing no flags.
+
+    \value FollowSymlinks Walk into subdirectories that are reached through
+    symbolic links. Each directory is walked at most once, so symbolic link
+    loops (e.g., "link" => "." or "link" => "..") do not cause the walk to
+    recurse forever.
+*/
+
+/*!
+    \typedef QDirWalker::Visitor
+
+    The type of the function that walk() calls for every matching entry:
+    \c{std::function<void(const QDirWalker::Entry &)>}.
+*/
+
+/*!
+    \class QDirWalker::Entry
+    \inmodule QtCore
+    \brief The QDirWalker::Entry class describes an entry found by QDirWalker.
+
+    An Entry is only valid during the call of the visitor it is passed to.
+    Information about the entry is looked up when it is first requested;
+    copy out whatever needs to be kept.
+*/
+
+#include "qplatformdefs.h"
+#include "qdirwalker.h"
+
+#include <QtCore/qlist.h>
+#include <QtCore/qset.h>
+#if QT_CONFIG(regularexpression)
+#include <QtCore/qregularexpression.h>
+#endif
+#if QT_CONFIG(thread)
+#include <QtCore/qmutex.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#endif
+
+#include <QtCore/private/qfileinfo_p.h>
+#include <QtCore/private/qfilesystementry_p.h>
+#include <QtCore/private/qfilesystemmetadata_p.h>
+#ifdef Q_OS_UNIX
+#include <QtCore/private/qcore_unix_p.h>
+#include <QtCore/private/qstringconverter_p.h>
+#else
+#include <QtCore/private/qfilesystemiterator_p.h>
+#endif
+
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+struct QDirWalkerDirectory
+{
+    QString path;           // as reported by Entry::path()
+    QString prefix;         // path with a trailing separator
+#ifdef Q_OS_UNIX
+    QByteArray nativePrefix;
+#endif
+};
+
+#ifdef Q_OS_UNIX
+static inline int qt_fstatat(int dirFd, const char *name, QT_STATBUF *buffer, int flags)
+{
+#if defined(QT_USE_XOPEN_LFS_EXTENSIONS) && defined(QT_LARGEFILE_SUPPORT)
+    return ::fstatat64(dirFd, name, buffer, flags);
+#else
+    return ::fstatat(dirFd, name, buffer, flags);
+#endif
+}
+
+class QDirWalkerEntryPrivate
+{
+public:
+    enum Type : quint8 { Unknown, Missing, Directory, File, SymLink, Other };
+
+    QDirWalkerEntryPrivate(const QDirWalkerDirectory *dir, int dirFd, const QT_DIRENT *dirent,
+                           qsizetype nameLength)
+        : dir(dir), dirent(dirent), nameLength(nameLength), dirFd(dirFd),
+          type(typeFromDirEnt(*dirent))
+    {
+    }
+
+    const char *name() const { return dirent->d_name; }
+    QString fileName() const
+    {
+        if (cachedFileName.isNull())
+            cachedFileName = QString::fromUtf8(name(), nameLength);
+        return cachedFileName;
+    }
+    QString filePath() const { return dir->prefix + fileName(); }
+    QByteArray nativeFilePath() const
+    {
+        QByteArray path = dir->nativePrefix;
+        path.append(name(), nameLength);
+        return path;
+    }
+    QFileInfo fileInfo() const
+    {
+        QFileSystemMetaData metaData;
+        metaData.fillFromDirEnt(*dirent);
+        return QFileInfo(new QFileInfoPrivate(QFileSystemEntry(nativeFilePath(),
+                                                               QFileSystemEntry::FromNativePath()),
+                                              metaData));
+    }
+
+    bool isDir() const { return targetType() == Directory; }
+    bool isFile() const { return targetType() == File; }
+    bool isSymLink() const { return linkType() == SymLink; }
+    bool exists() const { return targetType() != Missing; }
+    bool isHidden() const
+    {
+        if (name()[0] == '.')
+            return true;
+#ifdef UF_HIDDEN
+        return stat() && (statBuffer.st_flags & UF_HIDDEN);
+#else
+        return false;
+#endif
+    }
+    qint64 size() const { return stat() ? qint64(statBuffer.st_size) : 0; }
+    QDateTime lastModified() const
+    {
+        if (!stat())
+            return QDateTime();
+        QFileSystemMetaData metaData;
+        metaData.fillFromStatBuf(statBuffer);
+        return metaData.modificationTime().toLocalTime();
+    }
+
+private:
+    static Type typeFromMode(mode_t mode)
+    {
+        if (S_ISDIR(mode))
+            return Directory;
+        if (S_ISREG(mode))
+            return File;
+        if (S_ISLNK(mode))
+            return SymLink;
+        return Other;
+    }
+
+    static Type typeFromDirEnt(const QT_DIRENT &dirent)
+    {
+#if defined(_DIRENT_HAVE_D_TYPE) || defined(Q_OS_BSD4)
+        switch (dirent.d_type) {
+        case DT_UNKNOWN:
+            return Unknown;
+        case DT_DIR:
+            return Directory;
+        case DT_REG:
+            return File;
+        case DT_LNK:
+            return SymLink;
+        default:
+            return Other;
+        }
+#else
+        Q_UNUSED(dirent);
+        return Unknown;
+#endif
+    }
+
+    // the type of the entry itself, without following symbolic links
+    Type linkType() const
+    {
+        if (type == Unknown) {
+            QT_STATBUF buffer;
+            if (qt_fstatat(dirFd, name(), &buffer, AT_SYMLINK_NOFOLLOW) != 0) {
+                type = Missing;
+            } else {
+                type = typeFromMode(buffer.st_mode);
+                if (type != SymLink) {
+                    statBuffer = buffer;
+                    statState = StatOk;
+                }
+            }
+        }
+        return type;
+    }
+
+    Type targetType() const
+    {
+        const Type t = linkType();
+        if (t != SymLink)
+            return t;
+        return stat() ? typeFromMode(statBuffer.st_mode) : Missing;
+    }
+
+    // stat() of the entry, following symbolic links
+    bool stat() const
+    {
+        if (statState == NotStatted)
+            statState = qt_fstatat(dirFd, name(), &statBuffer, 0) == 0 ? StatOk : StatFailed;
+        return statState == StatOk;
+    }
+
+public:
+    const QDirWalkerDirectory *dir;
+
+private:
+    enum StatState : quint8 { NotStatted, StatOk, StatFailed };
+
+    const QT_DIRENT *dirent;
+    qsizetype nameLength;
+    int dirFd;
+    mutable Type type;
+    mutable StatState statState = NotStatted;
+    mutable QT_STATBUF statBuffer;
+    mutable QString cachedFileName;
+};
+#else
+class QDirWalkerEntryPrivate
+{
+public:
+    QDirWalkerEntryPrivate(const QDirWalkerDirectory *dir, const QFileSystemEntry &entry,
+                           const QFileSystemMetaData &metaData)
+        : dir(dir), entry(entry), info(new QFileInfoPrivate(entry, metaData))
+    {
+    }
+
+    QString fileName() const { return entry.fileName(); }
+    QString filePath() const { return entry.filePath(); }
+    QFileInfo fileInfo() const { return info; }
+
+    bool isDir() const { return info.isDir(); }
+    bool isFile() const { return info.isFile(); }
+    bool isSymLink() const { return info.isSymLink(); }
+    bool exists() const { return info.exists(); }
+    bool isHidden() const { return info.isHidden(); }
+    qint64 size() const { return info.size(); }
+    QDateTime lastModified() const { return info.lastModified(); }
+
+    const QDirWalkerDirectory *dir;
+
+private:
+    QFileSystemEntry entry;
+    QFileInfo info;
+};
+#endif // Q_OS_UNIX
+
+class QDirWalkerPrivate
+{
+public:
+    QDirWalkerPrivate(const QString &path, const QStringList &nameFilters,
+                      QDir::Filters filters, QDirWalker::WalkerFlags flags);
+
+    void walkDirectories(QList<QDirWalkerDirectory> pending);
+    void readDirectory(const QDirWalkerDirectory &dir, QList<QDirWalkerDirectory> &subdirectories);
+    bool shouldDescend(const QDirWalkerEntryPrivate &entry) const;
+    bool matchesFilters(const QDirWalkerEntryPrivate &entry) const;
+    void visit(QDirWalkerEntryPrivate &entry, QList<QDirWalkerDirectory> &subdirectories);
+
+#ifdef Q_OS_UNIX
+    using DirectoryId = std::pair<quint64, quint64>;
+#else
+    using DirectoryId = QString;
+#endif
+    bool markVisited(const DirectoryId &id);
+
+    const QString path;
+    const QStringList nameFilters;
+    const QDir::Filters filters;
+    const QDirWalker::WalkerFlags flags;
+    int maxThreadCount;
+
+#if QT_CONFIG(regularexpression)
+    QList<QRegularExpression> nameRegExps;
+#endif
+
+    const QDirWalker::Visitor *visitor = nullptr;
+#if QT_CONFIG(thread)
+    QThreadPool *pool = nullptr;
+    QMutex visitedMutex;
+#endif
+    // Loop protection
+    QSet<DirectoryId> visitedDirectories;
+};
+
+QDirWalkerPrivate::QDirWalkerPrivate(const QString &path, const QStringList &nameFilters,
+                                     QDir::Filters filters, QDirWalker::WalkerFlags flags)
+    : path(path),
+      nameFilters(nameFilters),
+      filters(QDir::NoFilter == filters ? QDir::AllEntries : filters),
+      flags(flags),
+#if QT_CONFIG(thread)
+      maxThreadCount(QThread::idealThreadCount())
+#else
+      maxThreadCount(1)
+#endif
+{
+#if QT_CONFIG(regularexpression)
+    nameRegExps.reserve(nameFilters.size());
+    for (const auto &filter : nameFilters) {
+        auto re = QRegularExpression::fromWildcard(filter, (this->filters & QDir::CaseSensitive ?
+                                                                  Qt::CaseSensitive : Qt::CaseInsensitive));
+        // compile the pattern now, before several threads use it
+        (void)re.isValid();
+        nameRegExps.append(re);
+    }
+#endif
+}
+
+/*!
+    \internal
+
+    Walks the directories in \a pending and everything below them. Whenever
+    the pool has an idle thread, the directories found first, which are
+    nearest to the root and so likely to hold the most work, are handed to
+    it; the rest is walked depth-first on the current thread.
+*/
+void QDirWalkerPrivate::walkDirectories(QList<QDirWalkerDirectory> pending)
+{
+    while (!pending.isEmpty()) {
+#if QT_CONFIG(thread)
+        while (pool && pending.size() > 1) {
+            const QDirWalkerDirectory &dir = pending.constFirst();
+            if (!pool->tryStart([this, dir] { walkDirectories({ dir }); }))
+                break;
+            pending.removeFirst();
+        }
+#endif
+        const QDirWalkerDirectory dir = pending.takeLast();
+        readDirectory(dir, pending);
+    }
+}
+
+bool QDirWalkerPrivate::markVisited(const DirectoryId &id)
+{
+#if QT_CONFIG(thread)
+    QMutexLocker locker(&visitedMutex);
+#endif
+    if (visitedDirectories.contains(id))
+        return false;
+    visitedDirectories.insert(id);
+    return true;
+}
+
+void QDirWalkerPrivate::visit(QDirWalkerEntryPrivate &entry,
+                              QList<QDirWalkerDirectory> &subdirectories)
+{
+    if (shouldDescend(entry)) {
+        QDirWalkerDirectory subdirectory;
+#if defined(Q_OS_WIN)
+        subdirectory.path = entry.isSymLink() ? entry.fileInfo().canonicalFilePath()
+                                              : entry.filePath();
+#else
+        subdirectory.path = entry.filePath();
+#endif
+        subdirectory.prefix = subdirectory.path + QLatin1Char('/');
+#ifdef Q_OS_UNIX
+        subdirectory.nativePrefix = entry.nativeFilePath() + '/';
+#endif
+        subdirectories.append(std::move(subdirectory));
+    }
+
+    if (matchesFilters(entry)) {
+        const QDirWalker::Entry publicEntry(&entry);
+        (*visitor)(publicEntry);
+    }
+}
+
+#ifdef Q_OS_UNIX
+void QDirWalkerPrivate::readDirectory(const QDirWalkerDirectory &dir,
+                                      QList<QDirWalkerDirectory> &subdirectories)
+{
+    const int fd = qt_safe_open(dir.nativePrefix.constData(), O_RDONLY | O_DIRECTORY);
+    if (fd == -1)
+        return;
+
+    if (flags & QDirWalker::FollowSymlinks) {
+        QT_STATBUF buffer;
+        if (QT_FSTAT(fd, &buffer) == 0
+            && !markVisited(DirectoryId(quint64(buffer.st_dev), quint64(buffer.st_ino)))) {
+            qt_safe_close(fd);
+            return;
+        }
+    }
+
+    QT_DIR *dirp = ::fdopendir(fd);
+    if (!dirp) {
+        qt_safe_close(fd);
+        return;
+    }
+
+    while (const QT_DIRENT *dirent = QT_READDIR(dirp)) {
+        const char *name = dirent->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+            continue;
+        const qsizetype nameLength = qstrlen(name);
+        if (!QUtf8::isValidUtf8(QByteArrayView(name, nameLength)).isValidUtf8)
+            continue;
+
+        QDirWalkerEntryPrivate entry(&dir, fd, dirent, nameLength);
+        visit(entry, subdirectories);
+    }
+
+    QT_CLOSEDIR(dirp);
+}
+#elif !defined(QT_NO_FILESYSTEMITERATOR)
+void QDirWalkerPrivate::readDirectory(const QDirWalkerDirectory &dir,
+                                      QList<QDirWalkerDirectory> &subdirectories)
+{
+    if ((flags & QDirWalker::FollowSymlinks)
+        && !markVisited(QFileInfo(dir.path).canonicalFilePath())) {
+        return;
+    }
+
+    QFileSystemIterator it(QFileSystemEntry(dir.path), QDir::NoFilter, QStringList(),
+                           QDirIterator::NoIteratorFlags);
+    QFileSystemEntry fileEntry;
+    QFileSystemMetaData metaData;
+    while (it.advance(fileEntry, metaData)) {
+        const QString fileName = fileEntry.fileName();
+        if (fileName != QLatin1String(".") && fileName != QLatin1String("..")) {
+            QDirWalkerEntryPrivate entry(&dir, fileEntry, metaData);
+            visit(entry, subdirectories);
+        }
+        metaData = QFileSystemMetaData();
+    }
+}
+#else
+void QDirWalkerPrivate::readDirectory(const QDirWalkerDirectory &,
+                                      QList<QDirWalkerDirectory> &)
+{
+    qWarning("Qt was built with -no-feature-filesystemiterator: no files/plugins will be found!");
+}
+#endif
+
+/*!
+    \internal
+
+    Mirrors QDirIteratorPrivate::checkAndPushDirectory().
+*/
+bool QDirWalkerPrivate::shouldDescend(const QDirWalkerEntryPrivate &entry) const
+{
+    // Never follow non-directory entries
+    if (!entry.isDir())
+        return false;
+
+    // Follow symlinks only when asked
+    if (!(flags & QDirWalker::FollowSymlinks) && entry.isSymLink())
+        return false;
+
+    // No hidden directories unless requested
+    if (!(filters & QDir::AllDirs) && !(filters & QDir::Hidden) && entry.isHidden())
+        return false;
+
+    return true;
+}
+
+/*!
+    \internal
+
+    Mirrors QDirIteratorPrivate::matchesFilters(), minus the handling of "."
+    and "..", which are never visited.
+*/
+bool QDirWalkerPrivate::matchesFilters(const QDirWalkerEntryPrivate &entry) const
+{
+    // name filter
+#if QT_CONFIG(regularexpression)
+    // Pass all entries through name filters, except dirs if the AllDirs
+    if (!nameRegExps.isEmpty() && !((filters & QDir::AllDirs) && entry.isDir())) {
+        const QString fileName = entry.fileName();
+        bool matched = false;
+        for (const auto &re : nameRegExps) {
+            if (re.match(fileName).hasMatch()) {
+                matched = true;
+                break;
+            }
+        }
+        if (!matched)
+            return false;
+    }
+#endif
+    // skip symlinks
+    const bool skipSymlinks = filters.testAnyFlag(QDir::NoSymLinks);
+    const bool includeSystem = filters.testAnyFlag(QDir::System);
+    if (skipSymlinks && entry.isSymLink()) {
+        // The only reason to save this file is if it is a broken link and we are requesting system files.
+        if (!includeSystem || entry.exists())
+            return false;
+    }
+
+    // filter hidden
+    if (!filters.testAnyFlag(QDir::Hidden) && entry.isHidden())
+        return false;
+
+    // filter system files
+    if (!includeSystem && (!(entry.isFile() || entry.isDir() || entry.isSymLink())
+                           || (!entry.exists() && entry.isSymLink())))
+        return false;
+
+    // skip directories
+    const bool skipDirs = !(filters & (QDir::Dirs | QDir::AllDirs));
+    if (skipDirs && entry.isDir())
+        return false;
+
+    // skip files
+    const bool skipFiles = !(filters & QDir::Files);
+    if (skipFiles && entry.isFile())
+        return false;
+
+    // filter permissions
+    const bool filterPermissions = ((filters & QDir::PermissionMask)
+                                    && (filters & QDir::PermissionMask) != QDir::PermissionMask);
+    if (filterPermissions) {
+        const QFileInfo fi = entry.fileInfo();
+        const bool doWritable = filters.testAnyFlag(QDir::Writable);
+        const bool doExecutable = filters.testAnyFlag(QDir::Executable);
+        const bool doReadable = filters.testAnyFlag(QDir::Readable);
+        if ((doReadable && !fi.isReadable())
+            || (doWritable && !fi.isWritable())
+            || (doExecutable && !fi.isExecutable())) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+    Constructs a QDirWalker that walks the tree below \a path, visiting all
+    entries except hidden and system ones. You can pass options via \a
+    flags.
+
+    \sa walk(), WalkerFlags
+*/
+QDirWalker::QDirWalker(const QString &path, WalkerFlags flags)
+    : d(new QDirWalkerPrivate(path, QStringList(), QDir::NoFilter, flags))
+{
+}
+
+/*!
+    Constructs a QDirWalker that walks the tree below \a path, visiting the
+    entries that match \a filters. You can pass options via \a flags.
+
+    By default, \a filters is QDir::NoFilter, which visits the same entries
+    as QDir::AllEntries.
+
+    \sa walk(), WalkerFlags
+*/
+QDirWalker::QDirWalker(const QString &path, QDir::Filters filters, WalkerFlags flags)
+    : d(new QDirWalkerPrivate(path, QStringList(), filters, flags))
+{
+}
+
+/*!
+    Constructs a QDirWalker that walks the tree below \a path, visiting the
+    entries that match \a nameFilters and \a filters. You can pass options
+    via \a flags.
+
+    \sa walk(), WalkerFlags, QDir::setNameFilters()
+*/
+QDirWalker::QDirWalker(const QString &path, const QStringList &nameFilters,
+                       QDir::Filters filters, WalkerFlags flags)
+    : d(new QDirWalkerPrivate(path, nameFilters, filters, flags))
+{
+}
+
+/*!
+    Destroys the QDirWalker.
+*/
+QDirWalker::~QDirWalker()
+{
+}
+
+/*!
+    Returns the path of the directory that is walked.
+*/
+QString QDirWalker::path() const
+{
+    return d->path;
+}
+
+/*!
+    Returns the name filters the entries are matched against.
+*/
+QStringList QDirWalker::nameFilters() const
+{
+    return d->nameFilters;
+}
+
+/*!
+    Returns the filters the entries are matched against.
+*/
+QDir::Filters QDirWalker::filter() const
+{
+    return d->filters;
+}
+
+/*!
+    Returns the flags that control the walk.
+*/
+QDirWalker::WalkerFlags QDirWalker::flags() const
+{
+    return d->flags;
+}
+
+/*!
+    Sets the maximum number of threads used by walk() to \a maxThreadCount.
+    With a value of 1 or less, walk() reads all directories on the calling
+    thread.
+
+    The default is QThread::idealThreadCount(). Trees on network or
+    otherwise slow storage can benefit from more threads than there are
+    processor cores.
+
+    \sa maxThreadCount()
+*/
+void QDirWalker::setMaxThreadCount(int maxThreadCount)
+{
+    d->maxThreadCount = qMax(maxThreadCount, 1);
+}
+
+/*!
+    Returns the maximum number of threads used by walk().
+
+    \sa setMaxThreadCount()
+*/
+int QDirWalker::maxThreadCount() const
+{
+    return d->maxThreadCount;
+}
+
+/*!
+    Walks the directory tree and calls \a visitor for every entry that
+    matches the filters. Returns when the whole tree has been walked.
+
+    Unless maxThreadCount() is 1, \a visitor is called from several worker
+    threads concurrently, and never from the calling thread.
+*/
+void QDirWalker::walk(const Visitor &visitor)
+{
+    if (!visitor)
+        return;
+
+    QDirWalkerDirectory root;
+    root.path = d->path;
+    root.prefix = d->path;
+    if (!root.prefix.isEmpty() && !root.prefix.endsWith(QLatin1Char('/')))
+        root.prefix += QLatin1Char('/');
+#ifdef Q_OS_UNIX
+    root.nativePrefix = QFile::encodeName(root.prefix);
+#endif
+
+    d->visitor = &visitor;
+    d->visitedDirectories.clear();
+#if QT_CONFIG(thread)
+    if (d->maxThreadCount > 1) {
+        QThreadPool pool;
+        pool.setMaxThreadCount(d->maxThreadCount);
+        d->pool = &pool;
+        QDirWalkerPrivate *dd = d.data();
+        pool.start([dd, root] { dd->walkDirectories({ root }); });
+        pool.waitForDone();
+        d->pool = nullptr;
+    } else
+#endif
+    {
+        d->walkDirectories({ root });
+    }
+    d->visitor = nullptr;
+    d->visitedDirectories.clear();
+}
+
+/*!
+    Returns the name of the entry, without the path.
+
+    \sa filePath()
+*/
+QString QDirWalker::Entry::fileName() const
+{
+    return d->fileName();
+}
+
+/*!
+    Returns the path of the entry, which is its fileName() appended to
+    path().
+
+    \sa fileName(), path()
+*/
+QString QDirWalker::Entry::filePath() const
+{
+    return d->filePath();
+}
+
+/*!
+    Returns the path of the directory containing the entry. For the entries
+    directly below the walked directory, this is the path passed to the
+    QDirWalker constructor.
+*/
+QString QDirWalker::Entry::path() const
+{
+    return d->dir->path;
+}
+
+/*!
+    Returns a QFileInfo for the entry. It is created with the information
+    the walker has already collected, so it is cheaper than constructing a
+    QFileInfo from filePath().
+*/
+QFileInfo QDirWalker::Entry::fileInfo() const
+{
+    return d->fileInfo();
+}
+
+/*!
+    Returns \c true if the entry is a directory or a symbolic link to one;
+    otherwise returns \c false.
+
+    \sa QFileInfo::isDir()
+*/
+bool QDirWalker::Entry::isDir() const
+{
+    return d->isDir();
+}
+
+/*!
+    Returns \c true if the entry is a regular file or a symbolic link to
+    one; otherwise returns \c false.
+
+    \sa QFileInfo::isFile()
+*/
+bool QDirWalker::Entry::isFile() const
+{
+    return d->isFile();
+}
+
+/*!
+    Returns \c true if the entry is a symbolic link; otherwise returns
+    \c false.
+
+    \sa QFileInfo::isSymLink()
+*/
+bool QDirWalker::Entry::isSymLink() const
+{
+    return d->isSymLink();
+}
+
+/*!
+    Returns the size of the entry in bytes, following symbolic links.
+    Returns 0 if the size cannot be determined.
+
+    \sa QFileInfo::size()
+*/
+qint64 QDirWalker::Entry::size() const
+{
+    return d->size();
+}
+
+/*!
+    Returns the time of the last modification of the entry, following
+    symbolic links, in local time.
+
+    \sa QFileInfo::lastModified()
+*/
+QDateTime QDirWalker::Entry::lastModified() const
+{
+    return d->lastModified();
+}
+
+QT_END_NAMESPACE
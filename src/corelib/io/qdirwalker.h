@@ -0,0 +1,110 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QDIRWALKER_H
+#define QDIRWALKER_H
+
+#include <QtCore/qdir.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+class QDirWalkerPrivate;
+class QDirWalkerEntryPrivate;
+class Q_CORE_EXPORT QDirWalker
+{
+public:
+    enum WalkerFlag {
+        NoWalkerFlags = 0x0,
+        FollowSymlinks = 0x1
+    };
+    Q_DECLARE_FLAGS(WalkerFlags, WalkerFlag)
+
+    class Q_CORE_EXPORT Entry
+    {
+    public:
+        QString fileName() const;
+        QString filePath() const;
+        QString path() const;
+        QFileInfo fileInfo() const;
+
+        bool isDir() const;
+        bool isFile() const;
+        bool isSymLink() const;
+        qint64 size() const;
+        QDateTime lastModified() const;
+
+    private:
+        friend class QDirWalkerPrivate;
+        explicit Entry(QDirWalkerEntryPrivate *dd) noexcept : d(dd) {}
+        Q_DISABLE_COPY_MOVE(Entry)
+
+        QDirWalkerEntryPrivate *d;
+    };
+
+    using Visitor = std::function<void(const Entry &)>;
+
+    explicit QDirWalker(const QString &path, WalkerFlags flags = NoWalkerFlags);
+    QDirWalker(const QString &path, QDir::Filters filters, WalkerFlags flags = NoWalkerFlags);
+    QDirWalker(const QString &path, const QStringList &nameFilters,
+               QDir::Filters filters = QDir::NoFilter, WalkerFlags flags = NoWalkerFlags);
+    ~QDirWalker();
+
+    QString path() const;
+    QStringList nameFilters() const;
+    QDir::Filters filter() const;
+    WalkerFlags flags() const;
+
+    void setMaxThreadCount(int maxThreadCount);
+    int maxThreadCount() const;
+
+    void walk(const Visitor &visitor);
+
+private:
+    Q_DISABLE_COPY(QDirWalker)
+
+    QScopedPointer<QDirWalkerPrivate> d;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(QDirWalker::WalkerFlags)
+
+QT_END_NAMESPACE
+
+#endif // QDIRWALKER_H
@@ -0,0 +1,274 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qspscringbufferdevice.h"
+#include "qspscringbuffer.h"
+
+#include "private/qiodevice_p.h"
+
+QT_BEGIN_NAMESPACE
+
+class QSpscRingBufferDevicePrivate : public QIODevicePrivate
+{
+    Q_DECLARE_PUBLIC(QSpscRingBufferDevice)
+
+public:
+    void notifyReadyRead();
+    void postReadyRead();
+
+    QSpscRingBuffer *buffer = nullptr;
+    qint64 notifiedPosition = 0;
+    bool readChannelFinished = false;
+};
+
+/*!
+    \class QSpscRingBufferDevice
+    \inmodule QtCore
+    \reentrant
+    \since 6.3
+    \ingroup io
+
+    \brief The QSpscRingBufferDevice class provides a QIODevice interface
+    for one end of a QSpscRingBuffer.
+
+    Opened ReadOnly, the device is the consumer end: it reads from the
+    buffer and emits readyRead() when the producer commits data, and
+    readChannelFinished() when the producer closes its end. Opened
+    WriteOnly, the device is the producer end: write() blocks until all
+    data has been stored in the buffer, and close() marks the end of the
+    data.
+
+    QIODevice is not thread-safe, so each thread uses its own device for
+    the shared buffer: typically a worker thread writes to a WriteOnly
+    device, while a ReadOnly device living in the consumer's thread
+    delivers the data with the usual readyRead() notifications.
+
+    \snippet code/src_corelib_io_qspscringbufferdevice.cpp 0
+
+    The device is always unbuffered and sequential: data is copied once,
+    between the ring buffer and the caller's memory.
+
+    \sa QSpscRingBuffer
+*/
+
+/*!
+    Constructs a device for \a buffer, which must outlive it, with the
+    given \a parent.
+*/
+QSpscRingBufferDevice::QSpscRingBufferDevice(QSpscRingBuffer *buffer, QObject *parent)
+    : QIODevice(*new QSpscRingBufferDevicePrivate, parent)
+{
+    Q_ASSERT(buffer);
+    d_func()->buffer = buffer;
+}
+
+/*!
+    Closes the device and destroys it. The buffer is not destroyed.
+*/
+QSpscRingBufferDevice::~QSpscRingBufferDevice()
+{
+    close();
+}
+
+/*!
+    Returns the ring buffer this device reads from or writes to.
+*/
+QSpscRingBuffer *QSpscRingBufferDevice::buffer() const
+{
+    return d_func()->buffer;
+}
+
+/*!
+    Opens the consumer end if \a mode is ReadOnly, or the producer end if
+    \a mode is WriteOnly. Opening both at once is not supported, and at
+    most one device may be open on each end of a buffer at a time.
+
+    \sa close()
+*/
+bool QSpscRingBufferDevice::open(OpenMode mode)
+{
+    Q_D(QSpscRingBufferDevice);
+    if ((mode & ReadWrite) == ReadWrite || !(mode & ReadWrite)) {
+        qWarning("QSpscRingBufferDevice::open: The device must be opened either ReadOnly or WriteOnly");
+        return false;
+    }
+    if (!QIODevice::open(mode | Unbuffered))
+        return false;
+    if (mode & ReadOnly) {
+        d->notifiedPosition = 0;
+        d->readChannelFinished = false;
+        d->buffer->setReadNotifier([d]() { d->postReadyRead(); });
+        d->notifyReadyRead();
+    }
+    return true;
+}
+
+/*!
+    Closes the device. Closing the producer end marks the end of the data,
+    see QSpscRingBuffer::closeWrite().
+*/
+void QSpscRingBufferDevice::close()
+{
+    Q_D(QSpscRingBufferDevice);
+    if (!isOpen())
+        return;
+    if (openMode() & WriteOnly)
+        d->buffer->closeWrite();
+    else
+        d->buffer->setReadNotifier({});
+    QIODevice::close();
+}
+
+/*!
+    \reimp
+
+    Always returns \c true.
+*/
+bool QSpscRingBufferDevice::isSequential() const
+{
+    return true;
+}
+
+/*!
+    \reimp
+*/
+qint64 QSpscRingBufferDevice::bytesAvailable() const
+{
+    Q_D(const QSpscRingBufferDevice);
+    qint64 result = QIODevice::bytesAvailable();
+    if (openMode() & ReadOnly)
+        result += d->buffer->size();
+    return result;
+}
+
+/*!
+    \reimp
+
+    Returns \c true on the consumer end once the producer closed its end and
+    all data has been read.
+*/
+bool QSpscRingBufferDevice::atEnd() const
+{
+    Q_D(const QSpscRingBufferDevice);
+    return QIODevice::atEnd() && (!(openMode() & ReadOnly) || d->buffer->atEnd());
+}
+
+/*!
+    \reimp
+
+    Blocks until data is available, or until \a msecs milliseconds have
+    passed. If new data has arrived since the last readyRead(), the signal
+    is emitted before returning. Returns \c true if data is available.
+*/
+bool QSpscRingBufferDevice::waitForReadyRead(int msecs)
+{
+    Q_D(QSpscRingBufferDevice);
+    if (!(openMode() & ReadOnly))
+        return false;
+    if (!d->buffer->waitForData(QDeadlineTimer(msecs)) || d->buffer->isEmpty())
+        return false;
+    d->notifyReadyRead();
+    return true;
+}
+
+/*!
+    \reimp
+*/
+qint64 QSpscRingBufferDevice::readData(char *data, qint64 maxlen)
+{
+    Q_D(QSpscRingBufferDevice);
+    const qint64 length = d->buffer->read(data, maxlen);
+    if (!length && d->buffer->atEnd())
+        return -1;
+    return length;
+}
+
+/*!
+    \reimp
+
+    Blocks until all of \a data has been stored in the buffer, which
+    requires the consumer to keep reading.
+*/
+qint64 QSpscRingBufferDevice::writeData(const char *data, qint64 len)
+{
+    Q_D(QSpscRingBufferDevice);
+    qint64 written = d->buffer->write(data, len);
+    while (written < len && d->buffer->waitForSpace())
+        written += d->buffer->write(data + written, len - written);
+    return written;
+}
+
+// Called on the producer thread, with the ring buffer's mutex locked.
+void QSpscRingBufferDevicePrivate::postReadyRead()
+{
+    Q_Q(QSpscRingBufferDevice);
+    QMetaObject::invokeMethod(q, [this]() { notifyReadyRead(); }, Qt::QueuedConnection);
+}
+
+void QSpscRingBufferDevicePrivate::notifyReadyRead()
+{
+    Q_Q(QSpscRingBufferDevice);
+    if (!(openMode & QIODevice::ReadOnly))
+        return;
+
+    const qint64 written = buffer->totalWritten();
+    const bool closed = buffer->isWriteClosed();
+    if (written != notifiedPosition) {
+        notifiedPosition = written;
+        emit q->readyRead();
+    }
+    if (closed) {
+        if (!readChannelFinished) {
+            readChannelFinished = true;
+            emit q->readChannelFinished();
+        }
+        return;
+    }
+
+    // arm first and check afterwards, so that data committed in between
+    // is not missed
+    buffer->armReadNotification();
+    if (buffer->totalWritten() != notifiedPosition || buffer->isWriteClosed())
+        postReadyRead();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qspscringbufferdevice.cpp"
@@ -0,0 +1,229 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qpropertyvisitor.h"
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QPropertyVisitor
+    \inmodule QtCore
+    \since 6.3
+    \brief The QPropertyVisitor class visits the properties of a class with
+    their native types.
+
+    Classes that contain the Q_PROPERTY_VISITOR macro next to the Q_OBJECT
+    or Q_GADGET macro get a static \c{qt_static_visitProperties()} function
+    generated by moc. It hands every stored property to a QPropertyVisitor as a
+    reference to a value of the property's own type, without wrapping it in
+    a QVariant and without looking the property up by name.
+
+    Subclasses implement visit() for the types they handle natively and the
+    generic overload taking a QMetaType for everything else. Properties whose
+    type has a property visitor of its own are passed to visitObject(), so
+    nested structures can be visited recursively.
+
+    A visitor either saves or loads properties, see isLoading(). When saving,
+    the visitor must not modify the values it is handed. When loading, the
+    generated code writes the values back through the property's WRITE
+    function or MEMBER variable; values of read-only properties are visited
+    and then discarded, which keeps position-based formats like QDataStream
+    symmetric.
+
+    The QtSerialization namespace uses this class to implement generic
+    QDataStream, CBOR and JSON serialization.
+
+    \sa Q_PROPERTY_VISITOR, QtSerialization
+*/
+
+/*!
+    \typedef QPropertyVisitor::VisitFunction
+
+    Type of the \c{qt_static_visitProperties()} function generated by moc.
+    It visits all stored properties of the object pointed to by its second
+    argument.
+*/
+
+/*!
+    \fn QPropertyVisitor::QPropertyVisitor(bool loading)
+
+    Constructs a visitor that loads property values if \a loading is \c true
+    and saves them otherwise.
+*/
+
+/*!
+    Destroys the visitor.
+*/
+QPropertyVisitor::~QPropertyVisitor()
+    = default;
+
+/*!
+    \fn bool QPropertyVisitor::isLoading() const
+
+    Returns \c true if this visitor assigns new values to the properties it
+    visits, \c false if it only reads them.
+*/
+
+/*!
+    Visits the property \a name of type \c bool, stored in \a value.
+    Returns \c true if the visitor assigned a new value to \a value, which
+    makes the generated code pass it on to the property's WRITE function.
+    Visitors that save properties return \c false.
+
+    The default implementation calls the generic visit() overload.
+*/
+bool QPropertyVisitor::visit(QLatin1String name, bool &value)
+{
+    return visit(name, QMetaType::fromType<bool>(), &value);
+}
+
+/*!
+    \overload
+*/
+bool QPropertyVisitor::visit(QLatin1String name, int &value)
+{
+    return visit(name, QMetaType::fromType<int>(), &value);
+}
+
+/*!
+    \overload
+*/
+bool QPropertyVisitor::visit(QLatin1String name, uint &value)
+{
+    return visit(name, QMetaType::fromType<uint>(), &value);
+}
+
+/*!
+    \overload
+*/
+bool QPropertyVisitor::visit(QLatin1String name, qint64 &value)
+{
+    return visit(name, QMetaType::fromType<qint64>(), &value);
+}
+
+/*!
+    \overload
+*/
+bool QPropertyVisitor::visit(QLatin1String name, quint64 &value)
+{
+    return visit(name, QMetaType::fromType<quint64>(), &value);
+}
+
+/*!
+    \overload
+*/
+bool QPropertyVisitor::visit(QLatin1String name, float &value)
+{
+    return visit(name, QMetaType::fromType<float>(), &value);
+}
+
+/*!
+    \overload
+*/
+bool QPropertyVisitor::visit(QLatin1String name, double &value)
+{
+    return visit(name, QMetaType::fromType<double>(), &value);
+}
+
+/*!
+    \overload
+*/
+bool QPropertyVisitor::visit(QLatin1String name, QString &value)
+{
+    return visit(name, QMetaType::fromType<QString>(), &value);
+}
+
+/*!
+    \overload
+*/
+bool QPropertyVisitor::visit(QLatin1String name, QByteArray &value)
+{
+    return visit(name, QMetaType::fromType<QByteArray>(), &value);
+}
+
+/*!
+    \fn bool QPropertyVisitor::visit(QLatin1String name, QMetaType type, void *value)
+
+    Visits the property \a name whose type has no dedicated visit() overload.
+    \a value points to an object of type \a type. Returns \c true if the
+    visitor assigned a new value to it.
+*/
+
+/*!
+    Visits the property \a name, whose type \a type has a property visitor of
+    its own. \a object points to the property's value and \a visitProperties
+    visits its properties. Returns \c true if the visitor assigned a new
+    value to any of them.
+
+    The default implementation treats the property like any other and calls
+    the generic visit() overload.
+*/
+bool QPropertyVisitor::visitObject(QLatin1String name, QMetaType type,
+                                   VisitFunction visitProperties, void *object)
+{
+    Q_UNUSED(visitProperties);
+    return visit(name, type, object);
+}
+
+/*!
+    \macro Q_PROPERTY_VISITOR
+    \relates QPropertyVisitor
+    \since 6.3
+
+    The Q_PROPERTY_VISITOR macro makes moc generate a typed property visitor
+    for a class that also contains the Q_OBJECT or Q_GADGET macro:
+
+    \snippet code/src_corelib_serialization_qpropertyserialization.cpp 0
+
+    The macro declares a public static member function
+    \c{qt_static_visitProperties(QPropertyVisitor &, void *)}, which visits
+    all stored properties of the class and of its first base class, if that
+    one uses Q_PROPERTY_VISITOR as well. Properties declared with MEMBER are
+    visited in place; all others are read through their READ function and,
+    when loading, written back through their WRITE function.
+
+    Classes derived from a class with Q_PROPERTY_VISITOR must use the macro
+    themselves, otherwise they inherit the visitor of their base class and
+    only its properties are visited.
+
+    \sa QPropertyVisitor, QtSerialization
+*/
+
+QT_END_NAMESPACE
@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QPROPERTYVISITOR_H
+#define QPROPERTYVISITOR_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qmetatype.h>
+#include <QtCore/qstring.h>
+
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+class Q_CORE_EXPORT QPropertyVisitor
+{
+public:
+    using VisitFunction = void (*)(QPropertyVisitor &, void *);
+
+    virtual ~QPropertyVisitor();
+
+    bool isLoading() const noexcept { return loading; }
+
+    virtual bool visit(QLatin1String name, bool &value);
+    virtual bool visit(QLatin1String name, int &value);
+    virtual bool visit(QLatin1String name, uint &value);
+    virtual bool visit(QLatin1String name, qint64 &value);
+    virtual bool visit(QLatin1String name, quint64 &value);
+    virtual bool visit(QLatin1String name, float &value);
+    virtual bool visit(QLatin1String name, double &value);
+    virtual bool visit(QLatin1String name, QString &value);
+    virtual bool visit(QLatin1String name, QByteArray &value);
+    virtual bool visit(QLatin1String name, QMetaType type, void *value) = 0;
+    virtual bool visitObject(QLatin1String name, QMetaType type, VisitFunction visitProperties,
+                             void *object);
+
+protected:
+    explicit QPropertyVisitor(bool loading) noexcept : loading(loading) {}
+
+private:
+    Q_DISABLE_COPY_MOVE(QPropertyVisitor)
+    bool loading;
+};
+
+namespace QtPrivate {
+
+template <typename T, typename = void>
+struct HasPropertyVisitor : std::false_type {};
+template <typename T>
+struct HasPropertyVisitor<T, std::void_t<decltype(&T::qt_static_visitProperties)>>
+    : std::true_type {};
+
+template <typename T, typename = void>
+struct IsBuiltinVisitable : std::false_type {};
+template <typename T>
+struct IsBuiltinVisitable<T, std::void_t<decltype(std::declval<QPropertyVisitor &>().visit(
+                                 QLatin1String(), std::declval<T &>()))>>
+    : std::true_type {};
+
+template <typename T>
+bool visitProperty(QPropertyVisitor &visitor, QLatin1String name, T &value)
+{
+    if constexpr (HasPropertyVisitor<T>::value)
+        return visitor.visitObject(name, QMetaType::fromType<T>(), &T::qt_static_visitProperties, &value);
+    else if constexpr (IsBuiltinVisitable<T>::value)
+        return visitor.visit(name, value);
+    else
+        return visitor.visit(name, QMetaType::fromType<T>(), &value);
+}
+
+template <typename Base, typename T>
+void visitBaseProperties([[maybe_unused]] QPropertyVisitor &visitor, [[maybe_unused]] T *object)
+{
+    if constexpr (HasPropertyVisitor<Base>::value && std::is_convertible_v<T *, Base *>)
+        Base::qt_static_visitProperties(visitor, static_cast<Base *>(object));
+}
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // QPROPERTYVISITOR_H
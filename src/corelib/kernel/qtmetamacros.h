@@ -45,6 +45,8 @@
 
 QT_BEGIN_NAMESPACE
 
+class QPropertyVisitor;
+
 #ifndef Q_MOC_OUTPUT_REVISION
 #define Q_MOC_OUTPUT_REVISION 68
 #endif
@@ -188,6 +190,14 @@ private: \
 /* qmake ignore Q_GADGET */
 #define Q_GADGET Q_GADGET_EXPORT()
 
+/* qmake ignore Q_PROPERTY_VISITOR */
+#define Q_PROPERTY_VISITOR \
+public: \
+    static void qt_static_visitProperties(QPropertyVisitor &, void *); \
+private: \
+    QT_ANNOTATE_CLASS(qt_property_visitor, "") \
+    /*end*/
+
     /* qmake ignore Q_NAMESPACE_EXPORT */
 #define Q_NAMESPACE_EXPORT(...) \
     extern __VA_ARGS__ const QMetaObject staticMetaObject; \
@@ -225,6 +235,7 @@ private: \
 #define Q_OBJECT_FAKE Q_OBJECT_FAKE
  /* qmake ignore Q_GADGET */
 #define Q_GADGET Q_GADGET
+#define Q_PROPERTY_VISITOR Q_PROPERTY_VISITOR
 #define Q_SCRIPTABLE Q_SCRIPTABLE
 #define Q_INVOKABLE Q_INVOKABLE
 #define Q_SIGNAL Q_SIGNAL
@@ -568,6 +568,9 @@ public:
     QByteArray::size_type bufferStart;
     bool corrupt = false;
 
+    // holds the last chunk returned as a view when reading from a QIODevice
+    QByteArray viewBuffer;
+
     QCborStreamReaderPrivate(const QByteArray &data)
         : device(nullptr), buffer(data)
     {
@@ -652,15 +655,18 @@ public:
             char *ptr;
             QByteArray *array;
             QString *string;
+            QByteArrayView *view;
         };
-        enum { ByteArray = -1, String = -3 };
+        enum { ByteArray = -1, String = -3, View = -5 };
         qsizetype maxlen_or_type;
 
         ReadStringChunk(char *ptr, qsizetype maxlen) : ptr(ptr), maxlen_or_type(maxlen) {}
         ReadStringChunk(QByteArray *array) : array(array), maxlen_or_type(ByteArray) {}
         ReadStringChunk(QString *str) : string(str), maxlen_or_type(String) {}
+        ReadStringChunk(QByteArrayView *view) : view(view), maxlen_or_type(View) {}
         bool isString() const { return maxlen_or_type == String; }
         bool isByteArray() const { return maxlen_or_type == ByteArray; }
+        bool isView() const { return maxlen_or_type == View; }
         bool isPlainPointer() const { return maxlen_or_type >= 0; }
     };
 
@@ -668,6 +674,7 @@ public:
     QCborStreamReader::StringResult<qsizetype> readStringChunk(ReadStringChunk params);
     qsizetype readStringChunk_byte(ReadStringChunk params, qsizetype len);
     qsizetype readStringChunk_unicode(ReadStringChunk params, qsizetype utf8len);
+    qsizetype readStringChunk_view(ReadStringChunk params, qsizetype len);
     bool ensureStringIteration();
 };
 
@@ -796,6 +803,10 @@ QCborStreamReader::QCborStreamReader()
 
    Creates a QCborStreamReader object with \a len bytes of data starting at \a
    data. The pointer must remain valid until QCborStreamReader is destroyed.
+
+   The data is not copied, so this is the most efficient way to read a file
+   mapped into memory with QFile::map(), especially in combination with
+   readUtf8StringView() and readByteArrayView().
  */
 QCborStreamReader::QCborStreamReader(const char *data, qsizetype len)
     : QCborStreamReader(QByteArray::fromRawData(data, len))
@@ -1384,6 +1395,79 @@ QCborStreamReader::StringResult<QByteArray> QCborStreamReader::_readByteArray_he
     return result;
 }
 
+/*!
+   \fn QCborStreamReader::StringResult<QUtf8StringView> QCborStreamReader::readUtf8StringView()
+   \since 6.3
+
+   Returns a view of one UTF-8 chunk of the CBOR text string. Like
+   readString(), this function must be called in a loop until it returns
+   EndOfString, even if isLengthKnown() is true.
+
+   If this QCborStreamReader was created on a byte array or on memory (such as
+   the memory returned by QFile::map()), the view points directly into that
+   data and no copy is made. The view remains valid for as long as the data
+   does, unless addData() is called. When reading from a QIODevice, the chunk
+   is copied into a buffer internal to this object and the view is only valid
+   until the next call to this function or to readByteArrayView().
+
+   The contents are validated to be UTF-8, the same as readString() does.
+
+   This function does not perform any type conversions, including from integers
+   or from byte arrays. Therefore, it may only be called if isString() returned
+   true; calling it in any other condition is an error.
+
+   \snippet code/src_corelib_serialization_qcborstream.cpp 30
+
+   \sa readByteArrayView(), readString(), isString()
+ */
+QCborStreamReader::StringResult<QUtf8StringView> QCborStreamReader::_readUtf8StringView_helper()
+{
+    QCborStreamReader::StringResult<QUtf8StringView> result;
+    auto r = _readByteArrayView_helper();
+    if (r.status == Ok && !QUtf8::isValidUtf8(r.data).isValidUtf8) {
+        d->handleError(CborErrorInvalidUtf8TextString);
+        return result;
+    }
+
+    result.data = QUtf8StringView(r.data.data(), r.data.size());
+    result.status = r.status;
+    return result;
+}
+
+/*!
+   \fn QCborStreamReader::StringResult<QByteArrayView> QCborStreamReader::readByteArrayView()
+   \since 6.3
+
+   Returns a view of one chunk of the CBOR byte string. Like readByteArray(),
+   this function must be called in a loop until it returns EndOfString, even if
+   isLengthKnown() is true.
+
+   The lifetime of the view is the same as for readUtf8StringView(): it points
+   into the data this QCborStreamReader parses, unless it is reading from a
+   QIODevice.
+
+   This function does not perform any type conversions, including from integers
+   or from strings. Therefore, it may only be called if isByteArray() is true;
+   calling it in any other condition is an error.
+
+   \sa readUtf8StringView(), readByteArray(), isByteArray()
+ */
+QCborStreamReader::StringResult<QByteArrayView> QCborStreamReader::_readByteArrayView_helper()
+{
+    QCborStreamReader::StringResult<QByteArrayView> result;
+    auto r = d->readStringChunk(&result.data);
+    result.status = r.status;
+    if (r.status == Error) {
+        result.data = {};
+    } else {
+        Q_ASSERT(r.data == result.data.size());
+        if (r.status == EndOfString && lastError() == QCborError::NoError)
+            preparse();
+    }
+
+    return result;
+}
+
 /*!
     \fn qsizetype QCborStreamReader::currentStringChunkSize() const
 
@@ -1529,6 +1613,9 @@ QCborStreamReaderPrivate::readStringChunk(ReadStringChunk params)
     if (params.isString()) {
         // readString()
         result.data = readStringChunk_unicode(params, qsizetype(len));
+    } else if (params.isView()) {
+        // readUtf8StringView() or readByteArrayView()
+        result.data = readStringChunk_view(params, qsizetype(len));
     } else {
         // readByteArray() or readStringChunk()
         result.data = readStringChunk_byte(params, qsizetype(len));
@@ -1619,6 +1706,31 @@ QCborStreamReaderPrivate::readStringChunk_byte(ReadStringChunk params, qsizetype
     return actuallyRead;
 }
 
+inline qsizetype
+QCborStreamReaderPrivate::readStringChunk_view(ReadStringChunk params, qsizetype len)
+{
+    if (!device) {
+        // the chunk is contiguous in the buffer we're parsing: no copy needed
+        *params.view = QByteArrayView(buffer.constData() + bufferStart, len);
+        return len;
+    }
+
+    // See note above on having ensured there is enough incoming data.
+    QT_TRY {
+        viewBuffer.resize(len);
+    } QT_CATCH (const std::bad_alloc &) {
+        handleError(len > MaxByteArraySize ? CborErrorDataTooLarge : CborErrorOutOfMemory);
+        return -1;
+    }
+
+    if (device->read(viewBuffer.data(), len) != len) {
+        handleError(CborErrorIO);
+        return -1;
+    }
+    *params.view = viewBuffer;
+    return len;
+}
+
 inline qsizetype
 QCborStreamReaderPrivate::readStringChunk_unicode(ReadStringChunk params, qsizetype utf8len)
 {
@@ -41,11 +41,13 @@
 #define QCBORSTREAMREADER_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qbytearrayview.h>
 #include <QtCore/qcborcommon.h>
 #include <QtCore/qfloat16.h>
 #include <QtCore/qscopedpointer.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qstringview.h>
+#include <QtCore/qutf8stringview.h>
 
 QT_REQUIRE_CONFIG(cborstreamreader);
 
@@ -157,6 +159,8 @@ public:
     StringResult<QByteArray> readByteArray(){ Q_ASSERT(isByteArray()); return _readByteArray_helper(); }
     qsizetype currentStringChunkSize() const{ Q_ASSERT(isString() || isByteArray()); return _currentStringChunkSize(); }
     StringResult<qsizetype> readStringChunk(char *ptr, qsizetype maxlen);
+    StringResult<QUtf8StringView> readUtf8StringView() { Q_ASSERT(isString()); return _readUtf8StringView_helper(); }
+    StringResult<QByteArrayView> readByteArrayView() { Q_ASSERT(isByteArray()); return _readByteArrayView_helper(); }
 
     bool toBool() const                 { Q_ASSERT(isBool()); return value64 - int(QCborSimpleType::False); }
     QCborTag toTag() const              { Q_ASSERT(isTag()); return QCborTag(value64); }
@@ -181,6 +185,8 @@ private:
     bool _enterContainer_helper();
     StringResult<QString> _readString_helper();
     StringResult<QByteArray> _readByteArray_helper();
+    StringResult<QUtf8StringView> _readUtf8StringView_helper();
+    StringResult<QByteArrayView> _readByteArrayView_helper();
     qsizetype _currentStringChunkSize() const;
 
     template <typename FP> FP _toFloatingPoint() const noexcept
@@ -1193,6 +1193,10 @@ static int compareElementRecursive(const QCborContainerPrivate *c1, const Elemen
 
 static int compareContainer(const QCborContainerPrivate *c1, const QCborContainerPrivate *c2)
 {
+    if (c1)
+        c1->materialize();
+    if (c2)
+        c2->materialize();
     auto len1 = c1 ? c1->elements.size() : 0;
     auto len2 = c2 ? c2->elements.size() : 0;
     if (len1 != len2) {
@@ -1340,6 +1344,8 @@ static void encodeToCbor(QCborStreamWriter &writer, const QCborContainerPrivate
 {
     if (idx == -QCborValue::Array || idx == -QCborValue::Map) {
         bool isArray = (idx == -QCborValue::Array);
+        if (d)
+            d->materialize();
         qsizetype len = d ? d->elements.size() : 0;
         if (isArray)
             writer.startArray(quint64(len));
@@ -2511,9 +2517,12 @@ QCborValue QCborValue::fromCbor(const QByteArray &ba, QCborParserError *error)
     \fn QCborValue QCborValue::fromCbor(const quint8 *data, qsizetype len, QCborParserError *error)
     \overload
 
-    Converts \a len bytes of \a data to a QByteArray and then calls the
+    Decodes \a len bytes of \a data, which are not copied, by calling the
     overload of this function that accepts a QByteArray, also passing \a error,
-    if provided.
+    if provided. The resulting QCborValue does not refer to \a data, so the
+    data only needs to remain valid during this call. This makes these
+    overloads suitable for decoding a file mapped into memory with
+    QFile::map().
 */
 #endif // QT_CONFIG(cborstreamreader)
 
@@ -2748,6 +2757,7 @@ QCborValueRef QCborValueRef::operator[](const QString &key)
     qsizetype size = 0;
     if (e.flags & QtCbor::Element::IsContainer) {
         if (e.container) {
+            e.container->materialize();
             if (e.type == QCborValue::Array) {
                 QCborValue repack = QCborValue(arrayAsMap(QCborArray(*e.container)));
                 qSwap(e.container, repack.container);
@@ -2809,6 +2819,7 @@ QCborValueRef QCborValueRef::operator[](QLatin1String key)
     qsizetype size = 0;
     if (e.flags & QtCbor::Element::IsContainer) {
         if (e.container) {
+            e.container->materialize();
             if (e.type == QCborValue::Array) {
                 QCborValue repack = QCborValue(arrayAsMap(QCborArray(*e.container)));
                 qSwap(e.container, repack.container);
@@ -2875,6 +2886,7 @@ QCborValueRef QCborValueRef::operator[](qint64 key)
     qsizetype size = 0;
     if (e.flags & QtCbor::Element::IsContainer) {
         if (e.container) {
+            e.container->materialize();
             if (e.type == QCborValue::Array) {
                 QCborValue repack = QCborValue(arrayAsMap(QCborArray(*e.container)));
                 qSwap(e.container, repack.container);
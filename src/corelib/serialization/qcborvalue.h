@@ -284,9 +284,9 @@ public:
     static QCborValue fromCbor(QCborStreamReader &reader);
     static QCborValue fromCbor(const QByteArray &ba, QCborParserError *error = nullptr);
     static QCborValue fromCbor(const char *data, qsizetype len, QCborParserError *error = nullptr)
-    { return fromCbor(QByteArray(data, int(len)), error); }
+    { return fromCbor(QByteArray::fromRawData(data, len), error); }
     static QCborValue fromCbor(const quint8 *data, qsizetype len, QCborParserError *error = nullptr)
-    { return fromCbor(QByteArray(reinterpret_cast<const char *>(data), int(len)), error); }
+    { return fromCbor(QByteArray::fromRawData(reinterpret_cast<const char *>(data), len), error); }
 #endif // QT_CONFIG(cborstreamreader)
 #if QT_CONFIG(cborstreamwriter)
     QByteArray toCbor(EncodingOptions opt = NoTransformation) const;
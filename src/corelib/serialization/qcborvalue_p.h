@@ -134,11 +134,22 @@ class QCborContainerPrivate : public QSharedData
 public:
     enum ContainerDisposition { CopyContainer, MoveContainer };
 
+    // Non-zero while this container holds the unparsed JSON text of an object
+    // or array in data (see QJsonDocument::LazyParsing). Such containers are
+    // only reachable through their parent's elements, and materialize() must
+    // be called before accessing their elements.
+    QAtomicInt lazy;
     QByteArray::size_type usedData = 0;
     QByteArray data;
     QList<QtCbor::Element> elements;
 
     void deref() { if (!ref.deref()) delete this; }
+    void materialize() const
+    {
+        if (Q_UNLIKELY(lazy.loadAcquire()))
+            materializeJson();
+    }
+    void materializeJson() const;
     void compact(qsizetype reserved);
     static QCborContainerPrivate *clone(QCborContainerPrivate *d, qsizetype reserved = -1);
     static QCborContainerPrivate *detach(QCborContainerPrivate *d, qsizetype reserved);
@@ -193,6 +204,7 @@ public:
         const QtCbor::Element &e = elements.at(idx);
         if (e.type != type || (e.flags & QtCbor::Element::IsContainer) == 0)
             return nullptr;
+        e.container->materialize();
         return e.container;
     }
 
@@ -313,8 +325,11 @@ public:
         QCborValue result(type);
         result.n = n;
         result.container = d;
-        if (d && disp == CopyContainer)
-            d->ref.ref();
+        if (d) {
+            d->materialize();
+            if (disp == CopyContainer)
+                d->ref.ref();
+        }
         return result;
     }
 
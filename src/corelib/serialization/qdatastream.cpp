@@ -1471,6 +1471,95 @@ int QDataStream::skipRawData(int len)
     \sa {Serializing Qt Data Types}
 */
 
+static void byteSwapArray(const void *src, qsizetype count, void *dst, int elementSize)
+{
+    switch (elementSize) {
+    case 2:
+        qbswap<2>(src, count, dst);
+        break;
+    case 4:
+        qbswap<4>(src, count, dst);
+        break;
+    case 8:
+        qbswap<8>(src, count, dst);
+        break;
+    default:
+        Q_ASSERT(elementSize == 1);
+        if (src != dst)
+            memcpy(dst, src, count);
+        break;
+    }
+}
+
+static bool isNativeByteOrder(const QDataStream &s)
+{
+    return s.byteOrder() == QDataStream::ByteOrder(QSysInfo::ByteOrder);
+}
+
+// readRawData() and writeRawData() take an int, so large arrays are
+// transferred in pieces of at most this many bytes
+static constexpr qsizetype MaxRawDataChunk = 1 << 30;
+
+/*!
+    \internal
+
+    Reads \a count arithmetic values of \a elementSize bytes each from \a s
+    into \a data in a single block, converting from the stream's byte order.
+    This is the bulk equivalent of reading the elements one by one. Returns
+    \c false if the stream ran out of data.
+*/
+bool QtPrivate::readArithmeticArray(QDataStream &s, void *data, qsizetype count, int elementSize)
+{
+    char *p = static_cast<char *>(data);
+    qsizetype bytes = count * elementSize;
+    while (bytes > 0) {
+        const int chunk = int(qMin(bytes, MaxRawDataChunk));
+        if (s.readRawData(p, chunk) != chunk || s.status() != QDataStream::Ok)
+            return false;
+        p += chunk;
+        bytes -= chunk;
+    }
+
+    if (elementSize > 1 && !isNativeByteOrder(s))
+        byteSwapArray(data, count, data, elementSize);
+    return true;
+}
+
+/*!
+    \internal
+
+    Writes \a count arithmetic values of \a elementSize bytes each from
+    \a data to \a s in a single block, converting to the stream's byte order.
+    This is the bulk equivalent of writing the elements one by one.
+*/
+void QtPrivate::writeArithmeticArray(QDataStream &s, const void *data, qsizetype count, int elementSize)
+{
+    const char *p = static_cast<const char *>(data);
+    qsizetype bytes = count * elementSize;
+
+    if (elementSize == 1 || isNativeByteOrder(s)) {
+        while (bytes > 0) {
+            const int chunk = int(qMin(bytes, MaxRawDataChunk));
+            if (s.writeRawData(p, chunk) != chunk)
+                return;
+            p += chunk;
+            bytes -= chunk;
+        }
+        return;
+    }
+
+    // swap through a small buffer instead of copying the whole array
+    alignas(16) char buffer[8192];
+    while (bytes > 0) {
+        const int chunk = int(qMin(bytes, qsizetype(sizeof(buffer))));
+        byteSwapArray(p, chunk / elementSize, buffer, elementSize);
+        if (s.writeRawData(buffer, chunk) != chunk)
+            return;
+        p += chunk;
+        bytes -= chunk;
+    }
+}
+
 QT_END_NAMESPACE
 
 #endif // QT_NO_DATASTREAM
@@ -240,6 +240,57 @@ private:
     QDataStream::Status oldStatus;
 };
 
+// Types whose serialized form is their in-memory representation, modulo byte
+// order. Lists of these can be read and written as one block.
+template <typename T>
+using IsBulkStreamable = std::disjunction<
+        std::conjunction<std::is_integral<T>, std::negation<std::is_same<T, bool>>>,
+        std::is_same<T, float>, std::is_same<T, double>>;
+
+template <typename T>
+bool canStreamInBulk(const QDataStream &s)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        // float and double are converted if the precision doesn't match
+        if (s.version() >= QDataStream::Qt_4_6)
+            return (s.floatingPointPrecision() == QDataStream::SinglePrecision)
+                    == (sizeof(T) == sizeof(float));
+    } else if constexpr (sizeof(T) == 8) {
+        // very old streams write 64-bit integers as two 32-bit halves
+        return s.version() >= 6;
+    }
+    return true;
+}
+
+Q_CORE_EXPORT bool readArithmeticArray(QDataStream &s, void *data, qsizetype count, int elementSize);
+Q_CORE_EXPORT void writeArithmeticArray(QDataStream &s, const void *data, qsizetype count, int elementSize);
+
+template <typename Container>
+QDataStream &readArithmeticArrayContainer(QDataStream &s, Container &c)
+{
+    StreamStateSaver stateSaver(&s);
+
+    c.clear();
+    quint32 n;
+    s >> n;
+    if (n) {
+        c.resize(n);
+        if (!readArithmeticArray(s, c.data(), n, sizeof(typename Container::value_type)))
+            c.clear();
+    }
+
+    return s;
+}
+
+template <typename Container>
+QDataStream &writeArithmeticArrayContainer(QDataStream &s, const Container &c)
+{
+    s << quint32(c.size());
+    writeArithmeticArray(s, c.constData(), c.size(), sizeof(typename Container::value_type));
+
+    return s;
+}
+
 template <typename Container>
 QDataStream &readArrayBasedContainer(QDataStream &s, Container &c)
 {
@@ -439,12 +490,20 @@ operator>>(QDataStream &s, T &t)
 template<typename T>
 inline QDataStreamIfHasIStreamOperatorsContainer<QList<T>, T> operator>>(QDataStream &s, QList<T> &v)
 {
+    if constexpr (QtPrivate::IsBulkStreamable<T>::value) {
+        if (QtPrivate::canStreamInBulk<T>(s))
+            return QtPrivate::readArithmeticArrayContainer(s, v);
+    }
     return QtPrivate::readArrayBasedContainer(s, v);
 }
 
 template<typename T>
 inline QDataStreamIfHasOStreamOperatorsContainer<QList<T>, T> operator<<(QDataStream &s, const QList<T> &v)
 {
+    if constexpr (QtPrivate::IsBulkStreamable<T>::value) {
+        if (QtPrivate::canStreamInBulk<T>(s))
+            return QtPrivate::writeArithmeticArrayContainer(s, v);
+    }
     return QtPrivate::writeSequentialContainer(s, v);
 }
 
@@ -232,6 +232,7 @@ static QJsonArray convertToJsonArray(QCborContainerPrivate *d,
 {
     QJsonArray a;
     if (d) {
+        d->materialize();
         for (qsizetype idx = 0; idx < d->elements.size(); ++idx)
             a.append(qt_convertToJson(d, idx, mode));
     }
@@ -245,6 +246,7 @@ static QJsonObject convertToJsonObject(QCborContainerPrivate *d,
 {
     QJsonObject o;
     if (d) {
+        d->materialize();
         for (qsizetype idx = 0; idx < d->elements.size(); idx += 2)
             o.insert(makeString(d, idx), qt_convertToJson(d, idx + 1, mode));
     }
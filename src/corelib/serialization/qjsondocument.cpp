@@ -300,6 +300,29 @@ QByteArray QJsonDocument::toJson(JsonFormat format) const
 
     return json;
 }
+
+/*!
+    \since 6.3
+    \overload
+
+    Writes the QJsonDocument to \a device as a UTF-8 encoded JSON document in
+    the provided \a format. The output is identical to that of toJson(), but
+    is written in blocks as it is produced instead of being assembled in
+    memory first.
+
+    Returns \c true on success, or \c false if writing to the device failed.
+    A null document writes nothing.
+ */
+bool QJsonDocument::toJson(QIODevice *device, JsonFormat format) const
+{
+    Q_ASSERT(device);
+    if (!d)
+        return true;
+
+    const QCborContainerPrivate *container = QJsonPrivate::Value::container(d->value);
+    return QJsonPrivate::Writer::toDevice(container, d->value.isArray(), device,
+                                          format == Compact);
+}
 #endif
 
 /*!
@@ -314,7 +337,49 @@ QByteArray QJsonDocument::toJson(JsonFormat format) const
  */
 QJsonDocument QJsonDocument::fromJson(const QByteArray &json, QJsonParseError *error)
 {
-    QJsonPrivate::Parser parser(json.constData(), json.length());
+    return fromJson(json, EagerParsing, error);
+}
+
+/*!
+    \enum QJsonDocument::ParseMode
+    \since 6.3
+
+    This value defines how fromJson() builds the document.
+
+    \value EagerParsing All objects and arrays are built while parsing.
+    \value LazyParsing Only the top-level object or array is built while
+        parsing. Nested objects and arrays are validated, but they keep a
+        reference to their text in the (shared) input and are built the first
+        time they are accessed. Strings without escape sequences are kept as
+        UTF-8 and converted when requested.
+  */
+
+/*!
+    \since 6.3
+    \overload
+
+    Parses \a json as a UTF-8 encoded JSON document using the given parse
+    \a mode, and creates a QJsonDocument from it.
+
+    Errors are detected and reported in \a error the same way in both modes.
+    LazyParsing is faster and uses less memory when only a small part of a
+    large document is read, but the document then keeps a reference to
+    \a json until all of its nested objects and arrays have been accessed.
+
+    \sa ParseMode
+ */
+QJsonDocument QJsonDocument::fromJson(const QByteArray &json, ParseMode mode,
+                                      QJsonParseError *error)
+{
+    QByteArray source = json;
+    if (mode == LazyParsing && !source.data_ptr().isMutable()) {
+        // the nested containers must be able to keep the text alive
+        source = QByteArray(json.constData(), json.size());
+    }
+
+    QJsonPrivate::Parser parser(source.constData(), source.length());
+    if (mode == LazyParsing)
+        parser.setLazy(source);
     QJsonDocument result;
     const QCborValue val = parser.parse(error);
     if (val.isArray() || val.isMap()) {
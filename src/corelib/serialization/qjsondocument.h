@@ -49,6 +49,7 @@ QT_BEGIN_NAMESPACE
 
 class QDebug;
 class QCborValue;
+class QIODevice;
 
 namespace QJsonPrivate { class Parser; }
 
@@ -114,10 +115,18 @@ public:
         Compact
     };
 
+    enum ParseMode {
+        EagerParsing,
+        LazyParsing
+    };
+
     static QJsonDocument fromJson(const QByteArray &json, QJsonParseError *error = nullptr);
+    static QJsonDocument fromJson(const QByteArray &json, ParseMode mode,
+                                  QJsonParseError *error = nullptr);
 
 #if !defined(QT_JSON_READONLY) || defined(Q_CLANG_QDOC)
     QByteArray toJson(JsonFormat format = Indented) const;
+    bool toJson(QIODevice *device, JsonFormat format = Indented) const;
 #endif
 
     bool isEmpty() const;
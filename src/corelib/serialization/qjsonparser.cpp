@@ -47,6 +47,9 @@
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
+#include "private/qsimd_p.h"
+#include "private/qtextscan_p.h"
+#include <qmutex.h>
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -222,7 +225,7 @@ private:
     QExplicitlySharedDataPointer<QCborContainerPrivate> *current;
 };
 
-Parser::Parser(const char *json, int length)
+Parser::Parser(const char *json, qsizetype length)
     : head(json), json(json)
     , nestingLevel(0)
     , lastError(QJsonParseError::NoError)
@@ -272,6 +275,69 @@ enum {
     Quote = 0x22
 };
 
+namespace {
+// quotes, backslashes and bytes with the high bit set, which start a
+// multi-byte UTF-8 sequence
+struct StringStops
+{
+    static bool stopsAt(char c) { return c == Quote || c == '\\' || uchar(c) >= 0x80; }
+#ifdef __SSE2__
+    static __m128i stops(__m128i data)
+    {
+        const __m128i quote = _mm_cmpeq_epi8(data, _mm_set1_epi8(Quote));
+        const __m128i backslash = _mm_cmpeq_epi8(data, _mm_set1_epi8('\\'));
+        return _mm_or_si128(data, _mm_or_si128(quote, backslash));
+    }
+#endif
+#ifdef QTEXTSCAN_AVX2
+    QT_FUNCTION_TARGET(AVX2) static __m256i stops(__m256i data)
+    {
+        const __m256i quote = _mm256_cmpeq_epi8(data, _mm256_set1_epi8(Quote));
+        const __m256i backslash = _mm256_cmpeq_epi8(data, _mm256_set1_epi8('\\'));
+        return _mm256_or_si256(data, _mm256_or_si256(quote, backslash));
+    }
+#endif
+};
+
+// anything but JSON whitespace
+struct NonWhitespaceStops
+{
+    static bool stopsAt(char c) { return c != Space && c != Tab && c != LineFeed && c != Return; }
+#ifdef __SSE2__
+    static __m128i stops(__m128i data)
+    {
+        const __m128i blank = _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8(Space)),
+                                           _mm_cmpeq_epi8(data, _mm_set1_epi8(Tab)));
+        const __m128i lineBreak = _mm_or_si128(_mm_cmpeq_epi8(data, _mm_set1_epi8(LineFeed)),
+                                               _mm_cmpeq_epi8(data, _mm_set1_epi8(Return)));
+        return _mm_xor_si128(_mm_or_si128(blank, lineBreak), _mm_set1_epi32(-1));
+    }
+#endif
+#ifdef QTEXTSCAN_AVX2
+    QT_FUNCTION_TARGET(AVX2) static __m256i stops(__m256i data)
+    {
+        const __m256i blank = _mm256_or_si256(_mm256_cmpeq_epi8(data, _mm256_set1_epi8(Space)),
+                                              _mm256_cmpeq_epi8(data, _mm256_set1_epi8(Tab)));
+        const __m256i lineBreak = _mm256_or_si256(_mm256_cmpeq_epi8(data, _mm256_set1_epi8(LineFeed)),
+                                                  _mm256_cmpeq_epi8(data, _mm256_set1_epi8(Return)));
+        return _mm256_xor_si256(_mm256_or_si256(blank, lineBreak), _mm256_set1_epi32(-1));
+    }
+#endif
+};
+} // unnamed namespace
+
+// Returns the first quote, backslash or non-ASCII byte in [ptr, end), or end.
+const char *QJsonPrivate::skipStringChars(const char *ptr, const char *end) noexcept
+{
+    return QtPrivate::scanUntil<StringStops>(ptr, end);
+}
+
+// Returns the first byte in [ptr, end) that is not JSON whitespace, or end.
+const char *QJsonPrivate::skipWhitespace(const char *ptr, const char *end) noexcept
+{
+    return QtPrivate::scanUntil<NonWhitespaceStops>(ptr, end);
+}
+
 void Parser::eatBOM()
 {
     // eat UTF-8 byte order mark
@@ -285,16 +351,10 @@ void Parser::eatBOM()
 
 bool Parser::eatSpace()
 {
-    while (json < end) {
-        if (*json > Space)
-            break;
-        if (*json != Space &&
-            *json != Tab &&
-            *json != LineFeed &&
-            *json != Return)
-            break;
-        ++json;
-    }
+    // compact documents have no whitespace between most tokens
+    if (json < end && *json > Space)
+        return true;
+    json = skipWhitespace(json, end);
     return (json < end);
 }
 
@@ -447,7 +507,7 @@ bool Parser::parseObject()
 
     char token = nextToken();
     while (token == Quote) {
-        if (!container)
+        if (!container && !skipping)
             container = new QCborContainerPrivate;
         if (!parseMember())
             return false;
@@ -525,7 +585,7 @@ bool Parser::parseArray()
                 lastError = QJsonParseError::UnterminatedArray;
                 return false;
             }
-            if (!container)
+            if (!container && !skipping)
                 container = new QCborContainerPrivate;
             if (!parseValue())
                 return false;
@@ -568,7 +628,8 @@ bool Parser::parseValue()
         if (*json++ == 'u' &&
             *json++ == 'l' &&
             *json++ == 'l') {
-            container->append(QCborValue(QCborValue::Null));
+            if (!skipping)
+                container->append(QCborValue(QCborValue::Null));
             DEBUG << "value: null";
             END;
             return true;
@@ -583,7 +644,8 @@ bool Parser::parseValue()
         if (*json++ == 'r' &&
             *json++ == 'u' &&
             *json++ == 'e') {
-            container->append(QCborValue(true));
+            if (!skipping)
+                container->append(QCborValue(true));
             DEBUG << "value: true";
             END;
             return true;
@@ -599,7 +661,8 @@ bool Parser::parseValue()
             *json++ == 'l' &&
             *json++ == 's' &&
             *json++ == 'e') {
-            container->append(QCborValue(false));
+            if (!skipping)
+                container->append(QCborValue(false));
             DEBUG << "value: false";
             END;
             return true;
@@ -614,6 +677,8 @@ bool Parser::parseValue()
         return true;
     }
     case BeginArray: {
+        if (lazy)
+            return parseNested(QCborValue::Array);
         StashedContainer stashedContainer(&container, QCborValue::Array);
         if (!parseArray())
             return false;
@@ -622,6 +687,8 @@ bool Parser::parseValue()
         return true;
     }
     case BeginObject: {
+        if (lazy)
+            return parseNested(QCborValue::Map);
         StashedContainer stashedContainer(&container, QCborValue::Map);
         if (!parseObject())
             return false;
@@ -653,6 +720,64 @@ bool Parser::parseValue()
 
 
 
+/*
+    In lazy mode, nested objects and arrays are validated without building
+    them. The container only keeps their text, sharing the source buffer, and
+    is parsed on first access by QCborContainerPrivate::materializeJson().
+*/
+bool Parser::parseNested(QCborValue::Type type)
+{
+    const char *begin = json - 1;
+    QExplicitlySharedDataPointer<QCborContainerPrivate> parent(std::move(container));
+    const bool wasSkipping = std::exchange(skipping, true);
+    const bool ok = type == QCborValue::Array ? parseArray() : parseObject();
+    skipping = wasSkipping;
+    container = std::move(parent);
+    if (!ok || skipping)
+        return ok;
+
+    QByteArray::DataPointer text = lazySource.data_ptr();
+    text.ptr = const_cast<char *>(begin);
+    text.size = json - begin;
+
+    auto nested = new QCborContainerPrivate;
+    nested->ref.ref();
+    nested->data = QByteArray(text);
+    nested->lazy.storeRelaxed(1);
+    container->elements.append(QtCbor::Element(nested, type));
+    return true;
+}
+
+static QBasicMutex materializeMutexPool[131];
+
+// Containers are materialized under a lock picked by address, so that threads
+// reading unrelated containers of a lazily parsed document don't contend.
+// Only one level is parsed at a time, so no thread holds two of these locks.
+static inline QBasicMutex *materializeLock(const QCborContainerPrivate *d)
+{
+    return &materializeMutexPool[quintptr(d) % (sizeof(materializeMutexPool) / sizeof(QBasicMutex))];
+}
+
+void QCborContainerPrivate::materializeJson() const
+{
+    QMutexLocker locker(materializeLock(this));
+    if (!lazy.loadRelaxed())
+        return;
+
+    auto that = const_cast<QCborContainerPrivate *>(this);
+    const QByteArray text = std::exchange(that->data, QByteArray());
+    Parser parser(text.constData(), text.size());
+    parser.setLazy(text);
+    const QCborValue value = parser.parse(nullptr);
+    Q_ASSERT(value.isArray() || value.isMap());
+    if (QCborContainerPrivate *parsed = QJsonPrivate::Value::container(value)) {
+        that->elements.swap(parsed->elements);
+        that->data.swap(parsed->data);
+        that->usedData = parsed->usedData;
+    }
+    that->lazy.storeRelease(0);
+}
+
 /*
         number = [ minus ] int [ frac ] [ exp ]
         decimal-point = %x2E       ; .
@@ -685,6 +810,7 @@ bool Parser::parseNumber()
         while (json < end && *json >= '0' && *json <= '9')
             ++json;
     }
+    const char *intEnd = json;
 
     // frac = decimal-point 1*DIGIT
     if (json < end && *json == '.') {
@@ -710,6 +836,19 @@ bool Parser::parseNumber()
         return false;
     }
 
+    // integers of up to 18 digits cannot overflow, so convert them in place
+    const char *digits = start + (*start == '-');
+    if (json == intEnd && json > digits && json - digits <= 18) {
+        if (!skipping) {
+            qint64 n = 0;
+            for (const char *p = digits; p != json; ++p)
+                n = n * 10 + (*p - '0');
+            container->append(digits == start ? n : -n);
+        }
+        END;
+        return true;
+    }
+
     const QByteArray number = QByteArray::fromRawData(start, json - start);
     DEBUG << "numberstring" << number;
 
@@ -717,7 +856,8 @@ bool Parser::parseNumber()
         bool ok;
         qlonglong n = number.toLongLong(&ok);
         if (ok) {
-            container->append(QCborValue(n));
+            if (!skipping)
+                container->append(QCborValue(n));
             END;
             return true;
         }
@@ -731,6 +871,11 @@ bool Parser::parseNumber()
         return false;
     }
 
+    if (skipping) {
+        END;
+        return true;
+    }
+
     qint64 n;
     if (convertDoubleTo(d, &n))
         container->append(QCborValue(n));
@@ -777,7 +922,7 @@ static inline bool addHexDigit(char digit, char32_t *result)
     return true;
 }
 
-static inline bool scanEscapeSequence(const char *&json, const char *end, char32_t *ch)
+bool QJsonPrivate::scanEscapeSequence(const char *&json, const char *end, char32_t *ch)
 {
     ++json;
     if (json >= end)
@@ -822,7 +967,7 @@ static inline bool scanEscapeSequence(const char *&json, const char *end, char32
     return true;
 }
 
-static inline bool scanUtf8Char(const char *&json, const char *end, char32_t *result)
+bool QJsonPrivate::scanUtf8Char(const char *&json, const char *end, char32_t *result)
 {
     const auto *usrc = reinterpret_cast<const uchar *>(json);
     const auto *uend = reinterpret_cast<const uchar *>(end);
@@ -845,6 +990,9 @@ bool Parser::parseString()
     bool isUtf8 = true;
     bool isAscii = true;
     while (json < end) {
+        json = skipStringChars(json, end);
+        if (json >= end)
+            break;
         char32_t ch = 0;
         if (*json == '"')
             break;
@@ -873,9 +1021,9 @@ bool Parser::parseString()
 
     // no escape sequences, we are done
     if (isUtf8) {
-        if (isAscii)
+        if (!skipping && isAscii)
             container->appendAsciiString(start, json - start - 1);
-        else
+        else if (!skipping)
             container->appendUtf8String(start, json - start - 1);
         END;
         return true;
@@ -887,6 +1035,12 @@ bool Parser::parseString()
 
     QString ucs4;
     while (json < end) {
+        const char *run = json;
+        json = skipStringChars(json, end);
+        if (json != run && !skipping)
+            ucs4.append(QLatin1String(run, json - run));
+        if (json >= end)
+            break;
         char32_t ch = 0;
         if (*json == '"')
             break;
@@ -901,7 +1055,8 @@ bool Parser::parseString()
                 return false;
             }
         }
-        ucs4.append(QChar::fromUcs4(ch));
+        if (!skipping)
+            ucs4.append(QChar::fromUcs4(ch));
     }
     ++json;
 
@@ -910,8 +1065,10 @@ bool Parser::parseString()
         return false;
     }
 
-    container->appendByteData(reinterpret_cast<const char *>(ucs4.utf16()), ucs4.size() * 2,
-                              QCborValue::String, QtCbor::Element::StringIsUtf16);
+    if (!skipping) {
+        container->appendByteData(reinterpret_cast<const char *>(ucs4.utf16()), ucs4.size() * 2,
+                                  QCborValue::String, QtCbor::Element::StringIsUtf16);
+    }
     END;
     return true;
 }
@@ -62,7 +62,11 @@ namespace QJsonPrivate {
 class Parser
 {
 public:
-    Parser(const char *json, int length);
+    Parser(const char *json, qsizetype length);
+
+    // Defers parsing of nested objects and arrays until they are accessed;
+    // the text being parsed must be part of \a source.
+    void setLazy(const QByteArray &source) { lazySource = source; lazy = true; }
 
     QCborValue parse(QJsonParseError *error);
 
@@ -77,6 +81,7 @@ private:
     bool parseString();
     bool parseValue();
     bool parseNumber();
+    bool parseNested(QCborValue::Type type);
     const char *head;
     const char *json;
     const char *end;
@@ -84,8 +89,17 @@ private:
     int nestingLevel;
     QJsonParseError::ParseError lastError;
     QExplicitlySharedDataPointer<QCborContainerPrivate> container;
+    QByteArray lazySource;
+    bool lazy = false;
+    bool skipping = false;
 };
 
+// scanning helpers, shared with QJsonStreamReader
+const char *skipStringChars(const char *ptr, const char *end) noexcept;
+const char *skipWhitespace(const char *ptr, const char *end) noexcept;
+bool scanEscapeSequence(const char *&json, const char *end, char32_t *ch);
+bool scanUtf8Char(const char *&json, const char *end, char32_t *result);
+
 }
 
 QT_END_NAMESPACE
@@ -0,0 +1,950 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qjsonstreamreader.h"
+
+#include <qcoreapplication.h>
+#include <qiodevice.h>
+#include <qjsonarray.h>
+#include <qjsonobject.h>
+#include <qvarlengtharray.h>
+#include <private/qjsonparser_p.h>
+#include <private/qnumeric_p.h>
+#include <private/qstringconverter_p.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QJsonPrivate;
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \since 6.3
+    \ingroup json
+    \reentrant
+
+    \brief The QJsonStreamReader class is a fast pull parser for JSON
+    documents.
+
+    QJsonStreamReader reads a JSON document one token at a time, without
+    building a QJsonDocument. The application calls readNext() and inspects
+    the resulting token; memory use depends on the size of the largest
+    token, not on the size of the document.
+
+    The data can come from a QIODevice, set with setDevice(), or be supplied
+    in chunks with addData(). If the data runs out in the middle of the
+    document, readNext() returns \l Invalid and error() returns
+    \l PrematureEndOfDocumentError; once more data has arrived, either in
+    the device or through addData(), reading continues where it stopped.
+    This makes the class suitable for parsing network replies as they
+    arrive:
+
+    \code
+        void Parser::onReadyRead()
+        {
+            reader.addData(reply->readAll());
+            while (!reader.atEnd()) {
+                switch (reader.readNext()) {
+                case QJsonStreamReader::Name:
+                    currentKey = reader.text();
+                    break;
+                // ...
+                case QJsonStreamReader::Invalid:
+                    if (reader.error() == QJsonStreamReader::PrematureEndOfDocumentError)
+                        return;     // wait for more data
+                    qWarning() << reader.errorString();
+                    return;
+                default:
+                    break;
+                }
+            }
+        }
+    \endcode
+
+    Strings, names, numbers and literals can be accessed without any copy
+    through textView(), which refers to the reader's input buffer whenever
+    the string contains no escape sequences. text() returns the decoded
+    string as a QString.
+
+    As with QJsonDocument, the top-level value must be an object or an
+    array. Data following the end of the document is not examined.
+
+    \sa QJsonStreamWriter, QJsonDocument, QCborStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::TokenType
+
+    This enum specifies the type of token the reader just read.
+
+    \value NoToken      The reader has not read anything yet.
+    \value Invalid      An error occurred, reported in error() and errorString().
+    \value StartObject  The reader reports the start of an object.
+    \value EndObject    The reader reports the end of an object.
+    \value StartArray   The reader reports the start of an array.
+    \value EndArray     The reader reports the end of an array.
+    \value Name         The reader reports the name of an object member;
+                        the value follows as the next token.
+    \value String       The reader reports a string value.
+    \value Number       The reader reports a number.
+    \value Bool         The reader reports \c true or \c false.
+    \value Null         The reader reports \c null.
+    \value EndDocument  The reader has read the whole document.
+*/
+
+/*!
+    \enum QJsonStreamReader::Error
+
+    This enum specifies the different error cases.
+
+    \value NoError      No error has occurred.
+    \value PrematureEndOfDocumentError
+                        The input ended before the document was complete.
+                        Reading resumes once more data is available.
+    \value NotWellFormedError
+                        The input is not valid JSON; errorString() contains
+                        the details.
+*/
+
+class QJsonStreamReaderPrivate
+{
+public:
+    enum State : quint8 {
+        Root,
+        FirstName,
+        NextName,
+        NameSeparator,
+        FirstValue,
+        NextValue,
+        AfterValue,
+        Done
+    };
+
+    QIODevice *device = nullptr;
+    QByteArray buffer;
+    qsizetype pos = 0;
+    qint64 bufferOffset = 0;
+    QVarLengthArray<char, 32> containers;
+    State state = Root;
+    bool bomChecked = false;
+
+    QJsonStreamReader::TokenType token = QJsonStreamReader::NoToken;
+    qsizetype tokenStart = 0;
+    qsizetype textBegin = 0;
+    qsizetype textEnd = 0;
+    bool textIsEscaped = false;
+    // how far an incomplete string at pos has been scanned, so that it is
+    // not rescanned from its start each time more data arrives
+    qsizetype stringScanned = 0;
+    bool stringEscaped = false;
+    bool stringAscii = true;
+    bool integral = false;
+    qint64 integer = 0;
+    double number = 0;
+    QString unescaped;
+    mutable QByteArray unescapedUtf8;
+
+    QJsonStreamReader::Error error = QJsonStreamReader::NoError;
+    QJsonParseError::ParseError parseError = QJsonParseError::NoError;
+    qint64 errorOffset = 0;
+
+    void clear();
+    void resetStringScan()
+    {
+        stringScanned = 0;
+        stringEscaped = false;
+        stringAscii = true;
+    }
+    void appendData(const char *data, qsizetype len);
+    bool fetchMore();
+    QJsonStreamReader::TokenType readNext();
+    QJsonStreamReader::TokenType scanToken();
+    QJsonStreamReader::TokenType startContainer(const char *p);
+    QJsonStreamReader::TokenType endContainer(const char *p);
+    QJsonStreamReader::TokenType scanValue(const char *p, const char *end);
+    QJsonStreamReader::TokenType scanLiteral(const char *p, const char *end, const char *literal,
+                                             QJsonStreamReader::TokenType type);
+    QJsonStreamReader::TokenType scanString(const char *p, const char *end, bool isName);
+    QJsonStreamReader::TokenType scanNumber(const char *p, const char *end);
+    QJsonStreamReader::TokenType fail(QJsonParseError::ParseError code, const char *p);
+
+    const char *begin() const { return buffer.constData(); }
+};
+
+static const int nestingLimit = 1024;
+
+void QJsonStreamReaderPrivate::clear()
+{
+    buffer.clear();
+    pos = 0;
+    bufferOffset = 0;
+    containers.clear();
+    state = Root;
+    bomChecked = false;
+    token = QJsonStreamReader::NoToken;
+    tokenStart = textBegin = textEnd = 0;
+    textIsEscaped = false;
+    resetStringScan();
+    unescaped.clear();
+    unescapedUtf8.clear();
+    error = QJsonStreamReader::NoError;
+    parseError = QJsonParseError::NoError;
+    errorOffset = 0;
+}
+
+// Appends data, first dropping what has been consumed up to the current
+// token, which stays readable. Views into the buffer handed out for it
+// become invalid.
+void QJsonStreamReaderPrivate::appendData(const char *data, qsizetype len)
+{
+    if (const qsizetype consumed = qMin(tokenStart, pos)) {
+        buffer.remove(0, consumed);
+        bufferOffset += consumed;
+        pos -= consumed;
+        tokenStart -= consumed;
+        textBegin -= consumed;
+        textEnd -= consumed;
+    }
+    buffer.append(data, len);
+}
+
+bool QJsonStreamReaderPrivate::fetchMore()
+{
+    if (!device || !device->isReadable())
+        return false;
+
+    constexpr qint64 MinimumChunk = 16 * 1024;
+    constexpr qint64 MaximumChunk = 1024 * 1024;
+    const qint64 chunk = qBound(MinimumChunk, device->bytesAvailable(), MaximumChunk);
+
+    // read straight into the buffer
+    appendData(nullptr, 0);
+    const qsizetype oldSize = buffer.size();
+    buffer.resize(oldSize + chunk);
+    const qint64 n = device->read(buffer.data() + oldSize, chunk);
+    buffer.resize(oldSize + qMax(n, qint64(0)));
+    return n > 0;
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::readNext()
+{
+    if (error == QJsonStreamReader::NotWellFormedError)
+        return QJsonStreamReader::Invalid;
+
+    // the previous token is done with, so its bytes may be dropped
+    tokenStart = textBegin = textEnd = pos;
+    textIsEscaped = false;
+    error = QJsonStreamReader::NoError;
+    parseError = QJsonParseError::NoError;
+    if (state == Done) {
+        // like QJsonDocument::fromJson(), only allow whitespace after the document
+        for (;;) {
+            const char *end = begin() + buffer.size();
+            const char *p = skipWhitespace(begin() + pos, end);
+            pos = tokenStart = textBegin = textEnd = p - begin();
+            if (p != end)
+                return token = fail(QJsonParseError::GarbageAtEnd, p);
+            if (!fetchMore())
+                return token = QJsonStreamReader::EndDocument;
+        }
+    }
+
+    for (;;) {
+        const QJsonStreamReader::TokenType type = scanToken();
+        if (type != QJsonStreamReader::NoToken)
+            return token = type;
+        if (!fetchMore())
+            break;
+    }
+
+    error = QJsonStreamReader::PrematureEndOfDocumentError;
+    errorOffset = bufferOffset + buffer.size();
+    return token = QJsonStreamReader::Invalid;
+}
+
+/*
+    Scans the next token in the buffer. Whitespace and separators are
+    consumed as they are found; if the token itself is incomplete, returns
+    NoToken without consuming it.
+*/
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::scanToken()
+{
+    const char *p = begin() + pos;
+    const char *end = begin() + buffer.size();
+
+    if (!bomChecked) {
+        static const char bom[] = "\xef\xbb\xbf";
+        const qsizetype n = qMin(end - p, qsizetype(3));
+        if (memcmp(p, bom, n) == 0) {
+            if (n < 3)
+                return QJsonStreamReader::NoToken;
+            p += 3;
+            pos += 3;
+        }
+        bomChecked = true;
+    }
+
+    for (;;) {
+        p = skipWhitespace(p, end);
+        pos = p - begin();
+        if (p == end)
+            return QJsonStreamReader::NoToken;
+
+        switch (state) {
+        case Root:
+            if (*p == '{' || *p == '[')
+                return startContainer(p);
+            return fail(QJsonParseError::IllegalValue, p);
+
+        case FirstName:
+        case NextName:
+            if (*p == '"')
+                return scanString(p, end, true);
+            if (*p == '}' && state == FirstName)
+                return endContainer(p);
+            return fail(state == FirstName ? QJsonParseError::UnterminatedObject
+                                           : QJsonParseError::MissingObject, p);
+
+        case NameSeparator:
+            if (*p != ':')
+                return fail(QJsonParseError::MissingNameSeparator, p);
+            pos = ++p - begin();
+            state = NextValue;
+            continue;
+
+        case FirstValue:
+            if (*p == ']')
+                return endContainer(p);
+            Q_FALLTHROUGH();
+        case NextValue:
+            return scanValue(p, end);
+
+        case AfterValue: {
+            const bool inObject = containers.last() == '{';
+            if (*p == ',') {
+                pos = ++p - begin();
+                state = inObject ? NextName : NextValue;
+                continue;
+            }
+            if (*p == (inObject ? '}' : ']'))
+                return endContainer(p);
+            return fail(inObject ? QJsonParseError::UnterminatedObject
+                                 : QJsonParseError::MissingValueSeparator, p);
+        }
+
+        case Done:
+            break;
+        }
+        Q_UNREACHABLE();
+        return QJsonStreamReader::Invalid;
+    }
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::startContainer(const char *p)
+{
+    if (containers.size() >= nestingLimit)
+        return fail(QJsonParseError::DeepNesting, p);
+    containers.append(*p);
+    state = *p == '{' ? FirstName : FirstValue;
+    tokenStart = textBegin = textEnd = p - begin();
+    pos = tokenStart + 1;
+    return *p == '{' ? QJsonStreamReader::StartObject : QJsonStreamReader::StartArray;
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::endContainer(const char *p)
+{
+    containers.removeLast();
+    state = containers.isEmpty() ? Done : AfterValue;
+    tokenStart = textBegin = textEnd = p - begin();
+    pos = tokenStart + 1;
+    return *p == '}' ? QJsonStreamReader::EndObject : QJsonStreamReader::EndArray;
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::scanValue(const char *p, const char *end)
+{
+    switch (*p) {
+    case '{':
+    case '[':
+        return startContainer(p);
+    case '"':
+        return scanString(p, end, false);
+    case 't':
+        return scanLiteral(p, end, "true", QJsonStreamReader::Bool);
+    case 'f':
+        return scanLiteral(p, end, "false", QJsonStreamReader::Bool);
+    case 'n':
+        return scanLiteral(p, end, "null", QJsonStreamReader::Null);
+    case '}':
+    case ']':
+        return fail(QJsonParseError::MissingObject, p);
+    default:
+        if (*p == '-' || (*p >= '0' && *p <= '9'))
+            return scanNumber(p, end);
+        return fail(QJsonParseError::IllegalValue, p);
+    }
+}
+
+QJsonStreamReader::TokenType
+QJsonStreamReaderPrivate::scanLiteral(const char *p, const char *end, const char *literal,
+                                      QJsonStreamReader::TokenType type)
+{
+    const qsizetype length = qsizetype(strlen(literal));
+    const qsizetype available = qMin(end - p, length);
+    if (memcmp(p, literal, available) != 0)
+        return fail(QJsonParseError::IllegalValue, p);
+    if (available < length)
+        return QJsonStreamReader::NoToken;
+
+    tokenStart = textBegin = p - begin();
+    textEnd = textBegin + length;
+    textIsEscaped = false;
+    integral = false;
+    integer = *p == 't';
+    pos = textEnd;
+    state = AfterValue;
+    return type;
+}
+
+QJsonStreamReader::TokenType
+QJsonStreamReaderPrivate::scanString(const char *p, const char *end, bool isName)
+{
+    // find the closing quote first, so that nothing is decoded twice when
+    // the string is split across chunks. The string stays at pos until it
+    // is complete, so each call resumes where the previous one stopped
+    // instead of starting over.
+    const char *const start = p + 1;
+    const char *q = start + stringScanned;
+    bool escaped = stringEscaped;
+    bool ascii = stringAscii;
+    for (;;) {
+        q = skipStringChars(q, end);
+        if (q == end || (*q == '\\' && end - q < 2)) {
+            stringScanned = q - start;
+            stringEscaped = escaped;
+            stringAscii = ascii;
+            return QJsonStreamReader::NoToken;
+        }
+        if (*q == '"')
+            break;
+        if (*q == '\\') {
+            // the escaped character cannot end the string; \u digits are
+            // checked when decoding
+            escaped = true;
+            q += 2;
+        } else {
+            ascii = false;
+            ++q;
+        }
+    }
+    resetStringScan();
+
+    unescaped.clear();
+    unescapedUtf8.clear();
+    if (escaped) {
+        // same decoding as QJsonDocument::fromJson()
+        const char *json = start;
+        while (json < q) {
+            const char *run = json;
+            json = skipStringChars(json, q);
+            if (json != run)
+                unescaped.append(QLatin1String(run, json - run));
+            if (json == q)
+                break;
+            char32_t ch = 0;
+            const char *at = json;
+            if (*json == '\\') {
+                if (!scanEscapeSequence(json, q, &ch))
+                    return fail(QJsonParseError::IllegalEscapeSequence, at);
+            } else if (!scanUtf8Char(json, q, &ch)) {
+                return fail(QJsonParseError::IllegalUTF8String, at);
+            }
+            unescaped.append(QChar::fromUcs4(ch));
+        }
+    } else if (!ascii && !QUtf8::isValidUtf8(QByteArrayView(start, q - start)).isValidUtf8) {
+        return fail(QJsonParseError::IllegalUTF8String, start);
+    }
+
+    tokenStart = p - begin();
+    textBegin = start - begin();
+    textEnd = q - begin();
+    textIsEscaped = escaped;
+    pos = textEnd + 1;
+    state = isName ? NameSeparator : AfterValue;
+    return isName ? QJsonStreamReader::Name : QJsonStreamReader::String;
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::scanNumber(const char *p, const char *end)
+{
+    // a number is only complete once the byte after it has arrived
+    const char *stop = p;
+    while (stop < end && ((*stop >= '0' && *stop <= '9') || *stop == '-' || *stop == '+'
+                          || *stop == '.' || *stop == 'e' || *stop == 'E'))
+        ++stop;
+    if (stop == end)
+        return QJsonStreamReader::NoToken;
+
+    // same grammar and conversions as QJsonDocument::fromJson()
+    const char *json = p;
+    bool isInt = true;
+    if (*json == '-')
+        ++json;
+    const char *digits = json;
+    if (json < stop && *json == '0') {
+        ++json;
+    } else {
+        while (json < stop && *json >= '0' && *json <= '9')
+            ++json;
+    }
+    const char *intEnd = json;
+    if (json < stop && *json == '.') {
+        ++json;
+        while (json < stop && *json >= '0' && *json <= '9') {
+            isInt = isInt && *json == '0';
+            ++json;
+        }
+    }
+    if (json < stop && (*json == 'e' || *json == 'E')) {
+        isInt = false;
+        ++json;
+        if (json < stop && (*json == '-' || *json == '+'))
+            ++json;
+        while (json < stop && *json >= '0' && *json <= '9')
+            ++json;
+    }
+    if (json != stop || intEnd == digits)
+        return fail(QJsonParseError::IllegalNumber, p);
+
+    integral = false;
+    if (json == intEnd && json - digits <= 18) {
+        qint64 n = 0;
+        for (const char *c = digits; c != json; ++c)
+            n = n * 10 + (*c - '0');
+        integer = digits == p ? n : -n;
+        integral = true;
+    } else {
+        const QByteArray text = QByteArray::fromRawData(p, json - p);
+        bool ok = false;
+        if (isInt) {
+            integer = text.toLongLong(&ok);
+            integral = ok;
+        }
+        if (!integral) {
+            number = text.toDouble(&ok);
+            if (!ok)
+                return fail(QJsonParseError::IllegalNumber, p);
+            integral = convertDoubleTo(number, &integer);
+        }
+    }
+    if (integral)
+        number = double(integer);
+
+    tokenStart = textBegin = p - begin();
+    textEnd = json - begin();
+    textIsEscaped = false;
+    pos = textEnd;
+    state = AfterValue;
+    return QJsonStreamReader::Number;
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::fail(QJsonParseError::ParseError code,
+                                                            const char *p)
+{
+    error = QJsonStreamReader::NotWellFormedError;
+    parseError = code;
+    errorOffset = bufferOffset + (p - begin());
+    tokenStart = textBegin = textEnd = p - begin();
+    return QJsonStreamReader::Invalid;
+}
+
+/*!
+    Constructs a stream reader with no input. Use setDevice() or addData()
+    to supply the document.
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d(new QJsonStreamReaderPrivate)
+{
+}
+
+/*!
+    Constructs a stream reader that reads from \a device. The device must
+    already be open.
+*/
+QJsonStreamReader::QJsonStreamReader(QIODevice *device)
+    : QJsonStreamReader()
+{
+    setDevice(device);
+}
+
+/*!
+    Constructs a stream reader that reads from \a data. The data is not
+    copied: textView() refers straight into it.
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : QJsonStreamReader()
+{
+    d->buffer = data;
+}
+
+/*!
+    Destroys the reader.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+    Sets the current device to \a device and resets the reader to its
+    initial state. The reader does not take ownership of the device.
+
+    \sa device(), clear()
+*/
+void QJsonStreamReader::setDevice(QIODevice *device)
+{
+    d->clear();
+    d->device = device;
+}
+
+/*!
+    Returns the device the reader reads from, or \nullptr if there is none.
+
+    \sa setDevice()
+*/
+QIODevice *QJsonStreamReader::device() const
+{
+    return d->device;
+}
+
+/*!
+    Appends \a data to the reader's input. If readNext() previously stopped
+    with PrematureEndOfDocumentError, the next call continues from where it
+    stopped.
+
+    The current token stays available, but any view obtained from
+    textView() becomes invalid.
+*/
+void QJsonStreamReader::addData(const QByteArray &data)
+{
+    if (d->pos == d->buffer.size() && !d->device
+            && (d->token == Invalid || d->token == NoToken)) {
+        // everything has been consumed and there is no current token whose
+        // text would have to stay available: share the data instead of
+        // copying it
+        d->bufferOffset += d->buffer.size();
+        d->buffer = data;
+        d->pos = d->tokenStart = d->textBegin = d->textEnd = 0;
+        return;
+    }
+    d->appendData(data.constData(), data.size());
+}
+
+/*!
+    \overload
+
+    Appends \a len bytes from \a data to the reader's input.
+*/
+void QJsonStreamReader::addData(const char *data, qsizetype len)
+{
+    d->appendData(data, len);
+}
+
+/*!
+    Discards all input and the reading state, and unsets the device.
+*/
+void QJsonStreamReader::clear()
+{
+    d->clear();
+    d->device = nullptr;
+}
+
+/*!
+    Returns \c true if the reader has read the whole document or stopped
+    on an error that cannot be recovered from. PrematureEndOfDocumentError
+    does not count as the end.
+*/
+bool QJsonStreamReader::atEnd() const
+{
+    return d->token == EndDocument || d->error == NotWellFormedError;
+}
+
+/*!
+    Reads the next token and returns its type.
+
+    After an error, this function keeps returning \l Invalid, except for
+    PrematureEndOfDocumentError, where it tries again to read. Once the
+    document is complete, it returns \l EndDocument. As with
+    QJsonDocument::fromJson(), only whitespace may follow the document;
+    anything else is reported as a NotWellFormedError.
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::readNext()
+{
+    return d->readNext();
+}
+
+/*!
+    Returns the type of the current token.
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::tokenType() const
+{
+    return d->token;
+}
+
+/*!
+    Returns the name of the current token type, for example "StartObject".
+*/
+QString QJsonStreamReader::tokenString() const
+{
+    static const char names[][12] = {
+        "NoToken", "Invalid", "StartObject", "EndObject", "StartArray", "EndArray",
+        "Name", "String", "Number", "Bool", "Null", "EndDocument"
+    };
+    return QLatin1String(names[d->token]);
+}
+
+/*!
+    Returns the number of objects and arrays the current token is nested
+    in. The StartObject and StartArray tokens count themselves; the
+    matching end tokens do not.
+*/
+int QJsonStreamReader::depth() const
+{
+    return int(d->containers.size());
+}
+
+/*!
+    Returns the offset in bytes from the start of the input of the current
+    token, or of the error after \l Invalid.
+*/
+qint64 QJsonStreamReader::currentOffset() const
+{
+    if (d->token == Invalid)
+        return d->errorOffset;
+    return d->bufferOffset + d->tokenStart;
+}
+
+/*!
+    Returns the text of the current String, Name, Number, Bool or Null
+    token, as UTF-8. For other tokens, returns an empty view.
+
+    For strings without escape sequences, the view refers directly to the
+    input data, so no copy is made. Otherwise it refers to a decoded copy
+    held by the reader; lone surrogates from \c{\u} escapes, which UTF-8
+    cannot represent, are replaced.
+
+    The view is valid until the next call to readNext(), addData() or
+    clear().
+
+    \sa text()
+*/
+QUtf8StringView QJsonStreamReader::textView() const
+{
+    if (d->token == Invalid)
+        return QUtf8StringView();
+    if (d->textIsEscaped) {
+        if (d->unescapedUtf8.isNull())
+            d->unescapedUtf8 = d->unescaped.toUtf8();
+        return d->unescapedUtf8;
+    }
+    return QUtf8StringView(d->begin() + d->textBegin, d->textEnd - d->textBegin);
+}
+
+/*!
+    Returns the decoded text of the current String or Name token, or the
+    text of a Number, Bool or Null token. For other tokens, returns a null
+    string.
+
+    \sa textView()
+*/
+QString QJsonStreamReader::text() const
+{
+    if (d->textIsEscaped && d->token != Invalid)
+        return d->unescaped;
+    return textView().toString();
+}
+
+/*!
+    Returns \c true if the current token is a Number that is an integer
+    which fits in a qint64. QJsonDocument stores those numbers as integers
+    too.
+
+    \sa toInteger(), toDouble()
+*/
+bool QJsonStreamReader::isInteger() const
+{
+    return d->token == Number && d->integral;
+}
+
+/*!
+    Returns the current Number token as an integer. If the number is not
+    integral or out of range, the result is the number converted to qint64.
+
+    \sa isInteger(), toDouble()
+*/
+qint64 QJsonStreamReader::toInteger() const
+{
+    Q_ASSERT(isNumber());
+    if (d->integral)
+        return d->integer;
+    qint64 result;
+    return convertDoubleTo(d->number, &result) ? result : qint64(d->number);
+}
+
+/*!
+    Returns the current Number token as a double.
+
+    \sa toInteger()
+*/
+double QJsonStreamReader::toDouble() const
+{
+    Q_ASSERT(isNumber());
+    return d->number;
+}
+
+/*!
+    Returns the value of the current Bool token.
+*/
+bool QJsonStreamReader::toBool() const
+{
+    Q_ASSERT(isBool());
+    return d->integer;
+}
+
+/*!
+    Reads the value starting at the current token and returns it as a
+    QJsonValue. For StartObject and StartArray, the whole object or array
+    is read, and the reader is left on the matching end token.
+
+    This allows a large document to be processed one element at a time,
+    building only the elements of interest. Returns an undefined
+    QJsonValue if the current token does not start a value or if an error
+    occurs; the input needed by the value should then already be complete.
+*/
+QJsonValue QJsonStreamReader::readValue()
+{
+    switch (tokenType()) {
+    case String:
+        return text();
+    case Number:
+        if (isInteger())
+            return toInteger();
+        return toDouble();
+    case Bool:
+        return toBool();
+    case Null:
+        return QJsonValue(QJsonValue::Null);
+    case StartObject: {
+        QJsonObject object;
+        while (readNext() == Name) {
+            const QString key = text();
+            readNext();
+            const QJsonValue value = readValue();
+            if (value.isUndefined())
+                return QJsonValue(QJsonValue::Undefined);
+            object.insert(key, value);
+        }
+        if (tokenType() != EndObject)
+            return QJsonValue(QJsonValue::Undefined);
+        return object;
+    }
+    case StartArray: {
+        QJsonArray array;
+        while (readNext() != EndArray) {
+            const QJsonValue value = readValue();
+            if (value.isUndefined())
+                return QJsonValue(QJsonValue::Undefined);
+            array.append(value);
+        }
+        return array;
+    }
+    default:
+        return QJsonValue(QJsonValue::Undefined);
+    }
+}
+
+/*!
+    If the current token is StartObject or StartArray, reads up to and
+    including the matching end token. Returns \c true on success, or
+    \c false if an error occurred. Does nothing for other tokens.
+*/
+bool QJsonStreamReader::skipCurrentValue()
+{
+    if (!isStartObject() && !isStartArray())
+        return !hasError();
+    const int level = depth();
+    while (readNext() != Invalid) {
+        if (depth() < level)
+            return true;
+    }
+    return false;
+}
+
+/*!
+    Returns the type of the current error, or NoError.
+
+    \sa errorString(), hasError()
+*/
+QJsonStreamReader::Error QJsonStreamReader::error() const
+{
+    return d->error;
+}
+
+/*!
+    Returns a message describing the current error, using the same
+    messages as QJsonParseError::errorString().
+*/
+QString QJsonStreamReader::errorString() const
+{
+    if (d->error == PrematureEndOfDocumentError)
+        return QCoreApplication::translate("QJsonStreamReader", "premature end of document");
+    QJsonParseError error;
+    error.error = d->parseError;
+    return error.errorString();
+}
+
+/*!
+    \fn bool QJsonStreamReader::hasError() const
+
+    Returns \c true if an error occurred.
+
+    \sa error()
+*/
+
+QT_END_NAMESPACE
+
+#include "moc_qjsonstreamreader.cpp"
@@ -0,0 +1,409 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qjsonstreamwriter.h"
+
+#include <qiodevice.h>
+#include <qlocale.h>
+#include <qvarlengtharray.h>
+#include <private/qjsonwriter_p.h>
+#include <private/qnumeric_p.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace QJsonPrivate;
+
+/*!
+    \class QJsonStreamWriter
+    \inmodule QtCore
+    \since 6.3
+    \ingroup json
+    \reentrant
+
+    \brief The QJsonStreamWriter class writes a JSON document token by
+    token.
+
+    QJsonStreamWriter is the counterpart of QJsonStreamReader. It writes
+    objects, arrays and values as they are passed in, without building a
+    QJsonObject or QJsonArray first, so that documents of any size can be
+    produced in constant memory:
+
+    \code
+        QJsonStreamWriter writer(&file);
+        writer.writeStartArray();
+        for (const Sample &sample : samples) {
+            writer.writeStartObject();
+            writer.writeName(u"time");
+            writer.writeInteger(sample.time);
+            writer.writeName(u"value");
+            writer.writeDouble(sample.value);
+            writer.writeEndObject();
+        }
+        writer.writeEndArray();
+    \endcode
+
+    Output to a QIODevice is buffered; it is written to the device when the
+    buffer fills up, when the top-level value is complete, when flush() is
+    called and when the writer is destroyed. Output to a QByteArray is
+    appended directly.
+
+    The output is compact by default. With autoFormatting() enabled, it is
+    laid out in the same way as QJsonDocument::toJson() with
+    QJsonDocument::Indented.
+
+    The writer does not check that the calls form a valid document beyond
+    assertions in debug builds: every object member must be introduced by
+    writeName(), and every start must be matched by the corresponding end.
+
+    \sa QJsonStreamReader, QJsonDocument::toJson()
+*/
+
+class QJsonStreamWriterPrivate
+{
+public:
+    QIODevice *device = nullptr;
+    QByteArray *target = nullptr;
+    QByteArray buffer;
+    QVarLengthArray<char, 32> containers;
+    bool firstElement = true;
+    bool afterName = false;
+    bool autoFormatting = false;
+    bool error = false;
+
+    QByteArray &out() { return target ? *target : buffer; }
+    void separate();
+    void beginValue();
+    void endValue();
+    void startContainer(char open);
+    void endContainer(char open, char close);
+    void flush();
+};
+
+static constexpr qsizetype FlushThreshold = 16 * 1024;
+
+// writes the separator and indentation in front of an element
+void QJsonStreamWriterPrivate::separate()
+{
+    QByteArray &json = out();
+    if (!firstElement)
+        json += autoFormatting ? ",\n" : ",";
+    firstElement = false;
+    if (autoFormatting)
+        json.append(4 * containers.size(), ' ');
+}
+
+void QJsonStreamWriterPrivate::beginValue()
+{
+    if (afterName) {
+        afterName = false;
+        return;
+    }
+    Q_ASSERT_X(containers.isEmpty() || containers.last() == '[', "QJsonStreamWriter",
+               "Object members need a name");
+    if (!containers.isEmpty())
+        separate();
+}
+
+void QJsonStreamWriterPrivate::endValue()
+{
+    if (!device)
+        return;
+    if (containers.isEmpty() || buffer.size() >= FlushThreshold)
+        flush();
+}
+
+void QJsonStreamWriterPrivate::startContainer(char open)
+{
+    beginValue();
+    QByteArray &json = out();
+    json += open;
+    if (autoFormatting)
+        json += '\n';
+    containers.append(open);
+    firstElement = true;
+}
+
+void QJsonStreamWriterPrivate::endContainer(char open, char close)
+{
+    Q_ASSERT_X(!containers.isEmpty() && containers.last() == open && !afterName,
+               "QJsonStreamWriter", "Mismatched end of object or array");
+    Q_UNUSED(open);
+    containers.removeLast();
+    QByteArray &json = out();
+    if (autoFormatting) {
+        if (!firstElement)
+            json += '\n';
+        json.append(4 * containers.size(), ' ');
+    }
+    json += close;
+    if (autoFormatting && containers.isEmpty())
+        json += '\n';
+    firstElement = false;
+    endValue();
+}
+
+void QJsonStreamWriterPrivate::flush()
+{
+    if (!device || buffer.isEmpty())
+        return;
+    if (device->write(buffer) != buffer.size())
+        error = true;
+    buffer.resize(0);
+}
+
+/*!
+    Constructs a writer with no output. Use setDevice() before writing.
+*/
+QJsonStreamWriter::QJsonStreamWriter()
+    : d(new QJsonStreamWriterPrivate)
+{
+}
+
+/*!
+    Constructs a writer that writes to \a device, which must already be
+    open for writing.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QIODevice *device)
+    : QJsonStreamWriter()
+{
+    d->device = device;
+}
+
+/*!
+    Constructs a writer that appends to \a data.
+*/
+QJsonStreamWriter::QJsonStreamWriter(QByteArray *data)
+    : QJsonStreamWriter()
+{
+    d->target = data;
+}
+
+/*!
+    Flushes any buffered output to the device and destroys the writer.
+*/
+QJsonStreamWriter::~QJsonStreamWriter()
+{
+    d->flush();
+}
+
+/*!
+    Flushes any buffered output to the current device and makes the writer
+    write to \a device instead. The writing state is kept, so the
+    document can continue on the new device.
+
+    \sa device()
+*/
+void QJsonStreamWriter::setDevice(QIODevice *device)
+{
+    d->flush();
+    d->device = device;
+    d->target = nullptr;
+}
+
+/*!
+    Returns the device the writer writes to, or \nullptr if it writes to a
+    QByteArray or has no output.
+*/
+QIODevice *QJsonStreamWriter::device() const
+{
+    return d->device;
+}
+
+/*!
+    Enables the indented output format if \a enable is \c true. It matches
+    QJsonDocument::toJson() with QJsonDocument::Indented. The default is
+    compact output.
+
+    Changing the format in the middle of a document produces valid, if
+    oddly laid out, JSON.
+*/
+void QJsonStreamWriter::setAutoFormatting(bool enable)
+{
+    d->autoFormatting = enable;
+}
+
+/*!
+    Returns \c true if the output is indented.
+
+    \sa setAutoFormatting()
+*/
+bool QJsonStreamWriter::autoFormatting() const
+{
+    return d->autoFormatting;
+}
+
+/*!
+    Starts an object. Its members are written with writeName() followed by
+    a value, and it is closed with writeEndObject().
+*/
+void QJsonStreamWriter::writeStartObject()
+{
+    d->startContainer('{');
+}
+
+/*!
+    Closes the current object.
+*/
+void QJsonStreamWriter::writeEndObject()
+{
+    d->endContainer('{', '}');
+}
+
+/*!
+    Starts an array, closed with writeEndArray().
+*/
+void QJsonStreamWriter::writeStartArray()
+{
+    d->startContainer('[');
+}
+
+/*!
+    Closes the current array.
+*/
+void QJsonStreamWriter::writeEndArray()
+{
+    d->endContainer('[', ']');
+}
+
+/*!
+    Writes \a name as the name of the next member of the current object.
+    The member's value must be written next.
+*/
+void QJsonStreamWriter::writeName(QAnyStringView name)
+{
+    Q_ASSERT_X(!d->containers.isEmpty() && d->containers.last() == '{' && !d->afterName,
+               "QJsonStreamWriter", "Names can only be written in objects");
+    d->separate();
+    QByteArray &json = d->out();
+    json += '"';
+    name.visit([&json](auto view) { Writer::appendEscaped(json, view); });
+    json += d->autoFormatting ? "\": " : "\":";
+    d->afterName = true;
+}
+
+/*!
+    Writes the string \a value.
+*/
+void QJsonStreamWriter::writeString(QAnyStringView value)
+{
+    d->beginValue();
+    QByteArray &json = d->out();
+    json += '"';
+    value.visit([&json](auto view) { Writer::appendEscaped(json, view); });
+    json += '"';
+    d->endValue();
+}
+
+/*!
+    Writes the integer \a value.
+*/
+void QJsonStreamWriter::writeInteger(qint64 value)
+{
+    d->beginValue();
+    d->out() += QByteArray::number(value);
+    d->endValue();
+}
+
+/*!
+    Writes the number \a value with the shortest representation that reads
+    back to the same value. Infinities and NaN, which JSON cannot
+    represent, are written as \c null, as QJsonDocument does.
+*/
+void QJsonStreamWriter::writeDouble(double value)
+{
+    d->beginValue();
+    if (qIsFinite(value))
+        d->out() += QByteArray::number(value, 'g', QLocale::FloatingPointShortest);
+    else
+        d->out() += "null";
+    d->endValue();
+}
+
+/*!
+    Writes \c true or \c false, depending on \a value.
+*/
+void QJsonStreamWriter::writeBool(bool value)
+{
+    d->beginValue();
+    d->out() += value ? "true" : "false";
+    d->endValue();
+}
+
+/*!
+    Writes \c null.
+*/
+void QJsonStreamWriter::writeNull()
+{
+    d->beginValue();
+    d->out() += "null";
+    d->endValue();
+}
+
+/*!
+    Writes \a value, including the whole contents of an object or array.
+    This allows parts of a document that are already held as QJsonValue to
+    be mixed with streamed output. An undefined value is written as
+    \c null.
+*/
+void QJsonStreamWriter::writeValue(const QJsonValue &value)
+{
+    d->beginValue();
+    const int indent = d->autoFormatting ? int(d->containers.size()) : 0;
+    Writer::valueToJson(QCborValue::fromJsonValue(value), d->out(), indent, !d->autoFormatting);
+    d->endValue();
+}
+
+/*!
+    Writes any buffered output to the device.
+*/
+void QJsonStreamWriter::flush()
+{
+    d->flush();
+}
+
+/*!
+    Returns \c true if writing to the device failed.
+*/
+bool QJsonStreamWriter::hasError() const
+{
+    return d->error;
+}
+
+QT_END_NAMESPACE
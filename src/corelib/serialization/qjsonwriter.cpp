@@ -39,99 +39,251 @@
 ****************************************************************************/
 
 #include <cmath>
+#include <qiodevice.h>
 #include <qlocale.h>
 #include "qjsonwriter_p.h"
 #include "qjson_p.h"
 #include "private/qstringconverter_p.h"
 #include <private/qnumeric_p.h>
 #include <private/qcborvalue_p.h>
+#include <private/qsimd_p.h>
+#include <private/qtextscan_p.h>
 
 QT_BEGIN_NAMESPACE
 
 using namespace QJsonPrivate;
 
-static void objectContentToJson(const QCborContainerPrivate *o, QByteArray &json, int indent, bool compact);
-static void arrayContentToJson(const QCborContainerPrivate *a, QByteArray &json, int indent, bool compact);
-
 static inline uchar hexdig(uint u)
 {
     return (u < 0xa ? '0' + u : 'a' + u - 0xa);
 }
 
-static QByteArray escapedString(const QString &s)
+// Escapes one character below 0x80 that JSON does not allow unescaped.
+static inline uchar *escapeAscii(uchar u, uchar *cursor)
 {
-    // give it a minimum size to ensure the resize() below always adds enough space
-    QByteArray ba(qMax(s.length(), 16), Qt::Uninitialized);
+    *cursor++ = '\\';
+    switch (u) {
+    case 0x22:
+        *cursor++ = '"';
+        break;
+    case 0x5c:
+        *cursor++ = '\\';
+        break;
+    case 0x8:
+        *cursor++ = 'b';
+        break;
+    case 0xc:
+        *cursor++ = 'f';
+        break;
+    case 0xa:
+        *cursor++ = 'n';
+        break;
+    case 0xd:
+        *cursor++ = 'r';
+        break;
+    case 0x9:
+        *cursor++ = 't';
+        break;
+    default:
+        *cursor++ = 'u';
+        *cursor++ = '0';
+        *cursor++ = '0';
+        *cursor++ = hexdig(u>>4);
+        *cursor++ = hexdig(u & 0xf);
+    }
+    return cursor;
+}
 
-    uchar *cursor = reinterpret_cast<uchar *>(const_cast<char *>(ba.constData()));
-    const uchar *ba_end = cursor + ba.length();
-    const char16_t *src = reinterpret_cast<const char16_t *>(s.constBegin());
-    const char16_t *const end = reinterpret_cast<const char16_t *>(s.constEnd());
+static inline bool needsEscape(uchar u)
+{
+    return u < 0x20 || u == 0x22 || u == 0x5c;
+}
 
+void Writer::appendEscaped(QByteArray &json, QStringView s)
+{
+    // Convert in blocks, so that the worst case of six output bytes per
+    // character can be reserved up front without overallocating for long
+    // strings.
+    constexpr qsizetype BlockSize = 256;
+    const char16_t *src = s.utf16();
+    const char16_t *const end = src + s.size();
     while (src != end) {
-        if (cursor >= ba_end - 6) {
-            // ensure we have enough space
-            int pos = cursor - (const uchar *)ba.constData();
-            ba.resize(ba.size()*2);
-            cursor = (uchar *)ba.data() + pos;
-            ba_end = (const uchar *)ba.constData() + ba.length();
-        }
+        const char16_t *blockEnd = src + qMin(end - src, BlockSize);
+        if (blockEnd != end && QChar::isHighSurrogate(blockEnd[-1]))
+            ++blockEnd;
 
-        char16_t u = *src++;
-        if (u < 0x80) {
-            if (u < 0x20 || u == 0x22 || u == 0x5c) {
+        const qsizetype offset = json.size();
+        json.resize(offset + 6 * (blockEnd - src) + 16);
+        uchar *cursor = reinterpret_cast<uchar *>(json.data()) + offset;
+        while (src != blockEnd) {
+#ifdef __SSE2__
+            if (blockEnd - src >= 8) {
+                // copy plain ASCII characters eight at a time
+                const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+                const __m128i ascii = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xff80))),
+                                                      _mm_setzero_si128());
+                const __m128i special = _mm_or_si128(_mm_cmplt_epi16(data, _mm_set1_epi16(0x20)),
+                                                     _mm_or_si128(_mm_cmpeq_epi16(data, _mm_set1_epi16(0x22)),
+                                                                  _mm_cmpeq_epi16(data, _mm_set1_epi16(0x5c))));
+                const uint clean = uint(_mm_movemask_epi8(_mm_andnot_si128(special, ascii)));
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(cursor), _mm_packus_epi16(data, data));
+                if (clean == 0xffff) {
+                    cursor += 8;
+                    src += 8;
+                    continue;
+                }
+                const uint count = qCountTrailingZeroBits(~clean) / 2;
+                cursor += count;
+                src += count;
+            }
+#endif
+            const char16_t u = *src++;
+            if (u < 0x80) {
+                if (needsEscape(u))
+                    cursor = escapeAscii(uchar(u), cursor);
+                else
+                    *cursor++ = uchar(u);
+            } else if (QUtf8Functions::toUtf8<QUtf8BaseTraits>(u, cursor, src, blockEnd) < 0) {
+                // failed to get valid utf8 use JSON escape sequence
                 *cursor++ = '\\';
-                switch (u) {
-                case 0x22:
-                    *cursor++ = '"';
-                    break;
-                case 0x5c:
-                    *cursor++ = '\\';
-                    break;
-                case 0x8:
-                    *cursor++ = 'b';
-                    break;
-                case 0xc:
-                    *cursor++ = 'f';
-                    break;
-                case 0xa:
-                    *cursor++ = 'n';
-                    break;
-                case 0xd:
-                    *cursor++ = 'r';
-                    break;
-                case 0x9:
-                    *cursor++ = 't';
-                    break;
-                default:
-                    *cursor++ = 'u';
-                    *cursor++ = '0';
-                    *cursor++ = '0';
-                    *cursor++ = hexdig(u>>4);
-                    *cursor++ = hexdig(u & 0xf);
-               }
-            } else {
-                *cursor++ = (uchar)u;
+                *cursor++ = 'u';
+                *cursor++ = hexdig(u>>12 & 0x0f);
+                *cursor++ = hexdig(u>>8 & 0x0f);
+                *cursor++ = hexdig(u>>4 & 0x0f);
+                *cursor++ = hexdig(u & 0x0f);
+            }
+        }
+        json.resize(cursor - reinterpret_cast<const uchar *>(json.constData()));
+    }
+}
+
+namespace {
+// control characters, quotes and backslashes
+struct EscapeStops
+{
+    static bool stopsAt(char c) { return needsEscape(uchar(c)); }
+#ifdef __SSE2__
+    static __m128i stops(__m128i data)
+    {
+        const __m128i maxControl = _mm_set1_epi8(0x1f);
+        const __m128i control = _mm_cmpeq_epi8(_mm_max_epu8(data, maxControl), maxControl);
+        const __m128i quote = _mm_cmpeq_epi8(data, _mm_set1_epi8(0x22));
+        const __m128i backslash = _mm_cmpeq_epi8(data, _mm_set1_epi8(0x5c));
+        return _mm_or_si128(control, _mm_or_si128(quote, backslash));
+    }
+#endif
+#ifdef QTEXTSCAN_AVX2
+    QT_FUNCTION_TARGET(AVX2) static __m256i stops(__m256i data)
+    {
+        const __m256i maxControl = _mm256_set1_epi8(0x1f);
+        const __m256i control = _mm256_cmpeq_epi8(_mm256_max_epu8(data, maxControl), maxControl);
+        const __m256i quote = _mm256_cmpeq_epi8(data, _mm256_set1_epi8(0x22));
+        const __m256i backslash = _mm256_cmpeq_epi8(data, _mm256_set1_epi8(0x5c));
+        return _mm256_or_si256(control, _mm256_or_si256(quote, backslash));
+    }
+#endif
+};
+} // unnamed namespace
+
+// Returns the first byte in [ptr, end) that needs escaping, or end.
+static const char *skipUnescapedUtf8(const char *ptr, const char *end)
+{
+    return QtPrivate::scanUntil<EscapeStops>(ptr, end);
+}
+
+void Writer::appendEscaped(QByteArray &json, QUtf8StringView s)
+{
+    const char *ptr = s.data();
+    const char *const end = ptr + s.size();
+    while (ptr != end) {
+        const char *run = ptr;
+        ptr = skipUnescapedUtf8(ptr, end);
+        json.append(run, ptr - run);
+        if (ptr == end)
+            break;
+        uchar escaped[6];
+        json.append(reinterpret_cast<const char *>(escaped),
+                    escapeAscii(uchar(*ptr++), escaped) - escaped);
+    }
+}
+
+void Writer::appendEscaped(QByteArray &json, QLatin1String s)
+{
+    if (QtPrivate::isAscii(s))
+        appendEscaped(json, QUtf8StringView(s.data(), s.size()));
+    else
+        appendEscaped(json, QStringView(QString(s)));
+}
+
+namespace {
+class JsonWriter
+{
+public:
+    static constexpr qsizetype FlushThreshold = 64 * 1024;
+
+    JsonWriter(QByteArray &json, bool compact, QIODevice *device = nullptr)
+        : json(json), device(device), compact(compact)
+    {}
+
+    void container(const QCborContainerPrivate *c, bool isArray, int indent);
+    void value(const QCborValue &v, int indent);
+    void element(const QCborContainerPrivate *c, qsizetype idx, int indent);
+    void string(const QCborContainerPrivate *c, qsizetype idx);
+    void integer(qint64 value);
+
+    bool flush()
+    {
+        if (device && !json.isEmpty()) {
+            failed = failed || device->write(json) != json.size();
+            json.resize(0);
+        }
+        return !failed;
+    }
+
+private:
+    QByteArray &json;
+    QIODevice *device;
+    bool compact;
+    bool failed = false;
+};
+}
+
+void JsonWriter::container(const QCborContainerPrivate *c, bool isArray, int indent)
+{
+    if (c)
+        c->materialize();
+    json += isArray ? '[' : '{';
+    if (!compact)
+        json += '\n';
+
+    if (c && !c->elements.empty()) {
+        const int contentIndent = indent + (compact ? 0 : 1);
+        const qsizetype step = isArray ? 1 : 2;
+        for (qsizetype i = 0; i < c->elements.size(); i += step) {
+            if (i)
+                json += compact ? "," : ",\n";
+            if (!compact)
+                json.append(4 * contentIndent, ' ');
+            if (!isArray) {
+                json += '"';
+                string(c, i);
+                json += compact ? "\":" : "\": ";
             }
-        } else if (QUtf8Functions::toUtf8<QUtf8BaseTraits>(u, cursor, src, end) < 0) {
-            // failed to get valid utf8 use JSON escape sequence
-            *cursor++ = '\\';
-            *cursor++ = 'u';
-            *cursor++ = hexdig(u>>12 & 0x0f);
-            *cursor++ = hexdig(u>>8 & 0x0f);
-            *cursor++ = hexdig(u>>4 & 0x0f);
-            *cursor++ = hexdig(u & 0x0f);
+            element(c, i + step - 1, contentIndent);
+            if (device && json.size() >= FlushThreshold)
+                flush();
         }
+        if (!compact)
+            json += '\n';
     }
 
-    ba.resize(cursor - (const uchar *)ba.constData());
-    return ba;
+    json.append(4 * indent, ' ');
+    json += isArray ? ']' : '}';
 }
 
-static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool compact)
+void JsonWriter::value(const QCborValue &v, int indent)
 {
-    QCborValue::Type type = v.type();
-    switch (type) {
+    switch (v.type()) {
     case QCborValue::True:
         json += "true";
         break;
@@ -139,7 +291,7 @@ static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool
         json += "false";
         break;
     case QCborValue::Integer:
-        json += QByteArray::number(v.toInteger());
+        integer(v.toInteger());
         break;
     case QCborValue::Double: {
         const double d = v.toDouble();
@@ -151,22 +303,14 @@ static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool
     }
     case QCborValue::String:
         json += '"';
-        json += escapedString(v.toString());
+        Writer::appendEscaped(json, v.toString());
         json += '"';
         break;
     case QCborValue::Array:
-        json += compact ? "[" : "[\n";
-        arrayContentToJson(
-                QJsonPrivate::Value::container(v), json, indent + (compact ? 0 : 1), compact);
-        json += QByteArray(4*indent, ' ');
-        json += ']';
+        container(QJsonPrivate::Value::container(v), true, indent);
         break;
     case QCborValue::Map:
-        json += compact ? "{" : "{\n";
-        objectContentToJson(
-                QJsonPrivate::Value::container(v), json, indent + (compact ? 0 : 1), compact);
-        json += QByteArray(4*indent, ' ');
-        json += '}';
+        container(QJsonPrivate::Value::container(v), false, indent);
         break;
     case QCborValue::Null:
     default:
@@ -174,71 +318,115 @@ static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool
     }
 }
 
-static void arrayContentToJson(const QCborContainerPrivate *a, QByteArray &json, int indent, bool compact)
+// Writes element idx of c without creating a QCborValue for it.
+void JsonWriter::element(const QCborContainerPrivate *c, qsizetype idx, int indent)
 {
-    if (!a || a->elements.empty())
-        return;
-
-    QByteArray indentString(4*indent, ' ');
-
-    qsizetype i = 0;
-    while (true) {
-        json += indentString;
-        valueToJson(a->valueAt(i), json, indent, compact);
-
-        if (++i == a->elements.size()) {
-            if (!compact)
-                json += '\n';
-            break;
-        }
-
-        json += compact ? "," : ",\n";
+    const QtCbor::Element &e = c->elements.at(idx);
+    switch (e.type) {
+    case QCborValue::Integer:
+        integer(e.value);
+        break;
+    case QCborValue::Double:
+        if (qIsFinite(e.fpvalue()))
+            json += QByteArray::number(e.fpvalue(), 'g', QLocale::FloatingPointShortest);
+        else
+            json += "null";
+        break;
+    case QCborValue::String:
+        json += '"';
+        string(c, idx);
+        json += '"';
+        break;
+    case QCborValue::Array:
+    case QCborValue::Map:
+        container(e.flags & QtCbor::Element::IsContainer ? e.container : nullptr,
+                  e.type == QCborValue::Array, indent);
+        break;
+    default:
+        value(c->valueAt(idx), indent);
+        break;
     }
 }
 
-
-static void objectContentToJson(const QCborContainerPrivate *o, QByteArray &json, int indent, bool compact)
+// Writes the escaped contents of the string at idx, straight from storage.
+void JsonWriter::string(const QCborContainerPrivate *c, qsizetype idx)
 {
-    if (!o || o->elements.empty())
-        return;
-
-    QByteArray indentString(4*indent, ' ');
-
-    qsizetype i = 0;
-    while (true) {
-        QCborValue e = o->valueAt(i);
-        json += indentString;
-        json += '"';
-        json += escapedString(o->valueAt(i).toString());
-        json += compact ? "\":" : "\": ";
-        valueToJson(o->valueAt(i + 1), json, indent, compact);
+    const QtCbor::Element &e = c->elements.at(idx);
+    const QtCbor::ByteData *b = c->byteData(e);
+    if (!b) {
+        if (e.type != QCborValue::String)
+            Writer::appendEscaped(json, c->valueAt(idx).toString());
+    } else if (e.flags & QtCbor::Element::StringIsUtf16) {
+        Writer::appendEscaped(json, b->asStringView());
+    } else if (e.flags & QtCbor::Element::StringIsAscii) {
+        Writer::appendEscaped(json, b->asLatin1());
+    } else {
+        Writer::appendEscaped(json, b->asUtf8StringView());
+    }
+}
 
-        if ((i += 2) == o->elements.size()) {
-            if (!compact)
-                json += '\n';
-            break;
-        }
+void JsonWriter::integer(qint64 value)
+{
+    char buffer[24];
+    char *const end = buffer + sizeof(buffer);
+    char *p = end;
+    quint64 u = value < 0 ? 0 - quint64(value) : quint64(value);
+    do {
+        *--p = char('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (value < 0)
+        *--p = '-';
+    json.append(p, end - p);
+}
 
-        json += compact ? "," : ",\n";
+// Estimates the output size from the stored string data and the number of
+// elements, so that the result is usually allocated only once.
+static qsizetype estimatedSize(const QCborContainerPrivate *c, int indent, bool compact)
+{
+    if (!c)
+        return 2;
+    c->materialize();
+    const qsizetype perElement = compact ? 8 : 12 + 4 * (indent + 1);
+    qsizetype size = 2 + c->data.size() + c->elements.size() * perElement;
+    for (const QtCbor::Element &e : c->elements) {
+        if (e.flags & QtCbor::Element::IsContainer)
+            size += estimatedSize(e.container, indent + 1, compact);
     }
+    return size;
 }
 
 void Writer::objectToJson(const QCborContainerPrivate *o, QByteArray &json, int indent, bool compact)
 {
-    json.reserve(json.size() + (o ? (int)o->elements.size() : 16));
-    json += compact ? "{" : "{\n";
-    objectContentToJson(o, json, indent + (compact ? 0 : 1), compact);
-    json += QByteArray(4*indent, ' ');
-    json += compact ? "}" : "}\n";
+    json.reserve(json.size() + estimatedSize(o, indent, compact));
+    JsonWriter(json, compact).container(o, false, indent);
+    if (!compact)
+        json += '\n';
 }
 
 void Writer::arrayToJson(const QCborContainerPrivate *a, QByteArray &json, int indent, bool compact)
 {
-    json.reserve(json.size() + (a ? (int)a->elements.size() : 16));
-    json += compact ? "[" : "[\n";
-    arrayContentToJson(a, json, indent + (compact ? 0 : 1), compact);
-    json += QByteArray(4*indent, ' ');
-    json += compact ? "]" : "]\n";
+    json.reserve(json.size() + estimatedSize(a, indent, compact));
+    JsonWriter(json, compact).container(a, true, indent);
+    if (!compact)
+        json += '\n';
+}
+
+void Writer::valueToJson(const QCborValue &v, QByteArray &json, int indent, bool compact)
+{
+    JsonWriter(json, compact).value(v, indent);
+}
+
+bool Writer::toDevice(const QCborContainerPrivate *c, bool isArray, QIODevice *device,
+                      bool compact)
+{
+    QByteArray buffer;
+    buffer.reserve(JsonWriter::FlushThreshold + JsonWriter::FlushThreshold / 4);
+    JsonWriter writer(buffer, compact, device);
+    writer.container(c, isArray, 0);
+    if (!compact)
+        buffer += '\n';
+    return writer.flush();
 }
 
 QT_END_NAMESPACE
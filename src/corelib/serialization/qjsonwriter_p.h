@@ -53,9 +53,12 @@
 
 #include <QtCore/private/qglobal_p.h>
 #include <qjsonvalue.h>
+#include <qutf8stringview.h>
 
 QT_BEGIN_NAMESPACE
 
+class QIODevice;
+
 namespace QJsonPrivate
 {
 
@@ -64,6 +67,13 @@ class Writer
 public:
     static void objectToJson(const QCborContainerPrivate *o, QByteArray &json, int indent, bool compact = false);
     static void arrayToJson(const QCborContainerPrivate *a, QByteArray &json, int indent, bool compact = false);
+    static void valueToJson(const QCborValue &v, QByteArray &json, int indent, bool compact = false);
+    static bool toDevice(const QCborContainerPrivate *c, bool isArray, QIODevice *device,
+                         bool compact = false);
+
+    static void appendEscaped(QByteArray &json, QStringView s);
+    static void appendEscaped(QByteArray &json, QUtf8StringView s);
+    static void appendEscaped(QByteArray &json, QLatin1String s);
 };
 
 }
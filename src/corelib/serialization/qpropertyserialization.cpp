@@ -0,0 +1,731 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qpropertyserialization.h"
+
+#include <qcbormap.h>
+#include <qcborvalue.h>
+#include <qjsonvalue.h>
+#include <qvariant.h>
+#include <qvarlengtharray.h>
+#if QT_CONFIG(cborstreamreader)
+#include <qcborstreamreader.h>
+#endif
+#if QT_CONFIG(cborstreamwriter)
+#include <qcborstreamwriter.h>
+#endif
+
+#include <cmath>
+#include <limits>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \namespace QtSerialization
+    \inmodule QtCore
+    \since 6.3
+    \brief The QtSerialization namespace contains generic serializers for
+    classes with a typed property visitor.
+
+    The functions in this namespace save and load the stored properties of
+    any class that uses the Q_PROPERTY_VISITOR macro. Unlike serialization
+    through QMetaProperty, the property values are never boxed in a QVariant
+    and are not looked up by name: moc generates code that hands each
+    property to the serializer with its native type.
+
+    \snippet code/src_corelib_serialization_qpropertyserialization.cpp 0
+    \snippet code/src_corelib_serialization_qpropertyserialization.cpp 1
+
+    The header also provides QDataStream operators for these classes, which
+    write the properties in declaration order without any framing. CBOR and
+    JSON output use a map with one entry per property, keyed by the property
+    name. Properties whose type has a property visitor of its own are written
+    as nested maps or objects. bool, integer, floating point, QString and
+    QByteArray properties are converted directly; all other types go through
+    QMetaType: QMetaType::save() and QMetaType::load() for QDataStream, and
+    QCborValue::fromVariant() or QJsonValue::fromVariant() for CBOR and JSON.
+    In JSON, byte arrays are encoded as Base64url, like
+    QCborValue::toJsonValue() does.
+
+    The loaders leave properties that are missing from the input untouched
+    and ignore entries they do not know. Reading CBOR is fastest when the map
+    entries appear in the order in which toCbor() wrote them, but any order is
+    accepted.
+
+    \sa QPropertyVisitor, Q_PROPERTY_VISITOR
+*/
+
+namespace {
+
+#ifndef QT_NO_DATASTREAM
+class DataStreamSaver final : public QPropertyVisitor
+{
+public:
+    explicit DataStreamSaver(QDataStream &stream) : QPropertyVisitor(false), stream(stream) {}
+
+    bool visit(QLatin1String, bool &value) override { stream << value; return false; }
+    bool visit(QLatin1String, int &value) override { stream << value; return false; }
+    bool visit(QLatin1String, uint &value) override { stream << value; return false; }
+    bool visit(QLatin1String, qint64 &value) override { stream << value; return false; }
+    bool visit(QLatin1String, quint64 &value) override { stream << value; return false; }
+    bool visit(QLatin1String, float &value) override { stream << value; return false; }
+    bool visit(QLatin1String, double &value) override { stream << value; return false; }
+    bool visit(QLatin1String, QString &value) override { stream << value; return false; }
+    bool visit(QLatin1String, QByteArray &value) override { stream << value; return false; }
+    bool visit(QLatin1String, QMetaType type, void *value) override
+    {
+        if (!type.save(stream, value))
+            stream.setStatus(QDataStream::WriteFailed);
+        return false;
+    }
+    bool visitObject(QLatin1String, QMetaType, VisitFunction visitProperties,
+                     void *object) override
+    {
+        visitProperties(*this, object);
+        return false;
+    }
+
+private:
+    QDataStream &stream;
+};
+
+class DataStreamLoader final : public QPropertyVisitor
+{
+public:
+    explicit DataStreamLoader(QDataStream &stream) : QPropertyVisitor(true), stream(stream) {}
+
+    bool visit(QLatin1String, bool &value) override { return load(value); }
+    bool visit(QLatin1String, int &value) override { return load(value); }
+    bool visit(QLatin1String, uint &value) override { return load(value); }
+    bool visit(QLatin1String, qint64 &value) override { return load(value); }
+    bool visit(QLatin1String, quint64 &value) override { return load(value); }
+    bool visit(QLatin1String, float &value) override { return load(value); }
+    bool visit(QLatin1String, double &value) override { return load(value); }
+    bool visit(QLatin1String, QString &value) override { return load(value); }
+    bool visit(QLatin1String, QByteArray &value) override { return load(value); }
+    bool visit(QLatin1String, QMetaType type, void *value) override
+    {
+        if (!type.load(stream, value))
+            stream.setStatus(QDataStream::ReadCorruptData);
+        return stream.status() == QDataStream::Ok;
+    }
+    bool visitObject(QLatin1String, QMetaType, VisitFunction visitProperties,
+                     void *object) override
+    {
+        visitProperties(*this, object);
+        return stream.status() == QDataStream::Ok;
+    }
+
+private:
+    template <typename T> bool load(T &value)
+    {
+        stream >> value;
+        return stream.status() == QDataStream::Ok;
+    }
+
+    QDataStream &stream;
+};
+#endif // QT_NO_DATASTREAM
+
+template <typename Int>
+static bool convertInteger(const QCborValue &v, Int *value)
+{
+    if (v.isInteger()) {
+        const qint64 i = v.toInteger();
+        if constexpr (std::is_signed_v<Int>) {
+            if (i < qint64(std::numeric_limits<Int>::min())
+                    || i > qint64(std::numeric_limits<Int>::max()))
+                return false;
+        } else {
+            if (i < 0 || quint64(i) > std::numeric_limits<Int>::max())
+                return false;
+        }
+        *value = Int(i);
+        return true;
+    }
+    if (v.isDouble()) {
+        // JSON has no separate integer type, so accept integral doubles
+        const double d = v.toDouble();
+        if (d < double(std::numeric_limits<Int>::min())
+                || d >= double(std::numeric_limits<Int>::max()) + 1.
+                || std::trunc(d) != d)
+            return false;
+        *value = Int(d);
+        return true;
+    }
+    return false;
+}
+
+template <typename Float>
+static bool convertFloatingPoint(const QCborValue &v, Float *value)
+{
+    if (v.isDouble())
+        *value = Float(v.toDouble());
+    else if (v.isInteger())
+        *value = Float(v.toInteger());
+    else
+        return false;
+    return true;
+}
+
+// Converts CBOR and JSON DOM values to the native property types
+class CborValueConverter : public QPropertyVisitor
+{
+protected:
+    CborValueConverter() : QPropertyVisitor(true) {}
+
+    bool check(bool converted)
+    {
+        ok &= converted;
+        return converted;
+    }
+
+    static bool convert(const QCborValue &v, bool *value)
+    {
+        if (!v.isBool())
+            return false;
+        *value = v.toBool();
+        return true;
+    }
+    static bool convert(const QCborValue &v, int *value) { return convertInteger(v, value); }
+    static bool convert(const QCborValue &v, uint *value) { return convertInteger(v, value); }
+    static bool convert(const QCborValue &v, qint64 *value) { return convertInteger(v, value); }
+    static bool convert(const QCborValue &v, quint64 *value) { return convertInteger(v, value); }
+    static bool convert(const QCborValue &v, float *value) { return convertFloatingPoint(v, value); }
+    static bool convert(const QCborValue &v, double *value) { return convertFloatingPoint(v, value); }
+    static bool convert(const QCborValue &v, QString *value)
+    {
+        if (!v.isString())
+            return false;
+        *value = v.toString();
+        return true;
+    }
+    static bool convert(const QCborValue &v, QByteArray *value)
+    {
+        if (v.isByteArray()) {
+            *value = v.toByteArray();
+            return true;
+        }
+        if (v.isString()) {
+            // that's how toJson() encodes byte arrays
+            auto r = QByteArray::fromBase64Encoding(v.toString().toLatin1(),
+                                                    QByteArray::Base64UrlEncoding
+                                                    | QByteArray::AbortOnBase64DecodingErrors);
+            if (!r)
+                return false;
+            *value = std::move(r.decoded);
+            return true;
+        }
+        return false;
+    }
+    static bool convert(const QCborValue &v, QMetaType type, void *value)
+    {
+        const QVariant variant = v.toVariant();
+        return QMetaType::convert(variant.metaType(), variant.constData(), type, value);
+    }
+    static bool convertObject(const QCborValue &v, VisitFunction visitProperties, void *object);
+
+    bool ok = true;
+};
+
+class CborMapLoader final : public CborValueConverter
+{
+public:
+    explicit CborMapLoader(const QCborMap &map) : map(map) {}
+
+    bool load(VisitFunction visitProperties, void *object)
+    {
+        visitProperties(*this, object);
+        return ok;
+    }
+
+    bool visit(QLatin1String name, bool &value) override { return loadValue(name, &value); }
+    bool visit(QLatin1String name, int &value) override { return loadValue(name, &value); }
+    bool visit(QLatin1String name, uint &value) override { return loadValue(name, &value); }
+    bool visit(QLatin1String name, qint64 &value) override { return loadValue(name, &value); }
+    bool visit(QLatin1String name, quint64 &value) override { return loadValue(name, &value); }
+    bool visit(QLatin1String name, float &value) override { return loadValue(name, &value); }
+    bool visit(QLatin1String name, double &value) override { return loadValue(name, &value); }
+    bool visit(QLatin1String name, QString &value) override { return loadValue(name, &value); }
+    bool visit(QLatin1String name, QByteArray &value) override { return loadValue(name, &value); }
+    bool visit(QLatin1String name, QMetaType type, void *value) override
+    {
+        const QCborValue v = map.value(name);
+        return !v.isUndefined() && check(convert(v, type, value));
+    }
+    bool visitObject(QLatin1String name, QMetaType, VisitFunction visitProperties,
+                     void *object) override
+    {
+        const QCborValue v = map.value(name);
+        return !v.isUndefined() && check(convertObject(v, visitProperties, object));
+    }
+
+private:
+    template <typename T> bool loadValue(QLatin1String name, T *value)
+    {
+        const QCborValue v = map.value(name);
+        return !v.isUndefined() && check(convert(v, value));
+    }
+
+    const QCborMap &map;
+};
+
+bool CborValueConverter::convertObject(const QCborValue &v, VisitFunction visitProperties,
+                                       void *object)
+{
+    if (!v.isMap())
+        return false;
+    const QCborMap map = v.toMap();
+    return CborMapLoader(map).load(visitProperties, object);
+}
+
+#if QT_CONFIG(cborstreamwriter)
+class CborStreamSaver final : public QPropertyVisitor
+{
+public:
+    explicit CborStreamSaver(QCborStreamWriter &writer) : QPropertyVisitor(false), writer(writer) {}
+
+    void save(VisitFunction visitProperties, const void *object)
+    {
+        writer.startMap();
+        visitProperties(*this, const_cast<void *>(object));
+        writer.endMap();
+    }
+
+    bool visit(QLatin1String name, bool &value) override { return saveValue(name, value); }
+    bool visit(QLatin1String name, int &value) override { return saveValue(name, value); }
+    bool visit(QLatin1String name, uint &value) override { return saveValue(name, value); }
+    bool visit(QLatin1String name, qint64 &value) override { return saveValue(name, value); }
+    bool visit(QLatin1String name, quint64 &value) override { return saveValue(name, value); }
+    bool visit(QLatin1String name, float &value) override { return saveValue(name, value); }
+    bool visit(QLatin1String name, double &value) override { return saveValue(name, value); }
+    bool visit(QLatin1String name, QString &value) override { return saveValue(name, QStringView(value)); }
+    bool visit(QLatin1String name, QByteArray &value) override { return saveValue(name, value); }
+    bool visit(QLatin1String name, QMetaType type, void *value) override
+    {
+        writer.append(name);
+        QCborValue::fromVariant(QVariant(type, value)).toCbor(writer);
+        return false;
+    }
+    bool visitObject(QLatin1String name, QMetaType, VisitFunction visitProperties,
+                     void *object) override
+    {
+        writer.append(name);
+        save(visitProperties, object);
+        return false;
+    }
+
+private:
+    template <typename T> bool saveValue(QLatin1String name, const T &value)
+    {
+        writer.append(name);
+        writer.append(value);
+        return false;
+    }
+
+    QCborStreamWriter &writer;
+};
+#endif // QT_CONFIG(cborstreamwriter)
+
+#if QT_CONFIG(cborstreamreader)
+class CborStreamLoader final : public CborValueConverter
+{
+public:
+    explicit CborStreamLoader(QCborStreamReader &reader) : reader(reader) {}
+
+    bool load(VisitFunction visitProperties, void *object)
+    {
+        if (!reader.isMap()) {
+            reader.next();
+            return false;
+        }
+        if (!reader.enterContainer())
+            return false;
+
+        visitProperties(*this, object);
+
+        // skip entries that no property asked for
+        while (!outOfOrder && reader.lastError() == QCborError::NoError && reader.hasNext())
+            reader.next();
+        if (reader.lastError() == QCborError::NoError)
+            reader.leaveContainer();
+        return ok && reader.lastError() == QCborError::NoError;
+    }
+
+    bool visit(QLatin1String name, bool &value) override
+    {
+        if (!seek(name))
+            return lookup(name, &value);
+        if (!reader.isBool())
+            return decode(&value);
+        value = reader.toBool();
+        reader.next();
+        return true;
+    }
+    bool visit(QLatin1String name, int &value) override { return loadInteger(name, &value); }
+    bool visit(QLatin1String name, uint &value) override { return loadInteger(name, &value); }
+    bool visit(QLatin1String name, qint64 &value) override { return loadInteger(name, &value); }
+    bool visit(QLatin1String name, quint64 &value) override { return loadInteger(name, &value); }
+    bool visit(QLatin1String name, float &value) override { return loadFloatingPoint(name, &value); }
+    bool visit(QLatin1String name, double &value) override { return loadFloatingPoint(name, &value); }
+    bool visit(QLatin1String name, QString &value) override
+    {
+        if (!seek(name))
+            return lookup(name, &value);
+        if (!reader.isString())
+            return decode(&value);
+        QString result;
+        auto r = reader.readString();
+        while (r.status == QCborStreamReader::Ok) {
+            result += r.data;
+            r = reader.readString();
+        }
+        if (!check(r.status == QCborStreamReader::EndOfString))
+            return false;
+        value = std::move(result);
+        return true;
+    }
+    bool visit(QLatin1String name, QByteArray &value) override
+    {
+        if (!seek(name))
+            return lookup(name, &value);
+        if (!reader.isByteArray())
+            return decode(&value);
+        QByteArray result;
+        auto r = reader.readByteArray();
+        while (r.status == QCborStreamReader::Ok) {
+            result += r.data;
+            r = reader.readByteArray();
+        }
+        if (!check(r.status == QCborStreamReader::EndOfString))
+            return false;
+        value = std::move(result);
+        return true;
+    }
+    bool visit(QLatin1String name, QMetaType type, void *value) override
+    {
+        if (!seek(name)) {
+            const QCborValue v = remaining.value(name);
+            return !v.isUndefined() && check(convert(v, type, value));
+        }
+        return check(convert(QCborValue::fromCbor(reader), type, value));
+    }
+    bool visitObject(QLatin1String name, QMetaType, VisitFunction visitProperties,
+                     void *object) override
+    {
+        if (!seek(name)) {
+            const QCborValue v = remaining.value(name);
+            return !v.isUndefined() && check(convertObject(v, visitProperties, object));
+        }
+        return check(CborStreamLoader(reader).load(visitProperties, object));
+    }
+
+private:
+    // Returns true if the reader is positioned on the value for the property
+    // called \a name. Returns false if the property has to be looked up in
+    // the remaining entries instead, which are read into a map as soon as an
+    // entry turns out to be out of order.
+    bool seek(QLatin1String name)
+    {
+        if (outOfOrder || reader.lastError() != QCborError::NoError || !reader.hasNext())
+            return false;
+
+        QCborValue otherKey;
+        if (reader.isString()) {
+            key.clear();
+            auto r = reader.readUtf8StringView();
+            while (r.status == QCborStreamReader::Ok) {
+                key.append(r.data.data(), r.data.size());
+                r = reader.readUtf8StringView();
+            }
+            if (r.status == QCborStreamReader::Error)
+                return false;
+            if (QByteArrayView(key.constData(), key.size()) == QByteArrayView(name.data(), name.size()))
+                return true;
+            otherKey = QString::fromUtf8(key.constData(), key.size());
+        } else {
+            otherKey = QCborValue::fromCbor(reader);
+        }
+
+        outOfOrder = true;
+        remaining.insert(otherKey, QCborValue::fromCbor(reader));
+        while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+            const QCborValue k = QCborValue::fromCbor(reader);
+            remaining.insert(k, QCborValue::fromCbor(reader));
+        }
+        return false;
+    }
+
+    template <typename T> bool lookup(QLatin1String name, T *value)
+    {
+        const QCborValue v = remaining.value(name);
+        return !v.isUndefined() && check(convert(v, value));
+    }
+
+    template <typename T> bool decode(T *value)
+    {
+        return check(convert(QCborValue::fromCbor(reader), value));
+    }
+
+    template <typename Int> bool loadInteger(QLatin1String name, Int *value)
+    {
+        if (!seek(name))
+            return lookup(name, value);
+        if (reader.isUnsignedInteger()) {
+            const quint64 u = reader.toUnsignedInteger();
+            reader.next();
+            if (!check(u <= quint64(std::numeric_limits<Int>::max())))
+                return false;
+            *value = Int(u);
+            return true;
+        }
+        if (reader.isNegativeInteger() && std::is_signed_v<Int>) {
+            const qint64 i = reader.toInteger();
+            reader.next();
+            if (!check(i < 0 && i >= qint64(std::numeric_limits<Int>::min())))
+                return false;
+            *value = Int(i);
+            return true;
+        }
+        return decode(value);
+    }
+
+    template <typename Float> bool loadFloatingPoint(QLatin1String name, Float *value)
+    {
+        if (!seek(name))
+            return lookup(name, value);
+        if (reader.isDouble())
+            *value = Float(reader.toDouble());
+        else if (reader.isFloat())
+            *value = Float(reader.toFloat());
+        else
+            return decode(value);
+        reader.next();
+        return true;
+    }
+
+    QCborStreamReader &reader;
+    QVarLengthArray<char, 64> key;
+    QCborMap remaining;
+    bool outOfOrder = false;
+};
+#endif // QT_CONFIG(cborstreamreader)
+
+class JsonSaver final : public QPropertyVisitor
+{
+public:
+    JsonSaver() : QPropertyVisitor(false) {}
+
+    QJsonObject save(VisitFunction visitProperties, const void *object)
+    {
+        visitProperties(*this, const_cast<void *>(object));
+        return std::move(json);
+    }
+
+    bool visit(QLatin1String name, bool &value) override { return save(name, value); }
+    bool visit(QLatin1String name, int &value) override { return save(name, value); }
+    bool visit(QLatin1String name, uint &value) override { return save(name, qint64(value)); }
+    bool visit(QLatin1String name, qint64 &value) override { return save(name, value); }
+    bool visit(QLatin1String name, quint64 &value) override
+    {
+        if (value <= quint64(std::numeric_limits<qint64>::max()))
+            return save(name, qint64(value));
+        return save(name, double(value));
+    }
+    bool visit(QLatin1String name, float &value) override { return save(name, double(value)); }
+    bool visit(QLatin1String name, double &value) override { return save(name, value); }
+    bool visit(QLatin1String name, QString &value) override { return save(name, value); }
+    bool visit(QLatin1String name, QByteArray &value) override
+    {
+        return save(name, QString::fromLatin1(value.toBase64(QByteArray::Base64UrlEncoding
+                                                             | QByteArray::OmitTrailingEquals)));
+    }
+    bool visit(QLatin1String name, QMetaType type, void *value) override
+    {
+        return save(name, QJsonValue::fromVariant(QVariant(type, value)));
+    }
+    bool visitObject(QLatin1String name, QMetaType, VisitFunction visitProperties,
+                     void *object) override
+    {
+        return save(name, JsonSaver().save(visitProperties, object));
+    }
+
+private:
+    bool save(QLatin1String name, const QJsonValue &value)
+    {
+        json.insert(name, value);
+        return false;
+    }
+
+    QJsonObject json;
+};
+
+} // unnamed namespace
+
+namespace QtSerialization {
+
+#ifndef QT_NO_DATASTREAM
+/*!
+    \fn template <typename T> QDataStream &operator<<(QDataStream &stream, const T &value)
+    \relates QtSerialization
+    \since 6.3
+
+    Writes the stored properties of \a value to \a stream, in the order in
+    which they are declared. This operator only participates in overload
+    resolution if \c T uses the Q_PROPERTY_VISITOR macro.
+*/
+
+/*!
+    \fn template <typename T> QDataStream &operator>>(QDataStream &stream, T &value)
+    \relates QtSerialization
+    \since 6.3
+
+    Reads the stored properties of \a value from \a stream, as written by
+    operator<<(). This operator only participates in overload resolution if
+    \c T uses the Q_PROPERTY_VISITOR macro.
+*/
+
+/*!
+    Writes the properties of \a object, visited by \a visitProperties, to
+    \a stream. The templated QDataStream operators call this function.
+*/
+void save(QDataStream &stream, VisitFunction visitProperties, const void *object)
+{
+    DataStreamSaver saver(stream);
+    visitProperties(saver, const_cast<void *>(object));
+}
+
+/*!
+    Reads the properties of \a object, visited by \a visitProperties, from
+    \a stream. The templated QDataStream operators call this function.
+*/
+void load(QDataStream &stream, VisitFunction visitProperties, void *object)
+{
+    DataStreamLoader loader(stream);
+    visitProperties(loader, object);
+}
+#endif // QT_NO_DATASTREAM
+
+#if QT_CONFIG(cborstreamwriter)
+/*!
+    \fn template <typename T> void QtSerialization::toCbor(QCborStreamWriter &writer, const T &value)
+
+    Writes the stored properties of \a value to \a writer, as a CBOR map.
+*/
+
+/*!
+    \overload
+
+    Writes the properties of \a object, visited by \a visitProperties, to
+    \a writer as a CBOR map.
+*/
+void toCbor(QCborStreamWriter &writer, VisitFunction visitProperties, const void *object)
+{
+    CborStreamSaver(writer).save(visitProperties, object);
+}
+#endif
+
+#if QT_CONFIG(cborstreamreader)
+/*!
+    \fn template <typename T> bool QtSerialization::fromCbor(QCborStreamReader &reader, T &value)
+
+    Reads a CBOR map from \a reader and assigns its entries to the properties
+    of \a value with the same names. Returns \c true on success. Returns
+    \c false if the next element is not a map, if the stream is corrupt or if
+    an entry could not be converted to the type of its property; properties
+    that were read before the error keep their new values.
+
+    The reader is positioned after the map afterwards, unless a decoding
+    error occurred.
+*/
+
+/*!
+    \overload
+
+    Reads the properties of \a object, visited by \a visitProperties, from
+    the CBOR map at the current position of \a reader.
+*/
+bool fromCbor(QCborStreamReader &reader, VisitFunction visitProperties, void *object)
+{
+    return CborStreamLoader(reader).load(visitProperties, object);
+}
+#endif
+
+/*!
+    \fn template <typename T> QJsonObject QtSerialization::toJson(const T &value)
+
+    Returns a JSON object with one entry for each stored property of
+    \a value.
+*/
+
+/*!
+    \overload
+
+    Returns a JSON object with the properties of \a object, visited by
+    \a visitProperties.
+*/
+QJsonObject toJson(VisitFunction visitProperties, const void *object)
+{
+    return JsonSaver().save(visitProperties, object);
+}
+
+/*!
+    \fn template <typename T> bool QtSerialization::fromJson(const QJsonObject &json, T &value)
+
+    Assigns the entries of \a json to the properties of \a value with the
+    same names. Returns \c false if an entry could not be converted to the
+    type of its property, \c true otherwise.
+*/
+
+/*!
+    \overload
+
+    Assigns the entries of \a json to the properties of \a object, visited by
+    \a visitProperties.
+*/
+bool fromJson(const QJsonObject &json, VisitFunction visitProperties, void *object)
+{
+    const QCborMap map = QCborMap::fromJsonObject(json);
+    return CborMapLoader(map).load(visitProperties, object);
+}
+
+} // namespace QtSerialization
+
+QT_END_NAMESPACE
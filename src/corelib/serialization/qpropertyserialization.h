@@ -0,0 +1,125 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QPROPERTYSERIALIZATION_H
+#define QPROPERTYSERIALIZATION_H
+
+#include <QtCore/qdatastream.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qpropertyvisitor.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+class QCborStreamReader;
+class QCborStreamWriter;
+
+namespace QtSerialization {
+
+using VisitFunction = QPropertyVisitor::VisitFunction;
+
+#ifndef QT_NO_DATASTREAM
+Q_CORE_EXPORT void save(QDataStream &stream, VisitFunction visitProperties, const void *object);
+Q_CORE_EXPORT void load(QDataStream &stream, VisitFunction visitProperties, void *object);
+#endif
+#if QT_CONFIG(cborstreamwriter)
+Q_CORE_EXPORT void toCbor(QCborStreamWriter &writer, VisitFunction visitProperties,
+                          const void *object);
+#endif
+#if QT_CONFIG(cborstreamreader)
+Q_CORE_EXPORT bool fromCbor(QCborStreamReader &reader, VisitFunction visitProperties,
+                            void *object);
+#endif
+Q_CORE_EXPORT QJsonObject toJson(VisitFunction visitProperties, const void *object);
+Q_CORE_EXPORT bool fromJson(const QJsonObject &json, VisitFunction visitProperties, void *object);
+
+template <typename T>
+using if_has_property_visitor = std::enable_if_t<QtPrivate::HasPropertyVisitor<T>::value, bool>;
+
+#if QT_CONFIG(cborstreamwriter)
+template <typename T, if_has_property_visitor<T> = true>
+void toCbor(QCborStreamWriter &writer, const T &value)
+{
+    toCbor(writer, &T::qt_static_visitProperties, std::addressof(value));
+}
+#endif
+
+#if QT_CONFIG(cborstreamreader)
+template <typename T, if_has_property_visitor<T> = true>
+bool fromCbor(QCborStreamReader &reader, T &value)
+{
+    return fromCbor(reader, &T::qt_static_visitProperties, std::addressof(value));
+}
+#endif
+
+template <typename T, if_has_property_visitor<T> = true>
+QJsonObject toJson(const T &value)
+{
+    return toJson(&T::qt_static_visitProperties, std::addressof(value));
+}
+
+template <typename T, if_has_property_visitor<T> = true>
+bool fromJson(const QJsonObject &json, T &value)
+{
+    return fromJson(json, &T::qt_static_visitProperties, std::addressof(value));
+}
+
+} // namespace QtSerialization
+
+#ifndef QT_NO_DATASTREAM
+template <typename T, QtSerialization::if_has_property_visitor<T> = true>
+QDataStream &operator<<(QDataStream &stream, const T &value)
+{
+    QtSerialization::save(stream, &T::qt_static_visitProperties, std::addressof(value));
+    return stream;
+}
+
+template <typename T, QtSerialization::if_has_property_visitor<T> = true>
+QDataStream &operator>>(QDataStream &stream, T &value)
+{
+    QtSerialization::load(stream, &T::qt_static_visitProperties, std::addressof(value));
+    return stream;
+}
+#endif
+
+QT_END_NAMESPACE
+
+#endif // QPROPERTYSERIALIZATION_H
@@ -234,6 +234,7 @@ static const int QTEXTSTREAM_BUFFERSIZE = 16384;
 
 #include <locale.h>
 #include "private/qlocale_p.h"
+#include "private/qlocale_tools_p.h"
 #include "private/qstringconverter_p.h"
 
 #include <stdlib.h>
@@ -410,8 +411,12 @@ bool QTextStreamPrivate::fillReadBuffer(qint64 maxBytes)
            QtDebugUtils::toPrintable(buf, bytesRead, 32).constData(), int(sizeof(buf)), int(bytesRead));
 #endif
 
+    // decode straight into the read buffer
     int oldReadBufferSize = readBuffer.size();
-    readBuffer += toUtf16(QByteArrayView(buf, bytesRead));
+    readBuffer.resize(oldReadBufferSize + toUtf16.requiredSpace(bytesRead));
+    const QChar *decodedEnd = toUtf16.appendToBuffer(readBuffer.data() + oldReadBufferSize,
+                                                     QByteArrayView(buf, bytesRead));
+    readBuffer.truncate(decodedEnd - readBuffer.constData());
 
     // remove all '\r\n' in the string.
     if (readBuffer.size() > oldReadBufferSize && textModeEnabled) {
@@ -572,6 +577,26 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
         }
         chPtr += startOffset;
 
+        if (delimiter == EndOfLine) {
+            // let the vectorized search find the line feed
+            int limit = endOffset - startOffset;
+            if (maxlen)
+                limit = qMin(limit, maxlen - totalSize);
+            const qsizetype lineFeed = QStringView(chPtr, limit).indexOf(QLatin1Char('\n'));
+            const int n = lineFeed < 0 ? limit : int(lineFeed) + 1;
+            if (lineFeed >= 0) {
+                foundToken = true;
+                const QChar beforeLineFeed = lineFeed > 0 ? chPtr[lineFeed - 1] : lastChar;
+                delimSize = (beforeLineFeed == QLatin1Char('\r')) ? 2 : 1;
+                consumeDelimiter = true;
+            }
+            if (n)
+                lastChar = chPtr[n - 1];
+            startOffset += n;
+            totalSize += n;
+            continue;
+        }
+
         for (; !foundToken && startOffset < endOffset && (!maxlen || totalSize < maxlen); ++startOffset) {
             const QChar ch = *chPtr++;
             ++totalSize;
@@ -590,12 +615,7 @@ bool QTextStreamPrivate::scan(const QChar **ptr, int *length, int maxlen, TokenD
                 }
                 break;
             case EndOfLine:
-                if (ch == QLatin1Char('\n')) {
-                    foundToken = true;
-                    delimSize = (lastChar == QLatin1Char('\r')) ? 2 : 1;
-                    consumeDelimiter = true;
-                }
-                lastChar = ch;
+                Q_UNREACHABLE();
                 break;
             }
         }
@@ -1642,6 +1662,49 @@ QTextStreamPrivate::NumberParsingStatus QTextStreamPrivate::getNumber(qulonglong
 
     // detect int encoding
     int base = params.integerBase;
+    if ((base == 0 || base == 10) && locale == QLocale::c()) {
+        // Fast path: parse a plain decimal number straight from the
+        // buffer. Anything that isn't clear-cut within the buffered data is
+        // left to the character-by-character parser below.
+        const QChar *p = readPtr();
+        const int available = device ? readBuffer.size() - readBufferOffset
+                                     : string->size() - stringOffset;
+        int k = 0;
+        bool negative = false;
+        if (available > 0 && (p[0] == QLatin1Char('-') || p[0] == QLatin1Char('+'))) {
+            negative = p[0] == QLatin1Char('-');
+            ++k;
+        } else if (base == 0 && available > 1 && p[0] == QLatin1Char('0')) {
+            const char16_t next = p[1].unicode();
+            if (next == 'x' || next == 'X' || next == 'b' || next == 'B'
+                || (next >= '0' && next <= '7')) {
+                k = -1;
+            }
+        }
+        const int firstDigit = k;
+        qulonglong val = 0;
+        if (k >= 0) {
+            for (; k < available; ++k) {
+                const char16_t c = p[k].unicode();
+                if (c < '0' || c > '9')
+                    break;
+                val = val * 10 + (c - '0');
+            }
+        }
+        // Unicode digits and numbers continuing past the buffer need the slow path
+        if (k > firstDigit && (k < available ? p[k].unicode() < 0x80 : !device)) {
+            consume(k);
+            if (negative) {
+                qlonglong ival = qlonglong(val);
+                if (ival > 0)
+                    ival = -ival;
+                val = qulonglong(ival);
+            }
+            if (ret)
+                *ret = val;
+            return npsOk;
+        }
+    }
     if (base == 0) {
         QChar ch;
         if (!getChar(&ch))
@@ -1869,6 +1932,17 @@ bool QTextStreamPrivate::getReal(double *f)
     scan(nullptr, nullptr, 0, NotSpace);
     consumeLastToken();
 
+    // look up the locale's symbols once, not for every character
+    const bool isCLocale = locale == QLocale::c();
+    QString decimalPoint, exponential, negativeSign, positiveSign, groupSeparator;
+    if (!isCLocale) {
+        decimalPoint = locale.decimalPoint().toLower();
+        exponential = locale.exponential().toLower();
+        negativeSign = locale.negativeSign().toLower();
+        positiveSign = locale.positiveSign().toLower();
+        groupSeparator = locale.groupSeparator().toLower();
+    }
+
     const int BufferSize = 128;
     char buf[BufferSize];
     int i = 0;
@@ -1897,18 +1971,26 @@ bool QTextStreamPrivate::getReal(double *f)
             break;
         default: {
             QChar lc = c.toLower();
-            if (lc == locale.decimalPoint().toLower())
+            if (isCLocale) {
+                if (lc == QLatin1Char('.'))
+                    input = InputDot;
+                else if (lc == QLatin1Char('e'))
+                    input = InputExp;
+                else if (lc == QLatin1Char('-') || lc == QLatin1Char('+'))
+                    input = InputSign;
+                else
+                    input = None;
+            } else if (lc == decimalPoint) {
                 input = InputDot;
-            else if (lc == locale.exponential().toLower())
+            } else if (lc == exponential) {
                 input = InputExp;
-            else if (lc == locale.negativeSign().toLower()
-                     || lc == locale.positiveSign().toLower())
+            } else if (lc == negativeSign || lc == positiveSign) {
                 input = InputSign;
-            else if (locale != QLocale::c() // backward-compatibility
-                     && lc == locale.groupSeparator().toLower())
+            } else if (lc == groupSeparator) { // backward-compatibility
                 input = InputDigit; // well, it isn't a digit, but no one cares.
-            else
+            } else {
                 input = None;
+            }
         }
             break;
         }
@@ -1952,7 +2034,13 @@ bool QTextStreamPrivate::getReal(double *f)
         return true;
     }
     bool ok;
-    *f = locale.toDouble(QString::fromLatin1(buf), &ok);
+    if (isCLocale) {
+        // buf holds nothing but C locale number characters already
+        int processed;
+        *f = qt_asciiToDouble(buf, i, ok, processed);
+    } else {
+        *f = locale.toDouble(QString::fromLatin1(buf), &ok);
+    }
     return ok;
 }
 
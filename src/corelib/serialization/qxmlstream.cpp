@@ -64,6 +64,9 @@ public: \
 private:
 #endif
 
+#include <private/qsimd_p.h>
+#include <private/qtextscan_p.h>
+
 #include <iterator>
 #include "qxmlstream_p.h"
 #include "qxmlstreamparser_p.h"
@@ -362,6 +365,12 @@ QXmlStreamEntityResolver *QXmlStreamReader::entityResolver() const
   from the PrematureEndOfDocumentError error and continues parsing the
   new data with the next call to readNext().
 
+  Input is discarded once it has been consumed, and a token that spans
+  several chunks is not scanned again from its beginning when parsing
+  resumes. Long-lived streams, like the ones used by XMPP, can therefore
+  be parsed indefinitely: memory use is bounded by the size of the
+  largest token, not by the amount of data received.
+
   For example, if your application reads data from the network using a
   \l{QNetworkAccessManager} {network access manager}, you would issue
   a \l{QNetworkRequest} {network request} to the manager and receive a
@@ -505,6 +514,12 @@ void QXmlStreamReader::addData(const QByteArray &data)
         qWarning("QXmlStreamReader: addData() with device()");
         return;
     }
+    // drop the input that has been decoded already, once it makes up at
+    // least half of the buffer, so that long-lived streams don't grow it
+    if (d->dataBufferPos && d->dataBufferPos >= d->dataBuffer.size() - d->dataBufferPos) {
+        d->dataBuffer.remove(0, d->dataBufferPos);
+        d->dataBufferPos = 0;
+    }
     d->dataBuffer += data;
 }
 
@@ -854,6 +869,8 @@ void QXmlStreamReaderPrivate::init()
     namespaceProcessing = true;
     rawReadBuffer.clear();
     dataBuffer.clear();
+    dataBufferPos = 0;
+    scanUntilStart = -1;
     readBuffer.clear();
     tagStackStringStorageSize = initialTagStackStringStorageSize;
 
@@ -955,6 +972,104 @@ inline uint QXmlStreamReaderPrivate::peekChar()
     return c;
 }
 
+/*
+    The scanning helpers below find the first character in the decoded input
+    that the tokenizer has to look at; everything before it can be appended
+    to the text buffer as a whole.
+
+    Plain characters are those that are neither one of the Delimiters, nor
+    below U+0020 (this includes tab and line breaks, which need to be
+    normalized or counted), nor one of the non-characters U+FFFE and U+FFFF.
+*/
+namespace {
+template <char16_t... Delimiters>
+struct NonPlainStops
+{
+    static bool stopsAt(char16_t c)
+    {
+        return c < 0x20 || c >= 0xfffe || ((c == Delimiters) || ...);
+    }
+#ifdef __SSE2__
+    static __m128i stops(__m128i data)
+    {
+        // c <= 0x1f and c >= 0xfffe, using unsigned saturation
+        __m128i stop = _mm_or_si128(
+                    _mm_cmpeq_epi16(_mm_subs_epu16(data, _mm_set1_epi16(0x1f)), _mm_setzero_si128()),
+                    _mm_cmpeq_epi16(_mm_adds_epu16(data, _mm_set1_epi16(1)), _mm_set1_epi32(-1)));
+        ((stop = _mm_or_si128(stop, _mm_cmpeq_epi16(data, _mm_set1_epi16(Delimiters)))), ...);
+        return stop;
+    }
+#endif
+#ifdef QTEXTSCAN_AVX2
+    QT_FUNCTION_TARGET(AVX2) static __m256i stops(__m256i data)
+    {
+        __m256i stop = _mm256_or_si256(
+                    _mm256_cmpeq_epi16(_mm256_subs_epu16(data, _mm256_set1_epi16(0x1f)),
+                                       _mm256_setzero_si256()),
+                    _mm256_cmpeq_epi16(_mm256_adds_epu16(data, _mm256_set1_epi16(1)),
+                                       _mm256_set1_epi32(-1)));
+        ((stop = _mm256_or_si256(stop, _mm256_cmpeq_epi16(data, _mm256_set1_epi16(Delimiters)))), ...);
+        return stop;
+    }
+#endif
+};
+
+struct NonBlankStops
+{
+    static bool stopsAt(char16_t c) { return c != ' ' && c != '\t'; }
+#ifdef __SSE2__
+    static __m128i stops(__m128i data)
+    {
+        const __m128i blank = _mm_or_si128(_mm_cmpeq_epi16(data, _mm_set1_epi16(' ')),
+                                           _mm_cmpeq_epi16(data, _mm_set1_epi16('\t')));
+        return _mm_xor_si128(blank, _mm_set1_epi32(-1));
+    }
+#endif
+#ifdef QTEXTSCAN_AVX2
+    QT_FUNCTION_TARGET(AVX2) static __m256i stops(__m256i data)
+    {
+        const __m256i blank = _mm256_or_si256(_mm256_cmpeq_epi16(data, _mm256_set1_epi16(' ')),
+                                              _mm256_cmpeq_epi16(data, _mm256_set1_epi16('\t')));
+        return _mm256_xor_si256(blank, _mm256_set1_epi32(-1));
+    }
+#endif
+};
+} // unnamed namespace
+
+template <char16_t... Delimiters>
+static const char16_t *skipPlainChars(const char16_t *ptr, const char16_t *end) noexcept
+{
+    return QtPrivate::scanUntil<NonPlainStops<Delimiters...>>(ptr, end);
+}
+
+// Returns the first character in [ptr, end) that is neither a space nor a tab, or end.
+static const char16_t *skipSpacesAndTabs(const char16_t *ptr, const char16_t *end) noexcept
+{
+    return QtPrivate::scanUntil<NonBlankStops>(ptr, end);
+}
+
+/*!
+  \internal
+
+  Appends the characters at the current read position up to the one returned
+  by \a skip to the text buffer and consumes them. Returns the number of
+  characters appended.
+
+  Only the decoded read buffer is scanned: characters that were put back
+  are handled one by one by the callers.
+ */
+int QXmlStreamReaderPrivate::fastScanRun(const char16_t *(*skip)(const char16_t *, const char16_t *))
+{
+    if (putStack.size() || readBufferPos >= readBuffer.size())
+        return 0;
+    const char16_t *data = reinterpret_cast<const char16_t *>(readBuffer.constData());
+    const char16_t *begin = data + readBufferPos;
+    const qsizetype n = skip(begin, data + readBuffer.size()) - begin;
+    textBuffer.append(reinterpret_cast<const QChar *>(begin), n);
+    readBufferPos += n;
+    return int(n);
+}
+
 /*!
   \internal
 
@@ -965,12 +1080,35 @@ inline uint QXmlStreamReaderPrivate::peekChar()
   If \a tokenToInject is not less than zero, injectToken() is called with
   \a tokenToInject when \a str is found.
 
+  If the input runs out before \a str is found, the characters scanned so far
+  are kept in the text buffer and false is returned. The rule calling this
+  function is resumed once more data is available, and scanning continues
+  where it stopped, so that long comments, CDATA sections and processing
+  instructions arriving in many pieces are scanned only once.
+
   If any error occurred, false is returned, otherwise true.
   */
 bool QXmlStreamReaderPrivate::scanUntil(const char *str, short tokenToInject)
 {
-    int pos = textBuffer.size();
-    int oldLineNumber = lineNumber;
+    if (scanUntilStart < 0) {
+        scanUntilStart = textBuffer.size();
+        scanUntilLineNumber = lineNumber;
+    }
+    const QLatin1String terminator(str);
+
+    // characters that cannot start the terminator are taken in runs
+    const char16_t *(*skip)(const char16_t *, const char16_t *) = nullptr;
+    switch (*str) {
+    case '-':
+        skip = skipPlainChars<u'-'>;
+        break;
+    case '?':
+        skip = skipPlainChars<u'?'>;
+        break;
+    case ']':
+        skip = skipPlainChars<u']'>;
+        break;
+    }
 
     uint c;
     while ((c = getChar()) != StreamEOF) {
@@ -990,28 +1128,28 @@ bool QXmlStreamReaderPrivate::scanUntil(const char *str, short tokenToInject)
         default:
             if (c < 0x20 || (c > 0xFFFD && c < 0x10000) || c > QChar::LastValidCodePoint ) {
                 raiseWellFormedError(QXmlStream::tr("Invalid XML character."));
-                lineNumber = oldLineNumber;
+                lineNumber = scanUntilLineNumber;
+                scanUntilStart = -1;
                 return false;
             }
             textBuffer += QChar(c);
         }
 
 
-        /* Second, attempt to lookup str. */
-        if (c == uint(*str)) {
-            if (!*(str + 1)) {
-                if (tokenToInject >= 0)
-                    injectToken(tokenToInject);
-                return true;
-            } else {
-                if (scanString(str + 1, tokenToInject, false))
-                    return true;
-            }
+        /* Second, check whether this completes str. */
+        if (c >= 0x80 || !memchr(str, int(c), terminator.size())) {
+            if (skip)
+                fastScanRun(skip);
+            continue;
+        }
+        if (textBuffer.size() - scanUntilStart >= terminator.size()
+            && QStringView(textBuffer).endsWith(terminator)) {
+            scanUntilStart = -1;
+            if (tokenToInject >= 0)
+                injectToken(tokenToInject);
+            return true;
         }
     }
-    putString(textBuffer, pos);
-    textBuffer.resize(pos);
-    lineNumber = oldLineNumber;
     return false;
 }
 
@@ -1190,6 +1328,7 @@ inline int QXmlStreamReaderPrivate::fastScanLiteralContent()
             }
             textBuffer += QChar(ushort(c));
             ++n;
+            n += fastScanRun(skipPlainChars<u'&', u'<', u'"', u'\''>);
         }
     }
     return n;
@@ -1213,6 +1352,7 @@ inline int QXmlStreamReaderPrivate::fastScanSpace()
         case '\t':
             textBuffer += QChar(c);
             ++n;
+            n += fastScanRun(skipSpacesAndTabs);
             break;
         default:
             putChar(c);
@@ -1287,6 +1427,7 @@ inline int QXmlStreamReaderPrivate::fastScanContentCharList()
             isWhitespace = false;
             textBuffer += QChar(ushort(c));
             ++n;
+            n += fastScanRun(skipPlainChars<u'&', u'<', u']'>);
         }
     }
     return n;
@@ -1491,12 +1632,22 @@ uint QXmlStreamReaderPrivate::getChar_helper()
         qint64 nbytesreadOrMinus1 = device->read(rawReadBuffer.data() + nbytesread, BUFFER_SIZE - nbytesread);
         nbytesread += qMax(nbytesreadOrMinus1, qint64{0});
     } else {
-        if (nbytesread)
-            rawReadBuffer += dataBuffer;
-        else
+        // Decode in-memory data in chunks as well, instead of converting all
+        // of it up front: this keeps the decoded text small and in cache.
+        const qsizetype available = dataBuffer.size() - dataBufferPos;
+        const qsizetype chunk = qMin(available, qsizetype(BUFFER_SIZE));
+        if (!nbytesread && chunk == dataBuffer.size()) {
             rawReadBuffer = dataBuffer;
+        } else {
+            rawReadBuffer.resize(nbytesread);
+            rawReadBuffer.append(dataBuffer.constData() + dataBufferPos, chunk);
+        }
         nbytesread = rawReadBuffer.size();
-        dataBuffer.clear();
+        dataBufferPos += chunk;
+        if (dataBufferPos == dataBuffer.size()) {
+            dataBuffer.clear();
+            dataBufferPos = 0;
+        }
     }
     if (!nbytesread) {
         atEnd = true;
@@ -243,6 +243,7 @@ public:
 
     QByteArray rawReadBuffer;
     QByteArray dataBuffer;
+    qsizetype dataBufferPos;
     uchar firstByte;
     qint64 nbytesread;
     QString readBuffer;
@@ -312,6 +313,10 @@ public:
 
     qint64 lineNumber, lastLineStart, characterOffset;
 
+    // where an interrupted scanUntil() resumes, or -1
+    qsizetype scanUntilStart;
+    qint64 scanUntilLineNumber;
+
 
     void write(const QString &);
     void write(const char *);
@@ -505,6 +510,7 @@ public:
     int fastScanContentCharList();
     int fastScanName(int *prefix = nullptr);
     inline int fastScanNMTOKEN();
+    int fastScanRun(const char16_t *(*skip)(const char16_t *, const char16_t *));
 
 
     bool parse();
@@ -2451,6 +2451,22 @@ qsizetype QtPrivate::findByteArray(QByteArrayView haystack, qsizetype from, QByt
     return qFindByteArray(haystack.data(), haystack.size(), from, needle.data(), ol);
 }
 
+/*!
+    \internal
+
+    Like findByteArray(haystack, from, needle), but case-insensitive if \a cs
+    is Qt::CaseInsensitive. Bytes are compared as Latin-1 characters, like
+    qstrnicmp() does.
+*/
+qsizetype QtPrivate::findByteArray(QByteArrayView haystack, qsizetype from, QByteArrayView needle,
+                                   Qt::CaseSensitivity cs) noexcept
+{
+    if (cs == Qt::CaseSensitive)
+        return findByteArray(haystack, from, needle);
+    return findString(QLatin1String(haystack.data(), haystack.size()), from,
+                      QLatin1String(needle.data(), needle.size()), cs);
+}
+
 /*! \fn qsizetype QByteArray::indexOf(QByteArrayView bv, qsizetype from) const
     \since 6.0
 
@@ -64,6 +64,10 @@ bool endsWith(QByteArrayView haystack, QByteArrayView needle) noexcept;
 [[nodiscard]] Q_CORE_EXPORT Q_DECL_PURE_FUNCTION
 qsizetype findByteArray(QByteArrayView haystack, qsizetype from, QByteArrayView needle) noexcept;
 
+[[nodiscard]] Q_CORE_EXPORT Q_DECL_PURE_FUNCTION
+qsizetype findByteArray(QByteArrayView haystack, qsizetype from, QByteArrayView needle,
+                        Qt::CaseSensitivity cs) noexcept;
+
 [[nodiscard]] Q_CORE_EXPORT Q_DECL_PURE_FUNCTION
 qsizetype lastIndexOf(QByteArrayView haystack, qsizetype from, QByteArrayView needle) noexcept;
 
@@ -75,6 +75,10 @@ QT_BEGIN_NAMESPACE
 
 QT_CLOCALE_HOLDER
 
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L && !defined(QT_BOOTSTRAPPED)
+#  define QT_USE_STD_FP_CHARCONV
+#endif
+
 void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, char *buf, int bufSize,
                       bool &sign, int &length, int &decpt)
 {
@@ -320,6 +324,28 @@ double qt_asciiToDouble(const char *num, qsizetype numLen, bool &ok, int &proces
     }
 
     double d = 0.0;
+#ifdef QT_USE_STD_FP_CHARCONV
+    // Fast path for the common case of a plain decimal number, without leading
+    // '+' or whitespace. std::from_chars() does not allocate and needs no
+    // terminator. Anything it doesn't fully accept (including overflow and
+    // underflow) is left to the general code below, which has the established
+    // semantics for those.
+    const auto isAsciiDigit = [](char c) { return c >= '0' && c <= '9'; };
+    const char *start = num;
+    if (*start == '-' && numLen > 1)
+        ++start;
+    if (int(numLen) == numLen && (isAsciiDigit(*start) || *start == '.')) {
+        const auto res = std::from_chars(num, num + numLen, d, std::chars_format::general);
+        if (res.ec == std::errc{}
+            && (res.ptr == num + numLen || strayCharMode == TrailingJunkAllowed)
+            && !isZero(d)) {
+            processed = int(res.ptr - num);
+            return d;
+        }
+        d = 0.0;
+    }
+#endif
+
 #if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED)
     int conv_flags = double_conversion::StringToDoubleConverter::NO_FLAGS;
     if (strayCharMode == TrailingJunkAllowed) {
@@ -549,6 +575,24 @@ static Q_ALWAYS_INLINE void qulltoString_helper(qulonglong number, int base, Cha
     }
 }
 
+// Writes the digits (and sign) backwards, ending just before \a end, and
+// returns a pointer to the first character written. The caller must provide
+// room for at least QtPrivate::MaxBasicLatinIntegerLength characters.
+char16_t *qulltoBasicLatin(qulonglong number, int base, bool negative, char16_t *end)
+{
+    static_assert(CHAR_BIT * sizeof(number) + 1 <= QtPrivate::MaxBasicLatinIntegerLength);
+    char16_t *p = end;
+    if (number == 0) {
+        *--p = u'0';
+        return p;
+    }
+
+    qulltoString_helper<char16_t>(number, base, p);
+    if (negative)
+        *--p = u'-';
+    return p;
+}
+
 // This is technically "qulonglong to ascii", but that name's taken
 QString qulltoBasicLatin(qulonglong number, int base, bool negative)
 {
@@ -556,16 +600,11 @@ QString qulltoBasicLatin(qulonglong number, int base, bool negative)
         return QStringLiteral("0");
     // Length of MIN_LLONG with the sign in front is 65; we never need surrogate pairs.
     // We do not need a terminator.
-    const unsigned maxlen = 65;
-    static_assert(CHAR_BIT * sizeof(number) + 1 <= maxlen);
-    char16_t buff[maxlen];
-    char16_t *const end = buff + maxlen, *p = end;
+    char16_t buff[QtPrivate::MaxBasicLatinIntegerLength];
+    char16_t *const end = buff + QtPrivate::MaxBasicLatinIntegerLength;
+    const char16_t *p = qulltoBasicLatin(number, base, negative, end);
 
-    qulltoString_helper<char16_t>(number, base, p);
-    if (negative)
-        *--p = u'-';
-
-    return QString(reinterpret_cast<QChar *>(p), end - p);
+    return QString(reinterpret_cast<const QChar *>(p), end - p);
 }
 
 QString qulltoa(qulonglong number, int base, const QStringView zero)
@@ -68,6 +68,12 @@ enum StrayCharacterMode {
 void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, char *buf, int bufSize,
                       bool &sign, int &length, int &decpt);
 
+namespace QtPrivate {
+// Length of MIN_LLONG in base 2, with the sign in front; no surrogates, no terminator
+constexpr qsizetype MaxBasicLatinIntegerLength = 65;
+}
+
+[[nodiscard]] char16_t *qulltoBasicLatin(qulonglong l, int base, bool negative, char16_t *end);
 [[nodiscard]] QString qulltoBasicLatin(qulonglong l, int base, bool negative);
 [[nodiscard]] QString qulltoa(qulonglong l, int base, const QStringView zero);
 [[nodiscard]] Q_CORE_EXPORT QString qdtoa(qreal d, int *decpt, int *sign);
@@ -40,7 +40,9 @@
 ****************************************************************************/
 
 #include "qregularexpression.h"
+#include "qregularexpression_p.h"
 
+#include <QtCore/qcache.h>
 #include <QtCore/qcoreapplication.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qlist.h>
@@ -465,6 +467,21 @@ QT_BEGIN_NAMESPACE
     \c{QT_ENABLE_REGEXP_JIT} environment variable to a non-zero or zero value
     respectively.
 
+    \section1 Sharing of Compiled Patterns
+
+    Compiling a pattern (and optimizing it with the JIT) is much more expensive
+    than matching it against a short subject string. Since Qt 6.3,
+    QRegularExpression therefore keeps a process-wide, size-bounded cache of
+    the most recently compiled patterns, keyed by the pattern string and the
+    pattern options. QRegularExpression objects that are created independently
+    (for instance, in different functions or threads) from the same pattern and
+    options share the same compiled, read-only code instead of compiling it
+    again.
+
+    The cache holds up to 128 patterns by default. The limit can be changed by
+    setting the \c{QT_REGEXP_CACHE_SIZE} environment variable before the first
+    regular expression is compiled; a value of 0 disables the cache.
+
     \sa QRegularExpressionMatch, QRegularExpressionMatchIterator
 */
 
@@ -735,6 +752,21 @@ static int convertToPcreOptions(QRegularExpression::MatchOptions matchOptions)
     return options;
 }
 
+/*
+    A compiled (and possibly JIT-optimized) PCRE2 pattern. Once created, the
+    code is never modified, so it can be shared between QRegularExpression
+    objects, and therefore between threads.
+*/
+struct QPcreCompiledPattern : QSharedData
+{
+    Q_DISABLE_COPY_MOVE(QPcreCompiledPattern)
+
+    explicit QPcreCompiledPattern(pcre2_code_16 *code) noexcept : code(code) {}
+    ~QPcreCompiledPattern() { pcre2_code_free_16(code); }
+
+    pcre2_code_16 *const code;
+};
+
 struct QRegularExpressionPrivate : QSharedData
 {
     QRegularExpressionPrivate();
@@ -767,9 +799,11 @@ struct QRegularExpressionPrivate : QSharedData
     // (right after a detach happened).
     mutable QMutex mutex;
 
-    // The PCRE code pointer is reference-counted by the QRegularExpressionPrivate
-    // objects themselves; when the private is copied (i.e. a detach happened)
-    // it is set to nullptr
+    // The PCRE code is reference-counted by compiledCode, which may be shared
+    // with other QRegularExpressionPrivate objects through the pattern cache;
+    // compiledPattern is a shortcut to compiledCode->code. When the private
+    // is copied (i.e. a detach happened) both are reset.
+    QExplicitlySharedDataPointer<QPcreCompiledPattern> compiledCode;
     pcre2_code_16 *compiledPattern;
     int errorCode;
     qsizetype errorOffset;
@@ -824,6 +858,93 @@ struct QRegularExpressionMatchIteratorPrivate : QSharedData
     const QRegularExpression::MatchOptions matchOptions;
 };
 
+/*
+    Process-wide cache of compiled patterns, keyed by pattern and options. It
+    evicts the least recently used patterns once it holds more than maxCost()
+    entries.
+*/
+class QRegularExpressionPatternCache
+{
+public:
+    using CompiledPattern = QExplicitlySharedDataPointer<QPcreCompiledPattern>;
+
+    QRegularExpressionPatternCache();
+
+    CompiledPattern find(const QString &pattern, QRegularExpression::PatternOptions options);
+    void insert(const QString &pattern, QRegularExpression::PatternOptions options,
+                const CompiledPattern &code);
+    void clear();
+
+    qsizetype hits = 0;
+    qsizetype misses = 0;
+    QMutex mutex;
+
+private:
+    struct Key
+    {
+        QString pattern;
+        QRegularExpression::PatternOptions options;
+
+        friend bool operator==(const Key &lhs, const Key &rhs) noexcept
+        { return lhs.options == rhs.options && lhs.pattern == rhs.pattern; }
+        friend size_t qHash(const Key &key, size_t seed = 0) noexcept
+        { return qHashMulti(seed, key.pattern, key.options.toInt()); }
+    };
+
+    QCache<Key, CompiledPattern> cache;
+};
+
+QRegularExpressionPatternCache::QRegularExpressionPatternCache()
+{
+    bool ok;
+    const int size = qEnvironmentVariableIntValue("QT_REGEXP_CACHE_SIZE", &ok);
+    cache.setMaxCost(ok && size >= 0 ? size : 128);
+}
+
+QRegularExpressionPatternCache::CompiledPattern
+QRegularExpressionPatternCache::find(const QString &pattern,
+                                     QRegularExpression::PatternOptions options)
+{
+    const QMutexLocker lock(&mutex);
+    if (const CompiledPattern *code = cache.object(Key{pattern, options})) {
+        ++hits;
+        return *code;
+    }
+    ++misses;
+    return {};
+}
+
+void QRegularExpressionPatternCache::insert(const QString &pattern,
+                                            QRegularExpression::PatternOptions options,
+                                            const CompiledPattern &code)
+{
+    const QMutexLocker lock(&mutex);
+    cache.insert(Key{pattern, options}, new CompiledPattern(code));
+}
+
+void QRegularExpressionPatternCache::clear()
+{
+    const QMutexLocker lock(&mutex);
+    cache.clear();
+    hits = 0;
+    misses = 0;
+}
+
+Q_GLOBAL_STATIC(QRegularExpressionPatternCache, patternCache)
+
+void qt_regularExpressionPatternCacheStatistics(qsizetype *hits, qsizetype *misses)
+{
+    QRegularExpressionPatternCache *cache = patternCache();
+    const QMutexLocker lock(&cache->mutex);
+    *hits = cache->hits;
+    *misses = cache->misses;
+}
+
+void qt_regularExpressionPatternCacheClear()
+{
+    patternCache()->clear();
+}
+
 /*!
     \internal
 */
@@ -840,6 +961,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate()
       patternOptions(),
       pattern(),
       mutex(),
+      compiledCode(),
       compiledPattern(nullptr),
       errorCode(0),
       errorOffset(-1),
@@ -871,6 +993,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
       patternOptions(other.patternOptions),
       pattern(other.pattern),
       mutex(),
+      compiledCode(),
       compiledPattern(nullptr),
       errorCode(0),
       errorOffset(-1),
@@ -885,7 +1008,7 @@ QRegularExpressionPrivate::QRegularExpressionPrivate(const QRegularExpressionPri
 */
 void QRegularExpressionPrivate::cleanCompiledPattern()
 {
-    pcre2_code_free_16(compiledPattern);
+    compiledCode.reset();
     compiledPattern = nullptr;
     errorCode = 0;
     errorOffset = -1;
@@ -906,6 +1029,15 @@ void QRegularExpressionPrivate::compilePattern()
     isDirty = false;
     cleanCompiledPattern();
 
+    QRegularExpressionPatternCache *cache = patternCache();
+    if (cache)
+        compiledCode = cache->find(pattern, patternOptions);
+    if (compiledCode) {
+        compiledPattern = compiledCode->code;
+        getPatternInfo();
+        return;
+    }
+
     int options = convertToPcreOptions(patternOptions);
     options |= PCRE2_UTF;
 
@@ -925,8 +1057,14 @@ void QRegularExpressionPrivate::compilePattern()
         errorCode = 0;
     }
 
+    compiledCode = new QPcreCompiledPattern(compiledPattern);
     optimizePattern();
     getPatternInfo();
+
+    // only publish the code once the JIT is done with it; from now on it is
+    // read-only
+    if (cache)
+        cache->insert(pattern, patternOptions, compiledCode);
 }
 
 /*!
@@ -7978,8 +7978,7 @@ static ArgEscapeData findArgEscapes(QStringView s)
 
     const QChar *c = uc_begin;
     while (c != uc_end) {
-        while (c != uc_end && c->unicode() != '%')
-            ++c;
+        c = reinterpret_cast<const QChar *>(QtPrivate::qustrchr(QStringView(c, uc_end), u'%'));
 
         if (c == uc_end)
             break;
@@ -8064,8 +8063,7 @@ static QString replaceArgEscapes(QStringView s, const ArgEscapeData &d, qsizetyp
            sequences remaining. */
 
         const QChar *text_start = c;
-        while (c->unicode() != '%')
-            ++c;
+        c = reinterpret_cast<const QChar *>(QtPrivate::qustrchr(QStringView(c, uc_end), u'%'));
 
         const QChar *escape_start = c++;
         const bool localize = c->unicode() == 'L';
@@ -8327,6 +8325,18 @@ QString QString::arg(qlonglong a, int fieldWidth, int base, QChar fillChar) cons
         return *this;
     }
 
+    if (d.locale_occurrences == 0 && fillChar != QLatin1Char('0') && base >= 2 && base <= 36) {
+        // C locale, no zero-padding: format on the stack, without going
+        // through QLocaleData and without allocating an intermediate string.
+        const bool negative = a < 0;
+        const qulonglong magnitude = negative ? 1u + qulonglong(-(a + 1)) : qulonglong(a);
+        char16_t buffer[QtPrivate::MaxBasicLatinIntegerLength];
+        char16_t *const end = buffer + QtPrivate::MaxBasicLatinIntegerLength;
+        const char16_t *begin = qulltoBasicLatin(magnitude, base, negative, end);
+        const QStringView arg(begin, end);
+        return replaceArgEscapes(*this, d, fieldWidth, arg, arg, fillChar);
+    }
+
     unsigned flags = QLocaleData::NoFlags;
     // ZeroPadded sorts out left-padding when the fill is zero, to the right of sign:
     if (fillChar == QLatin1Char('0'))
@@ -8375,6 +8385,15 @@ QString QString::arg(qulonglong a, int fieldWidth, int base, QChar fillChar) con
         return *this;
     }
 
+    if (d.locale_occurrences == 0 && fillChar != QLatin1Char('0') && base >= 2 && base <= 36) {
+        // See arg(qlonglong) above.
+        char16_t buffer[QtPrivate::MaxBasicLatinIntegerLength];
+        char16_t *const end = buffer + QtPrivate::MaxBasicLatinIntegerLength;
+        const char16_t *begin = qulltoBasicLatin(a, base, false, end);
+        const QStringView arg(begin, end);
+        return replaceArgEscapes(*this, d, fieldWidth, arg, arg, fillChar);
+    }
+
     unsigned flags = QLocaleData::NoFlags;
     // ZeroPadded sorts out left-padding when the fill is zero, to the right of sign:
     if (fillChar == QLatin1Char('0'))
@@ -143,14 +143,30 @@ QT_BEGIN_NAMESPACE
         use(e);
     \endcode
 
-    \sa QStringView::split(), QString::split(), QRegularExpression
+    \section1 Byte Arrays
+
+    Since Qt 6.3, QStringTokenizer can also split byte arrays. Pass a
+    QByteArrayView or QByteArray as the haystack, and a QByteArrayView
+    or \c char as the separator. The tokens are then QByteArrayViews
+    into the original data, so, unlike QByteArray::split(), no
+    QList and no per-token QByteArray is allocated:
+
+    \code
+    for (QByteArrayView line : qTokenize(QByteArrayView(log), '\n'))
+        use(line);
+    \endcode
+
+    Case-insensitive matching treats the bytes as Latin-1 characters.
+
+    \sa QStringView::split(), QString::split(), QByteArray::split(), QRegularExpression
 */
 
 /*!
     \typealias QStringTokenizer::value_type
 
-    Alias for \c{const QStringView} or \c{const QLatin1String},
-    depending on the tokenizer's \c Haystack template argument.
+    Alias for \c{const QStringView}, \c{const QLatin1String} or
+    \c{const QByteArrayView}, depending on the tokenizer's \c Haystack
+    template argument.
 */
 
 /*!
@@ -163,6 +163,7 @@ namespace QtPrivate {
 namespace Tok {
 
     constexpr qsizetype size(QChar) noexcept { return 1; }
+    constexpr qsizetype size(char) noexcept { return 1; }
     template <typename String>
     constexpr qsizetype size(const String &s) noexcept { return static_cast<qsizetype>(s.size()); }
 
@@ -170,6 +171,9 @@ namespace Tok {
     template <> struct ViewForImpl<QStringView>   { using type = QStringView; };
     template <> struct ViewForImpl<QLatin1String> { using type = QLatin1String; };
     template <> struct ViewForImpl<QChar>         { using type = QChar; };
+    template <> struct ViewForImpl<QByteArrayView> { using type = QByteArrayView; };
+    template <> struct ViewForImpl<char>          { using type = char; };
+    template <> struct ViewForImpl<QByteArray>  : ViewForImpl<QByteArrayView> {};
     template <> struct ViewForImpl<QString>     : ViewForImpl<QStringView> {};
     template <> struct ViewForImpl<QLatin1Char> : ViewForImpl<QChar> {};
     template <> struct ViewForImpl<char16_t>    : ViewForImpl<QChar> {};
@@ -185,7 +189,8 @@ namespace Tok {
 #endif
 
     // This metafunction maps a StringLike to a View (currently, QChar,
-    // QStringView, QLatin1String). This is what QStringTokenizerBase
+    // QStringView, QLatin1String, and char and QByteArrayView for byte
+    // arrays). This is what QStringTokenizerBase
     // operates on. QStringTokenizer adds pinning to keep rvalues alive
     // for the duration of the algorithm.
     template <typename String>
@@ -204,6 +209,10 @@ namespace Tok {
     template <>
     struct PinForImpl<QString> { using type = QString; };
 
+    // rvalue QByteArray -> QByteArray
+    template <>
+    struct PinForImpl<QByteArray> { using type = QByteArray; };
+
     // rvalue std::basic_string -> basic_string
     template <typename Char, typename...Args>
     struct PinForImpl<std::basic_string<Char, Args...>>
@@ -219,6 +228,7 @@ namespace Tok {
 
     template <typename T> struct is_owning_string_type : std::false_type {};
     template <> struct is_owning_string_type<QString> : std::true_type {};
+    template <> struct is_owning_string_type<QByteArray> : std::true_type {};
     template <typename...Args> struct is_owning_string_type<std::basic_string<Args...>> : std::true_type {};
 
     // unpinned
@@ -237,11 +247,11 @@ namespace Tok {
     struct Pinning<T, true>
     {
         T m_string;
-        // specialisation for owning string types (QString, std::u16string):
-        // stores the string:
+        // specialisation for owning string types (QString, QByteArray,
+        // std::u16string): stores the string:
         constexpr Pinning(T &&s) noexcept : m_string{std::move(s)} {}
         // ... and thus view() uses that instead of the argument passed in:
-        constexpr QStringView view(const T&) const noexcept { return m_string; }
+        constexpr ViewFor<T> view(const T&) const noexcept { return m_string; }
     };
 
     // NeedlePinning and HaystackPinning are there to distinguish them as
@@ -274,6 +284,23 @@ namespace Tok {
     //       : QStringTokenizerBase<QStringView, QStringView> (+ pinning)
     template <typename Haystack, typename Needle>
     using TokenizerBase = QStringTokenizerBase<ViewFor<Haystack>, ViewFor<Needle>>;
+
+    // Searching for the next separator. The string views all provide
+    // indexOf(needle, from, cs); byte array views don't take a
+    // Qt::CaseSensitivity, so they go through findByteArray() instead.
+    template <typename Haystack, typename Needle>
+    qsizetype indexOf(Haystack haystack, Needle needle, qsizetype from,
+                      Qt::CaseSensitivity cs) noexcept
+    { return haystack.indexOf(needle, from, cs); }
+    inline qsizetype indexOf(QByteArrayView haystack, QByteArrayView needle, qsizetype from,
+                             Qt::CaseSensitivity cs) noexcept
+    { return QtPrivate::findByteArray(haystack, from, needle, cs); }
+    inline qsizetype indexOf(QByteArrayView haystack, char needle, qsizetype from,
+                             Qt::CaseSensitivity cs) noexcept
+    {
+        return cs == Qt::CaseSensitive ? haystack.indexOf(needle, from)
+                                       : indexOf(haystack, QByteArrayView(&needle, 1), from, cs);
+    }
 } // namespace Tok
 } // namespace QtPrivate
 
@@ -430,7 +457,7 @@ auto QStringTokenizerBase<Haystack, Needle>::next(tokenizer_state state) const n
             // already at end:
             return {{}, false, state};
         }
-        state.end = m_haystack.indexOf(m_needle, state.start + state.extra, m_cs);
+        state.end = QtPrivate::Tok::indexOf(m_haystack, m_needle, state.start + state.extra, m_cs);
         Haystack result;
         if (state.end >= 0) {
             // token separator found => return intermediate element:
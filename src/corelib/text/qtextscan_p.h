@@ -0,0 +1,132 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QTEXTSCAN_P_H
+#define QTEXTSCAN_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/private/qglobal_p.h>
+#include <QtCore/private/qsimd_p.h>
+#include <QtCore/qalgorithms.h>
+
+QT_BEGIN_NAMESPACE
+
+#if !defined(QT_BOOTSTRAPPED) && defined(__SSE2__) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+#  define QTEXTSCAN_AVX2
+#endif
+
+namespace QtPrivate {
+
+/*
+    scanUntil() finds the first character in [ptr, end) selected by Stops, or
+    end, classifying the input a block at a time. Parsers and serializers use
+    it to skip over runs of characters that need no attention, such as plain
+    string content or insignificant whitespace.
+
+    Stops describes the characters to stop at, for characters of type Char
+    (one or two bytes wide):
+
+        struct Stops {
+            // true if c is to be stopped at
+            static bool stopsAt(Char c);
+        #ifdef __SSE2__
+            // all bits set in the elements to be stopped at, none in the others
+            static __m128i stops(__m128i data);
+        #endif
+        #ifdef QTEXTSCAN_AVX2
+            QT_FUNCTION_TARGET(AVX2) static __m256i stops(__m256i data);
+        #endif
+        };
+*/
+
+#ifdef QTEXTSCAN_AVX2
+template <typename Stops, typename Char>
+QT_FUNCTION_TARGET(AVX2)
+const Char *scanUntilAvx2(const Char *ptr, const Char *end) noexcept
+{
+    constexpr qsizetype Lanes = 32 / sizeof(Char);
+    for ( ; end - ptr >= Lanes; ptr += Lanes) {
+        const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+        if (const uint mask = uint(_mm256_movemask_epi8(Stops::stops(data))))
+            return ptr + qCountTrailingZeroBits(mask) / sizeof(Char);
+    }
+    return ptr;
+}
+#endif
+
+template <typename Stops, typename Char>
+const Char *scanUntil(const Char *ptr, const Char *end) noexcept
+{
+    static_assert(sizeof(Char) == 1 || sizeof(Char) == 2);
+#ifdef __SSE2__
+    constexpr qsizetype Lanes = 16 / sizeof(Char);
+    for (int block = 0; end - ptr >= Lanes; ++block, ptr += Lanes) {
+#  ifdef QTEXTSCAN_AVX2
+        // most runs are short; only switch to the wide loop for long ones
+        if (block == 2 && qCpuHasFeature(AVX2)) {
+            ptr = scanUntilAvx2<Stops>(ptr, end);
+            break;
+        }
+#  endif
+        const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+        if (const uint mask = uint(_mm_movemask_epi8(Stops::stops(data))))
+            return ptr + qCountTrailingZeroBits(mask) / sizeof(Char);
+    }
+#endif
+    while (ptr < end && !Stops::stopsAt(*ptr))
+        ++ptr;
+    return ptr;
+}
+
+} // namespace QtPrivate
+
+QT_END_NAMESPACE
+
+#endif // QTEXTSCAN_P_H
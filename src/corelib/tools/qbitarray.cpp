@@ -43,10 +43,149 @@
 #include <qdatastream.h>
 #include <qdebug.h>
 #include <qendian.h>
+#include <private/qsimd_p.h>
 #include <string.h>
 
 QT_BEGIN_NAMESPACE
 
+// The helpers below work on the bytes following the header byte; bit i is
+// bit (i % 8) of byte (i / 8), so loading bytes in little-endian order gives
+// words in which bit i of the array is bit (i % 64) of word (i / 64).
+namespace {
+
+// Loads the 64 bits starting at byte \a offset, reading the bytes at or
+// past \a size as zero.
+inline quint64 loadBits(const uchar *bits, qsizetype size, qsizetype offset) noexcept
+{
+    if (offset + 8 <= size)
+        return qFromLittleEndian<quint64>(bits + offset);
+    quint64 v = 0;
+    for (qsizetype i = size - 1; i >= offset; --i)
+        v = v << 8 | bits[i];
+    return v;
+}
+
+struct AndOp
+{
+    template <typename T> T operator()(T a, T b) const noexcept { return T(a & b); }
+#ifdef __SSE2__
+    __m128i operator()(__m128i a, __m128i b) const noexcept { return _mm_and_si128(a, b); }
+#endif
+};
+
+struct OrOp
+{
+    template <typename T> T operator()(T a, T b) const noexcept { return T(a | b); }
+#ifdef __SSE2__
+    __m128i operator()(__m128i a, __m128i b) const noexcept { return _mm_or_si128(a, b); }
+#endif
+};
+
+struct XorOp
+{
+    template <typename T> T operator()(T a, T b) const noexcept { return T(a ^ b); }
+#ifdef __SSE2__
+    __m128i operator()(__m128i a, __m128i b) const noexcept { return _mm_xor_si128(a, b); }
+#endif
+};
+
+struct NotOp
+{
+    template <typename T> T operator()(T, T b) const noexcept { return T(~b); }
+#ifdef __SSE2__
+    __m128i operator()(__m128i, __m128i b) const noexcept
+    { return _mm_xor_si128(b, _mm_set1_epi32(-1)); }
+#endif
+};
+
+// dst[i] = op(dst[i], src[i]) for the first n bytes
+template <typename Op>
+void bitwiseOperation(uchar *dst, const uchar *src, qsizetype n, Op op) noexcept
+{
+    qsizetype i = 0;
+#ifdef __SSE2__
+    for ( ; i + 32 <= n; i += 32) {
+        auto d = reinterpret_cast<__m128i *>(dst + i);
+        auto s = reinterpret_cast<const __m128i *>(src + i);
+        const __m128i r0 = op(_mm_loadu_si128(d), _mm_loadu_si128(s));
+        const __m128i r1 = op(_mm_loadu_si128(d + 1), _mm_loadu_si128(s + 1));
+        _mm_storeu_si128(d, r0);
+        _mm_storeu_si128(d + 1, r1);
+    }
+#endif
+    for ( ; i + 8 <= n; i += 8)
+        qToUnaligned(op(qFromUnaligned<quint64>(dst + i), qFromUnaligned<quint64>(src + i)), dst + i);
+    for ( ; i < n; ++i)
+        dst[i] = op(dst[i], src[i]);
+}
+
+#if !defined(QT_BOOTSTRAPPED) && defined(Q_PROCESSOR_X86_64) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+// Counts the bits in the first n & ~31 bytes, using a nibble lookup table.
+QT_FUNCTION_TARGET(AVX2)
+qsizetype populationCountAvx2(const uchar *bits, qsizetype n) noexcept
+{
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowNibbles = _mm256_set1_epi8(0x0f);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i total = zero;
+    qsizetype i = 0;
+    while (i + 32 <= n) {
+        // each step adds at most 8 to a byte counter, so flush every 31 steps
+        __m256i counters = zero;
+        for (int step = 0; step < 31 && i + 32 <= n; ++step, i += 32) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bits + i));
+            const __m256i lo = _mm256_and_si256(v, lowNibbles);
+            const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowNibbles);
+            counters = _mm256_add_epi8(counters, _mm256_shuffle_epi8(lookup, lo));
+            counters = _mm256_add_epi8(counters, _mm256_shuffle_epi8(lookup, hi));
+        }
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(counters, zero));
+    }
+    const __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(total),
+                                      _mm256_extracti128_si256(total, 1));
+    return qsizetype(_mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1));
+}
+#endif
+
+#if !defined(QT_BOOTSTRAPPED) && defined(Q_PROCESSOR_X86_64) && QT_COMPILER_SUPPORTS_HERE(POPCNT)
+QT_FUNCTION_TARGET(POPCNT)
+qsizetype populationCountPopcnt(const uchar *bits, qsizetype n) noexcept
+{
+    qsizetype count = 0;
+    qsizetype i = 0;
+    for ( ; i + 8 <= n; i += 8)
+        count += qsizetype(_mm_popcnt_u64(qFromUnaligned<quint64>(bits + i)));
+    for ( ; i < n; ++i)
+        count += qsizetype(_mm_popcnt_u32(bits[i]));
+    return count;
+}
+#endif
+
+qsizetype populationCount(const uchar *bits, qsizetype n) noexcept
+{
+    qsizetype count = 0;
+#if !defined(QT_BOOTSTRAPPED) && defined(Q_PROCESSOR_X86_64) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (n >= 64 && qCpuHasFeature(AVX2)) {
+        count = populationCountAvx2(bits, n);
+        bits += n & ~qsizetype(31);
+        n &= 31;
+    }
+#endif
+#if !defined(QT_BOOTSTRAPPED) && defined(Q_PROCESSOR_X86_64) && QT_COMPILER_SUPPORTS_HERE(POPCNT)
+    if (qCpuHasFeature(POPCNT))
+        return count + populationCountPopcnt(bits, n);
+#endif
+    qsizetype i = 0;
+    for ( ; i + 8 <= n; i += 8)
+        count += qsizetype(qPopulationCount(qFromUnaligned<quint64>(bits + i)));
+    for ( ; i < n; ++i)
+        count += qsizetype(qPopulationCount(bits[i]));
+    return count;
+}
+
+} // unnamed namespace
+
 /*!
     \class QBitArray
     \inmodule QtCore
@@ -177,31 +316,10 @@ QBitArray::QBitArray(qsizetype size, bool value)
 */
 qsizetype QBitArray::count(bool on) const
 {
-    qsizetype numBits = 0;
-    const quint8 *bits = reinterpret_cast<const quint8 *>(d.data()) + 1;
-
-    // the loops below will try to read from *end
-    // it's the QByteArray implicit NUL, so it will not change the bit count
-    const quint8 *const end = reinterpret_cast<const quint8 *>(d.end());
-
-    while (bits + 7 <= end) {
-        quint64 v = qFromUnaligned<quint64>(bits);
-        bits += 8;
-        numBits += qsizetype(qPopulationCount(v));
-    }
-    if (bits + 3 <= end) {
-        quint32 v = qFromUnaligned<quint32>(bits);
-        bits += 4;
-        numBits += qsizetype(qPopulationCount(v));
-    }
-    if (bits + 1 < end) {
-        quint16 v = qFromUnaligned<quint16>(bits);
-        bits += 2;
-        numBits += qsizetype(qPopulationCount(v));
-    }
-    if (bits < end)
-        numBits += qsizetype(qPopulationCount(bits[0]));
-
+    if (isEmpty())
+        return 0;
+    const qsizetype numBits = populationCount(reinterpret_cast<const uchar *>(d.constData()) + 1,
+                                              d.size() - 1);
     return on ? numBits : size() - numBits;
 }
 
@@ -374,6 +492,96 @@ quint32 QBitArray::toUInt32(QSysInfo::Endian endianness, bool *ok) const noexcep
     return total;
 }
 
+/*!
+    \since 6.3
+
+    Returns the index position of the first bit that is equal to \a value,
+    searching forward from index position \a from. Returns -1 if no such
+    bit is found.
+
+    If \a from is negative, the search starts at index position
+    size() + \a from, or at 0 if that is negative.
+
+    Whole words are examined at a time, which makes this much faster than
+    calling testBit() in a loop when the array is sparse.
+
+    \sa lastIndexOf(), count()
+*/
+qsizetype QBitArray::indexOf(bool value, qsizetype from) const noexcept
+{
+    const qsizetype sz = size();
+    if (from < 0)
+        from = qMax(from + sz, qsizetype(0));
+    if (from >= sz)
+        return -1;
+
+    const uchar *bits = reinterpret_cast<const uchar *>(d.constData()) + 1;
+    const qsizetype nbytes = d.size() - 1;
+    // look for set bits in words that are flipped if searching for zeroes;
+    // flipped padding bits end up past size() and are rejected below
+    const quint64 flip = value ? 0 : ~Q_UINT64_C(0);
+    qsizetype offset = from >> 3;
+    quint64 word = (loadBits(bits, nbytes, offset) ^ flip) & (~Q_UINT64_C(0) << (from & 7));
+    while (!word) {
+        offset += 8;
+        if (offset >= nbytes)
+            return -1;
+#ifdef __SSE2__
+        // skip 16 bytes that all differ from the value being searched for
+        const __m128i skip = _mm_set1_epi8(char(flip));
+        while (offset + 16 <= nbytes) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bits + offset));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, skip)) != 0xffff)
+                break;
+            offset += 16;
+        }
+#endif
+        word = loadBits(bits, nbytes, offset) ^ flip;
+    }
+    const qsizetype result = offset * 8 + qCountTrailingZeroBits(word);
+    return result < sz ? result : -1;
+}
+
+/*!
+    \since 6.3
+
+    Returns the index position of the last bit that is equal to \a value,
+    searching backward from index position \a from. Returns -1 if no such
+    bit is found.
+
+    If \a from is negative (the default), the search starts at index
+    position size() + \a from; if \a from is size() or greater, the search
+    starts at the last bit.
+
+    \sa indexOf()
+*/
+qsizetype QBitArray::lastIndexOf(bool value, qsizetype from) const noexcept
+{
+    const qsizetype sz = size();
+    if (from < 0)
+        from += sz;
+    else if (from >= sz)
+        from = sz - 1;
+    if (from < 0)
+        return -1;
+
+    const uchar *bits = reinterpret_cast<const uchar *>(d.constData()) + 1;
+    const qsizetype nbytes = d.size() - 1;
+    const quint64 flip = value ? 0 : ~Q_UINT64_C(0);
+    while (from >= 0) {
+        // the word ending with the byte that contains bit from
+        const qsizetype offset = qMax((from >> 3) - 7, qsizetype(0));
+        quint64 word = loadBits(bits, nbytes, offset) ^ flip;
+        const qsizetype usedBits = from - offset * 8 + 1;
+        if (usedBits < 64)
+            word &= (Q_UINT64_C(1) << usedBits) - 1;
+        if (word)
+            return offset * 8 + 63 - qCountLeadingZeroBits(word);
+        from = offset * 8 - 1;
+    }
+    return -1;
+}
+
 /*! \fn bool QBitArray::isDetached() const
 
     \internal
@@ -555,14 +763,13 @@ quint32 QBitArray::toUInt32(QSysInfo::Endian endianness, bool *ok) const noexcep
 QBitArray &QBitArray::operator&=(const QBitArray &other)
 {
     resize(qMax(size(), other.size()));
+    if (isEmpty())
+        return *this;
     uchar *a1 = reinterpret_cast<uchar *>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar *>(other.d.constData()) + 1;
-    qsizetype n = other.d.size() - 1;
-    qsizetype p = d.size() - 1 - n;
-    while (n-- > 0)
-        *a1++ &= *a2++;
-    while (p-- > 0)
-        *a1++ = 0;
+    const qsizetype n = qMax(other.d.size() - 1, qsizetype(0));
+    bitwiseOperation(a1, a2, n, AndOp());
+    memset(a1 + n, 0, d.size() - 1 - n);
     return *this;
 }
 
@@ -584,11 +791,11 @@ QBitArray &QBitArray::operator&=(const QBitArray &other)
 QBitArray &QBitArray::operator|=(const QBitArray &other)
 {
     resize(qMax(size(), other.size()));
+    if (other.isEmpty())
+        return *this;
     uchar *a1 = reinterpret_cast<uchar *>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar *>(other.d.constData()) + 1;
-    qsizetype n = other.d.size() - 1;
-    while (n-- > 0)
-        *a1++ |= *a2++;
+    bitwiseOperation(a1, a2, other.d.size() - 1, OrOp());
     return *this;
 }
 
@@ -610,11 +817,11 @@ QBitArray &QBitArray::operator|=(const QBitArray &other)
 QBitArray &QBitArray::operator^=(const QBitArray &other)
 {
     resize(qMax(size(), other.size()));
+    if (other.isEmpty())
+        return *this;
     uchar *a1 = reinterpret_cast<uchar *>(d.data()) + 1;
     const uchar *a2 = reinterpret_cast<const uchar *>(other.d.constData()) + 1;
-    qsizetype n = other.d.size() - 1;
-    while (n-- > 0)
-        *a1++ ^= *a2++;
+    bitwiseOperation(a1, a2, other.d.size() - 1, XorOp());
     return *this;
 }
 
@@ -632,15 +839,15 @@ QBitArray QBitArray::operator~() const
 {
     qsizetype sz = size();
     QBitArray a(sz);
+    if (!sz)
+        return a;
     const uchar *a1 = reinterpret_cast<const uchar *>(d.constData()) + 1;
     uchar *a2 = reinterpret_cast<uchar *>(a.d.data()) + 1;
-    qsizetype n = d.size() - 1;
+    const qsizetype n = d.size() - 1;
+    bitwiseOperation(a2, a1, n, NotOp());
 
-    while (n-- > 0)
-        *a2++ = ~*a1++;
-
-    if (sz && sz % 8)
-        *(a2 - 1) &= (1 << (sz % 8)) - 1;
+    if (sz % 8)
+        a2[n - 1] &= (1 << (sz % 8)) - 1;
     return a;
 }
 
@@ -754,6 +961,168 @@ QBitArray operator^(const QBitArray &a1, const QBitArray &a2)
     Sets the value referenced by the QBitRef to \a v.
 */
 
+/*!
+    \class QBitArrayRankSelect
+    \inmodule QtCore
+    \since 6.3
+    \brief The QBitArrayRankSelect class answers rank and select queries on
+    a QBitArray.
+
+    \ingroup tools
+
+    Given a bit array, rank(\e i) returns the number of 1-bits before index
+    position \e i, and select(\e n) returns the index position of the
+    \e{n}-th 1-bit. Both can be used to map between positions in a bit set
+    and positions in a densely packed array that stores one element per
+    set bit.
+
+    The constructor takes a copy of the bit array (which is cheap, as
+    QBitArray is implicitly shared) and builds an index over it in linear
+    time. The index takes 128 bits for every 512 bits of the array.
+    rank() then takes constant time: it reads one count for the 512-bit
+    block and one for the 64-bit word in the block, and counts the bits in
+    a single word. select() searches the blocks between two sampled
+    positions, which is constant time for evenly distributed bits and
+    logarithmic in the worst case.
+
+    Modifying the original bit array afterwards does not affect the index.
+
+    \sa QBitArray::count(), QBitArray::indexOf()
+*/
+
+// Each block of RankBlockBits bits has two entries in m_counts: the number
+// of 1-bits before the block, and the number of 1-bits in the block before
+// each of its words 1 to 7, packed in 9 bits each. A final entry holds the
+// total. m_samples[k] is the block that contains the (k * SelectSampleRate)-th
+// 1-bit.
+static constexpr qsizetype RankBlockBits = 512;
+static constexpr qsizetype SelectSampleRate = 512;
+
+/*!
+    \fn QBitArrayRankSelect::QBitArrayRankSelect()
+
+    Constructs an index over an empty bit array.
+*/
+
+/*!
+    Constructs an index over the bit array \a bits.
+*/
+QBitArrayRankSelect::QBitArrayRankSelect(const QBitArray &bits)
+    : m_bits(bits)
+{
+    const uchar *data = reinterpret_cast<const uchar *>(m_bits.bits());
+    const qsizetype nbytes = (m_bits.size() + 7) / 8;
+    const qsizetype blocks = (m_bits.size() + RankBlockBits - 1) / RankBlockBits;
+    m_counts.resize(2 * (blocks + 1));
+    m_samples.reserve(m_bits.count(true) / SelectSampleRate + 1);
+
+    quint64 total = 0;
+    for (qsizetype block = 0; block < blocks; ++block) {
+        quint64 relative = 0;
+        quint64 inBlock = 0;
+        for (int word = 0; word < 8; ++word) {
+            if (word)
+                relative |= inBlock << (9 * (word - 1));
+            inBlock += qPopulationCount(loadBits(data, nbytes, (block * 8 + word) * 8));
+        }
+        while (quint64(m_samples.size() * SelectSampleRate) < total + inBlock)
+            m_samples.append(block);
+        m_counts[2 * block] = total;
+        m_counts[2 * block + 1] = relative;
+        total += inBlock;
+    }
+    m_counts[2 * blocks] = total;
+    m_count = qsizetype(total);
+}
+
+/*!
+    \fn QBitArray QBitArrayRankSelect::bitArray() const
+
+    Returns the bit array that this index was built for.
+*/
+
+/*!
+    \fn qsizetype QBitArrayRankSelect::size() const
+
+    Returns the number of bits in the indexed bit array.
+*/
+
+/*!
+    \fn qsizetype QBitArrayRankSelect::count() const
+
+    Returns the number of 1-bits in the indexed bit array.
+*/
+
+/*!
+    Returns the number of 1-bits at index positions before \a i.
+
+    \a i must be a valid index position or equal to size(), in which case
+    the result is count().
+
+    \sa select()
+*/
+qsizetype QBitArrayRankSelect::rank(qsizetype i) const noexcept
+{
+    Q_ASSERT(size_t(i) <= size_t(size()));
+    const qsizetype block = i / RankBlockBits;
+    const int word = int(i / 64) % 8;
+    quint64 result = m_counts.at(2 * block);
+    if (word)
+        result += (m_counts.at(2 * block + 1) >> (9 * (word - 1))) & 0x1ff;
+    if (const int usedBits = int(i % 64)) {
+        const quint64 v = loadBits(reinterpret_cast<const uchar *>(m_bits.bits()),
+                                   (size() + 7) / 8, (i / 64) * 8);
+        result += qPopulationCount(v & ((Q_UINT64_C(1) << usedBits) - 1));
+    }
+    return qsizetype(result);
+}
+
+/*!
+    Returns the index position of the 1-bit that has \a n 1-bits before it,
+    that is, the position \e p for which testBit(\e p) is true and
+    rank(\e p) is \a n. Returns -1 if \a n is negative or not less than
+    count().
+
+    \sa rank()
+*/
+qsizetype QBitArrayRankSelect::select(qsizetype n) const noexcept
+{
+    if (n < 0 || n >= m_count)
+        return -1;
+
+    // find the last block with fewer than n + 1 set bits before it
+    const qsizetype sample = n / SelectSampleRate;
+    qsizetype lo = m_samples.at(sample);
+    qsizetype hi = sample + 1 < m_samples.size() ? m_samples.at(sample + 1) + 1
+                                                 : m_counts.size() / 2 - 1;
+    while (hi - lo > 1) {
+        const qsizetype mid = lo + (hi - lo) / 2;
+        if (m_counts.at(2 * mid) <= quint64(n))
+            lo = mid;
+        else
+            hi = mid;
+    }
+
+    quint64 remaining = quint64(n) - m_counts.at(2 * lo);
+    const quint64 relative = m_counts.at(2 * lo + 1);
+    int word = 7;
+    quint64 before = 0;
+    for ( ; word > 0; --word) {
+        before = (relative >> (9 * (word - 1))) & 0x1ff;
+        if (before <= remaining)
+            break;
+    }
+    if (!word)
+        before = 0;
+    remaining -= before;
+
+    const qsizetype offset = (lo * 8 + word) * 8;
+    quint64 v = loadBits(reinterpret_cast<const uchar *>(m_bits.bits()), (size() + 7) / 8, offset);
+    for ( ; remaining; --remaining)
+        v &= v - 1;
+    return offset * 8 + qCountTrailingZeroBits(v);
+}
+
 /*****************************************************************************
   QBitArray stream functions
  *****************************************************************************/
@@ -41,6 +41,7 @@
 #define QBITARRAY_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -100,6 +101,9 @@ public:
 
     inline void truncate(qsizetype pos) { if (pos < size()) resize(pos); }
 
+    qsizetype indexOf(bool value, qsizetype from = 0) const noexcept;
+    qsizetype lastIndexOf(bool value, qsizetype from = -1) const noexcept;
+
     const char *bits() const { return isEmpty() ? nullptr : d.constData() + 1; }
     static QBitArray fromBits(const char *data, qsizetype len);
 
@@ -158,6 +162,26 @@ public:
 inline QBitRef QBitArray::operator[](qsizetype i)
 { Q_ASSERT(i >= 0); return QBitRef(*this, i); }
 
+class Q_CORE_EXPORT QBitArrayRankSelect
+{
+public:
+    QBitArrayRankSelect() = default;
+    explicit QBitArrayRankSelect(const QBitArray &bits);
+
+    QBitArray bitArray() const { return m_bits; }
+    qsizetype size() const noexcept { return m_bits.size(); }
+    qsizetype count() const noexcept { return m_count; }
+
+    qsizetype rank(qsizetype i) const noexcept;
+    qsizetype select(qsizetype n) const noexcept;
+
+private:
+    QBitArray m_bits;
+    QList<quint64> m_counts;
+    QList<qsizetype> m_samples;
+    qsizetype m_count = 0;
+};
+
 #ifndef QT_NO_DATASTREAM
 Q_CORE_EXPORT QDataStream &operator<<(QDataStream &, const QBitArray &);
 Q_CORE_EXPORT QDataStream &operator>>(QDataStream &, QBitArray &);
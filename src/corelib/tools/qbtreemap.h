@@ -0,0 +1,943 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QBTREEMAP_H
+#define QBTREEMAP_H
+
+#include <QtCore/qiterator.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qshareddata_impl.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+
+QT_BEGIN_NAMESPACE
+
+namespace QBTreeMapPrivate {
+
+// Nodes are sized to cover a few cache lines. Leaves store their keys and
+// values in separate arrays, so that searching a node only reads keys.
+constexpr size_t NodeBytes = 512;
+
+constexpr qsizetype capacityFor(size_t elementSize) noexcept
+{
+    return qBound(qsizetype(4), qsizetype(NodeBytes / elementSize), qsizetype(64));
+}
+
+// Uninitialized storage for up to N objects of type T; the owner keeps track
+// of how many of them are constructed.
+template <typename T, qsizetype N>
+struct Array
+{
+    alignas(T) unsigned char storage[sizeof(T) * N];
+
+    T *data() noexcept { return std::launder(reinterpret_cast<T *>(storage)); }
+    const T *data() const noexcept { return std::launder(reinterpret_cast<const T *>(storage)); }
+    T &operator[](qsizetype i) noexcept { return data()[i]; }
+    const T &operator[](qsizetype i) const noexcept { return data()[i]; }
+
+    // inserts value at position i of the first count objects
+    template <typename U>
+    void insert(qsizetype count, qsizetype i, U &&value)
+    {
+        Q_ASSERT(count < N);
+        Q_ASSERT(i <= count);
+        T *b = data();
+        if (i == count) {
+            new (b + count) T(std::forward<U>(value));
+        } else {
+            new (b + count) T(std::move(b[count - 1]));
+            std::move_backward(b + i, b + count - 1, b + count);
+            b[i] = std::forward<U>(value);
+        }
+    }
+    // removes the object at position i of the first count objects
+    void erase(qsizetype count, qsizetype i)
+    {
+        Q_ASSERT(i < count);
+        T *b = data();
+        std::move(b + i + 1, b + count, b + i);
+        b[count - 1].~T();
+    }
+    // moves the objects [from, to) to the end of other, which has otherCount objects
+    void moveTo(qsizetype from, qsizetype to, Array &other, qsizetype otherCount)
+    {
+        Q_ASSERT(otherCount + (to - from) <= N);
+        T *b = data();
+        std::uninitialized_move(b + from, b + to, other.data() + otherCount);
+        std::destroy(b + from, b + to);
+    }
+    void copyFrom(const Array &other, qsizetype count)
+    {
+        std::uninitialized_copy_n(other.data(), count, data());
+    }
+    void destroy(qsizetype count) noexcept
+    {
+        std::destroy_n(data(), count);
+    }
+};
+
+template <typename Key, typename T>
+struct Leaf
+{
+    static constexpr qsizetype Capacity = capacityFor(sizeof(Key) + sizeof(T));
+    static constexpr qsizetype MinCount = Capacity / 2;
+
+    qsizetype count = 0;
+    Leaf *prev = nullptr;
+    Leaf *next = nullptr;
+    Array<Key, Capacity> keys;
+    Array<T, Capacity> values;
+
+    Leaf() noexcept = default;
+    ~Leaf()
+    {
+        keys.destroy(count);
+        values.destroy(count);
+    }
+    Q_DISABLE_COPY_MOVE(Leaf)
+};
+
+// An inner node with count keys has count + 1 children. All keys in the
+// subtree of children[i] are not less than keys[i - 1], and less than keys[i].
+template <typename Key>
+struct Inner
+{
+    static constexpr qsizetype Capacity = capacityFor(sizeof(Key) + sizeof(void *));
+    static constexpr qsizetype MinCount = Capacity / 2;
+
+    qsizetype count = 0;
+    void *children[Capacity + 1];
+    Array<Key, Capacity> keys;
+
+    Inner() noexcept = default;
+    ~Inner() { keys.destroy(count); }
+    Q_DISABLE_COPY_MOVE(Inner)
+
+    void insertChild(qsizetype i, void *child) noexcept
+    {
+        // called after the key has been inserted, so count is already updated
+        std::move_backward(children + i, children + count, children + count + 1);
+        children[i] = child;
+    }
+    void eraseChild(qsizetype i) noexcept
+    {
+        // called before the key is removed
+        std::move(children + i + 1, children + count + 1, children + i);
+    }
+};
+
+template <typename Key, typename T>
+struct Data : public QSharedData
+{
+    using LeafNode = Leaf<Key, T>;
+    using InnerNode = Inner<Key>;
+
+    struct Position
+    {
+        LeafNode *leaf;
+        qsizetype index;
+    };
+
+    void *root = nullptr;
+    LeafNode *first = nullptr;
+    LeafNode *last = nullptr;
+    qsizetype size = 0;
+    int height = 0; // number of inner node levels
+
+    Data()
+    {
+        LeafNode *leaf = new LeafNode;
+        root = first = last = leaf;
+    }
+    Data(const Data &other)
+        : QSharedData(), size(other.size), height(other.height)
+    {
+        root = copyNode(other.root, height);
+    }
+    ~Data()
+    {
+        destroyNode(root, height);
+    }
+    Data &operator=(const Data &) = delete;
+
+    static bool lessThan(const Key &lhs, const Key &rhs)
+    {
+        return std::less<Key>()(lhs, rhs);
+    }
+
+    void *copyNode(const void *node, int level)
+    {
+        if (level == 0) {
+            const LeafNode *from = static_cast<const LeafNode *>(node);
+            LeafNode *leaf = new LeafNode;
+            leaf->keys.copyFrom(from->keys, from->count);
+            leaf->values.copyFrom(from->values, from->count);
+            leaf->count = from->count;
+            // leaves are copied in order, link them up
+            leaf->prev = last;
+            if (last)
+                last->next = leaf;
+            else
+                first = leaf;
+            last = leaf;
+            return leaf;
+        }
+        const InnerNode *from = static_cast<const InnerNode *>(node);
+        InnerNode *inner = new InnerNode;
+        inner->keys.copyFrom(from->keys, from->count);
+        inner->count = from->count;
+        for (qsizetype i = 0; i <= from->count; ++i)
+            inner->children[i] = copyNode(from->children[i], level - 1);
+        return inner;
+    }
+
+    static void destroyNode(void *node, int level)
+    {
+        if (level == 0) {
+            delete static_cast<LeafNode *>(node);
+            return;
+        }
+        InnerNode *inner = static_cast<InnerNode *>(node);
+        for (qsizetype i = 0; i <= inner->count; ++i)
+            destroyNode(inner->children[i], level - 1);
+        delete inner;
+    }
+
+    // Turns a position past the last element of a leaf into the position of
+    // the first element of the next one, if any.
+    static Position normalized(Position p) noexcept
+    {
+        if (p.index == p.leaf->count && p.leaf->next)
+            return { p.leaf->next, 0 };
+        return p;
+    }
+
+    struct PathEntry
+    {
+        InnerNode *node;
+        qsizetype index;
+    };
+    using Path = QVarLengthArray<PathEntry, 16>;
+
+    LeafNode *findLeaf(const Key &key, Path *path = nullptr) const
+    {
+        void *node = root;
+        for (int level = height; level > 0; --level) {
+            InnerNode *inner = static_cast<InnerNode *>(node);
+            const Key *keys = inner->keys.data();
+            const qsizetype i = std::upper_bound(keys, keys + inner->count, key, lessThan) - keys;
+            if (path)
+                path->append({ inner, i });
+            node = inner->children[i];
+        }
+        return static_cast<LeafNode *>(node);
+    }
+
+    Position lowerBound(const Key &key) const
+    {
+        LeafNode *leaf = findLeaf(key);
+        const Key *keys = leaf->keys.data();
+        const qsizetype i = std::lower_bound(keys, keys + leaf->count, key, lessThan) - keys;
+        return normalized({ leaf, i });
+    }
+
+    Position upperBound(const Key &key) const
+    {
+        LeafNode *leaf = findLeaf(key);
+        const Key *keys = leaf->keys.data();
+        const qsizetype i = std::upper_bound(keys, keys + leaf->count, key, lessThan) - keys;
+        return normalized({ leaf, i });
+    }
+
+    Position find(const Key &key) const
+    {
+        LeafNode *leaf = findLeaf(key);
+        const Key *keys = leaf->keys.data();
+        const qsizetype i = std::lower_bound(keys, keys + leaf->count, key, lessThan) - keys;
+        if (i < leaf->count && !lessThan(key, keys[i]))
+            return { leaf, i };
+        return end();
+    }
+
+    Position begin() const noexcept { return { first, 0 }; }
+    Position end() const noexcept { return { last, last->count }; }
+
+    // Returns the position of key, inserting a value constructed from args if
+    // the key is not in the map yet.
+    template <typename... Args>
+    Position tryEmplace(const Key &key, bool *inserted, Args &&... args)
+    {
+        Path path;
+        LeafNode *leaf = findLeaf(key, &path);
+        const Key *keys = leaf->keys.data();
+        qsizetype i = std::lower_bound(keys, keys + leaf->count, key, lessThan) - keys;
+        if (i < leaf->count && !lessThan(key, keys[i])) {
+            *inserted = false;
+            return { leaf, i };
+        }
+
+        // key and args may refer to elements of this map, which a split moves
+        // around, so copy them first
+        Key k(key);
+        T value(std::forward<Args>(args)...);
+
+        if (leaf->count == LeafNode::Capacity) {
+            // Split the full leaf. When appending, leave it as it is, so that
+            // filling a map in order doesn't leave half-empty nodes behind.
+            const bool appending = !leaf->next && i == leaf->count;
+            const qsizetype splitAt = appending ? leaf->count : leaf->count / 2;
+            LeafNode *right = new LeafNode;
+            leaf->keys.moveTo(splitAt, leaf->count, right->keys, 0);
+            leaf->values.moveTo(splitAt, leaf->count, right->values, 0);
+            right->count = leaf->count - splitAt;
+            leaf->count = splitAt;
+            right->prev = leaf;
+            right->next = leaf->next;
+            if (right->next)
+                right->next->prev = right;
+            else
+                last = right;
+            leaf->next = right;
+            insertIntoParent(path, leaf, appending ? k : right->keys[0], right, appending);
+            if (i >= splitAt && (appending || i > splitAt)) {
+                i -= splitAt;
+                leaf = right;
+            }
+        }
+
+        leaf->keys.insert(leaf->count, i, std::move(k));
+        leaf->values.insert(leaf->count, i, std::move(value));
+        ++leaf->count;
+        ++size;
+        *inserted = true;
+        return { leaf, i };
+    }
+
+    void insertIntoParent(Path &path, void *left, Key separator, void *right, bool appending)
+    {
+        while (!path.isEmpty()) {
+            auto [parent, i] = path.last();
+            path.removeLast();
+            if (parent->count < InnerNode::Capacity) {
+                parent->keys.insert(parent->count, i, std::move(separator));
+                ++parent->count;
+                parent->insertChild(i + 1, right);
+                return;
+            }
+
+            // Split the full parent: the keys before splitAt stay, the key at
+            // splitAt moves up a level and the ones after it move to sibling.
+            const qsizetype splitAt = appending ? parent->count - 1 : parent->count / 2;
+            InnerNode *sibling = new InnerNode;
+            parent->keys.moveTo(splitAt + 1, parent->count, sibling->keys, 0);
+            std::copy(parent->children + splitAt + 1, parent->children + parent->count + 1,
+                      sibling->children);
+            sibling->count = parent->count - splitAt - 1;
+            Key up = std::move(parent->keys[splitAt]);
+            parent->keys.erase(splitAt + 1, splitAt);
+            parent->count = splitAt;
+
+            if (i <= splitAt) {
+                parent->keys.insert(parent->count, i, std::move(separator));
+                ++parent->count;
+                parent->insertChild(i + 1, right);
+            } else {
+                i -= splitAt + 1;
+                sibling->keys.insert(sibling->count, i, std::move(separator));
+                ++sibling->count;
+                sibling->insertChild(i + 1, right);
+            }
+
+            left = parent;
+            separator = std::move(up);
+            right = sibling;
+        }
+
+        InnerNode *newRoot = new InnerNode;
+        newRoot->keys.insert(0, 0, std::move(separator));
+        newRoot->count = 1;
+        newRoot->children[0] = left;
+        newRoot->children[1] = right;
+        root = newRoot;
+        ++height;
+    }
+
+    bool erase(const Key &key)
+    {
+        Path path;
+        LeafNode *leaf = findLeaf(key, &path);
+        const Key *keys = leaf->keys.data();
+        const qsizetype i = std::lower_bound(keys, keys + leaf->count, key, lessThan) - keys;
+        if (i == leaf->count || lessThan(key, keys[i]))
+            return false;
+
+        leaf->keys.erase(leaf->count, i);
+        leaf->values.erase(leaf->count, i);
+        --leaf->count;
+        --size;
+        if (leaf->count < LeafNode::MinCount && !path.isEmpty())
+            rebalanceLeaf(leaf, path);
+        return true;
+    }
+
+    void unlink(LeafNode *leaf) noexcept
+    {
+        if (leaf->prev)
+            leaf->prev->next = leaf->next;
+        else
+            first = leaf->next;
+        if (leaf->next)
+            leaf->next->prev = leaf->prev;
+        else
+            last = leaf->prev;
+    }
+
+    // Refills a leaf that has fewer than MinCount elements, either by taking
+    // an element from a sibling or by merging it with one.
+    void rebalanceLeaf(LeafNode *leaf, Path &path)
+    {
+        auto [parent, i] = path.last();
+        path.removeLast();
+        LeafNode *left = i > 0 ? static_cast<LeafNode *>(parent->children[i - 1]) : nullptr;
+        LeafNode *right = i < parent->count ? static_cast<LeafNode *>(parent->children[i + 1]) : nullptr;
+
+        if (left && left->count > LeafNode::MinCount) {
+            const qsizetype from = left->count - 1;
+            leaf->keys.insert(leaf->count, 0, std::move(left->keys[from]));
+            leaf->values.insert(leaf->count, 0, std::move(left->values[from]));
+            ++leaf->count;
+            left->keys.erase(left->count, from);
+            left->values.erase(left->count, from);
+            --left->count;
+            parent->keys[i - 1] = leaf->keys[0];
+            return;
+        }
+        if (right && right->count > LeafNode::MinCount) {
+            leaf->keys.insert(leaf->count, leaf->count, std::move(right->keys[0]));
+            leaf->values.insert(leaf->count, leaf->count, std::move(right->values[0]));
+            ++leaf->count;
+            right->keys.erase(right->count, 0);
+            right->values.erase(right->count, 0);
+            --right->count;
+            parent->keys[i] = right->keys[0];
+            return;
+        }
+
+        // Neither sibling can spare an element, so merge with one of them.
+        // The merged node has fewer than 2 * MinCount <= Capacity elements.
+        if (!left) {
+            left = leaf;
+            leaf = right;
+            ++i;
+        }
+        leaf->keys.moveTo(0, leaf->count, left->keys, left->count);
+        leaf->values.moveTo(0, leaf->count, left->values, left->count);
+        left->count += leaf->count;
+        leaf->count = 0;
+        unlink(leaf);
+        delete leaf;
+        parent->eraseChild(i);
+        parent->keys.erase(parent->count, i - 1);
+        --parent->count;
+        rebalanceInner(parent, path);
+    }
+
+    void rebalanceInner(InnerNode *node, Path &path)
+    {
+        if (path.isEmpty()) {
+            if (node->count == 0) {
+                // the root has a single child left, which becomes the new root
+                root = node->children[0];
+                delete node;
+                --height;
+            }
+            return;
+        }
+        if (node->count >= InnerNode::MinCount)
+            return;
+
+        auto [parent, i] = path.last();
+        path.removeLast();
+        InnerNode *left = i > 0 ? static_cast<InnerNode *>(parent->children[i - 1]) : nullptr;
+        InnerNode *right = i < parent->count ? static_cast<InnerNode *>(parent->children[i + 1]) : nullptr;
+
+        if (left && left->count > InnerNode::MinCount) {
+            // rotate the last child of left through the parent
+            node->keys.insert(node->count, 0, std::move(parent->keys[i - 1]));
+            ++node->count;
+            node->insertChild(0, left->children[left->count]);
+            parent->keys[i - 1] = std::move(left->keys[left->count - 1]);
+            left->keys.erase(left->count, left->count - 1);
+            --left->count;
+            return;
+        }
+        if (right && right->count > InnerNode::MinCount) {
+            // rotate the first child of right through the parent
+            node->keys.insert(node->count, node->count, std::move(parent->keys[i]));
+            ++node->count;
+            node->children[node->count] = right->children[0];
+            parent->keys[i] = std::move(right->keys[0]);
+            right->eraseChild(0);
+            right->keys.erase(right->count, 0);
+            --right->count;
+            return;
+        }
+
+        if (!left) {
+            left = node;
+            node = right;
+            ++i;
+        }
+        left->keys.insert(left->count, left->count, std::move(parent->keys[i - 1]));
+        ++left->count;
+        node->keys.moveTo(0, node->count, left->keys, left->count);
+        std::copy(node->children, node->children + node->count + 1, left->children + left->count);
+        left->count += node->count;
+        node->count = 0;
+        delete node;
+        parent->eraseChild(i);
+        parent->keys.erase(parent->count, i - 1);
+        --parent->count;
+        rebalanceInner(parent, path);
+    }
+};
+
+} // namespace QBTreeMapPrivate
+
+template <typename Key, typename T>
+class QBTreeMap
+{
+    using MapData = QBTreeMapPrivate::Data<Key, T>;
+    using Position = typename MapData::Position;
+    using LeafNode = typename MapData::LeafNode;
+    QtPrivate::QExplicitlySharedDataPointerV2<MapData> d;
+
+    static_assert(std::is_nothrow_destructible_v<Key>, "Types with throwing destructors are not supported in Qt containers.");
+    static_assert(std::is_nothrow_destructible_v<T>, "Types with throwing destructors are not supported in Qt containers.");
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using difference_type = qptrdiff;
+    using size_type = qsizetype;
+
+    QBTreeMap() = default;
+
+    // implicitly generated special member functions are OK!
+
+    QBTreeMap(std::initializer_list<std::pair<Key, T>> list)
+    {
+        for (auto &p : list)
+            insert(p.first, p.second);
+    }
+
+    void swap(QBTreeMap<Key, T> &other) noexcept
+    {
+        qSwap(d, other.d);
+    }
+
+    friend bool operator==(const QBTreeMap &lhs, const QBTreeMap &rhs)
+    {
+        if (lhs.d == rhs.d)
+            return true;
+        if (lhs.size() != rhs.size())
+            return false;
+        for (auto l = lhs.begin(), r = rhs.begin(); l != lhs.end(); ++l, ++r) {
+            if (!(l.key() == r.key()) || !(l.value() == r.value()))
+                return false;
+        }
+        return true;
+    }
+    friend bool operator!=(const QBTreeMap &lhs, const QBTreeMap &rhs) { return !(lhs == rhs); }
+
+    size_type size() const { return d ? d->size : 0; }
+    size_type count() const { return size(); }
+    bool isEmpty() const { return d ? d->size == 0 : true; }
+    bool empty() const { return isEmpty(); }
+
+    void detach()
+    {
+        d.detach();
+    }
+    bool isDetached() const noexcept
+    {
+        return d ? !d.isShared() : false;
+    }
+    bool isSharedWith(const QBTreeMap<Key, T> &other) const noexcept
+    {
+        return d == other.d;
+    }
+
+    void clear()
+    {
+        d.reset();
+    }
+
+    size_type remove(const Key &key)
+    {
+        if (!contains(key))
+            return 0;
+        const Key copy = key; // key might point into the map
+        d.detach();
+        d->erase(copy);
+        return 1;
+    }
+
+    T take(const Key &key)
+    {
+        if (!contains(key))
+            return T();
+        const Key copy = key; // key might point into the map
+        d.detach();
+        const Position p = d->find(copy);
+        T result = std::move(p.leaf->values[p.index]);
+        d->erase(copy);
+        return result;
+    }
+
+    bool contains(const Key &key) const
+    {
+        if (!d)
+            return false;
+        return !isEnd(d->find(key));
+    }
+    size_type count(const Key &key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    Key key(const T &value, const Key &defaultKey = Key()) const
+    {
+        for (auto i = begin(); i != end(); ++i) {
+            if (i.value() == value)
+                return i.key();
+        }
+        return defaultKey;
+    }
+
+    T value(const Key &key, const T &defaultValue = T()) const
+    {
+        if (!d)
+            return defaultValue;
+        const Position p = d->find(key);
+        if (!isEnd(p))
+            return p.leaf->values[p.index];
+        return defaultValue;
+    }
+
+    T &operator[](const Key &key)
+    {
+        const auto copy = d.isShared() ? *this : QBTreeMap(); // keep `key` alive across the detach
+        d.detach();
+        bool inserted;
+        const Position p = d->tryEmplace(key, &inserted);
+        return p.leaf->values[p.index];
+    }
+
+    T operator[](const Key &key) const
+    {
+        return value(key);
+    }
+
+    QList<Key> keys() const
+    {
+        QList<Key> result;
+        result.reserve(size());
+        for (auto i = begin(); i != end(); ++i)
+            result.append(i.key());
+        return result;
+    }
+
+    QList<T> values() const
+    {
+        QList<T> result;
+        result.reserve(size());
+        for (auto i = begin(); i != end(); ++i)
+            result.append(i.value());
+        return result;
+    }
+
+    class const_iterator;
+
+    class iterator
+    {
+        friend class QBTreeMap<Key, T>;
+        friend class const_iterator;
+
+        LeafNode *leaf = nullptr;
+        qsizetype index = 0;
+        explicit iterator(Position p) : leaf(p.leaf), index(p.index) {}
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = qptrdiff;
+        using value_type = T;
+        using pointer = T *;
+        using reference = T &;
+
+        iterator() = default;
+
+        const Key &key() const { return leaf->keys[index]; }
+        T &value() const { return leaf->values[index]; }
+        T &operator*() const { return leaf->values[index]; }
+        T *operator->() const { return &leaf->values[index]; }
+        friend bool operator==(const iterator &lhs, const iterator &rhs)
+        { return lhs.leaf == rhs.leaf && lhs.index == rhs.index; }
+        friend bool operator!=(const iterator &lhs, const iterator &rhs) { return !(lhs == rhs); }
+
+        iterator &operator++()
+        {
+            if (++index == leaf->count && leaf->next) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+        iterator operator++(int)
+        {
+            iterator r = *this;
+            ++*this;
+            return r;
+        }
+        iterator &operator--()
+        {
+            if (index == 0) {
+                leaf = leaf->prev;
+                index = leaf->count;
+            }
+            --index;
+            return *this;
+        }
+        iterator operator--(int)
+        {
+            iterator r = *this;
+            --*this;
+            return r;
+        }
+    };
+
+    class const_iterator
+    {
+        friend class QBTreeMap<Key, T>;
+
+        const LeafNode *leaf = nullptr;
+        qsizetype index = 0;
+        explicit const_iterator(Position p) : leaf(p.leaf), index(p.index) {}
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using difference_type = qptrdiff;
+        using value_type = T;
+        using pointer = const T *;
+        using reference = const T &;
+
+        const_iterator() = default;
+        Q_IMPLICIT const_iterator(const iterator &o) : leaf(o.leaf), index(o.index) {}
+
+        const Key &key() const { return leaf->keys[index]; }
+        const T &value() const { return leaf->values[index]; }
+        const T &operator*() const { return leaf->values[index]; }
+        const T *operator->() const { return &leaf->values[index]; }
+        friend bool operator==(const const_iterator &lhs, const const_iterator &rhs)
+        { return lhs.leaf == rhs.leaf && lhs.index == rhs.index; }
+        friend bool operator!=(const const_iterator &lhs, const const_iterator &rhs) { return !(lhs == rhs); }
+
+        const_iterator &operator++()
+        {
+            if (++index == leaf->count && leaf->next) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+        const_iterator operator++(int)
+        {
+            const_iterator r = *this;
+            ++*this;
+            return r;
+        }
+        const_iterator &operator--()
+        {
+            if (index == 0) {
+                leaf = leaf->prev;
+                index = leaf->count;
+            }
+            --index;
+            return *this;
+        }
+        const_iterator operator--(int)
+        {
+            const_iterator r = *this;
+            --*this;
+            return r;
+        }
+    };
+
+    class key_iterator
+    {
+        const_iterator i;
+
+    public:
+        using iterator_category = typename const_iterator::iterator_category;
+        using difference_type = typename const_iterator::difference_type;
+        using value_type = Key;
+        using pointer = const Key *;
+        using reference = const Key &;
+
+        key_iterator() = default;
+        explicit key_iterator(const_iterator o) : i(o) { }
+
+        const Key &operator*() const { return i.key(); }
+        const Key *operator->() const { return &i.key(); }
+        bool operator==(key_iterator o) const { return i == o.i; }
+        bool operator!=(key_iterator o) const { return i != o.i; }
+
+        inline key_iterator &operator++() { ++i; return *this; }
+        inline key_iterator operator++(int) { return key_iterator(i++);}
+        inline key_iterator &operator--() { --i; return *this; }
+        inline key_iterator operator--(int) { return key_iterator(i--); }
+        const_iterator base() const { return i; }
+    };
+
+    // STL style
+    iterator begin() { detach(); return iterator(d->begin()); }
+    const_iterator begin() const { return d ? const_iterator(d->begin()) : const_iterator(); }
+    const_iterator constBegin() const { return begin(); }
+    const_iterator cbegin() const { return begin(); }
+    iterator end() { detach(); return iterator(d->end()); }
+    const_iterator end() const { return d ? const_iterator(d->end()) : const_iterator(); }
+    const_iterator constEnd() const { return end(); }
+    const_iterator cend() const { return end(); }
+    key_iterator keyBegin() const { return key_iterator(begin()); }
+    key_iterator keyEnd() const { return key_iterator(end()); }
+
+    iterator erase(const_iterator it)
+    {
+        Q_ASSERT(it != constEnd());
+        const Key key = it.key(); // the node holding it might go away
+        d.detach();
+        d->erase(key);
+        return iterator(d->lowerBound(key));
+    }
+
+    iterator find(const Key &key)
+    {
+        const auto copy = d.isShared() ? *this : QBTreeMap(); // keep `key` alive across the detach
+        detach();
+        return iterator(d->find(key));
+    }
+    const_iterator find(const Key &key) const
+    {
+        return constFind(key);
+    }
+    const_iterator constFind(const Key &key) const
+    {
+        if (!d)
+            return const_iterator();
+        return const_iterator(d->find(key));
+    }
+
+    iterator lowerBound(const Key &key)
+    {
+        const auto copy = d.isShared() ? *this : QBTreeMap(); // keep `key` alive across the detach
+        detach();
+        return iterator(d->lowerBound(key));
+    }
+    const_iterator lowerBound(const Key &key) const
+    {
+        if (!d)
+            return const_iterator();
+        return const_iterator(d->lowerBound(key));
+    }
+
+    iterator upperBound(const Key &key)
+    {
+        const auto copy = d.isShared() ? *this : QBTreeMap(); // keep `key` alive across the detach
+        detach();
+        return iterator(d->upperBound(key));
+    }
+    const_iterator upperBound(const Key &key) const
+    {
+        if (!d)
+            return const_iterator();
+        return const_iterator(d->upperBound(key));
+    }
+
+    iterator insert(const Key &key, const T &value)
+    {
+        const auto copy = d.isShared() ? *this : QBTreeMap(); // keep `key` alive across the detach
+        d.detach();
+        bool inserted;
+        const Position p = d->tryEmplace(key, &inserted, value);
+        if (!inserted)
+            p.leaf->values[p.index] = value;
+        return iterator(p);
+    }
+
+    T &first() { Q_ASSERT(!isEmpty()); return *begin(); }
+    const T &first() const { Q_ASSERT(!isEmpty()); return *constBegin(); }
+    const Key &firstKey() const { Q_ASSERT(!isEmpty()); return constBegin().key(); }
+    T &last() { Q_ASSERT(!isEmpty()); return *(--end()); }
+    const T &last() const { Q_ASSERT(!isEmpty()); return *(--constEnd()); }
+    const Key &lastKey() const { Q_ASSERT(!isEmpty()); return (--constEnd()).key(); }
+
+private:
+    bool isEnd(Position p) const noexcept
+    {
+        return p.leaf == d->last && p.index == d->last->count;
+    }
+};
+
+Q_DECLARE_ASSOCIATIVE_ITERATOR(BTreeMap)
+Q_DECLARE_MUTABLE_ASSOCIATIVE_ITERATOR(BTreeMap)
+
+template <typename Key, typename T>
+void swap(QBTreeMap<Key, T> &lhs, QBTreeMap<Key, T> &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+QT_END_NAMESPACE
+
+#endif // QBTREEMAP_H
@@ -0,0 +1,394 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QCONCURRENTCACHE_H
+#define QCONCURRENTCACHE_H
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#include <QtCore/qpromise.h>
+#include <QtCore/qthreadpool.h>
+#endif
+
+#include <chrono>
+#include <memory>
+#include <optional>
+
+QT_BEGIN_NAMESPACE
+
+struct QConcurrentCacheStatistics
+{
+    qint64 hits = 0;
+    qint64 misses = 0;
+    qint64 insertions = 0;
+    qint64 evictions = 0;
+    qint64 expirations = 0;
+};
+
+template <typename Key, typename T>
+class QConcurrentCache
+{
+    struct Entry
+    {
+        T value;
+        QDeadlineTimer deadline;
+
+        // avoids reading the clock for entries that never expire
+        bool hasExpired() const noexcept { return !deadline.isForever() && deadline.hasExpired(); }
+    };
+
+#if QT_CONFIG(future)
+    // A load started by fetch(). If the key is inserted, removed or cleared
+    // while the load runs, the loaded value may be older than what the cache
+    // holds now, so it is only handed to the waiting futures.
+    struct Pending
+    {
+        QFuture<T> future;
+        bool superseded = false;
+    };
+#endif
+
+    // Each shard is a QCache (so eviction is LRU by cost within the shard),
+    // guarded by its own mutex. Lookups update the LRU order, so they need
+    // exclusive access, too; spreading the keys over many shards keeps the
+    // contention low. Shards are kept on separate cache lines.
+    struct alignas(64) Shard
+    {
+        mutable QMutex mutex;
+        QCache<Key, Entry> cache;
+        QConcurrentCacheStatistics statistics;
+#if QT_CONFIG(future)
+        QHash<Key, Pending> pending;
+#endif
+    };
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = qsizetype;
+
+    explicit QConcurrentCache(qsizetype maxCost = 100, qsizetype shardCount = 16)
+    {
+        Q_ASSERT(shardCount > 0);
+        qsizetype count = 1;
+        while (count < shardCount)
+            count *= 2;
+        m_shards.reset(new Shard[count]);
+        m_mask = size_t(count - 1);
+        setMaxCost(maxCost);
+    }
+
+    ~QConcurrentCache()
+    {
+#if QT_CONFIG(future)
+        // Pending loads still access the cache, wait for them.
+        for (size_t i = 0; i <= m_mask; ++i) {
+            QList<QFuture<T>> pending;
+            {
+                QMutexLocker locker(&m_shards[i].mutex);
+                for (const Pending &p : qAsConst(m_shards[i].pending))
+                    pending.append(p.future);
+            }
+            for (QFuture<T> &future : pending)
+                future.waitForFinished();
+        }
+#endif
+    }
+
+    qsizetype shardCount() const noexcept { return qsizetype(m_mask + 1); }
+
+    // Each shard gets an equal part of the total cost budget.
+    void setMaxCost(qsizetype maxCost)
+    {
+        Q_ASSERT(maxCost >= 0);
+        m_maxCost = maxCost;
+        const qsizetype perShard = (maxCost + qsizetype(m_mask)) / qsizetype(m_mask + 1);
+        for (size_t i = 0; i <= m_mask; ++i) {
+            Shard &s = m_shards[i];
+            QMutexLocker locker(&s.mutex);
+            const qsizetype before = s.cache.size();
+            s.cache.setMaxCost(perShard);
+            s.statistics.evictions += before - s.cache.size();
+        }
+    }
+    qsizetype maxCost() const noexcept { return m_maxCost; }
+
+    void setDefaultTimeToLive(std::chrono::milliseconds ttl) noexcept
+    { m_defaultTtl.storeRelaxed(ttl.count()); }
+    std::chrono::milliseconds defaultTimeToLive() const noexcept
+    { return std::chrono::milliseconds(m_defaultTtl.loadRelaxed()); }
+
+    bool insert(const Key &key, const T &value, qsizetype cost = 1)
+    {
+        return insert(key, value, cost, defaultTimeToLive());
+    }
+
+    bool insert(const Key &key, const T &value, qsizetype cost, std::chrono::milliseconds ttl)
+    {
+        auto entry = std::make_unique<Entry>(Entry{ value, deadlineFor(ttl) });
+        Shard &s = shardFor(key);
+        QMutexLocker locker(&s.mutex);
+        supersedePendingLocked(s, key);
+        return insertLocked(s, key, entry.release(), cost);
+    }
+
+    bool remove(const Key &key)
+    {
+        Shard &s = shardFor(key);
+        QMutexLocker locker(&s.mutex);
+        supersedePendingLocked(s, key);
+        return s.cache.remove(key);
+    }
+
+    std::optional<T> take(const Key &key)
+    {
+        std::unique_ptr<Entry> entry;
+        {
+            Shard &s = shardFor(key);
+            QMutexLocker locker(&s.mutex);
+            supersedePendingLocked(s, key);
+            entry.reset(s.cache.take(key));
+        }
+        if (!entry || entry->hasExpired())
+            return std::nullopt;
+        return std::move(entry->value);
+    }
+
+    bool contains(const Key &key) const
+    {
+        Shard &s = shardFor(key);
+        QMutexLocker locker(&s.mutex);
+        return s.cache.contains(key) && !s.cache.object(key)->hasExpired();
+    }
+
+    std::optional<T> value(const Key &key) const
+    {
+        Shard &s = shardFor(key);
+        QMutexLocker locker(&s.mutex);
+        if (const Entry *entry = lookupLocked(s, key))
+            return entry->value;
+        return std::nullopt;
+    }
+
+    T value(const Key &key, const T &defaultValue) const
+    {
+        Shard &s = shardFor(key);
+        QMutexLocker locker(&s.mutex);
+        if (const Entry *entry = lookupLocked(s, key))
+            return entry->value;
+        return defaultValue;
+    }
+
+#if QT_CONFIG(future)
+    template <typename Loader>
+    QFuture<T> fetch(const Key &key, Loader loader, qsizetype cost = 1,
+                     QThreadPool *pool = QThreadPool::globalInstance())
+    {
+        Shard &s = shardFor(key);
+        QMutexLocker locker(&s.mutex);
+        if (const Entry *entry = lookupLocked(s, key))
+            return QtFuture::makeReadyFuture(T(entry->value));
+
+        // Only one load per key at a time; later requests share its result.
+        if (const auto it = s.pending.constFind(key); it != s.pending.cend())
+            return it->future;
+
+        auto promise = std::make_shared<QPromise<T>>();
+        QFuture<T> future = promise->future();
+        promise->start();
+        s.pending.insert(key, Pending{ future });
+        locker.unlock();
+
+        pool->start([this, key, cost, promise, loader]() {
+            std::optional<T> loaded;
+            QT_TRY {
+                loaded.emplace(loader(key));
+            } QT_CATCH(...) {
+#ifndef QT_NO_EXCEPTIONS
+                promise->setException(std::current_exception());
+#endif
+            }
+            {
+                Shard &s = shardFor(key);
+                std::unique_ptr<Entry> entry;
+                if (loaded)
+                    entry.reset(new Entry{ *loaded, deadlineFor(defaultTimeToLive()) });
+                QMutexLocker locker(&s.mutex);
+                if (entry && !s.pending.value(key).superseded)
+                    insertLocked(s, key, entry.release(), cost);
+                s.pending.remove(key);
+            }
+            if (loaded)
+                promise->addResult(std::move(*loaded));
+            promise->finish();
+        });
+        return future;
+    }
+#endif
+
+    qsizetype size() const
+    {
+        qsizetype result = 0;
+        for (size_t i = 0; i <= m_mask; ++i) {
+            QMutexLocker locker(&m_shards[i].mutex);
+            result += m_shards[i].cache.size();
+        }
+        return result;
+    }
+    qsizetype count() const { return size(); }
+    bool isEmpty() const { return size() == 0; }
+
+    qsizetype totalCost() const
+    {
+        qsizetype result = 0;
+        for (size_t i = 0; i <= m_mask; ++i) {
+            QMutexLocker locker(&m_shards[i].mutex);
+            result += m_shards[i].cache.totalCost();
+        }
+        return result;
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i <= m_mask; ++i) {
+            Shard &s = m_shards[i];
+            QMutexLocker locker(&s.mutex);
+#if QT_CONFIG(future)
+            for (Pending &p : s.pending)
+                p.superseded = true;
+#endif
+            s.cache.clear();
+        }
+    }
+
+    QConcurrentCacheStatistics statistics() const
+    {
+        QConcurrentCacheStatistics result;
+        for (size_t i = 0; i <= m_mask; ++i) {
+            QMutexLocker locker(&m_shards[i].mutex);
+            const QConcurrentCacheStatistics &s = m_shards[i].statistics;
+            result.hits += s.hits;
+            result.misses += s.misses;
+            result.insertions += s.insertions;
+            result.evictions += s.evictions;
+            result.expirations += s.expirations;
+        }
+        return result;
+    }
+
+    void resetStatistics()
+    {
+        for (size_t i = 0; i <= m_mask; ++i) {
+            QMutexLocker locker(&m_shards[i].mutex);
+            m_shards[i].statistics = QConcurrentCacheStatistics();
+        }
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(QConcurrentCache)
+
+    static QDeadlineTimer deadlineFor(std::chrono::milliseconds ttl) noexcept
+    {
+        if (ttl.count() < 0)
+            return QDeadlineTimer(QDeadlineTimer::Forever);
+        return QDeadlineTimer(ttl);
+    }
+
+    // Keeps a running load from overwriting a newer change to key.
+    // Must be called with the shard's mutex held.
+    void supersedePendingLocked(Shard &s, const Key &key)
+    {
+#if QT_CONFIG(future)
+        if (const auto it = s.pending.find(key); it != s.pending.end())
+            it->superseded = true;
+#else
+        Q_UNUSED(s);
+        Q_UNUSED(key);
+#endif
+    }
+
+    // Takes ownership of entry. Must be called with the shard's mutex held.
+    bool insertLocked(Shard &s, const Key &key, Entry *entry, qsizetype cost)
+    {
+        const qsizetype before = s.cache.size() + (s.cache.contains(key) ? 0 : 1);
+        const bool inserted = s.cache.insert(key, entry, cost);
+        if (inserted)
+            ++s.statistics.insertions;
+        s.statistics.evictions += before - s.cache.size() - (inserted ? 0 : 1);
+        return inserted;
+    }
+
+    // Returns the live entry for key, if any, dropping it if it has expired.
+    // Must be called with the shard's mutex held.
+    const Entry *lookupLocked(Shard &s, const Key &key) const
+    {
+        const Entry *entry = s.cache.object(key);
+        if (entry && entry->hasExpired()) {
+            s.cache.remove(key);
+            ++s.statistics.expirations;
+            entry = nullptr;
+        }
+        if (entry)
+            ++s.statistics.hits;
+        else
+            ++s.statistics.misses;
+        return entry;
+    }
+
+    Shard &shardFor(const Key &key) const
+    {
+        const size_t h = QHashPrivate::hash(qHash(key, m_seed), m_seed);
+        return m_shards[h & m_mask];
+    }
+
+    std::unique_ptr<Shard[]> m_shards;
+    size_t m_mask = 0;
+    size_t m_seed = QHashSeed::globalSeed();
+    qsizetype m_maxCost = 0;
+    QAtomicInteger<qint64> m_defaultTtl = -1;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTCACHE_H
@@ -0,0 +1,213 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QCONCURRENTHASH_H
+#define QCONCURRENTHASH_H
+
+#include <QtCore/qhash.h>
+#include <QtCore/qreadwritelock.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+template <typename Key, typename T>
+class QConcurrentHash
+{
+    // Each shard is an ordinary QHash (and thus uses QHash's Span storage)
+    // with its own lock. Shards are kept on separate cache lines, so that
+    // threads working on different shards don't contend on the locks.
+    struct alignas(64) Shard
+    {
+        mutable QReadWriteLock lock;
+        QHash<Key, T> hash;
+    };
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = qsizetype;
+
+    explicit QConcurrentHash(qsizetype shardCount = 16)
+        : m_seed(QHashSeed::globalSeed())
+    {
+        Q_ASSERT(shardCount > 0);
+        qsizetype count = 1;
+        while (count < shardCount)
+            count *= 2;
+        m_shards.reset(new Shard[count]);
+        m_mask = size_t(count - 1);
+    }
+
+    qsizetype shardCount() const noexcept { return qsizetype(m_mask + 1); }
+
+    void insert(const Key &key, const T &value)
+    {
+        Shard &s = shardFor(key);
+        QWriteLocker locker(&s.lock);
+        s.hash.insert(key, value);
+    }
+
+    bool tryInsert(const Key &key, const T &value)
+    {
+        Shard &s = shardFor(key);
+        QWriteLocker locker(&s.lock);
+        if (s.hash.contains(key))
+            return false;
+        s.hash.insert(key, value);
+        return true;
+    }
+
+    template <typename Function>
+    bool update(const Key &key, Function f)
+    {
+        Shard &s = shardFor(key);
+        QWriteLocker locker(&s.lock);
+        auto it = s.hash.find(key);
+        if (it == s.hash.end())
+            return false;
+        f(it.value());
+        return true;
+    }
+
+    bool remove(const Key &key)
+    {
+        Shard &s = shardFor(key);
+        QWriteLocker locker(&s.lock);
+        return s.hash.remove(key);
+    }
+
+    T take(const Key &key)
+    {
+        Shard &s = shardFor(key);
+        QWriteLocker locker(&s.lock);
+        return s.hash.take(key);
+    }
+
+    bool contains(const Key &key) const
+    {
+        const Shard &s = shardFor(key);
+        QReadLocker locker(&s.lock);
+        return s.hash.contains(key);
+    }
+
+    T value(const Key &key, const T &defaultValue = T()) const
+    {
+        const Shard &s = shardFor(key);
+        QReadLocker locker(&s.lock);
+        return s.hash.value(key, defaultValue);
+    }
+
+    qsizetype size() const
+    {
+        qsizetype result = 0;
+        for (size_t i = 0; i <= m_mask; ++i) {
+            QReadLocker locker(&m_shards[i].lock);
+            result += m_shards[i].hash.size();
+        }
+        return result;
+    }
+    qsizetype count() const { return size(); }
+    bool isEmpty() const
+    {
+        for (size_t i = 0; i <= m_mask; ++i) {
+            QReadLocker locker(&m_shards[i].lock);
+            if (!m_shards[i].hash.isEmpty())
+                return false;
+        }
+        return true;
+    }
+
+    void clear()
+    {
+        for (size_t i = 0; i <= m_mask; ++i) {
+            QHash<Key, T> old;
+            {
+                QWriteLocker locker(&m_shards[i].lock);
+                m_shards[i].hash.swap(old);
+            }
+            // old is destroyed here, outside of the lock
+        }
+    }
+
+    template <typename Function>
+    void forEach(Function f) const
+    {
+        for (size_t i = 0; i <= m_mask; ++i) {
+            // Taking an implicitly shared copy is O(1); writers detach from
+            // it, so we can iterate it without holding the lock.
+            const QHash<Key, T> shard = shardSnapshot(i);
+            for (auto it = shard.cbegin(), end = shard.cend(); it != end; ++it)
+                f(it.key(), it.value());
+        }
+    }
+
+    QHash<Key, T> snapshot() const
+    {
+        QHash<Key, T> result;
+        result.reserve(size());
+        forEach([&result](const Key &key, const T &value) { result.insert(key, value); });
+        return result;
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(QConcurrentHash)
+
+    QHash<Key, T> shardSnapshot(size_t i) const
+    {
+        QReadLocker locker(&m_shards[i].lock);
+        return m_shards[i].hash;
+    }
+
+    Shard &shardFor(const Key &key) const
+    {
+        // Re-mix the hash, so that the shard index doesn't correlate with the
+        // bucket the key ends up in inside the shard's QHash.
+        const size_t h = QHashPrivate::hash(qHash(key, m_seed), m_seed);
+        return m_shards[h & m_mask];
+    }
+
+    std::unique_ptr<Shard[]> m_shards;
+    size_t m_mask = 0;
+    size_t m_seed = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTHASH_H
@@ -40,6 +40,21 @@
 
 #include <qcryptographichash.h>
 #include <qiodevice.h>
+#include <qvarlengtharray.h>
+#include <private/qsimd_p.h>
+#ifndef QT_BOOTSTRAPPED
+#include <qendian.h>
+#include <qfiledevice.h>
+#if QT_CONFIG(thread)
+#include <qsemaphore.h>
+#include <qthread.h>
+#include <qthreadpool.h>
+#endif
+#endif
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
 
 #include "../../3rdparty/sha1/sha1.cpp"
 
@@ -140,6 +155,702 @@ QT_BEGIN_NAMESPACE
 
 static constexpr qsizetype MaxHashLength = 64;
 
+// Accelerated block functions. They only ever process complete blocks. The
+// wrappers further down (sha1AddData(), sha256AddData(), ...) leave partial
+// blocks in the buffer of the reference state, and do the final padding
+// themselves in a local buffer, so both paths keep working on the same state.
+#if !defined(QT_BOOTSTRAPPED) && defined(Q_PROCESSOR_X86) \
+    && QT_COMPILER_SUPPORTS_HERE(SHA) && QT_COMPILER_SUPPORTS_HERE(SSE4_1)
+#  define QCRYPTOGRAPHICHASH_SHA_NI
+#endif
+#if !defined(QT_BOOTSTRAPPED) && !defined(QT_CRYPTOGRAPHICHASH_ONLY_SHA1) \
+    && defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(AVX2)
+#  define QCRYPTOGRAPHICHASH_AVX2
+#endif
+#if !defined(QT_BOOTSTRAPPED) && defined(Q_PROCESSOR_ARM) && QT_COMPILER_SUPPORTS_HERE(AES)
+#  define QCRYPTOGRAPHICHASH_ARM_CRYPTO
+#endif
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+alignas(32) static const quint32 sha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+#endif
+
+#ifdef QCRYPTOGRAPHICHASH_SHA_NI
+namespace ShaNi {
+struct Sha1Rounds
+{
+    __m128i abcd;
+    __m128i e[2];
+    __m128i w[4];
+};
+
+// Rounds 4 * G to 4 * G + 3, interleaved with the message schedule.
+template <int G>
+QT_FUNCTION_TARGET(SHA) QT_FUNCTION_TARGET(SSE4_1)
+static inline void sha1Group(Sha1Rounds &r, const uchar *data, __m128i byteSwap)
+{
+    __m128i &w = r.w[G % 4];
+    __m128i &e = r.e[G % 2];
+    if constexpr (G < 4)
+        w = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * G)), byteSwap);
+    if constexpr (G == 0)
+        e = _mm_add_epi32(e, w);
+    else
+        e = _mm_sha1nexte_epu32(e, w);
+    r.e[(G + 1) % 2] = r.abcd;
+    if constexpr (G >= 3 && G <= 18)
+        r.w[(G + 1) % 4] = _mm_sha1msg2_epu32(r.w[(G + 1) % 4], w);
+    r.abcd = _mm_sha1rnds4_epu32(r.abcd, e, G / 5);
+    if constexpr (G >= 1 && G <= 16)
+        r.w[(G + 3) % 4] = _mm_sha1msg1_epu32(r.w[(G + 3) % 4], w);
+    if constexpr (G >= 2 && G <= 17)
+        r.w[(G + 2) % 4] = _mm_xor_si128(r.w[(G + 2) % 4], w);
+}
+
+template <size_t... G>
+QT_FUNCTION_TARGET(SHA) QT_FUNCTION_TARGET(SSE4_1)
+static inline void sha1Block(Sha1Rounds &r, const uchar *data, __m128i byteSwap, std::index_sequence<G...>)
+{
+    (sha1Group<G>(r, data, byteSwap), ...);
+}
+
+QT_FUNCTION_TARGET(SHA) QT_FUNCTION_TARGET(SSE4_1)
+static void sha1Blocks(quint32 state[5], const uchar *data, size_t blocks) noexcept
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    Sha1Rounds r;
+    r.abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state)), 0x1b);
+    r.e[0] = _mm_set_epi32(int(state[4]), 0, 0, 0);
+    for (; blocks; --blocks, data += 64) {
+        const __m128i abcd = r.abcd;
+        const __m128i e = r.e[0];
+        sha1Block(r, data, byteSwap, std::make_index_sequence<20>());
+        r.e[0] = _mm_sha1nexte_epu32(r.e[0], e);
+        r.abcd = _mm_add_epi32(r.abcd, abcd);
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_shuffle_epi32(r.abcd, 0x1b));
+    state[4] = quint32(_mm_extract_epi32(r.e[0], 3));
+}
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+struct Sha256Rounds
+{
+    __m128i abef;
+    __m128i cdgh;
+    __m128i w[4];
+};
+
+// Rounds 4 * G to 4 * G + 3, interleaved with the message schedule.
+template <int G>
+QT_FUNCTION_TARGET(SHA) QT_FUNCTION_TARGET(SSE4_1)
+static inline void sha256Group(Sha256Rounds &r, const uchar *data, __m128i byteSwap)
+{
+    __m128i &w = r.w[G % 4];
+    if constexpr (G < 4)
+        w = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * G)), byteSwap);
+    __m128i wk = _mm_add_epi32(w, _mm_load_si128(reinterpret_cast<const __m128i *>(sha256RoundConstants + 4 * G)));
+    r.cdgh = _mm_sha256rnds2_epu32(r.cdgh, r.abef, wk);
+    if constexpr (G >= 3 && G <= 14) {
+        __m128i &next = r.w[(G + 1) % 4];
+        next = _mm_add_epi32(next, _mm_alignr_epi8(w, r.w[(G + 3) % 4], 4));
+        next = _mm_sha256msg2_epu32(next, w);
+    }
+    wk = _mm_shuffle_epi32(wk, 0x0e);
+    r.abef = _mm_sha256rnds2_epu32(r.abef, r.cdgh, wk);
+    if constexpr (G >= 1 && G <= 12)
+        r.w[(G + 3) % 4] = _mm_sha256msg1_epu32(r.w[(G + 3) % 4], w);
+}
+
+template <size_t... G>
+QT_FUNCTION_TARGET(SHA) QT_FUNCTION_TARGET(SSE4_1)
+static inline void sha256Block(Sha256Rounds &r, const uchar *data, __m128i byteSwap, std::index_sequence<G...>)
+{
+    (sha256Group<G>(r, data, byteSwap), ...);
+}
+
+QT_FUNCTION_TARGET(SHA) QT_FUNCTION_TARGET(SSE4_1)
+static void sha256Blocks(quint32 state[8], const uchar *data, size_t blocks) noexcept
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // the instructions want the state as ABEF and CDGH
+    __m128i dcba = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state));
+    __m128i hgfe = _mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4));
+    dcba = _mm_shuffle_epi32(dcba, 0xb1);
+    hgfe = _mm_shuffle_epi32(hgfe, 0x1b);
+    Sha256Rounds r;
+    r.abef = _mm_alignr_epi8(dcba, hgfe, 8);
+    r.cdgh = _mm_blend_epi16(hgfe, dcba, 0xf0);
+
+    for (; blocks; --blocks, data += 64) {
+        const __m128i abef = r.abef;
+        const __m128i cdgh = r.cdgh;
+        sha256Block(r, data, byteSwap, std::make_index_sequence<16>());
+        r.abef = _mm_add_epi32(r.abef, abef);
+        r.cdgh = _mm_add_epi32(r.cdgh, cdgh);
+    }
+
+    const __m128i feba = _mm_shuffle_epi32(r.abef, 0x1b);
+    const __m128i dchg = _mm_shuffle_epi32(r.cdgh, 0xb1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+} // namespace ShaNi
+#endif // QCRYPTOGRAPHICHASH_SHA_NI
+
+#ifdef QCRYPTOGRAPHICHASH_ARM_CRYPTO
+namespace ArmCrypto {
+static bool isAvailable() noexcept
+{
+#  if defined(Q_OS_LINUX)
+    // Do specific runtime-only check as Yocto hard enables Crypto extension for
+    // all armv8 configs
+    return qCpuFeatures() & CpuFeatureAES;
+#  else
+    return qCpuHasFeature(AES);
+#  endif
+}
+
+QT_FUNCTION_TARGET(AES)
+static void sha1Blocks(quint32 state[5], const uchar *data, size_t blocks) noexcept
+{
+    static const quint32 roundConstants[4] = { 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6 };
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32_t e = state[4];
+    for (; blocks; --blocks, data += 64) {
+        const uint32x4_t savedAbcd = abcd;
+        const uint32_t savedE = e;
+        uint32x4_t w[4];
+        for (int i = 0; i < 4; ++i)
+            w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+        for (int g = 0; g < 20; ++g) {
+            const uint32x4_t wk = vaddq_u32(w[g % 4], vdupq_n_u32(roundConstants[g / 5]));
+            const uint32_t nextE = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+            if (g < 5)
+                abcd = vsha1cq_u32(abcd, e, wk);
+            else if (g < 10 || g >= 15)
+                abcd = vsha1pq_u32(abcd, e, wk);
+            else
+                abcd = vsha1mq_u32(abcd, e, wk);
+            e = nextE;
+            if (g < 16) {
+                w[g % 4] = vsha1su1q_u32(vsha1su0q_u32(w[g % 4], w[(g + 1) % 4], w[(g + 2) % 4]),
+                                         w[(g + 3) % 4]);
+            }
+        }
+        abcd = vaddq_u32(abcd, savedAbcd);
+        e += savedE;
+    }
+    vst1q_u32(state, abcd);
+    state[4] = e;
+}
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+QT_FUNCTION_TARGET(AES)
+static void sha256Blocks(quint32 state[8], const uchar *data, size_t blocks) noexcept
+{
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32x4_t efgh = vld1q_u32(state + 4);
+    for (; blocks; --blocks, data += 64) {
+        const uint32x4_t savedAbcd = abcd;
+        const uint32x4_t savedEfgh = efgh;
+        uint32x4_t w[4];
+        for (int i = 0; i < 4; ++i)
+            w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+        for (int g = 0; g < 16; ++g) {
+            const uint32x4_t wk = vaddq_u32(w[g % 4], vld1q_u32(sha256RoundConstants + 4 * g));
+            const uint32x4_t previousAbcd = abcd;
+            abcd = vsha256hq_u32(abcd, efgh, wk);
+            efgh = vsha256h2q_u32(efgh, previousAbcd, wk);
+            if (g < 12) {
+                w[g % 4] = vsha256su1q_u32(vsha256su0q_u32(w[g % 4], w[(g + 1) % 4]),
+                                           w[(g + 2) % 4], w[(g + 3) % 4]);
+            }
+        }
+        abcd = vaddq_u32(abcd, savedAbcd);
+        efgh = vaddq_u32(efgh, savedEfgh);
+    }
+    vst1q_u32(state, abcd);
+    vst1q_u32(state + 4, efgh);
+}
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+} // namespace ArmCrypto
+#endif // QCRYPTOGRAPHICHASH_ARM_CRYPTO
+
+#ifdef QCRYPTOGRAPHICHASH_AVX2
+namespace Avx2 {
+QT_FUNCTION_TARGET(AVX2)
+static inline __m256i rotr32(__m256i x, int n)
+{
+    return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+// Compresses one block for each of eight independent SHA-256 states, stored
+// transposed (state[i] holds word i of all eight lanes). Lanes whose bit is
+// set in activeLanes are updated; the others keep their state.
+QT_FUNCTION_TARGET(AVX2)
+static void sha256Lanes(__m256i state[8], const uchar *const block[8], int activeLanes) noexcept
+{
+    __m256i w[64];
+    for (int t = 0; t < 16; ++t) {
+        const auto word = [&](int lane) {
+            return int(qFromBigEndian<quint32>(block[lane] + 4 * t));
+        };
+        w[t] = _mm256_setr_epi32(word(0), word(1), word(2), word(3),
+                                 word(4), word(5), word(6), word(7));
+    }
+    for (int t = 16; t < 64; ++t) {
+        const __m256i w15 = w[t - 15];
+        const __m256i w2 = w[t - 2];
+        const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr32(w15, 7), rotr32(w15, 18)),
+                                            _mm256_srli_epi32(w15, 3));
+        const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr32(w2, 17), rotr32(w2, 19)),
+                                            _mm256_srli_epi32(w2, 10));
+        w[t] = _mm256_add_epi32(_mm256_add_epi32(w[t - 16], s0), _mm256_add_epi32(w[t - 7], s1));
+    }
+
+    __m256i a = state[0], b = state[1], c = state[2], d = state[3];
+    __m256i e = state[4], f = state[5], g = state[6], h = state[7];
+    for (int t = 0; t < 64; ++t) {
+        const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr32(e, 6), rotr32(e, 11)), rotr32(e, 25));
+        const __m256i ch = _mm256_xor_si256(g, _mm256_and_si256(e, _mm256_xor_si256(f, g)));
+        const __m256i k = _mm256_set1_epi32(int(sha256RoundConstants[t]));
+        const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, s1),
+                                            _mm256_add_epi32(_mm256_add_epi32(ch, k), w[t]));
+        const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr32(a, 2), rotr32(a, 13)), rotr32(a, 22));
+        const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, t1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(t1, _mm256_add_epi32(s0, maj));
+    }
+
+    const __m256i lanes = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256i active = _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(activeLanes), lanes), lanes);
+    const __m256i result[8] = { a, b, c, d, e, f, g, h };
+    for (int i = 0; i < 8; ++i)
+        state[i] = _mm256_add_epi32(state[i], _mm256_and_si256(result[i], active));
+}
+
+// Hashes up to eight messages with SHA-224 or SHA-256 (depending on the
+// initial state) in parallel, writing the full 32-byte digests to out.
+QT_FUNCTION_TARGET(AVX2)
+static void sha256Batch(const QByteArrayView *messages, int count, const uint32_t initial[8],
+                        uchar (*out)[32]) noexcept
+{
+    Q_ASSERT(count > 0 && count <= 8);
+    // The last one or two blocks of each message, with the padding.
+    uchar tails[8][128];
+    qsizetype fullBlocks[8] = {};
+    qsizetype totalBlocks[8] = {};
+    qsizetype maxBlocks = 0;
+    for (int lane = 0; lane < count; ++lane) {
+        const qsizetype length = messages[lane].size();
+        fullBlocks[lane] = length / 64;
+        const qsizetype rest = length % 64;
+        const qsizetype tailBlocks = rest < 56 ? 1 : 2;
+        memset(tails[lane], 0, sizeof(tails[lane]));
+        if (rest)
+            memcpy(tails[lane], messages[lane].data() + 64 * fullBlocks[lane], rest);
+        tails[lane][rest] = 0x80;
+        qToBigEndian(quint64(length) * 8, tails[lane] + 64 * tailBlocks - 8);
+        totalBlocks[lane] = fullBlocks[lane] + tailBlocks;
+        maxBlocks = qMax(maxBlocks, totalBlocks[lane]);
+    }
+
+    __m256i state[8];
+    for (int i = 0; i < 8; ++i)
+        state[i] = _mm256_set1_epi32(int(initial[i]));
+
+    const uchar *block[8];
+    for (qsizetype n = 0; n < maxBlocks; ++n) {
+        int activeLanes = 0;
+        for (int lane = 0; lane < 8; ++lane) {
+            if (lane < count && n < totalBlocks[lane]) {
+                activeLanes |= 1 << lane;
+                block[lane] = n < fullBlocks[lane]
+                        ? reinterpret_cast<const uchar *>(messages[lane].data()) + 64 * n
+                        : tails[lane] + 64 * (n - fullBlocks[lane]);
+            } else {
+                block[lane] = tails[0]; // ignored
+            }
+        }
+        sha256Lanes(state, block, activeLanes);
+    }
+
+    alignas(32) quint32 words[8][8];
+    for (int i = 0; i < 8; ++i)
+        _mm256_store_si256(reinterpret_cast<__m256i *>(words[i]), state[i]);
+    for (int lane = 0; lane < count; ++lane) {
+        for (int i = 0; i < 8; ++i)
+            qToBigEndian(words[i][lane], out[lane] + 4 * i);
+    }
+}
+
+#if !QT_CONFIG(system_libb2)
+QT_FUNCTION_TARGET(AVX2)
+static inline __m256i rotr64By63(__m256i x)
+{
+    return _mm256_xor_si256(_mm256_srli_epi64(x, 63), _mm256_add_epi64(x, x));
+}
+
+// The state is kept as four rows of four 64-bit words, so each G function
+// below works on a whole column (or, after rotating the rows, diagonal).
+QT_FUNCTION_TARGET(AVX2)
+static void blake2bCompress(blake2b_state *S, const uint8_t *block) noexcept
+{
+    const __m256i rotr16 = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+                                            2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+    const __m256i rotr24 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+                                            3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+    quint64 m[16];
+    memcpy(m, block, sizeof(m));
+    for (quint64 &word : m)
+        word = qFromLittleEndian(word);
+
+    const __m256i h0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(S->h));
+    const __m256i h1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(S->h + 4));
+    __m256i a = h0;
+    __m256i b = h1;
+    __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blake2b_IV));
+    __m256i d = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(blake2b_IV + 4)),
+                                 _mm256_set_epi64x(qint64(S->f[1]), qint64(S->f[0]),
+                                                   qint64(S->t[1]), qint64(S->t[0])));
+
+    const auto g = [&](__m256i x, __m256i y) QT_FUNCTION_TARGET(AVX2) {
+        a = _mm256_add_epi64(_mm256_add_epi64(a, b), x);
+        d = _mm256_shuffle_epi32(_mm256_xor_si256(d, a), _MM_SHUFFLE(2, 3, 0, 1));
+        c = _mm256_add_epi64(c, d);
+        b = _mm256_shuffle_epi8(_mm256_xor_si256(b, c), rotr24);
+        a = _mm256_add_epi64(_mm256_add_epi64(a, b), y);
+        d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rotr16);
+        c = _mm256_add_epi64(c, d);
+        b = rotr64By63(_mm256_xor_si256(b, c));
+    };
+    const auto words = [&m](const uint8_t *s, int first) QT_FUNCTION_TARGET(AVX2) {
+        return _mm256_set_epi64x(qint64(m[s[first + 6]]), qint64(m[s[first + 4]]),
+                                 qint64(m[s[first + 2]]), qint64(m[s[first]]));
+    };
+
+    for (const auto &sigma : blake2b_sigma) {
+        g(words(sigma, 0), words(sigma, 1));
+        b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(0, 3, 2, 1));
+        c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));
+        d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(2, 1, 0, 3));
+        g(words(sigma, 8), words(sigma, 9));
+        b = _mm256_permute4x64_epi64(b, _MM_SHUFFLE(2, 1, 0, 3));
+        c = _mm256_permute4x64_epi64(c, _MM_SHUFFLE(1, 0, 3, 2));
+        d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(0, 3, 2, 1));
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(S->h), _mm256_xor_si256(h0, _mm256_xor_si256(a, c)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(S->h + 4), _mm256_xor_si256(h1, _mm256_xor_si256(b, d)));
+}
+#endif // !QT_CONFIG(system_libb2)
+} // namespace Avx2
+#endif // QCRYPTOGRAPHICHASH_AVX2
+
+static void sha1Blocks(Sha1State *state, const uchar *data, size_t blocks) noexcept
+{
+#if defined(QCRYPTOGRAPHICHASH_SHA_NI) || defined(QCRYPTOGRAPHICHASH_ARM_CRYPTO)
+#  ifdef QCRYPTOGRAPHICHASH_SHA_NI
+    namespace Accelerated = ShaNi;
+    const bool accelerated = qCpuHasFeature(SHA) && qCpuHasFeature(SSE4_1);
+#  else
+    namespace Accelerated = ArmCrypto;
+    const bool accelerated = ArmCrypto::isAvailable();
+#  endif
+    if (accelerated) {
+        quint32 h[5] = { state->h0, state->h1, state->h2, state->h3, state->h4 };
+        Accelerated::sha1Blocks(h, data, blocks);
+        state->h0 = h[0];
+        state->h1 = h[1];
+        state->h2 = h[2];
+        state->h3 = h[3];
+        state->h4 = h[4];
+        return;
+    }
+#endif
+    for (; blocks; --blocks, data += 64)
+        sha1ProcessChunk(state, data);
+}
+
+// Like sha1Update(), but hands complete blocks to sha1Blocks().
+static void sha1AddData(Sha1State *state, const uchar *data, size_t length) noexcept
+{
+    if (const size_t rest = state->messageSize & 63) {
+        const size_t fill = qMin(length, 64 - rest);
+        sha1Update(state, data, fill);
+        data += fill;
+        length -= fill;
+    }
+    if (const size_t blocks = length / 64) {
+        sha1Blocks(state, data, blocks);
+        state->messageSize += 64 * blocks;
+        data += 64 * blocks;
+        length -= 64 * blocks;
+    }
+    if (length)
+        sha1Update(state, data, length);
+}
+
+// Like sha1FinalizeState() followed by sha1ToHash(), but pads in a local
+// buffer so that the last blocks also go through sha1Blocks().
+static void sha1Finalize(Sha1State *state, uchar *out) noexcept
+{
+    uchar tail[128] = {};
+    const size_t rest = state->messageSize & 63;
+    memcpy(tail, state->buffer, rest);
+    tail[rest] = 0x80;
+    const size_t blocks = rest < 56 ? 1 : 2;
+    qToBigEndian(state->messageSize * 8, tail + 64 * blocks - 8);
+    sha1Blocks(state, tail, blocks);
+    sha1ToHash(state, out);
+}
+
+#ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+static void sha256Blocks(SHA256Context *context, const uchar *data, size_t blocks) noexcept
+{
+#if defined(QCRYPTOGRAPHICHASH_SHA_NI)
+    if (qCpuHasFeature(SHA) && qCpuHasFeature(SSE4_1))
+        return ShaNi::sha256Blocks(context->Intermediate_Hash, data, blocks);
+#elif defined(QCRYPTOGRAPHICHASH_ARM_CRYPTO)
+    if (ArmCrypto::isAvailable())
+        return ArmCrypto::sha256Blocks(context->Intermediate_Hash, data, blocks);
+#endif
+    for (; blocks; --blocks, data += 64) {
+        memcpy(context->Message_Block, data, 64);
+        SHA224_256ProcessMessageBlock(context);
+    }
+}
+
+// Like SHA256Input() (which is also SHA224Input()), but hands complete
+// blocks to sha256Blocks() instead of copying the input byte by byte.
+static void sha256AddData(SHA256Context *context, const uchar *data, size_t length) noexcept
+{
+    if (context->Computed || context->Corrupted)
+        return;
+    if (context->Message_Block_Index) {
+        const size_t fill = qMin(length, size_t(64 - context->Message_Block_Index));
+        SHA256Input(context, data, uint(fill));
+        data += fill;
+        length -= fill;
+    }
+    if (const size_t blocks = length / 64) {
+        sha256Blocks(context, data, blocks);
+        const quint64 bits = (quint64(context->Length_High) << 32 | context->Length_Low)
+                + quint64(blocks) * 512;
+        if (bits < quint64(blocks) * 512)
+            context->Corrupted = shaInputTooLong;
+        context->Length_High = quint32(bits >> 32);
+        context->Length_Low = quint32(bits);
+        data += 64 * blocks;
+        length -= 64 * blocks;
+    }
+    if (length)
+        SHA256Input(context, data, uint(length));
+}
+
+// Like SHA256Result() (and SHA224Result()), but pads in a local buffer so
+// that the last blocks also go through sha256Blocks().
+static void sha256Finalize(SHA256Context *context, uchar *out, qsizetype hashSize) noexcept
+{
+    uchar tail[128] = {};
+    const size_t rest = size_t(context->Message_Block_Index);
+    memcpy(tail, context->Message_Block, rest);
+    tail[rest] = 0x80;
+    const size_t blocks = rest < 56 ? 1 : 2;
+    qToBigEndian(quint64(context->Length_High) << 32 | context->Length_Low, tail + 64 * blocks - 8);
+    sha256Blocks(context, tail, blocks);
+    for (qsizetype i = 0; i < hashSize / 4; ++i)
+        qToBigEndian(context->Intermediate_Hash[i], out + 4 * i);
+}
+
+#if !QT_CONFIG(system_libb2)
+static void blake2bCompress(blake2b_state *S, const uint8_t *block) noexcept
+{
+#ifdef QCRYPTOGRAPHICHASH_AVX2
+    if (qCpuHasFeature(AVX2))
+        return Avx2::blake2bCompress(S, block);
+#endif
+    blake2b_compress(S, block);
+}
+
+// Same as blake2b_update(), but with a runtime-selected compression function.
+static void blake2bAddData(blake2b_state *S, const uint8_t *in, size_t length) noexcept
+{
+    if (!length)
+        return;
+    const size_t left = S->buflen;
+    const size_t fill = BLAKE2B_BLOCKBYTES - left;
+    if (length > fill) {
+        // the last block is kept back, it needs the finalization flag
+        S->buflen = 0;
+        memcpy(S->buf + left, in, fill);
+        blake2b_increment_counter(S, BLAKE2B_BLOCKBYTES);
+        blake2bCompress(S, S->buf);
+        in += fill;
+        length -= fill;
+        while (length > BLAKE2B_BLOCKBYTES) {
+            blake2b_increment_counter(S, BLAKE2B_BLOCKBYTES);
+            blake2bCompress(S, in);
+            in += BLAKE2B_BLOCKBYTES;
+            length -= BLAKE2B_BLOCKBYTES;
+        }
+    }
+    memcpy(S->buf + S->buflen, in, length);
+    S->buflen += length;
+}
+#endif // !QT_CONFIG(system_libb2)
+
+static void blake2bUpdate(blake2b_state *S, const uchar *data, size_t length) noexcept
+{
+#if QT_CONFIG(system_libb2)
+    blake2b_update(S, data, length);
+#else
+    blake2bAddData(S, data, length);
+#endif
+}
+
+// BLAKE2b in tree mode (BLAKE2 specification, section 2.10): the input is
+// split into leaves of Blake2bTreeLeafLength bytes, which are hashed
+// independently; the root node hashes the concatenated leaf digests. The
+// parameters are unlimited fanout, depth 2 and 64-byte inner digests.
+static constexpr size_t Blake2bTreeLeafLength = 1024 * 1024;
+
+struct Blake2bTreeState
+{
+    blake2b_state root;
+    blake2b_state leaf;
+    quint64 leafIndex;      // node offset of leaf
+    size_t leafLength;      // bytes added to leaf so far
+};
+
+static void blake2bTreeInitNode(blake2b_state *S, quint64 nodeOffset, uchar nodeDepth) noexcept
+{
+    // Build the parameter block byte by byte: its C layout differs between
+    // the bundled BLAKE2 sources and libb2, the serialized form does not.
+    uchar param[BLAKE2B_OUTBYTES] = {};
+    static_assert(sizeof(blake2b_param) == sizeof(param));
+    param[0] = BLAKE2B_OUTBYTES;    // digest length
+    param[2] = 0;                   // fanout: unlimited
+    param[3] = 2;                   // depth
+    qToLittleEndian(quint32(Blake2bTreeLeafLength), param + 4);
+    qToLittleEndian(nodeOffset, param + 8);
+    param[16] = nodeDepth;
+    param[17] = BLAKE2B_OUTBYTES;   // inner length
+    blake2b_param P;
+    memcpy(&P, param, sizeof(P));
+    blake2b_init_param(S, &P);
+}
+
+static void blake2bTreeReset(Blake2bTreeState *S) noexcept
+{
+    blake2bTreeInitNode(&S->root, 0, 1);
+    blake2bTreeInitNode(&S->leaf, 0, 0);
+    S->leafIndex = 0;
+    S->leafLength = 0;
+}
+
+static void blake2bTreeHashLeaf(const uchar *data, quint64 leafIndex, uchar *digest) noexcept
+{
+    blake2b_state leaf;
+    blake2bTreeInitNode(&leaf, leafIndex, 0);
+    blake2bUpdate(&leaf, data, Blake2bTreeLeafLength);
+    blake2b_final(&leaf, digest, BLAKE2B_OUTBYTES);
+}
+
+// Hashes \a count complete leaves, none of which is the last one.
+static void blake2bTreeHashLeaves(const uchar *data, quint64 firstLeaf, int count,
+                                  uchar *digests) noexcept
+{
+#if QT_CONFIG(thread)
+    QAtomicInteger<int> next = 0;
+    const auto hashLeaves = [&]() {
+        for (int i; (i = next.fetchAndAddRelaxed(1)) < count; )
+            blake2bTreeHashLeaf(data + i * Blake2bTreeLeafLength, firstLeaf + i,
+                                digests + i * BLAKE2B_OUTBYTES);
+    };
+
+    // Only use threads that are idle right now, so this can neither wait
+    // for nor deadlock with other work in the pool.
+    QThreadPool *pool = QThreadPool::globalInstance();
+    QSemaphore done;
+    const int helpers = qMin(QThread::idealThreadCount(), count) - 1;
+    int started = 0;
+    while (started < helpers && pool->tryStart([&]() { hashLeaves(); done.release(); }))
+        ++started;
+    hashLeaves();
+    done.acquire(started);
+#else
+    for (int i = 0; i < count; ++i)
+        blake2bTreeHashLeaf(data + i * Blake2bTreeLeafLength, firstLeaf + i,
+                            digests + i * BLAKE2B_OUTBYTES);
+#endif
+}
+
+static void blake2bTreeAddData(Blake2bTreeState *S, const uchar *data, size_t length) noexcept
+{
+    const size_t fill = Blake2bTreeLeafLength - S->leafLength;
+    if (length <= fill) {
+        blake2bUpdate(&S->leaf, data, length);
+        S->leafLength += length;
+        return;
+    }
+
+    // The current leaf is complete and more data follows, so it is not the
+    // last one and can be finished.
+    blake2bUpdate(&S->leaf, data, fill);
+    data += fill;
+    length -= fill;
+    uchar digest[BLAKE2B_OUTBYTES];
+    blake2b_final(&S->leaf, digest, BLAKE2B_OUTBYTES);
+    blake2bUpdate(&S->root, digest, sizeof(digest));
+    ++S->leafIndex;
+
+    // Hash the complete leaves in parallel, but keep the last one back: it
+    // needs the last-node flag if no more data is added.
+    constexpr int Batch = 64;
+    uchar digests[Batch * BLAKE2B_OUTBYTES];
+    while (length > Blake2bTreeLeafLength) {
+        const int count = int(qMin((length - 1) / Blake2bTreeLeafLength, size_t(Batch)));
+        blake2bTreeHashLeaves(data, S->leafIndex, count, digests);
+        blake2bUpdate(&S->root, digests, count * BLAKE2B_OUTBYTES);
+        S->leafIndex += count;
+        data += count * Blake2bTreeLeafLength;
+        length -= count * Blake2bTreeLeafLength;
+    }
+
+    blake2bTreeInitNode(&S->leaf, S->leafIndex, 0);
+    blake2bUpdate(&S->leaf, data, length);
+    S->leafLength = length;
+}
+
+static void blake2bTreeFinalize(Blake2bTreeState *S, uchar *out) noexcept
+{
+    uchar digest[BLAKE2B_OUTBYTES];
+    S->leaf.last_node = 1;
+    blake2b_final(&S->leaf, digest, BLAKE2B_OUTBYTES);
+    blake2bUpdate(&S->root, digest, sizeof(digest));
+    S->root.last_node = 1;
+    blake2b_final(&S->root, out, BLAKE2B_OUTBYTES);
+}
+#endif // QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+
 static constexpr int hashLengthInternal(QCryptographicHash::Algorithm method) noexcept
 {
     switch (method) {
@@ -181,6 +892,7 @@ static constexpr int hashLengthInternal(QCryptographicHash::Algorithm method) no
     case QCryptographicHash::RealSha3_512:
     case QCryptographicHash::Keccak_512:
     case QCryptographicHash::Blake2b_512:
+    case QCryptographicHash::Blake2bTree_512:
         static_assert(512 / 8 <= MaxHashLength);
         return 512 / 8;
 #endif
@@ -216,6 +928,7 @@ public:
         SHA3Context sha3Context;
         blake2b_state blake2bContext;
         blake2s_state blake2sContext;
+        Blake2bTreeState blake2bTreeContext;
 #endif
     };
 #ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
@@ -337,6 +1050,11 @@ void QCryptographicHashPrivate::sha3Finish(int bitCount, Sha3Variant sha3Variant
   \value Blake2s_160 Generate a BLAKE2s-160 hash sum. Introduced in Qt 6.0
   \value Blake2s_224 Generate a BLAKE2s-224 hash sum. Introduced in Qt 6.0
   \value Blake2s_256 Generate a BLAKE2s-256 hash sum. Introduced in Qt 6.0
+  \value Blake2bTree_512 Generate a 512-bit BLAKE2b hash sum in tree mode,
+  with 1 MiB leaves, unlimited fanout and a depth of 2. Leaves are hashed
+  in parallel using the global QThreadPool, which makes this the fastest
+  method for large inputs on multi-core systems. The result differs from
+  Blake2b_512. Introduced in Qt 6.3
   \omitvalue RealSha3_224
   \omitvalue RealSha3_256
   \omitvalue RealSha3_384
@@ -429,6 +1147,10 @@ void QCryptographicHashPrivate::reset() noexcept
         new (&blake2sContext) blake2s_state;
         blake2s_init(&blake2sContext, hashLengthInternal(method));
         break;
+    case QCryptographicHash::Blake2bTree_512:
+        new (&blake2bTreeContext) Blake2bTreeState;
+        blake2bTreeReset(&blake2bTreeContext);
+        break;
 #endif
     }
     result.clear();
@@ -476,7 +1198,7 @@ void QCryptographicHashPrivate::addData(QByteArrayView bytes) noexcept
 #endif
         switch (method) {
         case QCryptographicHash::Sha1:
-            sha1Update(&sha1Context, (const unsigned char *)data, length);
+            sha1AddData(&sha1Context, reinterpret_cast<const uchar *>(data), size_t(length));
             break;
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
         default:
@@ -491,10 +1213,10 @@ void QCryptographicHashPrivate::addData(QByteArrayView bytes) noexcept
             MD5Update(&md5Context, (const unsigned char *)data, length);
             break;
         case QCryptographicHash::Sha224:
-            SHA224Input(&sha224Context, reinterpret_cast<const unsigned char *>(data), length);
+            sha256AddData(&sha224Context, reinterpret_cast<const uchar *>(data), size_t(length));
             break;
         case QCryptographicHash::Sha256:
-            SHA256Input(&sha256Context, reinterpret_cast<const unsigned char *>(data), length);
+            sha256AddData(&sha256Context, reinterpret_cast<const uchar *>(data), size_t(length));
             break;
         case QCryptographicHash::Sha384:
             SHA384Input(&sha384Context, reinterpret_cast<const unsigned char *>(data), length);
@@ -516,7 +1238,7 @@ void QCryptographicHashPrivate::addData(QByteArrayView bytes) noexcept
         case QCryptographicHash::Blake2b_256:
         case QCryptographicHash::Blake2b_384:
         case QCryptographicHash::Blake2b_512:
-            blake2b_update(&blake2bContext, reinterpret_cast<const uint8_t *>(data), length);
+            blake2bUpdate(&blake2bContext, reinterpret_cast<const uchar *>(data), size_t(length));
             break;
         case QCryptographicHash::Blake2s_128:
         case QCryptographicHash::Blake2s_160:
@@ -524,6 +1246,9 @@ void QCryptographicHashPrivate::addData(QByteArrayView bytes) noexcept
         case QCryptographicHash::Blake2s_256:
             blake2s_update(&blake2sContext, reinterpret_cast<const uint8_t *>(data), length);
             break;
+        case QCryptographicHash::Blake2bTree_512:
+            blake2bTreeAddData(&blake2bTreeContext, reinterpret_cast<const uchar *>(data), size_t(length));
+            break;
 #endif
         }
     }
@@ -533,6 +1258,11 @@ void QCryptographicHashPrivate::addData(QByteArrayView bytes) noexcept
 /*!
   Reads the data from the open QIODevice \a device until it ends
   and hashes it. Returns \c true if reading was successful.
+
+  If \a device is a QFileDevice that supports it, the remainder of the file
+  is mapped into memory and hashed from there instead of being read; the
+  file position is then moved to the end.
+
   \since 5.0
  */
 bool QCryptographicHash::addData(QIODevice *device)
@@ -543,8 +1273,33 @@ bool QCryptographicHash::addData(QIODevice *device)
     if (!device->isOpen())
         return false;
 
-    char buffer[1024];
-    int length;
+#ifndef QT_BOOTSTRAPPED
+    // Hashing from a mapping avoids copying the file contents, and gives
+    // Blake2bTree_512 enough data at once to hash leaves in parallel. Text
+    // mode would translate line endings, which a mapping does not.
+    auto file = qobject_cast<QFileDevice *>(device);
+    if (file && !file->isSequential() && !file->isTextModeEnabled()) {
+        constexpr qint64 WindowSize = qint64(64) * 1024 * 1024;
+        const qint64 size = file->size();
+        qint64 pos = file->pos();
+        while (pos < size) {
+            const qint64 length = qMin(size - pos, WindowSize);
+            uchar *map = file->map(pos, length);
+            if (!map)
+                break;
+            d->addData({map, qsizetype(length)});
+            file->unmap(map);
+            pos += length;
+        }
+        if (pos == size)
+            return file->seek(pos);
+        if (!file->seek(pos))
+            return false;
+    }
+#endif
+
+    char buffer[16384];
+    qint64 length;
 
     while ((length = device->read(buffer, sizeof(buffer))) > 0)
         d->addData({buffer, length});
@@ -588,8 +1343,7 @@ void QCryptographicHashPrivate::finalize() noexcept
     case QCryptographicHash::Sha1: {
         Sha1State copy = sha1Context;
         result.resize(20);
-        sha1FinalizeState(&copy);
-        sha1ToHash(&copy, (unsigned char *)result.data());
+        sha1Finalize(&copy, reinterpret_cast<uchar *>(result.data()));
         break;
     }
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
@@ -613,13 +1367,13 @@ void QCryptographicHashPrivate::finalize() noexcept
     case QCryptographicHash::Sha224: {
         SHA224Context copy = sha224Context;
         result.resize(SHA224HashSize);
-        SHA224Result(&copy, reinterpret_cast<unsigned char *>(result.data()));
+        sha256Finalize(&copy, reinterpret_cast<uchar *>(result.data()), SHA224HashSize);
         break;
     }
     case QCryptographicHash::Sha256: {
         SHA256Context copy = sha256Context;
         result.resize(SHA256HashSize);
-        SHA256Result(&copy, reinterpret_cast<unsigned char *>(result.data()));
+        sha256Finalize(&copy, reinterpret_cast<uchar *>(result.data()), SHA256HashSize);
         break;
     }
     case QCryptographicHash::Sha384: {
@@ -668,6 +1422,12 @@ void QCryptographicHashPrivate::finalize() noexcept
         blake2s_final(&copy, reinterpret_cast<uint8_t *>(result.data()), length);
         break;
     }
+    case QCryptographicHash::Blake2bTree_512: {
+        Blake2bTreeState copy = blake2bTreeContext;
+        result.resize(BLAKE2B_OUTBYTES);
+        blake2bTreeFinalize(&copy, reinterpret_cast<uchar *>(result.data()));
+        break;
+    }
 #endif
     }
 }
@@ -686,6 +1446,55 @@ QByteArray QCryptographicHash::hash(QByteArrayView data, Algorithm method)
     return hash.resultView().toByteArray();
 }
 
+/*!
+  \since 6.3
+
+  Returns the hashes of the buffers in \a data using \a method, in the
+  same order. The result is the same as calling hash() for each buffer.
+
+  Hashing many independent buffers at once allows processing them in
+  parallel: on x86 processors that support AVX2 but not the SHA
+  extensions, SHA-224 and SHA-256 hash up to eight buffers at a time.
+  This is most effective for many buffers of similar size.
+
+  \sa hash()
+*/
+QList<QByteArray> QCryptographicHash::hashMany(const QList<QByteArrayView> &data, Algorithm method)
+{
+    QList<QByteArray> result;
+#ifdef QCRYPTOGRAPHICHASH_AVX2
+    if ((method == Sha224 || method == Sha256) && data.size() > 1
+            && qCpuHasFeature(AVX2) && !qCpuHasFeature(SHA)) {
+        // Lanes run until their longest message is done, so batch messages
+        // of similar length together.
+        QVarLengthArray<qsizetype, 64> order(data.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&data](qsizetype lhs, qsizetype rhs) {
+            return data.at(lhs).size() < data.at(rhs).size();
+        });
+
+        const uint32_t *initial = method == Sha224 ? SHA224_H0 : SHA256_H0;
+        const qsizetype length = hashLengthInternal(method);
+        result.resize(data.size());
+        for (qsizetype i = 0; i < data.size(); i += 8) {
+            const int count = int(qMin(data.size() - i, qsizetype(8)));
+            QByteArrayView messages[8];
+            for (int lane = 0; lane < count; ++lane)
+                messages[lane] = data.at(order[i + lane]);
+            uchar digests[8][32];
+            Avx2::sha256Batch(messages, count, initial, digests);
+            for (int lane = 0; lane < count; ++lane)
+                result[order[i + lane]] = QByteArray(reinterpret_cast<const char *>(digests[lane]), length);
+        }
+        return result;
+    }
+#endif
+    result.reserve(data.size());
+    for (QByteArrayView buffer : data)
+        result.append(hash(buffer, method));
+    return result;
+}
+
 /*!
   Returns the size of the output of the selected hash \a method in bytes.
 
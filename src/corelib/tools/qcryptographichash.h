@@ -43,6 +43,7 @@
 #define QCRYPTOGRAPHICHASH_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
 #include <QtCore/qobjectdefs.h>
 
 QT_BEGIN_NAMESPACE
@@ -95,6 +96,7 @@ public:
         Blake2s_160,
         Blake2s_224,
         Blake2s_256,
+        Blake2bTree_512,
 #endif
     };
     Q_ENUM(Algorithm)
@@ -121,6 +123,7 @@ public:
     static QByteArray hash(const QByteArray &data, Algorithm method);
 #endif
     static QByteArray hash(QByteArrayView data, Algorithm method);
+    static QList<QByteArray> hashMany(const QList<QByteArrayView> &data, Algorithm method);
     static int hashLength(Algorithm method);
 private:
     Q_DISABLE_COPY(QCryptographicHash)
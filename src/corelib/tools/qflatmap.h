@@ -37,21 +37,11 @@
 **
 ****************************************************************************/
 
-#ifndef QFLATMAP_P_H
-#define QFLATMAP_P_H
-
-//
-//  W A R N I N G
-//  -------------
-//
-// This file is not part of the Qt API.  It exists for the convenience
-// of a number of Qt sources files.  This header file may change from
-// version to version without notice, or even be removed.
-//
-// We mean it.
-//
-
-#include "qlist.h"
+#ifndef QFLATMAP_H
+#define QFLATMAP_H
+
+#include <QtCore/qlist.h>
+#include <QtCore/qvarlengtharray.h>
 
 #include <algorithm>
 #include <functional>
@@ -75,6 +65,11 @@ QT_BEGIN_NAMESPACE
   One can customize the underlying container type by passing the KeyContainer
   and MappedContainer template arguments:
       QFlatMap<float, int, std::less<float>, std::vector<float>, std::vector<int>>
+
+  Inserting a range of elements appends them to the containers and then sorts
+  and deduplicates them in one go, which is much faster than inserting them
+  one by one. With a transparent comparator such as std::less<>, lookups
+  accept any type comparable with Key, like QStringView for QString keys.
 */
 
 namespace Qt {
@@ -419,7 +414,7 @@ private:
     struct is_marked_transparent_type : std::false_type { };
 
     template <class X>
-    struct is_marked_transparent_type<X, typename X::is_transparent> : std::true_type { };
+    struct is_marked_transparent_type<X, std::void_t<typename X::is_transparent>> : std::true_type { };
 
     template <class X>
     using is_marked_transparent = typename std::enable_if<
@@ -640,18 +635,38 @@ public:
         return binary_find(key) != end();
     }
 
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    bool contains(const X &key) const
+    {
+        return binary_find(key) != end();
+    }
+
     T value(const Key &key, const T &defaultValue) const
     {
         auto it = binary_find(key);
         return it == end() ? defaultValue : it.value();
     }
 
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    T value(const X &key, const T &defaultValue) const
+    {
+        auto it = binary_find(key);
+        return it == end() ? defaultValue : it.value();
+    }
+
     T value(const Key &key) const
     {
         auto it = binary_find(key);
         return it == end() ? T() : it.value();
     }
 
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    T value(const X &key) const
+    {
+        auto it = binary_find(key);
+        return it == end() ? T() : it.value();
+    }
+
     T &operator[](const Key &key)
     {
         auto it = lower_bound(key);
@@ -745,6 +760,15 @@ public:
         insertRange(first, last);
     }
 
+    void insert(const key_container_type &keys, const mapped_container_type &values)
+    {
+        Q_ASSERT(keys.size() == values.size());
+        const size_type s = c.keys.size();
+        std::copy(keys.begin(), keys.end(), std::back_inserter(c.keys));
+        std::copy(values.begin(), values.end(), std::back_inserter(c.values));
+        ensureOrderedUnique(s);
+    }
+
     // ### Merge with the templated version above
     //     once we can use std::disjunction in is_compatible_iterator.
     void insert(const value_type *first, const value_type *last)
@@ -817,11 +841,23 @@ public:
         return binary_find(k);
     }
 
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    iterator find(const X &k)
+    {
+        return binary_find(k);
+    }
+
     const_iterator find(const key_type &k) const
     {
         return binary_find(k);
     }
 
+    template <class X, class Y = Compare, is_marked_transparent<Y> = nullptr>
+    const_iterator find(const X &k) const
+    {
+        return binary_find(k);
+    }
+
     key_compare key_comp() const noexcept
     {
         return static_cast<key_compare>(*this);
@@ -867,14 +903,15 @@ private:
     template <class InputIt>
     void insertRange(InputIt first, InputIt last)
     {
-        size_type i = c.keys.size();
+        const size_type s = c.keys.size();
+        size_type i = s;
         c.keys.resize(i + std::distance(first, last));
         c.values.resize(c.keys.size());
         for (; first != last; ++first, ++i) {
             c.keys[i] = first->first;
             c.values[i] = first->second;
         }
-        ensureOrderedUnique();
+        ensureOrderedUnique(s);
     }
 
     class IndexedKeyComparator
@@ -905,19 +942,23 @@ private:
             c.values[i] = first->second;
         }
 
-        std::vector<size_type> p(size_t(c.keys.size()));
-        std::iota(p.begin(), p.end(), 0);
-        std::inplace_merge(p.begin(), p.begin() + s, p.end(), IndexedKeyComparator(this));
-        applyPermutation(p);
+        if (!isOrdered(s ? s - 1 : 0)) {
+            std::vector<size_type> p(size_t(c.keys.size()));
+            std::iota(p.begin(), p.end(), 0);
+            std::inplace_merge(p.begin(), p.begin() + s, p.end(), IndexedKeyComparator(this));
+            applyPermutation(p);
+        }
         makeUnique();
     }
 
-    iterator binary_find(const Key &key)
+    template <class X>
+    iterator binary_find(const X &key)
     {
         return { &c, const_cast<const full_map_t *>(this)->binary_find(key).i };
     }
 
-    const_iterator binary_find(const Key &key) const
+    template <class X>
+    const_iterator binary_find(const X &key) const
     {
         auto it = lower_bound(key);
         if (it != end()) {
@@ -928,12 +969,27 @@ private:
         return it;
     }
 
-    void ensureOrderedUnique()
+    // returns whether the keys starting at index from are in order,
+    // allowing for equivalent neighbors
+    bool isOrdered(size_type from) const
+    {
+        const auto b = c.keys.begin() + from;
+        return std::is_sorted(b, c.keys.end(), key_comp());
+    }
+
+    // Sorts the elements by key, keeping the last of equivalent ones. The
+    // first sortedPrefix elements are known to be sorted and unique already.
+    void ensureOrderedUnique(size_type sortedPrefix = 0)
     {
-        std::vector<size_type> p(size_t(c.keys.size()));
-        std::iota(p.begin(), p.end(), 0);
-        std::stable_sort(p.begin(), p.end(), IndexedKeyComparator(this));
-        applyPermutation(p);
+        // Appending elements in order is common, don't sort in that case.
+        if (!isOrdered(sortedPrefix ? sortedPrefix - 1 : 0)) {
+            std::vector<size_type> p(size_t(c.keys.size()));
+            std::iota(p.begin(), p.end(), 0);
+            std::stable_sort(p.begin() + sortedPrefix, p.end(), IndexedKeyComparator(this));
+            std::inplace_merge(p.begin(), p.begin() + sortedPrefix, p.end(),
+                               IndexedKeyComparator(this));
+            applyPermutation(p);
+        }
         makeUnique();
     }
 
@@ -957,25 +1013,24 @@ private:
         }
     }
 
+    // Removes all but the last of each run of equivalent keys, in one pass.
+    // The keys must be sorted.
     void makeUnique()
     {
-        if (c.keys.size() < 2)
-            return;
-        auto k = std::end(c.keys) - 1;
-        auto i = k - 1;
-        for (;;) {
-            if (key_compare::operator()(*i, *k) || key_compare::operator()(*k, *i)) {
-                if (i == std::begin(c.keys))
-                    break;
-                --i;
-                --k;
-            } else {
-                c.values.erase(std::begin(c.values) + std::distance(std::begin(c.keys), i));
-                i = c.keys.erase(i);
-                if (i == std::begin(c.keys))
-                    break;
-                k = i + 1;
+        const size_type s = c.keys.size();
+        size_type out = 0;
+        for (size_type i = 0; i < s; ++i) {
+            if (i + 1 < s && !key_compare::operator()(c.keys[i], c.keys[i + 1]))
+                continue;
+            if (out != i) {
+                c.keys[out] = std::move(c.keys[i]);
+                c.values[out] = std::move(c.values[i]);
             }
+            ++out;
+        }
+        if (out != s) {
+            c.keys.erase(c.keys.begin() + out, c.keys.end());
+            c.values.erase(c.values.begin() + out, c.values.end());
         }
     }
 
@@ -987,4 +1042,4 @@ using QVarLengthFlatMap = QFlatMap<Key, T, Compare, QVarLengthArray<Key, N>, QVa
 
 QT_END_NAMESPACE
 
-#endif // QFLATMAP_P_H
+#endif // QFLATMAP_H
@@ -3724,4 +3724,27 @@ size_t qHash(long double key, size_t seed) noexcept
     Returns the number of elements removed, if any.
 */
 
+/*!
+    \macro Q_DECLARE_HASH_TAG_PROBING(Type)
+    \relates QHash
+    \since 6.3
+
+    Makes QHash and QSet store a one-byte tag derived from the hash of each
+    key next to its bucket, for keys of type \a Type. Lookups then compare
+    the tags of 16 consecutive buckets at once and only compare the keys
+    whose tag matches. This makes looking up keys that are expensive to
+    compare faster, in particular keys that are not in the hash, at the cost
+    of 128 bytes for every 128 buckets.
+
+    The tags change the layout of the hash table. The macro must therefore
+    be used at global scope, right after the declaration of \a Type and
+    before any QHash or QSet with that key type is used, in all code that
+    uses such a QHash or QSet.
+
+    \code
+    struct PathKey { QString path; };
+    Q_DECLARE_HASH_TAG_PROBING(PathKey)
+    \endcode
+*/
+
 QT_END_NAMESPACE
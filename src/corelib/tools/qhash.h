@@ -41,12 +41,14 @@
 #ifndef QHASH_H
 #define QHASH_H
 
+#include <QtCore/qalgorithms.h>
 #include <QtCore/qcontainertools_impl.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qiterator.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qmath.h>
 #include <QtCore/qrefcount.h>
+#include <QtCore/qsimd.h>
 
 #include <initializer_list>
 #include <functional> // for std::hash
@@ -259,9 +261,37 @@ struct SpanConstants {
     static constexpr size_t NEntries = (1 << SpanShift);
     static constexpr size_t LocalBucketMask = (NEntries - 1);
     static constexpr size_t UnusedEntry = 0xff;
+    static constexpr unsigned char EmptyTag = 0;
+    static constexpr size_t GroupSize = 16;
 
     static_assert ((NEntries & LocalBucketMask) == 0, "NEntries must be a power of two.");
+    static_assert ((NEntries % GroupSize) == 0, "NEntries must be a multiple of GroupSize.");
+
+    // The tag stores 7 bits of the hash, with the high bit set to distinguish
+    // it from EmptyTag. The bucket index is taken from the low bits of the hash,
+    // so use the high ones for the tag: keys in the same probe sequence then
+    // usually have different tags.
+    static constexpr unsigned char tagForHash(size_t hash) noexcept
+    {
+        return static_cast<unsigned char>(0x80 | (hash >> (std::numeric_limits<size_t>::digits - 7)));
+    }
+};
+
+// Tag probing adds a tag array to every Span. As that changes the layout of QHash's inline data, it
+// is only used for key types that opt in with Q_DECLARE_HASH_TAG_PROBING.
+template <typename Key>
+struct ProbeWithTags : std::false_type {};
+
+template <bool WithTags>
+struct SpanTags {
+    unsigned char tags[SpanConstants::NEntries];
+    SpanTags() noexcept
+    {
+        memset(tags, SpanConstants::EmptyTag, sizeof(tags));
+    }
 };
+template <>
+struct SpanTags<false> {};
 
 // Regular hash tables consist of a list of buckets that can store Nodes. But simply allocating one large array of buckets
 // would waste a lot of memory. To avoid this, we split the vector of buckets up into a vector of Spans. Each Span represents
@@ -271,8 +301,15 @@ struct SpanConstants {
 // actual storage space for the Nodes (the 'entries' member) or 0xff (UnusedEntry) to flag that the bucket is empty.
 // As we have only 128 entries per Span, the offset array can be represented using an unsigned char. This trick makes the hash
 // table have a very small memory overhead compared to many other implementations.
+//
+// In addition, for key types that opt in through Q_DECLARE_HASH_TAG_PROBING, each bucket has a tag byte, which is either
+// EmptyTag or 7 bits of the hash of the Node stored in it. Lookups then compare the tags of GroupSize consecutive buckets
+// at once (using SIMD where available), and only compare keys for buckets whose tag matches. This keeps the number of key
+// comparisons and of cache misses on the entries low, especially for lookups of keys that are not in the table.
 template<typename Node>
-struct Span {
+struct Span : SpanTags<ProbeWithTags<typename Node::KeyType>::value> {
+    static constexpr bool UsesTags = ProbeWithTags<typename Node::KeyType>::value;
+
     // Entry is a slot available for storing a Node. The Span holds a pointer to
     // an array of Entries. Upon construction of the array, those entries are
     // unused, and nextFree() is being used to set up a singly linked list
@@ -286,6 +323,7 @@ struct Span {
         Node &node() { return *reinterpret_cast<Node *>(&storage); }
     };
 
+    // the tags, if any, come first: matchTags() may read up to GroupSize - 1 bytes past their end
     unsigned char offsets[SpanConstants::NEntries];
     Entry *entries = nullptr;
     unsigned char allocated = 0;
@@ -311,16 +349,22 @@ struct Span {
             entries = nullptr;
         }
     }
-    Node *insert(size_t i)
+    Node *insert(size_t i, unsigned char tag)
     {
         Q_ASSERT(i <= SpanConstants::NEntries);
         Q_ASSERT(offsets[i] == SpanConstants::UnusedEntry);
+        if constexpr (UsesTags)
+            Q_ASSERT(tag != SpanConstants::EmptyTag);
+        else
+            Q_UNUSED(tag);
         if (nextFree == allocated)
             addStorage();
         unsigned char entry = nextFree;
         Q_ASSERT(entry < allocated);
         nextFree = entries[entry].nextFree();
         offsets[i] = entry;
+        if constexpr (UsesTags)
+            this->tags[i] = tag;
         return &entries[entry].node();
     }
     void erase(size_t bucket) noexcept(std::is_nothrow_destructible<Node>::value)
@@ -330,6 +374,8 @@ struct Span {
 
         unsigned char entry = offsets[bucket];
         offsets[bucket] = SpanConstants::UnusedEntry;
+        if constexpr (UsesTags)
+            this->tags[bucket] = SpanConstants::EmptyTag;
 
         entries[entry].node().~Node();
         entries[entry].nextFree() = nextFree;
@@ -339,6 +385,50 @@ struct Span {
     {
         return offsets[i];
     }
+    unsigned char tag(size_t i) const noexcept
+    {
+        if constexpr (UsesTags)
+            return this->tags[i];
+        else
+            return SpanConstants::EmptyTag;
+    }
+    struct TagMatch {
+        uint matches; // buckets whose tag equals the one searched for
+        uint empties; // unused buckets
+        size_t length; // number of buckets that were checked
+    };
+    // Checks the tags of up to GroupSize buckets starting at i, but not past
+    // the end of the Span. Bit n of the masks refers to bucket i + n.
+    TagMatch matchTags(size_t i, unsigned char tag) const noexcept
+    {
+        Q_ASSERT(i < SpanConstants::NEntries);
+        const size_t length = qMin(SpanConstants::GroupSize, SpanConstants::NEntries - i);
+        const uint valid = (1u << length) - 1;
+        uint matches = 0;
+        uint empties = 0;
+#if QT_COMPILER_USES(sse2)
+        const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i *>(this->tags + i));
+        matches = uint(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(char(tag)))));
+        // occupied buckets have the high bit set
+        empties = uint(_mm_movemask_epi8(group)) ^ 0xffffu;
+#elif QT_COMPILER_USES(neon) && defined(Q_PROCESSOR_ARM_64)
+        static const uint8_t bitValues[16] = {
+            1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128
+        };
+        const uint8x16_t bits = vld1q_u8(bitValues);
+        const uint8x16_t group = vld1q_u8(this->tags + i);
+        const uint8x16_t m = vandq_u8(vceqq_u8(group, vdupq_n_u8(tag)), bits);
+        const uint8x16_t e = vandq_u8(vceqq_u8(group, vdupq_n_u8(SpanConstants::EmptyTag)), bits);
+        matches = vaddv_u8(vget_low_u8(m)) | (uint(vaddv_u8(vget_high_u8(m))) << 8);
+        empties = vaddv_u8(vget_low_u8(e)) | (uint(vaddv_u8(vget_high_u8(e))) << 8);
+#else
+        for (size_t n = 0; n < length; ++n) {
+            matches |= uint(this->tags[i + n] == tag) << n;
+            empties |= uint(this->tags[i + n] == SpanConstants::EmptyTag) << n;
+        }
+#endif
+        return { matches & valid, empties & valid, length };
+    }
     bool hasNode(size_t i) const noexcept
     {
         return (offsets[i] != SpanConstants::UnusedEntry);
@@ -375,6 +465,10 @@ struct Span {
         Q_ASSERT(offsets[to] == SpanConstants::UnusedEntry);
         offsets[to] = offsets[from];
         offsets[from] = SpanConstants::UnusedEntry;
+        if constexpr (UsesTags) {
+            this->tags[to] = this->tags[from];
+            this->tags[from] = SpanConstants::EmptyTag;
+        }
     }
     void moveFromSpan(Span &fromSpan, size_t fromIndex, size_t to) noexcept(std::is_nothrow_move_constructible_v<Node>)
     {
@@ -386,11 +480,15 @@ struct Span {
             addStorage();
         Q_ASSERT(nextFree < allocated);
         offsets[to] = nextFree;
+        if constexpr (UsesTags)
+            this->tags[to] = fromSpan.tags[fromIndex];
         Entry &toEntry = entries[nextFree];
         nextFree = toEntry.nextFree();
 
         size_t fromOffset = fromSpan.offsets[fromIndex];
         fromSpan.offsets[fromIndex] = SpanConstants::UnusedEntry;
+        if constexpr (UsesTags)
+            fromSpan.tags[fromIndex] = SpanConstants::EmptyTag;
         Entry &fromEntry = fromSpan.entries[fromOffset];
 
         if constexpr (isRelocatable<Node>()) {
@@ -520,6 +618,11 @@ struct Data
         {
             advance_impl(d, d->spans);
         }
+        // advances by n buckets; must not cross the end of the current Span
+        void advanceWrapped(const Data *d, size_t n) noexcept
+        {
+            advance_impl(d, d->spans, n);
+        }
         void advance(const Data *d) noexcept
         {
             advance_impl(d, nullptr);
@@ -540,9 +643,9 @@ struct Data
         {
             return &span->at(index);
         }
-        Node *insert() const
+        Node *insert(unsigned char tag) const
         {
-            return span->insert(index);
+            return span->insert(index, tag);
         }
 
     private:
@@ -552,10 +655,11 @@ struct Data
         }
         friend bool operator!=(Bucket lhs, Bucket rhs) noexcept { return !(lhs == rhs); }
 
-        void advance_impl(const Data *d, Span *whenAtEnd) noexcept
+        void advance_impl(const Data *d, Span *whenAtEnd, size_t n = 1) noexcept
         {
             Q_ASSERT(span);
-            ++index;
+            index += n;
+            Q_ASSERT(index <= SpanConstants::NEntries);
             if (Q_UNLIKELY(index == SpanConstants::NEntries)) {
                 index = 0;
                 ++span;
@@ -593,7 +697,7 @@ struct Data
                 const Node &n = span.at(index);
                 auto it = resized ? findBucket(n.key) : Bucket{ spans + s, index };
                 Q_ASSERT(it.isUnused());
-                Node *newNode = it.insert();
+                Node *newNode = it.insert(span.tag(index));
                 new (newNode) Node(n);
             }
         }
@@ -656,7 +760,7 @@ struct Data
                 Node &n = span.at(index);
                 auto it = findBucket(n.key);
                 Q_ASSERT(it.isUnused());
-                Node *newNode = it.insert();
+                Node *newNode = it.insert(span.tag(index));
                 new (newNode) Node(std::move(n));
             }
             span.freeData();
@@ -682,45 +786,73 @@ struct Data
     }
 
     Bucket findBucket(const Key &key) const noexcept
+    {
+        return findBucketWithHash(key, QHashPrivate::calculateHash(key, seed));
+    }
+
+    Bucket findBucketWithHash(const Key &key, size_t hash) const noexcept
     {
         Q_ASSERT(numBuckets > 0);
-        size_t hash = QHashPrivate::calculateHash(key, seed);
         Bucket bucket(this, GrowthPolicy::bucketForHash(numBuckets, hash));
-        // loop over the buckets until we find the entry we search for
-        // or an empty slot, in which case we know the entry doesn't exist
-        while (true) {
-            size_t offset = bucket.offset();
-            if (offset == SpanConstants::UnusedEntry) {
-                return bucket;
-            } else {
-                Node &n = bucket.nodeAtOffset(offset);
-                if (qHashEquals(n.key, key))
+        if constexpr (!Span::UsesTags) {
+            // loop over the buckets until we find the entry we search for
+            // or an empty slot, in which case we know the entry doesn't exist
+            while (true) {
+                size_t offset = bucket.offset();
+                if (offset == SpanConstants::UnusedEntry) {
                     return bucket;
+                } else {
+                    Node &n = bucket.nodeAtOffset(offset);
+                    if (qHashEquals(n.key, key))
+                        return bucket;
+                }
+                bucket.advanceWrapped(this);
             }
-            bucket.advanceWrapped(this);
+        } else {
+            const unsigned char tag = SpanConstants::tagForHash(hash);
+            // At our load factor, most lookups end in the home bucket, so check it
+            // inline and only scan whole groups of buckets out of line.
+            const unsigned char homeTag = bucket.span->tag(bucket.index);
+            if (homeTag == SpanConstants::EmptyTag)
+                return bucket;
+            if (homeTag == tag && qHashEquals(bucket.node()->key, key))
+                return bucket;
+            return findBucketInGroups(key, bucket, tag);
         }
     }
 
-    Node *findNode(const Key &key) const noexcept
+    Q_NEVER_INLINE Bucket findBucketInGroups(const Key &key, Bucket bucket, unsigned char tag) const noexcept
     {
-        Q_ASSERT(numBuckets > 0);
-        size_t hash = QHashPrivate::calculateHash(key, seed);
-        Bucket bucket(this, GrowthPolicy::bucketForHash(numBuckets, hash));
-        // loop over the buckets until we find the entry we search for
-        // or an empty slot, in which case we know the entry doesn't exist
+        // loop over groups of buckets until we find the entry we search for
+        // or an empty slot, in which case we know the entry doesn't exist.
+        // Only buckets with a matching tag need to have their key compared.
         while (true) {
-            size_t offset = bucket.offset();
-            if (offset == SpanConstants::UnusedEntry) {
-                return nullptr;
-            } else {
-                Node &n = bucket.nodeAtOffset(offset);
+            auto [matches, empties, length] = bucket.span->matchTags(bucket.index, tag);
+            if (empties) {
+                // the first unused bucket ends the probe sequence
+                matches &= (empties & (0u - empties)) - 1;
+            }
+            while (matches) {
+                const size_t index = bucket.index + qCountTrailingZeroBits(matches);
+                Node &n = bucket.span->at(index);
                 if (qHashEquals(n.key, key))
-                    return &n;
+                    return Bucket(bucket.span, index);
+                matches &= matches - 1;
             }
-            bucket.advanceWrapped(this);
+            if (empties)
+                return Bucket(bucket.span, bucket.index + qCountTrailingZeroBits(empties));
+            bucket.advanceWrapped(this, length);
         }
     }
 
+    Node *findNode(const Key &key) const noexcept
+    {
+        Bucket bucket = findBucket(key);
+        if (bucket.isUnused())
+            return nullptr;
+        return bucket.node();
+    }
+
     struct InsertionResult
     {
         iterator it;
@@ -730,18 +862,19 @@ struct Data
     InsertionResult findOrInsert(const Key &key) noexcept
     {
         Bucket it(static_cast<Span *>(nullptr), 0);
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
         if (numBuckets > 0) {
-            it = findBucket(key);
+            it = findBucketWithHash(key, hash);
             if (!it.isUnused())
                 return { it.toIterator(this), true };
         }
         if (shouldGrow()) {
             rehash(size + 1);
-            it = findBucket(key); // need to get a new iterator after rehashing
+            it = findBucketWithHash(key, hash); // need to get a new iterator after rehashing
         }
         Q_ASSERT(it.span != nullptr);
         Q_ASSERT(it.isUnused());
-        it.insert();
+        it.insert(SpanConstants::tagForHash(hash));
         ++size;
         return { it.toIterator(this), false };
     }
@@ -2228,4 +2361,12 @@ qsizetype erase_if(QMultiHash<Key, T> &hash, Predicate pred)
 
 QT_END_NAMESPACE
 
+#define Q_DECLARE_HASH_TAG_PROBING(KEY) \
+    QT_BEGIN_NAMESPACE \
+    namespace QHashPrivate { \
+    template <> \
+    struct ProbeWithTags<KEY> : std::true_type {}; \
+    } \
+    QT_END_NAMESPACE
+
 #endif // QHASH_H
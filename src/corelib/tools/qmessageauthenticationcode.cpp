@@ -86,6 +86,7 @@ static int qt_hash_block_size(QCryptographicHash::Algorithm method)
     case QCryptographicHash::Blake2b_256:
     case QCryptographicHash::Blake2b_384:
     case QCryptographicHash::Blake2b_512:
+    case QCryptographicHash::Blake2bTree_512:
         return BLAKE2B_BLOCKBYTES;
     case QCryptographicHash::Blake2s_128:
     case QCryptographicHash::Blake2s_160:
@@ -0,0 +1,436 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qspscringbuffer.h"
+
+#include <qmath.h>
+
+#if defined(Q_OS_LINUX)
+#  include "private/qcore_unix_p.h"
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  if defined(SYS_memfd_create)
+#    define QSPSCRINGBUFFER_DOUBLE_MAPPING
+#  endif
+#endif
+
+#include <string.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QSpscRingBuffer
+    \inmodule QtCore
+    \since 6.3
+    \ingroup thread
+
+    \brief The QSpscRingBuffer class provides a fixed-capacity byte ring
+    buffer for one producer thread and one consumer thread.
+
+    The producer appends data with write(), or with writePointer() and
+    commit(); the consumer takes it with read(), or with readPointer() and
+    free(). Neither side takes a lock: each side owns one position and
+    publishes it with release semantics, so data written before a commit()
+    is visible to the consumer once it sees the new size.
+
+    If the buffer is DoubleMapped, the same memory is mapped twice in a row,
+    so that readPointer() and writePointer() always return all readable or
+    writable bytes as one contiguous block, even across the wrap-around
+    point. Otherwise they return the block up to the end of the buffer.
+
+    Either side can block until the other makes progress, with waitForData()
+    and waitForSpace(). The mutex and wait conditions used for that are
+    only touched when a side is actually waiting.
+
+    Exactly one thread may use the producer functions, and one thread the
+    consumer functions, at a time. To use one end of the buffer as a
+    QIODevice, with readyRead() notifications in the consumer's thread, see
+    QSpscRingBufferDevice.
+
+    \sa QSpscRingBufferDevice
+*/
+
+/*!
+    \enum QSpscRingBuffer::MappingMode
+
+    This enum describes how the memory of the buffer is allocated.
+
+    \value HeapAllocated The buffer is a single heap block. readPointer()
+                         and writePointer() stop at the end of the block.
+    \value DoubleMapped  The buffer is mapped twice, back to back, so that
+                         readPointer() and writePointer() always return a
+                         contiguous block. This is supported on Linux; on
+                         other platforms, or if the mapping fails, the
+                         buffer falls back to HeapAllocated.
+
+    \sa isDoubleMapped()
+*/
+
+/*!
+    \fn qint64 QSpscRingBuffer::capacity() const
+
+    Returns the number of bytes the buffer can hold. This is at least the
+    capacity requested in the constructor.
+*/
+
+/*!
+    \fn bool QSpscRingBuffer::isDoubleMapped() const
+
+    Returns \c true if the buffer memory is mapped twice, so that all
+    readable or writable bytes are always contiguous.
+
+    \sa MappingMode
+*/
+
+/*!
+    \fn qint64 QSpscRingBuffer::size() const
+
+    Returns the number of bytes that have been committed and not yet freed.
+    While the other side is active, the value is only a snapshot: the
+    producer may commit more data, and the consumer may free some, at any
+    time. Still, the consumer can always read at least size() bytes, and
+    the producer can always write at least freeSpace() bytes.
+
+    \sa freeSpace(), isEmpty()
+*/
+
+/*!
+    \fn bool QSpscRingBuffer::isEmpty() const
+
+    Returns \c true if there is no unread data in the buffer.
+
+    \sa size()
+*/
+
+/*!
+    \fn qint64 QSpscRingBuffer::freeSpace() const
+
+    Returns the number of bytes that can be written without waiting.
+
+    \sa size(), waitForSpace()
+*/
+
+/*!
+    \fn qint64 QSpscRingBuffer::totalWritten() const
+
+    Returns the total number of bytes committed since the buffer was
+    created.
+*/
+
+/*!
+    \fn bool QSpscRingBuffer::isWriteClosed() const
+
+    Returns \c true if the producer called closeWrite().
+*/
+
+/*!
+    \fn bool QSpscRingBuffer::atEnd() const
+
+    Returns \c true if the producer called closeWrite() and the consumer
+    has read all data.
+*/
+
+#ifdef QSPSCRINGBUFFER_DOUBLE_MAPPING
+// Maps a memory file twice, back to back. Returns nullptr on failure.
+static char *mapTwice(qint64 size)
+{
+    const int fd = int(syscall(SYS_memfd_create, "QSpscRingBuffer", 1 /* MFD_CLOEXEC */));
+    if (fd < 0)
+        return nullptr;
+    char *result = nullptr;
+    if (::ftruncate(fd, size) == 0) {
+        void *base = ::mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base != MAP_FAILED) {
+            char *first = static_cast<char *>(base);
+            const int flags = MAP_SHARED | MAP_FIXED;
+            if (::mmap(first, size, PROT_READ | PROT_WRITE, flags, fd, 0) != MAP_FAILED
+                    && ::mmap(first + size, size, PROT_READ | PROT_WRITE, flags, fd, 0) != MAP_FAILED) {
+                result = first;
+            } else {
+                ::munmap(base, 2 * size);
+            }
+        }
+    }
+    qt_safe_close(fd);
+    return result;
+}
+#endif
+
+/*!
+    Constructs a ring buffer that can hold at least \a minimumCapacity bytes.
+    The capacity is rounded up to a power of two, and to the page size if
+    \a mode is DoubleMapped. If double mapping is not supported, the buffer
+    is allocated on the heap instead.
+*/
+QSpscRingBuffer::QSpscRingBuffer(qint64 minimumCapacity, MappingMode mode)
+{
+    Q_ASSERT(minimumCapacity > 0);
+    m_capacity = qint64(qNextPowerOfTwo(quint64(minimumCapacity - 1)));
+#ifdef QSPSCRINGBUFFER_DOUBLE_MAPPING
+    if (mode == DoubleMapped) {
+        m_capacity = qMax(m_capacity, qint64(::sysconf(_SC_PAGESIZE)));
+        m_data = mapTwice(m_capacity);
+        m_doubleMapped = m_data != nullptr;
+    }
+#else
+    Q_UNUSED(mode);
+#endif
+    if (!m_data) {
+        m_data = static_cast<char *>(::malloc(size_t(m_capacity)));
+        Q_CHECK_PTR(m_data);
+    }
+}
+
+/*!
+    Destroys the buffer. Neither side may use it any more.
+*/
+QSpscRingBuffer::~QSpscRingBuffer()
+{
+#ifdef QSPSCRINGBUFFER_DOUBLE_MAPPING
+    if (m_doubleMapped) {
+        ::munmap(m_data, 2 * m_capacity);
+        return;
+    }
+#endif
+    ::free(m_data);
+}
+
+/*!
+    Returns a pointer to the first free byte and sets \a length to the number
+    of bytes that can be written there. Call commit() to publish the bytes
+    written. Must be called on the producer side.
+*/
+char *QSpscRingBuffer::writePointer(qint64 &length) noexcept
+{
+    const qint64 tail = m_tail.load(std::memory_order_relaxed);
+    const qint64 offset = tail & (m_capacity - 1);
+    length = m_capacity - (tail - m_head.load(std::memory_order_acquire));
+    if (!m_doubleMapped)
+        length = qMin(length, m_capacity - offset);
+    return m_data + offset;
+}
+
+/*!
+    Publishes \a bytes bytes written at writePointer() to the consumer.
+*/
+void QSpscRingBuffer::commit(qint64 bytes) noexcept
+{
+    Q_ASSERT(bytes >= 0 && bytes <= freeSpace());
+    m_tail.store(m_tail.load(std::memory_order_relaxed) + bytes, std::memory_order_release);
+    // order the store above before the load below: a consumer that starts
+    // waiting either sees the new tail, or gets woken up
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiters.load(std::memory_order_relaxed) & (ConsumerWaiting | ReadNotificationArmed))
+        wakeConsumer();
+}
+
+/*!
+    Copies up to \a size bytes from \a data into the buffer and publishes
+    them. Returns the number of bytes copied, which is less than \a size if
+    the buffer is full.
+*/
+qint64 QSpscRingBuffer::write(const char *data, qint64 size) noexcept
+{
+    const qint64 tail = m_tail.load(std::memory_order_relaxed);
+    const qint64 length = qMin(size, m_capacity - (tail - m_head.load(std::memory_order_acquire)));
+    if (length <= 0)
+        return 0;
+    const qint64 offset = tail & (m_capacity - 1);
+    const qint64 first = m_doubleMapped ? length : qMin(length, m_capacity - offset);
+    memcpy(m_data + offset, data, size_t(first));
+    memcpy(m_data, data + first, size_t(length - first));
+    commit(length);
+    return length;
+}
+
+/*!
+    Marks the end of the data: once the consumer has read everything, atEnd()
+    returns \c true and waitForData() no longer blocks.
+*/
+void QSpscRingBuffer::closeWrite() noexcept
+{
+    m_writeClosed.store(true, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiters.load(std::memory_order_relaxed) & (ConsumerWaiting | ReadNotificationArmed))
+        wakeConsumer();
+}
+
+/*!
+    Returns a pointer to the first unread byte and sets \a length to the
+    number of bytes that can be read there. Call free() to release them.
+    Must be called on the consumer side.
+*/
+const char *QSpscRingBuffer::readPointer(qint64 &length) const noexcept
+{
+    const qint64 head = m_head.load(std::memory_order_relaxed);
+    const qint64 offset = head & (m_capacity - 1);
+    length = m_tail.load(std::memory_order_acquire) - head;
+    if (!m_doubleMapped)
+        length = qMin(length, m_capacity - offset);
+    return m_data + offset;
+}
+
+/*!
+    Releases the first \a bytes unread bytes, making room for the producer.
+*/
+void QSpscRingBuffer::free(qint64 bytes) noexcept
+{
+    Q_ASSERT(bytes >= 0 && bytes <= size());
+    m_head.store(m_head.load(std::memory_order_relaxed) + bytes, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_waiters.load(std::memory_order_relaxed) & ProducerWaiting)
+        wakeProducer();
+}
+
+/*!
+    Copies up to \a maxLength bytes into \a data and releases them. Returns
+    the number of bytes copied.
+*/
+qint64 QSpscRingBuffer::read(char *data, qint64 maxLength) noexcept
+{
+    const qint64 head = m_head.load(std::memory_order_relaxed);
+    const qint64 length = qMin(maxLength, m_tail.load(std::memory_order_acquire) - head);
+    if (length <= 0)
+        return 0;
+    const qint64 offset = head & (m_capacity - 1);
+    const qint64 first = m_doubleMapped ? length : qMin(length, m_capacity - offset);
+    memcpy(data, m_data + offset, size_t(first));
+    memcpy(data + first, m_data, size_t(length - first));
+    free(length);
+    return length;
+}
+
+/*!
+    Blocks the consumer until there is data to read, the producer called
+    closeWrite(), or \a deadline expires. Returns \c true unless the
+    deadline expired.
+*/
+bool QSpscRingBuffer::waitForData(QDeadlineTimer deadline)
+{
+    if (!isEmpty() || isWriteClosed())
+        return true;
+#if QT_CONFIG(thread)
+    QMutexLocker locker(&m_mutex);
+    m_waiters.fetch_or(ConsumerWaiting, std::memory_order_seq_cst);
+    bool result = true;
+    while (isEmpty() && !isWriteClosed()) {
+        if (!m_dataAvailable.wait(&m_mutex, deadline)) {
+            result = !isEmpty() || isWriteClosed();
+            break;
+        }
+    }
+    m_waiters.fetch_and(~ConsumerWaiting, std::memory_order_relaxed);
+    return result;
+#else
+    Q_UNUSED(deadline);
+    return false;
+#endif
+}
+
+/*!
+    Blocks the producer until there is free space, or \a deadline expires.
+    Returns \c true unless the deadline expired.
+*/
+bool QSpscRingBuffer::waitForSpace(QDeadlineTimer deadline)
+{
+    if (freeSpace())
+        return true;
+#if QT_CONFIG(thread)
+    QMutexLocker locker(&m_mutex);
+    m_waiters.fetch_or(ProducerWaiting, std::memory_order_seq_cst);
+    bool result = true;
+    while (!freeSpace()) {
+        if (!m_spaceAvailable.wait(&m_mutex, deadline)) {
+            result = freeSpace() != 0;
+            break;
+        }
+    }
+    m_waiters.fetch_and(~ProducerWaiting, std::memory_order_relaxed);
+    return result;
+#else
+    Q_UNUSED(deadline);
+    return false;
+#endif
+}
+
+/*!
+    Sets the function that the producer calls when it commits data, or
+    closes the write side, after the consumer armed the notification with
+    armReadNotification(). \a notifier is called with an internal mutex
+    locked, so it should do no more than post an event.
+*/
+void QSpscRingBuffer::setReadNotifier(std::function<void()> notifier)
+{
+    QMutexLocker locker(&m_mutex);
+    m_readNotifier = std::move(notifier);
+}
+
+/*!
+    Requests one call of the read notifier for the next commit. Data that
+    was committed before this call does not trigger it; compare
+    totalWritten() before and after arming to detect that case.
+*/
+void QSpscRingBuffer::armReadNotification() noexcept
+{
+    m_waiters.fetch_or(ReadNotificationArmed, std::memory_order_seq_cst);
+}
+
+void QSpscRingBuffer::wakeConsumer() noexcept
+{
+    QMutexLocker locker(&m_mutex);
+    const int waiters = m_waiters.fetch_and(~ReadNotificationArmed, std::memory_order_relaxed);
+    if ((waiters & ReadNotificationArmed) && m_readNotifier)
+        m_readNotifier();
+#if QT_CONFIG(thread)
+    if (waiters & ConsumerWaiting)
+        m_dataAvailable.wakeAll();
+#endif
+}
+
+void QSpscRingBuffer::wakeProducer() noexcept
+{
+#if QT_CONFIG(thread)
+    QMutexLocker locker(&m_mutex);
+    m_spaceAvailable.wakeAll();
+#endif
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,123 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSPSCRINGBUFFER_H
+#define QSPSCRINGBUFFER_H
+
+#include <QtCore/qglobal.h>
+#include <QtCore/qdeadlinetimer.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qwaitcondition.h>
+
+#include <atomic>
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+class Q_CORE_EXPORT QSpscRingBuffer
+{
+    Q_DISABLE_COPY_MOVE(QSpscRingBuffer)
+public:
+    enum MappingMode {
+        HeapAllocated,
+        DoubleMapped
+    };
+
+    explicit QSpscRingBuffer(qint64 minimumCapacity, MappingMode mode = DoubleMapped);
+    ~QSpscRingBuffer();
+
+    inline qint64 capacity() const noexcept { return m_capacity; }
+    inline bool isDoubleMapped() const noexcept { return m_doubleMapped; }
+
+    inline qint64 size() const noexcept
+    {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+    inline bool isEmpty() const noexcept { return size() == 0; }
+    inline qint64 freeSpace() const noexcept { return m_capacity - size(); }
+    inline qint64 totalWritten() const noexcept { return m_tail.load(std::memory_order_acquire); }
+
+    char *writePointer(qint64 &length) noexcept;
+    void commit(qint64 bytes) noexcept;
+    qint64 write(const char *data, qint64 size) noexcept;
+    void closeWrite() noexcept;
+    bool waitForSpace(QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever));
+
+    const char *readPointer(qint64 &length) const noexcept;
+    void free(qint64 bytes) noexcept;
+    qint64 read(char *data, qint64 maxLength) noexcept;
+    inline bool isWriteClosed() const noexcept
+    { return m_writeClosed.load(std::memory_order_acquire); }
+    inline bool atEnd() const noexcept { return isWriteClosed() && isEmpty(); }
+    bool waitForData(QDeadlineTimer deadline = QDeadlineTimer(QDeadlineTimer::Forever));
+
+    void setReadNotifier(std::function<void()> notifier);
+    void armReadNotification() noexcept;
+
+private:
+    void wakeConsumer() noexcept;
+    void wakeProducer() noexcept;
+
+    enum WaiterFlag {
+        ConsumerWaiting = 0x1,
+        ReadNotificationArmed = 0x2,
+        ProducerWaiting = 0x4
+    };
+
+    char *m_data = nullptr;
+    qint64 m_capacity = 0;
+    bool m_doubleMapped = false;
+
+    // each position is written by one side only; keep them on separate
+    // cache lines so that the two sides do not invalidate each other
+    alignas(64) std::atomic<qint64> m_head = 0;
+    alignas(64) std::atomic<qint64> m_tail = 0;
+    alignas(64) std::atomic<int> m_waiters = 0;
+    std::atomic<bool> m_writeClosed = false;
+
+    QMutex m_mutex;
+    QWaitCondition m_dataAvailable;
+    QWaitCondition m_spaceAvailable;
+    std::function<void()> m_readNotifier;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSPSCRINGBUFFER_H
@@ -42,7 +42,7 @@
 #ifndef QT_NO_TABLETEVENT
 
 #include <QtGui/qpointingdevice.h>
-#include <QtCore/private/qflatmap_p.h>
+#include <QtCore/qflatmap.h>
 
 Q_LOGGING_CATEGORY(lcQpaTablet, "qt.qpa.input.tablet")
 
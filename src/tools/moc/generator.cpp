@@ -462,6 +462,12 @@ void Generator::generateCode()
     if (hasStaticMetaCall)
         generateStaticMetacall();
 
+//
+// Generate typed property visitor
+//
+    if (cdef->hasPropertyVisitor)
+        generatePropertyVisitor();
+
 //
 // Build extra array
 //
@@ -1448,6 +1454,70 @@ void Generator::generateStaticMetacall()
     fprintf(out, "}\n\n");
 }
 
+void Generator::generatePropertyVisitor()
+{
+    fprintf(out, "void %s::qt_static_visitProperties(QPropertyVisitor &_v, void *_o)\n{\n",
+            cdef->qualified.constData());
+    fprintf(out, "    auto *_t = static_cast<%s *>(_o);\n", cdef->qualified.constData());
+    fprintf(out, "    (void)_t;\n");
+
+    if (!purestSuperClass.isEmpty())
+        fprintf(out, "    QtPrivate::visitBaseProperties< %s>(_v, _t);\n", purestSuperClass.constData());
+
+    for (const PropertyDef &p : qAsConst(cdef->propertyList)) {
+        if (p.stored == "false")
+            continue;
+        if (p.read.isEmpty() && p.member.isEmpty())
+            continue;
+        QByteArray prefix = "_t->";
+        if (p.inPrivateClass.size())
+            prefix += p.inPrivateClass + "->";
+
+        // A plain data member can be visited in place, unless it is constant
+        // or writing it has to emit a change signal.
+        if (p.read.isEmpty() && p.notify.isEmpty() && !p.constant) {
+            fprintf(out, "    QtPrivate::visitProperty(_v, QLatin1String(\"%s\"), %s%s);\n",
+                    p.name.constData(), prefix.constData(), p.member.constData());
+            continue;
+        }
+
+        fprintf(out, "    {\n");
+        if (!p.read.isEmpty())
+            fprintf(out, "        %s _p = %s%s%s();\n", p.type.constData(),
+                    p.gspec == PropertyDef::PointerSpec ? "*" : "",
+                    prefix.constData(), p.read.constData());
+        else
+            fprintf(out, "        %s _p = %s%s;\n", p.type.constData(),
+                    prefix.constData(), p.member.constData());
+        if (p.constant || (p.write.isEmpty() && p.member.isEmpty())) {
+            fprintf(out, "        QtPrivate::visitProperty(_v, QLatin1String(\"%s\"), _p);\n",
+                    p.name.constData());
+        } else if (!p.write.isEmpty()) {
+            fprintf(out, "        if (QtPrivate::visitProperty(_v, QLatin1String(\"%s\"), _p) && _v.isLoading())\n",
+                    p.name.constData());
+            fprintf(out, "            %s%s(std::move(_p));\n", prefix.constData(), p.write.constData());
+        } else {
+            fprintf(out, "        if (QtPrivate::visitProperty(_v, QLatin1String(\"%s\"), _p) && _v.isLoading()\n",
+                    p.name.constData());
+            fprintf(out, "                && %s%s != _p) {\n", prefix.constData(), p.member.constData());
+            fprintf(out, "            %s%s = std::move(_p);\n", prefix.constData(), p.member.constData());
+            if (p.notifyId > -1) {
+                const FunctionDef &f = cdef->signalList.at(p.notifyId);
+                if (f.arguments.size() == 0)
+                    fprintf(out, "            Q_EMIT _t->%s();\n", p.notify.constData());
+                else if (f.arguments.size() == 1 && f.arguments.at(0).normalizedType == p.type)
+                    fprintf(out, "            Q_EMIT _t->%s(%s%s);\n",
+                            p.notify.constData(), prefix.constData(), p.member.constData());
+            } else if (p.notifyId < -1) {
+                fprintf(out, "            Q_EMIT _t->%s();\n", p.notify.constData());
+            }
+            fprintf(out, "        }\n");
+        }
+        fprintf(out, "    }\n");
+    }
+    fprintf(out, "}\n\n");
+}
+
 void Generator::generateSignal(FunctionDef *def,int index)
 {
     if (def->wasCloned || def->isAbstract)
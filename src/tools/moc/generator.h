@@ -62,6 +62,7 @@ private:
     void generateProperties();
     void generateMetacall();
     void generateStaticMetacall();
+    void generatePropertyVisitor();
     void generateSignal(FunctionDef *def, int index);
     void generatePluginMetaData();
     QMultiMap<QByteArray, int> automaticPropertyMetaTypesHelper();
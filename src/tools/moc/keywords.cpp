@@ -30,12 +30,12 @@
 // DO NOT EDIT.
 
 static const short keyword_trans[][128] = {
-    {0,0,0,0,0,0,0,0,0,586,583,0,0,0,0,0,
+    {0,0,0,0,0,0,0,0,0,594,591,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-     586,252,584,587,8,38,239,585,25,26,236,234,30,235,27,237,
+     594,252,592,595,8,38,239,593,25,26,236,234,30,235,27,237,
      22,22,22,22,22,22,22,22,22,22,34,41,23,39,24,43,
      0,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,
-     8,21,8,8,8,8,8,8,8,8,8,31,589,32,238,8,
+     8,21,8,8,8,8,8,8,8,8,8,31,597,32,238,8,
      0,1,2,3,4,5,6,7,8,9,8,8,10,11,12,13,
      14,8,15,16,17,18,19,20,8,8,8,36,245,37,248,0},
     {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
@@ -116,7 +116,7 @@ static const short keyword_trans[][128] = {
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-     0,0,0,0,0,0,0,0,290,222,0,0,504,0,0,0,
+     0,0,0,0,0,0,0,0,290,222,0,0,512,0,0,0,
      0,0,0,0,55,0,0,330,0,0,0,0,0,0,0,0},
     {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
@@ -155,7 +155,7 @@ static const short keyword_trans[][128] = {
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-     0,0,0,0,528,0,0,0,0,0,0,0,0,0,0,357,
+     0,0,0,0,536,0,0,0,0,0,0,0,0,0,0,357,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
     {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
@@ -177,7 +177,7 @@ static const short keyword_trans[][128] = {
     {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,42,0,0,0,28,0,
-     592,592,592,592,592,592,592,592,592,592,0,0,0,0,0,0,
+     600,600,600,600,600,600,600,600,600,600,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
@@ -336,7 +336,7 @@ static const short keyword_trans[][128] = {
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
     {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-     0,0,0,0,0,0,0,0,0,0,591,0,0,0,0,590,
+     0,0,0,0,0,0,0,0,0,0,599,0,0,0,0,598,
      0,0,0,0,0,0,0,0,0,0,0,0,0,258,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
@@ -372,21 +372,21 @@ static const short keyword_trans[][128] = {
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-     0,501,0,0,0,300,0,0,0,0,0,0,0,0,0,0,
+     0,509,0,0,0,300,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
     {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-     0,0,0,482,431,415,423,380,0,491,0,0,0,572,364,358,
-     393,0,564,479,0,0,0,0,0,0,0,0,0,0,0,0,
+     0,0,0,490,439,423,431,380,0,499,0,0,0,580,364,358,
+     393,0,572,487,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
     {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-     0,0,0,0,0,0,0,0,0,0,0,0,401,0,0,0,
+     0,0,0,0,0,0,0,0,0,0,0,0,409,0,0,0,
      0,0,394,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
@@ -394,7 +394,7 @@ static const short keyword_trans[][128] = {
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-     0,0,0,0,0,0,0,0,0,518,0,0,0,0,0,395,
+     0,0,0,0,0,0,0,0,0,526,0,0,0,0,0,395,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
@@ -403,7 +403,7 @@ static const short keyword_trans[][128] = {
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-     0,0,0,419,0,0,0,0,0,0,0,0,0,0,0,420,
+     0,0,0,427,0,0,0,0,0,0,0,0,0,0,0,428,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
     {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
@@ -411,14 +411,14 @@ static const short keyword_trans[][128] = {
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-     0,0,0,427,0,0,0,0,0,0,0,0,0,0,0,428,
+     0,0,0,435,0,0,0,0,0,0,0,0,0,0,0,436,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
     {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-     0,0,0,0,0,461,439,0,0,444,0,0,0,453,0,0,
+     0,0,0,0,0,469,447,0,0,452,0,0,0,461,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
@@ -426,7 +426,7 @@ static const short keyword_trans[][128] = {
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-     0,0,0,547,0,480,0,0,0,508,0,0,514,0,0,0,
+     0,0,0,555,0,488,0,0,0,516,0,0,522,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
@@ -435,7 +435,7 @@ static const short keyword_trans[][128] = {
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-     0,0,0,0,493,0,540,0,0,0,0,0,0,0,0,0,
+     0,0,0,0,501,0,548,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
     {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
@@ -443,7 +443,7 @@ static const short keyword_trans[][128] = {
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-     556,0,0,524,0,0,0,0,0,0,0,0,0,0,0,0,
+     564,0,0,532,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
      0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}
 };
@@ -856,194 +856,202 @@ static const struct
     {CHARACTER, 0, 82, 398, CHARACTER},
     {CHARACTER, 0, 84, 399, CHARACTER},
     {CHARACTER, 0, 89, 400, CHARACTER},
-    {Q_PROPERTY_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 85, 402, CHARACTER},
-    {CHARACTER, 0, 71, 403, CHARACTER},
-    {CHARACTER, 0, 73, 404, CHARACTER},
-    {CHARACTER, 0, 78, 405, CHARACTER},
-    {CHARACTER, 0, 95, 406, CHARACTER},
-    {CHARACTER, 0, 77, 407, CHARACTER},
-    {CHARACTER, 0, 69, 408, CHARACTER},
-    {CHARACTER, 0, 84, 409, CHARACTER},
-    {CHARACTER, 0, 65, 410, CHARACTER},
-    {CHARACTER, 0, 68, 411, CHARACTER},
-    {CHARACTER, 0, 65, 412, CHARACTER},
-    {CHARACTER, 0, 84, 413, CHARACTER},
-    {CHARACTER, 0, 65, 414, CHARACTER},
+    {Q_PROPERTY_TOKEN, 0, 95, 401, CHARACTER},
+    {CHARACTER, 0, 86, 402, CHARACTER},
+    {CHARACTER, 0, 73, 403, CHARACTER},
+    {CHARACTER, 0, 83, 404, CHARACTER},
+    {CHARACTER, 0, 73, 405, CHARACTER},
+    {CHARACTER, 0, 84, 406, CHARACTER},
+    {CHARACTER, 0, 79, 407, CHARACTER},
+    {CHARACTER, 0, 82, 408, CHARACTER},
+    {Q_PROPERTY_VISITOR_TOKEN, 0, 0, 0, CHARACTER},
+    {CHARACTER, 0, 85, 410, CHARACTER},
+    {CHARACTER, 0, 71, 411, CHARACTER},
+    {CHARACTER, 0, 73, 412, CHARACTER},
+    {CHARACTER, 0, 78, 413, CHARACTER},
+    {CHARACTER, 0, 95, 414, CHARACTER},
+    {CHARACTER, 0, 77, 415, CHARACTER},
+    {CHARACTER, 0, 69, 416, CHARACTER},
+    {CHARACTER, 0, 84, 417, CHARACTER},
+    {CHARACTER, 0, 65, 418, CHARACTER},
+    {CHARACTER, 0, 68, 419, CHARACTER},
+    {CHARACTER, 0, 65, 420, CHARACTER},
+    {CHARACTER, 0, 84, 421, CHARACTER},
+    {CHARACTER, 0, 65, 422, CHARACTER},
     {Q_PLUGIN_METADATA_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 78, 416, CHARACTER},
-    {CHARACTER, 0, 85, 417, CHARACTER},
-    {CHARACTER, 0, 77, 418, CHARACTER},
+    {CHARACTER, 0, 78, 424, CHARACTER},
+    {CHARACTER, 0, 85, 425, CHARACTER},
+    {CHARACTER, 0, 77, 426, CHARACTER},
     {Q_ENUM_TOKEN, 46, 0, 0, CHARACTER},
     {Q_ENUMS_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 78, 421, CHARACTER},
-    {CHARACTER, 0, 83, 422, CHARACTER},
+    {CHARACTER, 0, 78, 429, CHARACTER},
+    {CHARACTER, 0, 83, 430, CHARACTER},
     {Q_ENUM_NS_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 76, 424, CHARACTER},
-    {CHARACTER, 0, 65, 425, CHARACTER},
-    {CHARACTER, 0, 71, 426, CHARACTER},
+    {CHARACTER, 0, 76, 432, CHARACTER},
+    {CHARACTER, 0, 65, 433, CHARACTER},
+    {CHARACTER, 0, 71, 434, CHARACTER},
     {Q_FLAG_TOKEN, 47, 0, 0, CHARACTER},
     {Q_FLAGS_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 78, 429, CHARACTER},
-    {CHARACTER, 0, 83, 430, CHARACTER},
+    {CHARACTER, 0, 78, 437, CHARACTER},
+    {CHARACTER, 0, 83, 438, CHARACTER},
     {Q_FLAG_NS_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 69, 432, CHARACTER},
-    {CHARACTER, 0, 67, 433, CHARACTER},
-    {CHARACTER, 0, 76, 434, CHARACTER},
-    {CHARACTER, 0, 65, 435, CHARACTER},
-    {CHARACTER, 0, 82, 436, CHARACTER},
-    {CHARACTER, 0, 69, 437, CHARACTER},
-    {CHARACTER, 0, 95, 438, CHARACTER},
+    {CHARACTER, 0, 69, 440, CHARACTER},
+    {CHARACTER, 0, 67, 441, CHARACTER},
+    {CHARACTER, 0, 76, 442, CHARACTER},
+    {CHARACTER, 0, 65, 443, CHARACTER},
+    {CHARACTER, 0, 82, 444, CHARACTER},
+    {CHARACTER, 0, 69, 445, CHARACTER},
+    {CHARACTER, 0, 95, 446, CHARACTER},
     {CHARACTER, 48, 0, 0, CHARACTER},
-    {CHARACTER, 0, 76, 440, CHARACTER},
-    {CHARACTER, 0, 65, 441, CHARACTER},
-    {CHARACTER, 0, 71, 442, CHARACTER},
-    {CHARACTER, 0, 83, 443, CHARACTER},
+    {CHARACTER, 0, 76, 448, CHARACTER},
+    {CHARACTER, 0, 65, 449, CHARACTER},
+    {CHARACTER, 0, 71, 450, CHARACTER},
+    {CHARACTER, 0, 83, 451, CHARACTER},
     {Q_DECLARE_FLAGS_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 78, 445, CHARACTER},
-    {CHARACTER, 0, 84, 446, CHARACTER},
-    {CHARACTER, 0, 69, 447, CHARACTER},
-    {CHARACTER, 0, 82, 448, CHARACTER},
-    {CHARACTER, 0, 70, 449, CHARACTER},
-    {CHARACTER, 0, 65, 450, CHARACTER},
-    {CHARACTER, 0, 67, 451, CHARACTER},
-    {CHARACTER, 0, 69, 452, CHARACTER},
-    {Q_DECLARE_INTERFACE_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 69, 454, CHARACTER},
-    {CHARACTER, 0, 84, 455, CHARACTER},
-    {CHARACTER, 0, 65, 456, CHARACTER},
-    {CHARACTER, 0, 84, 457, CHARACTER},
-    {CHARACTER, 0, 89, 458, CHARACTER},
-    {CHARACTER, 0, 80, 459, CHARACTER},
+    {CHARACTER, 0, 78, 453, CHARACTER},
+    {CHARACTER, 0, 84, 454, CHARACTER},
+    {CHARACTER, 0, 69, 455, CHARACTER},
+    {CHARACTER, 0, 82, 456, CHARACTER},
+    {CHARACTER, 0, 70, 457, CHARACTER},
+    {CHARACTER, 0, 65, 458, CHARACTER},
+    {CHARACTER, 0, 67, 459, CHARACTER},
     {CHARACTER, 0, 69, 460, CHARACTER},
-    {Q_DECLARE_METATYPE_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 88, 462, CHARACTER},
+    {Q_DECLARE_INTERFACE_TOKEN, 0, 0, 0, CHARACTER},
+    {CHARACTER, 0, 69, 462, CHARACTER},
     {CHARACTER, 0, 84, 463, CHARACTER},
-    {CHARACTER, 0, 69, 464, CHARACTER},
-    {CHARACTER, 0, 78, 465, CHARACTER},
-    {CHARACTER, 0, 83, 466, CHARACTER},
-    {CHARACTER, 0, 73, 467, CHARACTER},
-    {CHARACTER, 0, 79, 468, CHARACTER},
-    {CHARACTER, 0, 78, 469, CHARACTER},
-    {CHARACTER, 0, 95, 470, CHARACTER},
-    {CHARACTER, 0, 73, 471, CHARACTER},
-    {CHARACTER, 0, 78, 472, CHARACTER},
-    {CHARACTER, 0, 84, 473, CHARACTER},
-    {CHARACTER, 0, 69, 474, CHARACTER},
-    {CHARACTER, 0, 82, 475, CHARACTER},
-    {CHARACTER, 0, 70, 476, CHARACTER},
-    {CHARACTER, 0, 65, 477, CHARACTER},
-    {CHARACTER, 0, 67, 478, CHARACTER},
-    {CHARACTER, 0, 69, 452, CHARACTER},
-    {CHARACTER, 49, 0, 0, CHARACTER},
+    {CHARACTER, 0, 65, 464, CHARACTER},
+    {CHARACTER, 0, 84, 465, CHARACTER},
+    {CHARACTER, 0, 89, 466, CHARACTER},
+    {CHARACTER, 0, 80, 467, CHARACTER},
+    {CHARACTER, 0, 69, 468, CHARACTER},
+    {Q_DECLARE_METATYPE_TOKEN, 0, 0, 0, CHARACTER},
+    {CHARACTER, 0, 88, 470, CHARACTER},
+    {CHARACTER, 0, 84, 471, CHARACTER},
+    {CHARACTER, 0, 69, 472, CHARACTER},
+    {CHARACTER, 0, 78, 473, CHARACTER},
+    {CHARACTER, 0, 83, 474, CHARACTER},
+    {CHARACTER, 0, 73, 475, CHARACTER},
+    {CHARACTER, 0, 79, 476, CHARACTER},
+    {CHARACTER, 0, 78, 477, CHARACTER},
+    {CHARACTER, 0, 95, 478, CHARACTER},
+    {CHARACTER, 0, 73, 479, CHARACTER},
+    {CHARACTER, 0, 78, 480, CHARACTER},
     {CHARACTER, 0, 84, 481, CHARACTER},
-    {CHARACTER, 0, 83, 427, CHARACTER},
-    {CHARACTER, 0, 76, 483, CHARACTER},
-    {CHARACTER, 0, 65, 484, CHARACTER},
-    {CHARACTER, 0, 83, 485, CHARACTER},
-    {CHARACTER, 0, 83, 486, CHARACTER},
-    {CHARACTER, 0, 73, 487, CHARACTER},
-    {CHARACTER, 0, 78, 488, CHARACTER},
-    {CHARACTER, 0, 70, 489, CHARACTER},
-    {CHARACTER, 0, 79, 490, CHARACTER},
+    {CHARACTER, 0, 69, 482, CHARACTER},
+    {CHARACTER, 0, 82, 483, CHARACTER},
+    {CHARACTER, 0, 70, 484, CHARACTER},
+    {CHARACTER, 0, 65, 485, CHARACTER},
+    {CHARACTER, 0, 67, 486, CHARACTER},
+    {CHARACTER, 0, 69, 460, CHARACTER},
+    {CHARACTER, 49, 0, 0, CHARACTER},
+    {CHARACTER, 0, 84, 489, CHARACTER},
+    {CHARACTER, 0, 83, 435, CHARACTER},
+    {CHARACTER, 0, 76, 491, CHARACTER},
+    {CHARACTER, 0, 65, 492, CHARACTER},
+    {CHARACTER, 0, 83, 493, CHARACTER},
+    {CHARACTER, 0, 83, 494, CHARACTER},
+    {CHARACTER, 0, 73, 495, CHARACTER},
+    {CHARACTER, 0, 78, 496, CHARACTER},
+    {CHARACTER, 0, 70, 497, CHARACTER},
+    {CHARACTER, 0, 79, 498, CHARACTER},
     {Q_CLASSINFO_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 78, 492, CHARACTER},
+    {CHARACTER, 0, 78, 500, CHARACTER},
     {CHARACTER, 50, 0, 0, CHARACTER},
-    {CHARACTER, 0, 69, 494, CHARACTER},
-    {CHARACTER, 0, 82, 495, CHARACTER},
-    {CHARACTER, 0, 70, 496, CHARACTER},
-    {CHARACTER, 0, 65, 497, CHARACTER},
-    {CHARACTER, 0, 67, 498, CHARACTER},
-    {CHARACTER, 0, 69, 499, CHARACTER},
-    {CHARACTER, 0, 83, 500, CHARACTER},
+    {CHARACTER, 0, 69, 502, CHARACTER},
+    {CHARACTER, 0, 82, 503, CHARACTER},
+    {CHARACTER, 0, 70, 504, CHARACTER},
+    {CHARACTER, 0, 65, 505, CHARACTER},
+    {CHARACTER, 0, 67, 506, CHARACTER},
+    {CHARACTER, 0, 69, 507, CHARACTER},
+    {CHARACTER, 0, 83, 508, CHARACTER},
     {Q_INTERFACES_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 108, 502, CHARACTER},
-    {CHARACTER, 0, 115, 503, CHARACTER},
+    {CHARACTER, 0, 108, 510, CHARACTER},
+    {CHARACTER, 0, 115, 511, CHARACTER},
     {SIGNALS, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 111, 505, CHARACTER},
-    {CHARACTER, 0, 116, 506, CHARACTER},
-    {CHARACTER, 0, 115, 507, CHARACTER},
+    {CHARACTER, 0, 111, 513, CHARACTER},
+    {CHARACTER, 0, 116, 514, CHARACTER},
+    {CHARACTER, 0, 115, 515, CHARACTER},
     {SLOTS, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 71, 509, CHARACTER},
-    {CHARACTER, 0, 78, 510, CHARACTER},
-    {CHARACTER, 0, 65, 511, CHARACTER},
-    {CHARACTER, 0, 76, 512, CHARACTER},
-    {Q_SIGNAL_TOKEN, 0, 83, 513, CHARACTER},
+    {CHARACTER, 0, 71, 517, CHARACTER},
+    {CHARACTER, 0, 78, 518, CHARACTER},
+    {CHARACTER, 0, 65, 519, CHARACTER},
+    {CHARACTER, 0, 76, 520, CHARACTER},
+    {Q_SIGNAL_TOKEN, 0, 83, 521, CHARACTER},
     {Q_SIGNALS_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 79, 515, CHARACTER},
-    {CHARACTER, 0, 84, 516, CHARACTER},
-    {Q_SLOT_TOKEN, 0, 83, 517, CHARACTER},
+    {CHARACTER, 0, 79, 523, CHARACTER},
+    {CHARACTER, 0, 84, 524, CHARACTER},
+    {Q_SLOT_TOKEN, 0, 83, 525, CHARACTER},
     {Q_SLOTS_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 86, 519, CHARACTER},
-    {CHARACTER, 0, 65, 520, CHARACTER},
-    {CHARACTER, 0, 84, 521, CHARACTER},
-    {CHARACTER, 0, 69, 522, CHARACTER},
-    {CHARACTER, 0, 95, 523, CHARACTER},
+    {CHARACTER, 0, 86, 527, CHARACTER},
+    {CHARACTER, 0, 65, 528, CHARACTER},
+    {CHARACTER, 0, 84, 529, CHARACTER},
+    {CHARACTER, 0, 69, 530, CHARACTER},
+    {CHARACTER, 0, 95, 531, CHARACTER},
     {CHARACTER, 51, 0, 0, CHARACTER},
-    {CHARACTER, 0, 76, 525, CHARACTER},
-    {CHARACTER, 0, 79, 526, CHARACTER},
-    {CHARACTER, 0, 84, 527, CHARACTER},
+    {CHARACTER, 0, 76, 533, CHARACTER},
+    {CHARACTER, 0, 79, 534, CHARACTER},
+    {CHARACTER, 0, 84, 535, CHARACTER},
     {Q_PRIVATE_SLOT_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 95, 529, CHARACTER},
-    {CHARACTER, 0, 77, 530, CHARACTER},
-    {CHARACTER, 0, 79, 531, CHARACTER},
-    {CHARACTER, 0, 67, 532, CHARACTER},
-    {CHARACTER, 0, 95, 533, CHARACTER},
-    {CHARACTER, 0, 67, 534, CHARACTER},
-    {CHARACTER, 0, 79, 535, CHARACTER},
-    {CHARACTER, 0, 77, 536, CHARACTER},
-    {CHARACTER, 0, 80, 537, CHARACTER},
-    {CHARACTER, 0, 65, 538, CHARACTER},
-    {CHARACTER, 0, 84, 539, CHARACTER},
+    {CHARACTER, 0, 95, 537, CHARACTER},
+    {CHARACTER, 0, 77, 538, CHARACTER},
+    {CHARACTER, 0, 79, 539, CHARACTER},
+    {CHARACTER, 0, 67, 540, CHARACTER},
+    {CHARACTER, 0, 95, 541, CHARACTER},
+    {CHARACTER, 0, 67, 542, CHARACTER},
+    {CHARACTER, 0, 79, 543, CHARACTER},
+    {CHARACTER, 0, 77, 544, CHARACTER},
+    {CHARACTER, 0, 80, 545, CHARACTER},
+    {CHARACTER, 0, 65, 546, CHARACTER},
+    {CHARACTER, 0, 84, 547, CHARACTER},
     {Q_MOC_COMPAT_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 79, 541, CHARACTER},
-    {CHARACTER, 0, 75, 542, CHARACTER},
-    {CHARACTER, 0, 65, 543, CHARACTER},
-    {CHARACTER, 0, 66, 544, CHARACTER},
-    {CHARACTER, 0, 76, 545, CHARACTER},
-    {CHARACTER, 0, 69, 546, CHARACTER},
+    {CHARACTER, 0, 79, 549, CHARACTER},
+    {CHARACTER, 0, 75, 550, CHARACTER},
+    {CHARACTER, 0, 65, 551, CHARACTER},
+    {CHARACTER, 0, 66, 552, CHARACTER},
+    {CHARACTER, 0, 76, 553, CHARACTER},
+    {CHARACTER, 0, 69, 554, CHARACTER},
     {Q_INVOKABLE_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 82, 548, CHARACTER},
-    {CHARACTER, 0, 73, 549, CHARACTER},
-    {CHARACTER, 0, 80, 550, CHARACTER},
-    {CHARACTER, 0, 84, 551, CHARACTER},
-    {CHARACTER, 0, 65, 552, CHARACTER},
-    {CHARACTER, 0, 66, 553, CHARACTER},
-    {CHARACTER, 0, 76, 554, CHARACTER},
-    {CHARACTER, 0, 69, 555, CHARACTER},
+    {CHARACTER, 0, 82, 556, CHARACTER},
+    {CHARACTER, 0, 73, 557, CHARACTER},
+    {CHARACTER, 0, 80, 558, CHARACTER},
+    {CHARACTER, 0, 84, 559, CHARACTER},
+    {CHARACTER, 0, 65, 560, CHARACTER},
+    {CHARACTER, 0, 66, 561, CHARACTER},
+    {CHARACTER, 0, 76, 562, CHARACTER},
+    {CHARACTER, 0, 69, 563, CHARACTER},
     {Q_SCRIPTABLE_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 82, 557, CHARACTER},
-    {CHARACTER, 0, 79, 558, CHARACTER},
-    {CHARACTER, 0, 80, 559, CHARACTER},
-    {CHARACTER, 0, 69, 560, CHARACTER},
-    {CHARACTER, 0, 82, 561, CHARACTER},
-    {CHARACTER, 0, 84, 562, CHARACTER},
-    {CHARACTER, 0, 89, 563, CHARACTER},
+    {CHARACTER, 0, 82, 565, CHARACTER},
+    {CHARACTER, 0, 79, 566, CHARACTER},
+    {CHARACTER, 0, 80, 567, CHARACTER},
+    {CHARACTER, 0, 69, 568, CHARACTER},
+    {CHARACTER, 0, 82, 569, CHARACTER},
+    {CHARACTER, 0, 84, 570, CHARACTER},
+    {CHARACTER, 0, 89, 571, CHARACTER},
     {Q_PRIVATE_PROPERTY_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 69, 565, CHARACTER},
-    {CHARACTER, 0, 86, 566, CHARACTER},
-    {CHARACTER, 0, 73, 567, CHARACTER},
-    {CHARACTER, 0, 83, 568, CHARACTER},
-    {CHARACTER, 0, 73, 569, CHARACTER},
-    {CHARACTER, 0, 79, 570, CHARACTER},
-    {CHARACTER, 0, 78, 571, CHARACTER},
+    {CHARACTER, 0, 69, 573, CHARACTER},
+    {CHARACTER, 0, 86, 574, CHARACTER},
+    {CHARACTER, 0, 73, 575, CHARACTER},
+    {CHARACTER, 0, 83, 576, CHARACTER},
+    {CHARACTER, 0, 73, 577, CHARACTER},
+    {CHARACTER, 0, 79, 578, CHARACTER},
+    {CHARACTER, 0, 78, 579, CHARACTER},
     {Q_REVISION_TOKEN, 0, 0, 0, CHARACTER},
-    {CHARACTER, 0, 79, 573, CHARACTER},
-    {CHARACTER, 0, 67, 574, CHARACTER},
-    {CHARACTER, 0, 95, 575, CHARACTER},
-    {CHARACTER, 0, 73, 576, CHARACTER},
-    {CHARACTER, 0, 78, 577, CHARACTER},
-    {CHARACTER, 0, 67, 578, CHARACTER},
-    {CHARACTER, 0, 76, 579, CHARACTER},
-    {CHARACTER, 0, 85, 580, CHARACTER},
-    {CHARACTER, 0, 68, 581, CHARACTER},
-    {CHARACTER, 0, 69, 582, CHARACTER},
+    {CHARACTER, 0, 79, 581, CHARACTER},
+    {CHARACTER, 0, 67, 582, CHARACTER},
+    {CHARACTER, 0, 95, 583, CHARACTER},
+    {CHARACTER, 0, 73, 584, CHARACTER},
+    {CHARACTER, 0, 78, 585, CHARACTER},
+    {CHARACTER, 0, 67, 586, CHARACTER},
+    {CHARACTER, 0, 76, 587, CHARACTER},
+    {CHARACTER, 0, 85, 588, CHARACTER},
+    {CHARACTER, 0, 68, 589, CHARACTER},
+    {CHARACTER, 0, 69, 590, CHARACTER},
     {Q_MOC_INCLUDE_TOKEN, 0, 0, 0, CHARACTER},
     {NEWLINE, 0, 0, 0, NOTOKEN},
     {QUOTE, 0, 0, 0, NOTOKEN},
     {SINGLEQUOTE, 0, 0, 0, NOTOKEN},
     {WHITESPACE, 0, 0, 0, NOTOKEN},
-    {HASH, 0, 35, 588, HASH},
+    {HASH, 0, 35, 596, HASH},
     {PP_HASHHASH, 0, 0, 0, NOTOKEN},
     {BACKSLASH, 0, 0, 0, NOTOKEN},
     {CPP_COMMENT, 0, 0, 0, NOTOKEN},
@@ -867,6 +867,9 @@ void Moc::parse()
                 case Q_PROPERTY_TOKEN:
                     parseProperty(&def);
                     break;
+                case Q_PROPERTY_VISITOR_TOKEN:
+                    def.hasPropertyVisitor = true;
+                    break;
                 case Q_PLUGIN_METADATA_TOKEN:
                     parsePluginData(&def);
                     break;
@@ -1110,6 +1113,9 @@ void Moc::generate(FILE *out, FILE *jsonOutput)
 
     fprintf(out, "#include <QtCore/qbytearray.h>\n"); // For QByteArrayData
     fprintf(out, "#include <QtCore/qmetatype.h>\n");  // For QMetaType::Type
+    if (std::any_of(classList.cbegin(), classList.cend(),
+                    [](const ClassDef &def) { return def.hasPropertyVisitor; }))
+        fprintf(out, "#include <QtCore/qpropertyvisitor.h>\n");
     if (mustIncludeQPluginH)
         fprintf(out, "#include <QtCore/qplugin.h>\n");
 
@@ -1963,6 +1969,8 @@ QJsonObject ClassDef::toJson() const
         cls[QLatin1String("gadget")] = true;
     if (hasQNamespace)
         cls[QLatin1String("namespace")] = true;
+    if (hasPropertyVisitor)
+        cls[QLatin1String("propertyVisitor")] = true;
 
     QJsonArray superClasses;
 
@@ -205,6 +205,7 @@ struct ClassDef : BaseDef {
     bool hasQObject = false;
     bool hasQGadget = false;
     bool hasQNamespace = false;
+    bool hasPropertyVisitor = false;
     bool requireCompleteMethodTypes = false;
 
     QJsonObject toJson() const;
@@ -155,6 +155,7 @@ QT_BEGIN_NAMESPACE
     F(Q_OBJECT_TOKEN) \
     F(Q_GADGET_TOKEN) \
     F(Q_GADGET_EXPORT_TOKEN) \
+    F(Q_PROPERTY_VISITOR_TOKEN) \
     F(Q_NAMESPACE_TOKEN) \
     F(Q_NAMESPACE_EXPORT_TOKEN) \
     F(Q_PROPERTY_TOKEN) \
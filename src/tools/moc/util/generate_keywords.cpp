@@ -218,6 +218,7 @@ static const Keyword keywords[] = {
     { "Q_GADGET", "Q_GADGET_TOKEN" },
     { "Q_GADGET_EXPORT", "Q_GADGET_EXPORT_TOKEN" },
     { "Q_PROPERTY", "Q_PROPERTY_TOKEN" },
+    { "Q_PROPERTY_VISITOR", "Q_PROPERTY_VISITOR_TOKEN" },
     { "Q_PLUGIN_METADATA", "Q_PLUGIN_METADATA_TOKEN" },
     { "Q_ENUMS", "Q_ENUMS_TOKEN" },
     { "Q_ENUM", "Q_ENUM_TOKEN" },
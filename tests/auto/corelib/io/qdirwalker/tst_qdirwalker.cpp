@@ -0,0 +1,276 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+
+#include <qdirwalker.h>
+#include <qdiriterator.h>
+#include <qfileinfo.h>
+#include <qmutex.h>
+#include <qset.h>
+#include <qtemporarydir.h>
+
+#include <atomic>
+
+#if defined(Q_OS_VXWORKS)
+#define Q_NO_SYMLINKS
+#endif
+
+Q_DECLARE_METATYPE(QDir::Filters)
+Q_DECLARE_METATYPE(QDirWalker::WalkerFlags)
+
+class tst_QDirWalker : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void sameEntriesAsQDirIterator_data();
+    void sameEntriesAsQDirIterator();
+    void entryInformation_data();
+    void entryInformation();
+    void trailingSlash();
+    void nonExistentPath();
+    void maxThreadCount();
+
+private:
+    bool createFile(const QString &path, const QByteArray &contents = QByteArray());
+
+    QTemporaryDir tempDir;
+    QString root;
+};
+
+bool tst_QDirWalker::createFile(const QString &path, const QByteArray &contents)
+{
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly) && file.write(contents) == contents.size();
+}
+
+void tst_QDirWalker::initTestCase()
+{
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    root = tempDir.path() + QLatin1String("/tree");
+
+    QDir dir(tempDir.path());
+    QVERIFY(dir.mkpath(QLatin1String("tree/dir1/sub")));
+    QVERIFY(dir.mkpath(QLatin1String("tree/dir2")));
+    QVERIFY(dir.mkpath(QLatin1String("tree/.hiddendir/inner")));
+    QVERIFY(dir.mkpath(QLatin1String("outside")));
+
+    QVERIFY(createFile(root + QLatin1String("/a.txt"), "hello"));
+    QVERIFY(createFile(root + QLatin1String("/b.dat"), QByteArray(1000, 'b')));
+    QVERIFY(createFile(root + QLatin1String("/.hidden.txt")));
+    QVERIFY(createFile(root + QLatin1String("/dir1/c.txt")));
+    QVERIFY(createFile(root + QLatin1String("/dir1/sub/d.TXT")));
+    QVERIFY(createFile(root + QLatin1String("/.hiddendir/e.txt")));
+    QVERIFY(createFile(root + QLatin1String("/.hiddendir/inner/f.dat")));
+    QVERIFY(createFile(tempDir.path() + QLatin1String("/outside/g.txt")));
+
+    // enough directories to keep several threads busy
+    QString path = root + QLatin1String("/wide");
+    for (int i = 0; i < 40; ++i) {
+        const QString subdir = path + QLatin1String("/d") + QString::number(i);
+        QVERIFY(dir.mkpath(subdir + QLatin1String("/deeper")));
+        for (int j = 0; j < 10; ++j)
+            QVERIFY(createFile(subdir + QLatin1String("/f") + QString::number(j) + QLatin1String(".txt")));
+        QVERIFY(createFile(subdir + QLatin1String("/deeper/x.dat")));
+    }
+
+#ifndef Q_NO_SYMLINKS
+    QVERIFY(QFile::link(root + QLatin1String("/a.txt"), root + QLatin1String("/linkToFile")));
+    QVERIFY(QFile::link(tempDir.path() + QLatin1String("/outside"),
+                        root + QLatin1String("/linkToOutside")));
+    QVERIFY(QFile::link(root + QLatin1String("/nonexistent"), root + QLatin1String("/brokenLink")));
+    // a loop back to an ancestor
+    QVERIFY(QFile::link(root + QLatin1String("/dir1"), root + QLatin1String("/dir1/sub/up")));
+#endif
+}
+
+void tst_QDirWalker::sameEntriesAsQDirIterator_data()
+{
+    QTest::addColumn<QStringList>("nameFilters");
+    QTest::addColumn<QDir::Filters>("filters");
+    QTest::addColumn<QDirWalker::WalkerFlags>("flags");
+    QTest::addColumn<int>("threads");
+
+    const QDirWalker::WalkerFlags noFlags = QDirWalker::NoWalkerFlags;
+    for (int threads : { 1, 4 }) {
+        const QByteArray suffix = threads == 1 ? " (1 thread)" : " (4 threads)";
+        QTest::newRow("default" + suffix) << QStringList() << QDir::Filters(QDir::NoFilter)
+                                          << noFlags << threads;
+        QTest::newRow("files" + suffix) << QStringList() << QDir::Filters(QDir::Files)
+                                        << noFlags << threads;
+        QTest::newRow("dirs" + suffix) << QStringList() << QDir::Filters(QDir::Dirs)
+                                       << noFlags << threads;
+        QTest::newRow("hidden" + suffix) << QStringList()
+                                         << QDir::Filters(QDir::AllEntries | QDir::Hidden)
+                                         << noFlags << threads;
+        QTest::newRow("system" + suffix) << QStringList()
+                                         << QDir::Filters(QDir::AllEntries | QDir::System)
+                                         << noFlags << threads;
+        QTest::newRow("nosymlinks" + suffix) << QStringList()
+                                             << QDir::Filters(QDir::AllEntries | QDir::NoSymLinks)
+                                             << noFlags << threads;
+        QTest::newRow("namefilter" + suffix) << QStringList{ QLatin1String("*.txt") }
+                                             << QDir::Filters(QDir::NoFilter)
+                                             << noFlags << threads;
+        QTest::newRow("namefilter-casesensitive" + suffix)
+                << QStringList{ QLatin1String("*.txt") }
+                << QDir::Filters(QDir::Files | QDir::CaseSensitive) << noFlags << threads;
+        QTest::newRow("namefilter-alldirs" + suffix)
+                << QStringList{ QLatin1String("*.dat") }
+                << QDir::Filters(QDir::Files | QDir::AllDirs) << noFlags << threads;
+        QTest::newRow("followsymlinks" + suffix)
+                << QStringList() << QDir::Filters(QDir::AllEntries | QDir::System)
+                << QDirWalker::WalkerFlags(QDirWalker::FollowSymlinks) << threads;
+    }
+}
+
+void tst_QDirWalker::sameEntriesAsQDirIterator()
+{
+    QFETCH(QStringList, nameFilters);
+    QFETCH(QDir::Filters, filters);
+    QFETCH(QDirWalker::WalkerFlags, flags);
+    QFETCH(int, threads);
+
+    QDirIterator::IteratorFlags iteratorFlags = QDirIterator::Subdirectories;
+    if (flags & QDirWalker::FollowSymlinks)
+        iteratorFlags |= QDirIterator::FollowSymlinks;
+    const QDir::Filters iteratorFilters =
+            (filters == QDir::NoFilter ? QDir::Filters(QDir::AllEntries) : filters)
+            | QDir::NoDotAndDotDot;
+    QSet<QString> expected;
+    QDirIterator it(root, nameFilters, iteratorFilters, iteratorFlags);
+    while (it.hasNext())
+        expected.insert(it.next());
+    QVERIFY(!expected.isEmpty());
+
+    QMutex mutex;
+    QSet<QString> visited;
+    QStringList duplicates;
+    QDirWalker walker(root, nameFilters, filters, flags);
+    walker.setMaxThreadCount(threads);
+    walker.walk([&](const QDirWalker::Entry &entry) {
+        const QString path = entry.filePath();
+        QMutexLocker locker(&mutex);
+        if (visited.contains(path))
+            duplicates.append(path);
+        visited.insert(path);
+    });
+
+    QVERIFY2(duplicates.isEmpty(), qPrintable(duplicates.join(QLatin1String(", "))));
+    QCOMPARE(visited, expected);
+}
+
+void tst_QDirWalker::entryInformation_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("4 threads") << 4;
+}
+
+void tst_QDirWalker::entryInformation()
+{
+    QFETCH(int, threads);
+
+    QMutex mutex;
+    QStringList mismatches;
+    std::atomic<int> count = 0;
+    auto check = [&](const QDirWalker::Entry &entry, const char *what, bool ok) {
+        if (!ok) {
+            QMutexLocker locker(&mutex);
+            mismatches.append(entry.filePath() + QLatin1Char(' ') + QLatin1String(what));
+        }
+    };
+
+    QDirWalker walker(root, QDir::AllEntries | QDir::Hidden | QDir::System);
+    walker.setMaxThreadCount(threads);
+    walker.walk([&](const QDirWalker::Entry &entry) {
+        ++count;
+        const QFileInfo fi(entry.filePath());
+        check(entry, "fileName", entry.fileName() == fi.fileName());
+        check(entry, "path", entry.path() == fi.path());
+        check(entry, "isDir", entry.isDir() == fi.isDir());
+        check(entry, "isFile", entry.isFile() == fi.isFile());
+        check(entry, "isSymLink", entry.isSymLink() == fi.isSymLink());
+        check(entry, "size", entry.size() == fi.size());
+        check(entry, "lastModified", entry.lastModified() == fi.lastModified());
+        const QFileInfo entryInfo = entry.fileInfo();
+        check(entry, "fileInfo", entryInfo.filePath() == fi.filePath()
+                                 && entryInfo.isDir() == fi.isDir()
+                                 && entryInfo.isSymLink() == fi.isSymLink()
+                                 && entryInfo.size() == fi.size());
+    });
+
+    QVERIFY2(mismatches.isEmpty(), qPrintable(mismatches.join(QLatin1String(", "))));
+    QVERIFY(count > 400);
+}
+
+void tst_QDirWalker::trailingSlash()
+{
+    QStringList paths;
+    QDirWalker walker(root + QLatin1String("/dir1/"), QDir::Files);
+    walker.setMaxThreadCount(1);
+    walker.walk([&](const QDirWalker::Entry &entry) {
+        paths.append(entry.filePath());
+        QCOMPARE(entry.path(), entry.fileName() == QLatin1String("c.txt")
+                                       ? root + QLatin1String("/dir1/")
+                                       : root + QLatin1String("/dir1/sub"));
+    });
+    paths.sort();
+    QCOMPARE(paths, QStringList({ root + QLatin1String("/dir1/c.txt"),
+                                  root + QLatin1String("/dir1/sub/d.TXT") }));
+}
+
+void tst_QDirWalker::nonExistentPath()
+{
+    bool visited = false;
+    QDirWalker walker(root + QLatin1String("/nonexistent"));
+    walker.walk([&](const QDirWalker::Entry &) { visited = true; });
+    QVERIFY(!visited);
+
+    QDirWalker fileWalker(root + QLatin1String("/a.txt"));
+    fileWalker.walk([&](const QDirWalker::Entry &) { visited = true; });
+    QVERIFY(!visited);
+}
+
+void tst_QDirWalker::maxThreadCount()
+{
+    QDirWalker walker(root);
+    QVERIFY(walker.maxThreadCount() >= 1);
+    walker.setMaxThreadCount(3);
+    QCOMPARE(walker.maxThreadCount(), 3);
+    walker.setMaxThreadCount(0);
+    QCOMPARE(walker.maxThreadCount(), 1);
+}
+
+QTEST_MAIN(tst_QDirWalker)
+
+#include "tst_qdirwalker.moc"
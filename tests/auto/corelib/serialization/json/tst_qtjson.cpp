@@ -36,6 +36,9 @@ QT_WARNING_DISABLE_DEPRECATED
 #include "qjsonvalue.h"
 #include "qjsondocument.h"
 #include "qregularexpression.h"
+#include "qbuffer.h"
+#include "qcborvalue.h"
+#include "qthread.h"
 #include "private/qnumeric_p.h"
 #include <limits>
 
@@ -105,12 +108,18 @@ private Q_SLOTS:
     void toJson();
     void toJsonSillyNumericValues();
     void toJsonLargeNumericValues();
+    void toJsonDevice();
+    void toJsonEscapeBlocks();
     void fromJson();
     void fromJsonErrors();
     void parseNumbers();
     void parseStrings();
     void parseDuplicateKeys();
     void testParser();
+    void lazyParsing();
+    void lazyParsingErrors_data();
+    void lazyParsingErrors();
+    void lazyParsingThreads();
 
     void assignToDocument();
 
@@ -142,6 +151,7 @@ private Q_SLOTS:
     void nesting();
 
     void longStrings();
+    void parseBlockBoundaries();
 
     void arrayInitializerList();
     void objectInitializerList();
@@ -1763,6 +1773,65 @@ void tst_QtJson::toJsonSillyNumericValues()
     QCOMPARE(json, expected);
 }
 
+void tst_QtJson::toJsonDevice()
+{
+    // large enough for the writer to flush to the device several times
+    QJsonArray array;
+    for (int i = 0; i < 5000; ++i) {
+        array.append(QJsonObject{ { "index", i },
+                                  { "name", QString("item \"%1\"\n").arg(i) },
+                                  { "value", i * 0.5 },
+                                  { "tags", QJsonArray{ "a", QString(QChar(0x20ac)), true } } });
+    }
+    const QJsonDocument documents[] = { QJsonDocument(array),
+                                        QJsonDocument(QJsonObject{ { "array", array } }),
+                                        QJsonDocument(QJsonObject()) };
+    for (const QJsonDocument &doc : documents) {
+        for (QJsonDocument::JsonFormat format : { QJsonDocument::Indented, QJsonDocument::Compact }) {
+            QBuffer buffer;
+            QVERIFY(buffer.open(QIODevice::WriteOnly));
+            QVERIFY(doc.toJson(&buffer, format));
+            QCOMPARE(buffer.data(), doc.toJson(format));
+        }
+    }
+
+    QBuffer buffer;
+    QVERIFY(QJsonDocument().toJson(&buffer));
+    QVERIFY(buffer.data().isEmpty());
+
+    QTest::ignoreMessage(QtWarningMsg, "QIODevice::write (QBuffer): device not open");
+    QVERIFY(!documents[0].toJson(&buffer));
+}
+
+void tst_QtJson::toJsonEscapeBlocks()
+{
+    // the writer escapes strings in blocks; put the interesting characters at
+    // every offset around the block sizes
+    const QString specials[] = { "\n", "\"", "\\", QString(QChar(0x1f)), QString(QChar(0xe9)),
+                                 QString(QChar(0x20ac)), QString::fromUtf8("\xf0\x9f\x98\x80") };
+    const QByteArray escaped[] = { "\\n", "\\\"", "\\\\", "\\u001f", "\xc3\xa9",
+                                   "\xe2\x82\xac", "\xf0\x9f\x98\x80" };
+    for (int length = 0; length < 300; length += length < 40 ? 1 : 13) {
+        const QString prefix(length, 'x');
+        for (int i = 0; i < int(std::size(specials)); ++i) {
+            const QString s = prefix + specials[i] + prefix;
+            const QByteArray json = QJsonDocument(QJsonArray{ s }).toJson(QJsonDocument::Compact);
+            QCOMPARE(json, "[\"" + prefix.toLatin1() + escaped[i] + prefix.toLatin1() + "\"]");
+            QCOMPARE(QJsonDocument::fromJson(json).array().at(0).toString(), s);
+
+            // keys are stored as US-ASCII or UTF-8 when possible
+            const QJsonObject object{ { s, 1 } };
+            QCOMPARE(QJsonDocument(object).toJson(QJsonDocument::Compact),
+                     "{\"" + prefix.toLatin1() + escaped[i] + prefix.toLatin1() + "\":1}");
+        }
+    }
+
+    // unpaired surrogates cannot be encoded as UTF-8
+    const QString lone = QString(3, 'x') + QChar(0xd800) + QString(20, 'y');
+    QCOMPARE(QJsonDocument(QJsonArray{ lone }).toJson(QJsonDocument::Compact),
+             "[\"xxx\\ud800" + QByteArray(20, 'y') + "\"]");
+}
+
 void tst_QtJson::toJsonLargeNumericValues()
 {
     QJsonObject object;
@@ -2290,6 +2359,119 @@ void tst_QtJson::testParser()
     QVERIFY(!doc.isEmpty());
 }
 
+void tst_QtJson::lazyParsing()
+{
+    QFile file(testDataDir + "/test.json");
+    QVERIFY(file.open(QFile::ReadOnly));
+    const QByteArray testJson = file.readAll();
+
+    const QJsonDocument eager = QJsonDocument::fromJson(testJson);
+    QVERIFY(eager.isArray());
+    {
+        const QJsonDocument lazy = QJsonDocument::fromJson(testJson, QJsonDocument::LazyParsing);
+        QCOMPARE(lazy.toJson(QJsonDocument::Compact), eager.toJson(QJsonDocument::Compact));
+        QCOMPARE(lazy.toJson(QJsonDocument::Indented), eager.toJson(QJsonDocument::Indented));
+    }
+    {
+        const QJsonDocument lazy = QJsonDocument::fromJson(testJson, QJsonDocument::LazyParsing);
+        QCOMPARE(lazy, eager);
+        QCOMPARE(lazy.toVariant(), eager.toVariant());
+    }
+    {
+        const QJsonDocument lazy = QJsonDocument::fromJson(testJson, QJsonDocument::LazyParsing);
+        QCOMPARE(QCborValue::fromJsonValue(lazy.array()).toCbor(),
+                 QCborValue::fromJsonValue(eager.array()).toCbor());
+    }
+
+    // the input does not need to outlive the document, even if it is not owned
+    QByteArray buffer = "{ \"outer\": { \"inner\": [1, \"two\", { \"three\": 3.5 }] }, "
+                        "\"other\": [ \"caf\u00e9\", \"\\n\" ] }";
+    QJsonDocument lazy = QJsonDocument::fromJson(QByteArray::fromRawData(buffer.constData(),
+                                                                         buffer.size()),
+                                                 QJsonDocument::LazyParsing);
+    buffer.fill('x');
+    QJsonObject outer = lazy.object().value("outer").toObject();
+    QCOMPARE(outer.value("inner").toArray().at(2).toObject().value("three").toDouble(), 3.5);
+    QCOMPARE(lazy.object().value("other").toArray().at(0).toString(), QString::fromUtf8("caf\u00e9"));
+    QCOMPARE(lazy.object().value("other").toArray().at(1).toString(), QString("\n"));
+
+    // nested containers can be modified like any other
+    QJsonObject root = lazy.object();
+    outer.insert("added", true);
+    root.insert("outer", outer);
+    QCOMPARE(QJsonDocument(root).toJson(QJsonDocument::Compact),
+             QByteArray("{\"other\":[\"caf\u00e9\",\"\\n\"],"
+                        "\"outer\":{\"added\":true,\"inner\":[1,\"two\",{\"three\":3.5}]}}"));
+    QCOMPARE(lazy.object().value("outer").toObject().size(), 1);
+}
+
+void tst_QtJson::lazyParsingErrors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("unterminated-nested") << QByteArray("[ [1, 2 ");
+    QTest::newRow("bad-value-nested") << QByteArray("{ \"a\": [ { \"b\": nul } ] }");
+    QTest::newRow("bad-number-nested") << QByteArray("[ [ - ] ]");
+    QTest::newRow("bad-escape-nested") << QByteArray("[ [ \"\\u12x4\" ] ]");
+    QTest::newRow("bad-utf8-nested") << QByteArray("[ { \"k\": \"\xff\" } ]");
+    QTest::newRow("missing-separator-nested") << QByteArray("{ \"a\": { \"b\" 1 } }");
+    QTest::newRow("missing-object-nested") << QByteArray("[ [ 1, ] ]");
+    QTest::newRow("garbage-after-nested") << QByteArray("[ [ ] ] x");
+    QTest::newRow("deep-nesting") << QByteArray(2000, '[') + QByteArray(2000, ']');
+}
+
+void tst_QtJson::lazyParsingErrors()
+{
+    QFETCH(QByteArray, json);
+
+    QJsonParseError eagerError;
+    QVERIFY(QJsonDocument::fromJson(json, &eagerError).isNull());
+    QVERIFY(eagerError.error != QJsonParseError::NoError);
+
+    QJsonParseError lazyError;
+    QVERIFY(QJsonDocument::fromJson(json, QJsonDocument::LazyParsing, &lazyError).isNull());
+    QCOMPARE(lazyError.error, eagerError.error);
+    QCOMPARE(lazyError.offset, eagerError.offset);
+}
+
+void tst_QtJson::lazyParsingThreads()
+{
+    QJsonArray array;
+    for (int i = 0; i < 200; ++i) {
+        const QJsonArray items{ i, QString::number(i), QJsonObject{ { "n", i } } };
+        array.append(QJsonObject{ { "index", i }, { "items", items } });
+    }
+    const QByteArray json = QJsonDocument(array).toJson(QJsonDocument::Compact);
+
+    // threads materializing the same nested containers concurrently all see
+    // the same values
+    const QJsonDocument lazy = QJsonDocument::fromJson(json, QJsonDocument::LazyParsing);
+    QList<QByteArray> results(4);
+    QList<QThread *> threads;
+    for (QByteArray &result : results) {
+        threads.append(QThread::create([&lazy, &result] {
+            const QJsonArray array = lazy.array();
+            for (qsizetype i = array.size() - 1; i >= 0; --i) {
+                const QJsonArray items = array.at(i).toObject().value("items").toArray();
+                result += QJsonDocument(items).toJson(QJsonDocument::Compact);
+            }
+        }));
+        threads.last()->start();
+    }
+    for (QThread *thread : qAsConst(threads)) {
+        QVERIFY(thread->wait());
+        delete thread;
+    }
+
+    QByteArray expected;
+    for (qsizetype i = array.size() - 1; i >= 0; --i) {
+        const QJsonArray items = array.at(i).toObject().value("items").toArray();
+        expected += QJsonDocument(items).toJson(QJsonDocument::Compact);
+    }
+    for (const QByteArray &result : qAsConst(results))
+        QCOMPARE(result, expected);
+}
+
 void tst_QtJson::assignToDocument()
 {
     {
@@ -3015,6 +3197,46 @@ void tst_QtJson::testJsonValueRefDefault()
     QCOMPARE(empty["n/a"].toDouble(42.0), 42.0);
 }
 
+void tst_QtJson::parseBlockBoundaries()
+{
+    // the parser scans strings and whitespace in blocks; put the interesting
+    // bytes at every offset around the block sizes
+    const QByteArray specials[] = { "\\n", "\\\"", "\\u0402", UNICODE_DJE, "\xe2\x82\xac" };
+    const QString decoded[] = { "\n", "\"", QChar(0x402), QChar(0x402), QChar(0x20ac) };
+    for (int length = 0; length < 80; ++length) {
+        const QByteArray prefix(length, 'x');
+        const QByteArray space = QByteArray(length, ' ') + "\r\n\t";
+        for (int i = 0; i < int(std::size(specials)); ++i) {
+            const QByteArray json = '[' + space + '"' + prefix + specials[i] + prefix + '"'
+                    + space + ',' + space + '"' + prefix + '"' + space + ']';
+            QJsonParseError error;
+            const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+            QCOMPARE(error.error, QJsonParseError::NoError);
+            const QJsonArray array = doc.array();
+            QCOMPARE(array.size(), 2);
+            QCOMPARE(array.at(0).toString(),
+                     QString::fromLatin1(prefix) + decoded[i] + QString::fromLatin1(prefix));
+            QCOMPARE(array.at(1).toString(), QString::fromLatin1(prefix));
+        }
+
+        QJsonParseError error;
+        QJsonDocument::fromJson('[' + space + '"' + prefix, &error);
+        QCOMPARE(error.error, QJsonParseError::UnterminatedString);
+        QJsonDocument::fromJson('[' + space + '"' + prefix + "\xff\"]", &error);
+        QCOMPARE(error.error, QJsonParseError::IllegalUTF8String);
+        QCOMPARE(error.offset, length + 5 + length);
+    }
+
+    const QJsonArray numbers = QJsonDocument::fromJson(
+            "[999999999999999999, -999999999999999999, 9223372036854775807, -0, "
+            "12345678901234567890]").array();
+    QCOMPARE(numbers.at(0).toInteger(), 999999999999999999LL);
+    QCOMPARE(numbers.at(1).toInteger(), -999999999999999999LL);
+    QCOMPARE(numbers.at(2).toInteger(), std::numeric_limits<qint64>::max());
+    QCOMPARE(numbers.at(3).toInteger(-1), 0);
+    QCOMPARE(numbers.at(4).toDouble(), 12345678901234567890.);
+}
+
 void tst_QtJson::arrayInitializerList()
 {
     QVERIFY(QJsonArray{}.isEmpty());
@@ -58,6 +58,9 @@ private Q_SLOTS:
     void fixed();
     void strings_data();
     void strings();
+    void stringViews_data() { strings_data(); }
+    void stringViews();
+    void invalidUtf8StringView();
     void tags_data();
     void tags() { fixed(); }
     void emptyContainers_data();
@@ -727,6 +730,70 @@ void tst_QCborStreamReader::strings()
         QCOMPARE(chunks, 1);
 }
 
+void tst_QCborStreamReader::stringViews()
+{
+    QFETCH(QByteArray, data);
+    QFETCH_GLOBAL(bool, useDevice);
+
+    QBuffer buffer(&data), controlBuffer(&data);
+    QCborStreamReader reader(data), controlReader(data);
+    if (useDevice) {
+        buffer.open(QIODevice::ReadOnly);
+        controlBuffer.open(QIODevice::ReadOnly);
+        reader.setDevice(&buffer);
+        controlReader.setDevice(&controlBuffer);
+    }
+    QVERIFY(reader.isString() || reader.isByteArray());
+
+    forever {
+        QCborStreamReader::StringResult<QByteArray> controlData;
+        QCborStreamReader::StringResult<QByteArrayView> r;
+        if (reader.isString()) {
+            auto cr = controlReader.readString();
+            controlData.data = cr.data.toUtf8();
+            controlData.status = cr.status;
+            auto vr = reader.readUtf8StringView();
+            r.data = QByteArrayView(vr.data.data(), vr.data.size());
+            r.status = vr.status;
+        } else {
+            controlData = controlReader.readByteArray();
+            r = reader.readByteArrayView();
+        }
+        QVERIFY(controlData.status != QCborStreamReader::Error);
+        QCOMPARE(r.status, controlData.status);
+        QCOMPARE(r.data, QByteArrayView(controlData.data));
+
+        if (!useDevice && !r.data.isEmpty()) {
+            // points into the original data
+            QVERIFY(r.data.data() > data.constData());
+            QVERIFY(r.data.data() + r.data.size() <= data.constData() + data.size());
+        }
+
+        if (r.status == QCborStreamReader::EndOfString)
+            break;
+    }
+    QCOMPARE(reader.lastError(), QCborError::NoError);
+    QCOMPARE(reader.currentOffset(), controlReader.currentOffset());
+}
+
+void tst_QCborStreamReader::invalidUtf8StringView()
+{
+    QFETCH_GLOBAL(bool, useDevice);
+    QByteArray data("\x82\x63\x61\xff\x62\x01", 6);
+
+    QBuffer buffer(&data);
+    QCborStreamReader reader(data);
+    if (useDevice) {
+        buffer.open(QIODevice::ReadOnly);
+        reader.setDevice(&buffer);
+    }
+    QVERIFY(reader.enterContainer());
+    QVERIFY(reader.isString());
+    auto r = reader.readUtf8StringView();
+    QCOMPARE(r.status, QCborStreamReader::Error);
+    QCOMPARE(reader.lastError(), QCborError::InvalidUtf8String);
+}
+
 void tst_QCborStreamReader::tags_data()
 {
     addColumns();
@@ -201,6 +201,10 @@ private slots:
     void status_QHash_QMap();
 
     void status_QList_QVector();
+    void status_arithmeticList();
+
+    void streamArithmeticList_data();
+    void streamArithmeticList();
 
     void streamToAndFromQByteArray();
 
@@ -3211,6 +3215,136 @@ void tst_QDataStream::status_QList_QVector()
     }
 }
 
+void tst_QDataStream::status_arithmeticList()
+{
+    // same as status_QList_QVector, but for lists that are read in one block
+    for (QDataStream::ByteOrder order : { QDataStream::BigEndian, QDataStream::LittleEndian }) {
+        const bool big = order == QDataStream::BigEndian;
+        const QByteArray two = big ? QByteArray("\x00\x00\x00\x02\x00\x01\x00\x02", 8)
+                                   : QByteArray("\x02\x00\x00\x00\x01\x00\x02\x00", 8);
+        for (int i = 0; i <= two.size(); ++i) {
+            QByteArray ba = two.left(i);
+            QDataStream stream(&ba, QIODevice::ReadOnly);
+            stream.setByteOrder(order);
+            QList<qint16> list = { 42 };
+            stream >> list;
+            if (i == two.size()) {
+                QCOMPARE(stream.status(), QDataStream::Ok);
+                QCOMPARE(list, QList<qint16>({ 1, 2 }));
+            } else {
+                QCOMPARE(stream.status(), QDataStream::ReadPastEnd);
+                QVERIFY(list.isEmpty());
+            }
+        }
+
+        // a previously latched error status is kept
+        QByteArray ba = two;
+        QDataStream stream(&ba, QIODevice::ReadOnly);
+        stream.setByteOrder(order);
+        stream.setStatus(QDataStream::ReadCorruptData);
+        QList<qint16> list;
+        stream >> list;
+        QCOMPARE(stream.status(), QDataStream::ReadCorruptData);
+        QCOMPARE(list, QList<qint16>({ 1, 2 }));
+    }
+}
+
+template <typename T>
+static QList<T> arithmeticTestList(qsizetype size)
+{
+    QList<T> list;
+    list.reserve(size);
+    for (qsizetype i = 0; i < size; ++i) {
+        if constexpr (std::is_floating_point_v<T>)
+            list.append(T(i) / 3 - 100);
+        else
+            list.append(T(quint64(i) * 0x0102030405060708ULL + 0x1122));
+    }
+    return list;
+}
+
+template <typename T>
+static void streamArithmeticListImpl(QDataStream::ByteOrder order,
+                                     QDataStream::FloatingPointPrecision precision,
+                                     qsizetype size)
+{
+    const QList<T> list = arithmeticTestList<T>(size);
+
+    // element by element, the way it's specified
+    QByteArray expected;
+    {
+        QDataStream stream(&expected, QIODevice::WriteOnly);
+        stream.setByteOrder(order);
+        stream.setFloatingPointPrecision(precision);
+        stream << quint32(list.size());
+        for (T t : list)
+            stream << t;
+    }
+
+    QByteArray ba;
+    {
+        QDataStream stream(&ba, QIODevice::WriteOnly);
+        stream.setByteOrder(order);
+        stream.setFloatingPointPrecision(precision);
+        stream << list;
+        QCOMPARE(stream.status(), QDataStream::Ok);
+    }
+    QCOMPARE(ba, expected);
+
+    QDataStream stream(ba);
+    stream.setByteOrder(order);
+    stream.setFloatingPointPrecision(precision);
+    QList<T> read;
+    stream >> read;
+    QCOMPARE(stream.status(), QDataStream::Ok);
+    QVERIFY(stream.atEnd());
+    QList<T> reference = list;
+    if constexpr (std::is_same_v<T, double>) {
+        if (precision == QDataStream::SinglePrecision) {
+            for (double &d : reference)
+                d = float(d);
+        }
+    }
+    QCOMPARE(read, reference);
+}
+
+void tst_QDataStream::streamArithmeticList_data()
+{
+    QTest::addColumn<QDataStream::ByteOrder>("byteOrder");
+    QTest::addColumn<QDataStream::FloatingPointPrecision>("precision");
+    QTest::addColumn<qsizetype>("size");
+
+    for (qsizetype size : { 0, 1, 7, 33, 1000, 5001 }) {
+        QTest::addRow("big-endian/%lld", qlonglong(size))
+                << QDataStream::BigEndian << QDataStream::DoublePrecision << size;
+        QTest::addRow("little-endian/%lld", qlonglong(size))
+                << QDataStream::LittleEndian << QDataStream::DoublePrecision << size;
+        QTest::addRow("big-endian/single-precision/%lld", qlonglong(size))
+                << QDataStream::BigEndian << QDataStream::SinglePrecision << size;
+    }
+}
+
+void tst_QDataStream::streamArithmeticList()
+{
+    QFETCH(QDataStream::ByteOrder, byteOrder);
+    QFETCH(QDataStream::FloatingPointPrecision, precision);
+    QFETCH(qsizetype, size);
+
+    streamArithmeticListImpl<char>(byteOrder, precision, size);
+    streamArithmeticListImpl<qint8>(byteOrder, precision, size);
+    streamArithmeticListImpl<quint8>(byteOrder, precision, size);
+    streamArithmeticListImpl<qint16>(byteOrder, precision, size);
+    streamArithmeticListImpl<quint16>(byteOrder, precision, size);
+    streamArithmeticListImpl<char16_t>(byteOrder, precision, size);
+    streamArithmeticListImpl<qint32>(byteOrder, precision, size);
+    streamArithmeticListImpl<quint32>(byteOrder, precision, size);
+    streamArithmeticListImpl<char32_t>(byteOrder, precision, size);
+    streamArithmeticListImpl<qint64>(byteOrder, precision, size);
+    streamArithmeticListImpl<quint64>(byteOrder, precision, size);
+    streamArithmeticListImpl<float>(byteOrder, precision, size);
+    streamArithmeticListImpl<double>(byteOrder, precision, size);
+}
+
 void tst_QDataStream::streamToAndFromQByteArray()
 {
     QByteArray data;
@@ -0,0 +1,443 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonStreamReader>
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void tokens();
+    void chunked_data();
+    void chunked();
+    void tokenAcrossAddData();
+    void longStringChunks();
+    void device();
+    void strings_data();
+    void strings();
+    void zeroCopy();
+    void numbers_data();
+    void numbers();
+    void errors_data();
+    void errors();
+    void readValue();
+    void skipCurrentValue();
+};
+
+static const char sampleDocument[] =
+        "\xef\xbb\xbf{\n"
+        "    \"name\": \"sensor \\\"7\\\"\",\n"
+        "    \"values\": [1, -2.5, 3e2, true, false, null, {}, []],\n"
+        "    \"nested\": {\"a\": {\"b\": [\"c\", \"\xd0\x82\"]}},\n"
+        "    \"empty\": \"\"\n"
+        "}\n";
+
+static QByteArray bytes(QUtf8StringView view)
+{
+    return QByteArray(view.data(), view.size());
+}
+
+// describes each token, so that token sequences can be compared as strings
+static QStringList readTokens(QJsonStreamReader &reader)
+{
+    QStringList tokens;
+    while (!reader.atEnd()) {
+        const QJsonStreamReader::TokenType type = reader.readNext();
+        if (type == QJsonStreamReader::Invalid) {
+            if (reader.error() == QJsonStreamReader::PrematureEndOfDocumentError)
+                break;
+            tokens << QLatin1String("Invalid");
+            break;
+        }
+        QString token = reader.tokenString();
+        if (type == QJsonStreamReader::Name || type == QJsonStreamReader::String
+                || type == QJsonStreamReader::Number) {
+            token += QLatin1Char(':') + reader.text();
+        } else if (type == QJsonStreamReader::Bool) {
+            token += QLatin1String(reader.toBool() ? ":true" : ":false");
+        }
+        tokens << token;
+    }
+    return tokens;
+}
+
+static const QStringList sampleTokens = {
+    "StartObject",
+    "Name:name", "String:sensor \"7\"",
+    "Name:values", "StartArray", "Number:1", "Number:-2.5", "Number:3e2",
+    "Bool:true", "Bool:false", "Null", "StartObject", "EndObject",
+    "StartArray", "EndArray", "EndArray",
+    "Name:nested", "StartObject", "Name:a", "StartObject", "Name:b", "StartArray",
+    "String:c", "String:" + QString(QChar(0x402)), "EndArray", "EndObject", "EndObject",
+    "Name:empty", "String:",
+    "EndObject", "EndDocument"
+};
+
+void tst_QJsonStreamReader::tokens()
+{
+    QJsonStreamReader reader{QByteArray(sampleDocument)};
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QCOMPARE(readTokens(reader), sampleTokens);
+    QVERIFY(!reader.hasError());
+    QVERIFY(reader.atEnd());
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    // depth and offsets
+    reader.clear();
+    reader.addData(QByteArray("[{\"a\": [1]}]"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.depth(), 1);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.depth(), 2);
+    QCOMPARE(reader.currentOffset(), 1);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.currentOffset(), 2);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.depth(), 3);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.currentOffset(), 8);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.depth(), 2);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.depth(), 0);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QJsonStreamReader::chunked_data()
+{
+    QTest::addColumn<int>("chunkSize");
+    for (int chunkSize : { 1, 2, 3, 7, 16, 64 })
+        QTest::addRow("%d", chunkSize) << chunkSize;
+}
+
+void tst_QJsonStreamReader::chunked()
+{
+    QFETCH(int, chunkSize);
+    const QByteArray document(sampleDocument);
+
+    QJsonStreamReader reader;
+    QStringList tokens;
+    for (qsizetype i = 0; i < document.size(); i += chunkSize) {
+        reader.addData(document.mid(i, chunkSize));
+        tokens += readTokens(reader);
+        if (i + chunkSize < document.size() && !reader.atEnd())
+            QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    }
+    QCOMPARE(tokens, sampleTokens);
+    QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+}
+
+void tst_QJsonStreamReader::tokenAcrossAddData()
+{
+    // the current token stays readable when data is added, whether that
+    // appends to the unread input or replaces the fully consumed one
+    QJsonStreamReader reader;
+    reader.addData(QByteArray("[\"first\", 12"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    reader.addData(QByteArray("34, \"second\""));
+    QCOMPARE(reader.text(), QLatin1String("first"));
+    QCOMPARE(bytes(reader.textView()), "first");
+    QCOMPARE(reader.currentOffset(), 1);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.toInteger(), 1234);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    reader.addData(QByteArray(", \"th\\u0069rd\"]"));
+    QCOMPARE(reader.text(), QLatin1String("second"));
+    QCOMPARE(bytes(reader.textView()), "second");
+    QCOMPARE(reader.currentOffset(), 16);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.text(), QLatin1String("third"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    // whitespace may follow the document in later pieces, anything else not
+    reader.addData(QByteArray(" \n"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+    reader.addData(QByteArray("1"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error(), QJsonStreamReader::NotWellFormedError);
+    QCOMPARE(reader.currentOffset(), 41);
+}
+
+void tst_QJsonStreamReader::longStringChunks()
+{
+    // a string spanning many chunks, with escape sequences split at chunk
+    // boundaries
+    QByteArray json = "[\"";
+    QString expected;
+    for (int i = 0; i < 2000; ++i) {
+        json += QByteArray(i % 7, 'a') + "\\n\\u00e9";
+        expected += QString(i % 7, QLatin1Char('a')) + QLatin1Char('\n') + QChar(0xe9);
+    }
+    json += "\"]";
+
+    for (int chunkSize : { 1, 5, 1000 }) {
+        QJsonStreamReader reader;
+        qsizetype i = 0;
+        QJsonStreamReader::TokenType type = QJsonStreamReader::Invalid;
+        while (type != QJsonStreamReader::String && i < json.size()) {
+            reader.addData(json.mid(i, chunkSize));
+            i += chunkSize;
+            type = reader.readNext();
+            if (type == QJsonStreamReader::Invalid)
+                QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+        }
+        QCOMPARE(type, QJsonStreamReader::String);
+        QCOMPARE(reader.text(), expected);
+    }
+}
+
+void tst_QJsonStreamReader::device()
+{
+    // large enough to need several reads from the device
+    QJsonArray array;
+    for (int i = 0; i < 20000; ++i)
+        array.append(QJsonObject{ { "index", i }, { "text", QString::number(i).repeated(3) } });
+    QByteArray data = QJsonDocument(array).toJson();
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QJsonStreamReader reader(&buffer);
+    QCOMPARE(reader.device(), &buffer);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    for (int i = 0; i < 20000; ++i) {
+        QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+        QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+        QCOMPARE(bytes(reader.textView()), "index");
+        QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+        QCOMPARE(reader.toInteger(), i);
+        QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+        QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+        QCOMPARE(reader.text(), QString::number(i).repeated(3));
+        QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    }
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    // a truncated device is a premature end
+    data.chop(10);
+    buffer.seek(0);
+    reader.setDevice(&buffer);
+    while (reader.readNext() != QJsonStreamReader::Invalid)
+        ;
+    QCOMPARE(reader.error(), QJsonStreamReader::PrematureEndOfDocumentError);
+    QVERIFY(!reader.atEnd());
+}
+
+void tst_QJsonStreamReader::strings_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("empty") << QByteArray("\"\"") << QString("");
+    QTest::newRow("ascii") << QByteArray("\"Foo\"") << QString("Foo");
+    QTest::newRow("utf8") << QByteArray("\"abc\xd0\x82""abc\"") << ("abc" + QString(QChar(0x402)) + "abc");
+    QTest::newRow("escapes") << QByteArray(R"("\"\\\/\b\f\n\r\t")") << QString("\"\\/\b\f\n\r\t");
+    QTest::newRow("unicode-escape") << QByteArray(R"("abc\u0402abc")") << ("abc" + QString(QChar(0x402)) + "abc");
+    QTest::newRow("surrogates") << QByteArray(R"("\ud83d\ude00")") << QString::fromUcs4(U"\U0001f600");
+    QTest::newRow("long") << ('"' + QByteArray(100, 'x') + "\\n" + QByteArray(100, 'y') + '"')
+                          << (QString(100, 'x') + '\n' + QString(100, 'y'));
+}
+
+void tst_QJsonStreamReader::strings()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    QJsonStreamReader reader('[' + json + ",{" + json + ":0}]");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.text(), expected);
+    QCOMPARE(reader.textView().toString(), expected);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Name);
+    QCOMPARE(reader.text(), expected);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+}
+
+void tst_QJsonStreamReader::zeroCopy()
+{
+    const QByteArray json(R"(["plain", "esc\naped", 12.5, true])");
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.textView().data(), json.constData() + 2);
+    QCOMPARE(bytes(reader.textView()), "plain");
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(bytes(reader.textView()), "esc\naped");
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.textView().data(), json.constData() + json.indexOf("12.5"));
+    QCOMPARE(bytes(reader.textView()), "12.5");
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Bool);
+    QCOMPARE(bytes(reader.textView()), "true");
+}
+
+void tst_QJsonStreamReader::numbers_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<bool>("isInteger");
+    QTest::addColumn<qint64>("integer");
+    QTest::addColumn<double>("value");
+
+    QTest::newRow("zero") << QByteArray("0") << true << qint64(0) << 0.;
+    QTest::newRow("minus-zero") << QByteArray("-0") << true << qint64(0) << 0.;
+    QTest::newRow("int") << QByteArray("-12345") << true << qint64(-12345) << -12345.;
+    QTest::newRow("18-digits") << QByteArray("999999999999999999") << true
+                               << Q_INT64_C(999999999999999999) << 999999999999999999.;
+    QTest::newRow("int64-max") << QByteArray("9223372036854775807") << true
+                               << std::numeric_limits<qint64>::max() << 9223372036854775807.;
+    QTest::newRow("too-large") << QByteArray("18446744073709551616") << false
+                               << qint64(0) << 18446744073709551616.;
+    QTest::newRow("integral-frac") << QByteArray("2.000") << true << qint64(2) << 2.;
+    QTest::newRow("frac") << QByteArray("0.25") << false << qint64(0) << 0.25;
+    QTest::newRow("exp") << QByteArray("1.5e3") << true << qint64(1500) << 1500.;
+    QTest::newRow("negative-exp") << QByteArray("-25E-2") << false << qint64(0) << -0.25;
+}
+
+void tst_QJsonStreamReader::numbers()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(bool, isInteger);
+    QFETCH(qint64, integer);
+    QFETCH(double, value);
+
+    QJsonStreamReader reader('[' + json + ']');
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.isInteger(), isInteger);
+    QCOMPARE(reader.toDouble(), value);
+    if (isInteger)
+        QCOMPARE(reader.toInteger(), integer);
+
+    // the same value as the DOM parser
+    const QJsonValue dom = QJsonDocument::fromJson('[' + json + ']').array().at(0);
+    QCOMPARE(reader.readValue(), dom);
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<qint64>("offset");
+
+    QTest::newRow("scalar-root") << QByteArray("1 ") << qint64(0);
+    QTest::newRow("missing-name-separator") << QByteArray("{\"a\" 1}") << qint64(5);
+    QTest::newRow("missing-value-separator") << QByteArray("[1 2]") << qint64(3);
+    QTest::newRow("unterminated-object") << QByteArray("{\"a\":1 \"b\":2}") << qint64(7);
+    QTest::newRow("trailing-comma-array") << QByteArray("[1,]") << qint64(3);
+    QTest::newRow("trailing-comma-object") << QByteArray("{\"a\":1,}") << qint64(7);
+    QTest::newRow("mismatched") << QByteArray("[1}") << qint64(2);
+    QTest::newRow("bad-literal") << QByteArray("[nul]") << qint64(1);
+    QTest::newRow("bad-number") << QByteArray("[-]") << qint64(1);
+    QTest::newRow("leading-zero") << QByteArray("[01]") << qint64(1);
+    QTest::newRow("bad-escape") << QByteArray(R"(["\u12x4"])") << qint64(2);
+    QTest::newRow("bad-utf8") << QByteArray("[\"\xff\"]") << qint64(2);
+    QTest::newRow("name-expected") << QByteArray("{1:2}") << qint64(1);
+    QTest::newRow("garbage-at-end") << QByteArray("[1] x") << qint64(4);
+    QTest::newRow("second-document") << QByteArray("{}{}") << qint64(2);
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(qint64, offset);
+
+    QJsonStreamReader reader(json);
+    while (reader.readNext() != QJsonStreamReader::Invalid)
+        QVERIFY(!reader.atEnd());
+    QCOMPARE(reader.error(), QJsonStreamReader::NotWellFormedError);
+    QVERIFY(!reader.errorString().isEmpty());
+    QCOMPARE(reader.currentOffset(), offset);
+    QVERIFY(reader.atEnd());
+
+    // errors are final
+    reader.addData(QByteArray("]}"));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+
+    QJsonParseError error;
+    QJsonDocument::fromJson(json, &error);
+    QVERIFY(error.error != QJsonParseError::NoError);
+}
+
+void tst_QJsonStreamReader::readValue()
+{
+    const QJsonDocument dom = QJsonDocument::fromJson(sampleDocument);
+    QVERIFY(dom.isObject());
+
+    QJsonStreamReader reader{QByteArray(sampleDocument)};
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readValue(), QJsonValue(dom.object()));
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    // one member at a time
+    reader.clear();
+    reader.addData(QByteArray(sampleDocument));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QJsonObject object;
+    while (reader.readNext() == QJsonStreamReader::Name) {
+        const QString name = reader.text();
+        reader.readNext();
+        object.insert(name, reader.readValue());
+    }
+    QCOMPARE(object, dom.object());
+}
+
+void tst_QJsonStreamReader::skipCurrentValue()
+{
+    QJsonStreamReader reader{QByteArray(sampleDocument)};
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QStringList names;
+    while (reader.readNext() == QJsonStreamReader::Name) {
+        names << reader.text();
+        reader.readNext();
+        QVERIFY(reader.skipCurrentValue());
+    }
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndObject);
+    QCOMPARE(names, QStringList({ "name", "values", "nested", "empty" }));
+}
+
+QTEST_MAIN(tst_QJsonStreamReader)
+#include "tst_qjsonstreamreader.moc"
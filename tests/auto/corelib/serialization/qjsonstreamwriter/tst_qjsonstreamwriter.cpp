@@ -0,0 +1,308 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QBuffer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonStreamReader>
+#include <QJsonStreamWriter>
+
+class tst_QJsonStreamWriter : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void matchesToJson_data();
+    void matchesToJson();
+    void strings_data();
+    void strings();
+    void writeValue();
+    void device();
+    void roundTrip();
+};
+
+// writes value token by token
+static void writeTokens(QJsonStreamWriter &writer, const QJsonValue &value)
+{
+    switch (value.type()) {
+    case QJsonValue::Object: {
+        writer.writeStartObject();
+        const QJsonObject object = value.toObject();
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            writer.writeName(it.key());
+            writeTokens(writer, it.value());
+        }
+        writer.writeEndObject();
+        break;
+    }
+    case QJsonValue::Array:
+        writer.writeStartArray();
+        for (const QJsonValue &element : value.toArray())
+            writeTokens(writer, element);
+        writer.writeEndArray();
+        break;
+    case QJsonValue::String:
+        writer.writeString(value.toString());
+        break;
+    case QJsonValue::Double:
+        if (value.toDouble() == value.toInteger())
+            writer.writeInteger(value.toInteger());
+        else
+            writer.writeDouble(value.toDouble());
+        break;
+    case QJsonValue::Bool:
+        writer.writeBool(value.toBool());
+        break;
+    default:
+        writer.writeNull();
+        break;
+    }
+}
+
+static QJsonObject sampleObject()
+{
+    return QJsonObject{
+        { "name", "sensor \"7\"\n" },
+        { "values", QJsonArray{ 1, -2.5, 300, true, false, QJsonValue::Null,
+                                QJsonObject(), QJsonArray() } },
+        { "nested", QJsonObject{ { "a", QJsonObject{ { "b", QJsonArray{ "c", "Ђ" } } } } } },
+        { "empty", "" },
+        { "large", 1e300 },
+    };
+}
+
+void tst_QJsonStreamWriter::matchesToJson_data()
+{
+    QTest::addColumn<QJsonValue>("value");
+    QTest::addColumn<bool>("indented");
+
+    for (bool indented : { false, true }) {
+        const char *format = indented ? "indented" : "compact";
+        QTest::addRow("object-%s", format) << QJsonValue(sampleObject()) << indented;
+        QTest::addRow("array-%s", format) << QJsonValue(QJsonArray{ sampleObject(), 1 }) << indented;
+        QTest::addRow("empty-object-%s", format) << QJsonValue(QJsonObject()) << indented;
+        QTest::addRow("empty-array-%s", format) << QJsonValue(QJsonArray()) << indented;
+    }
+}
+
+void tst_QJsonStreamWriter::matchesToJson()
+{
+    QFETCH(QJsonValue, value);
+    QFETCH(bool, indented);
+
+    const QJsonDocument document = value.isObject() ? QJsonDocument(value.toObject())
+                                                    : QJsonDocument(value.toArray());
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.setAutoFormatting(indented);
+    QCOMPARE(writer.autoFormatting(), indented);
+    writeTokens(writer, value);
+    QCOMPARE(output, document.toJson(indented ? QJsonDocument::Indented
+                                              : QJsonDocument::Compact));
+}
+
+void tst_QJsonStreamWriter::strings_data()
+{
+    QTest::addColumn<QString>("string");
+
+    QTest::newRow("empty") << QString("");
+    QTest::newRow("ascii") << QString("Foo");
+    QTest::newRow("escapes") << QString("\"\\/\b\f\n\r\t");
+    QTest::newRow("control") << QString(QChar(0x1)) + QChar(0x1f);
+    QTest::newRow("latin1") << QString("café");
+    QTest::newRow("bmp") << QString("abcЂabc");
+    QTest::newRow("surrogates") << QString::fromUcs4(U"\U0001f600");
+}
+
+void tst_QJsonStreamWriter::strings()
+{
+    QFETCH(QString, string);
+    const QByteArray expected = QJsonDocument(QJsonArray{ string }).toJson(QJsonDocument::Compact);
+
+    // UTF-16, UTF-8 and Latin-1 input all produce the same output
+    QByteArray output;
+    {
+        QJsonStreamWriter writer(&output);
+        writer.writeStartArray();
+        writer.writeString(string);
+        writer.writeEndArray();
+    }
+    QCOMPARE(output, expected);
+
+    output.clear();
+    const QByteArray utf8 = string.toUtf8();
+    {
+        QJsonStreamWriter writer(&output);
+        writer.writeStartArray();
+        writer.writeString(QUtf8StringView(utf8));
+        writer.writeEndArray();
+    }
+    QCOMPARE(output, expected);
+
+    const QByteArray latin1 = string.toLatin1();
+    if (QString::fromLatin1(latin1) == string) {
+        output.clear();
+        QJsonStreamWriter writer(&output);
+        writer.writeStartArray();
+        writer.writeString(QLatin1String(latin1));
+        writer.writeEndArray();
+        QCOMPARE(output, expected);
+    }
+
+    // names are escaped the same way
+    output.clear();
+    QJsonStreamWriter writer(&output);
+    writer.writeStartObject();
+    writer.writeName(QUtf8StringView(utf8));
+    writer.writeNull();
+    writer.writeEndObject();
+    QCOMPARE(QJsonDocument::fromJson(output).object().keys(), QStringList{ string });
+}
+
+void tst_QJsonStreamWriter::writeValue()
+{
+    // whole values can be mixed with streamed tokens
+    const QJsonObject object = sampleObject();
+    for (bool indented : { false, true }) {
+        QByteArray output;
+        QJsonStreamWriter writer(&output);
+        writer.setAutoFormatting(indented);
+        writer.writeStartObject();
+        for (auto it = object.begin(); it != object.end(); ++it) {
+            writer.writeName(it.key());
+            writer.writeValue(it.value());
+        }
+        writer.writeEndObject();
+        QCOMPARE(output, QJsonDocument(object).toJson(indented ? QJsonDocument::Indented
+                                                               : QJsonDocument::Compact));
+    }
+
+    QByteArray output;
+    QJsonStreamWriter writer(&output);
+    writer.writeStartArray();
+    writer.writeDouble(qInf());
+    writer.writeValue(QJsonValue(QJsonValue::Undefined));
+    writer.writeEndArray();
+    QCOMPARE(output, "[null,null]");
+}
+
+void tst_QJsonStreamWriter::device()
+{
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    {
+        QJsonStreamWriter writer(&buffer);
+        QCOMPARE(writer.device(), &buffer);
+        writer.writeStartArray();
+        for (int i = 0; i < 10000; ++i)
+            writer.writeString(QLatin1String("element"));
+
+        // output is buffered, but not indefinitely
+        QVERIFY(buffer.size() > 0);
+        QVERIFY(buffer.size() < 10000 * 10);
+
+        writer.writeEndArray();
+        // the end of the document flushes
+        QCOMPARE(buffer.size(), 10000 * 10 + 1);
+        QVERIFY(!writer.hasError());
+
+        writer.writeStartArray();
+        writer.writeNull();
+        QCOMPARE(buffer.size(), 10000 * 10 + 1);
+    }
+    // and so does the destructor
+    QCOMPARE(buffer.size(), 10000 * 10 + 1 + 5);
+
+    // writing to a device that is not open fails
+    QBuffer closed;
+    QJsonStreamWriter writer(&closed);
+    writer.writeStartArray();
+    QTest::ignoreMessage(QtWarningMsg, "QIODevice::write (QBuffer): device not open");
+    writer.writeEndArray();
+    QVERIFY(writer.hasError());
+}
+
+void tst_QJsonStreamWriter::roundTrip()
+{
+    QByteArray output;
+    {
+        QJsonStreamWriter writer(&output);
+        writer.setAutoFormatting(true);
+        writeTokens(writer, sampleObject());
+    }
+
+    QJsonStreamReader reader(output);
+    QByteArray copy;
+    QJsonStreamWriter writer(&copy);
+    writer.setAutoFormatting(true);
+    while (!reader.atEnd()) {
+        switch (reader.readNext()) {
+        case QJsonStreamReader::StartObject:
+            writer.writeStartObject();
+            break;
+        case QJsonStreamReader::EndObject:
+            writer.writeEndObject();
+            break;
+        case QJsonStreamReader::StartArray:
+            writer.writeStartArray();
+            break;
+        case QJsonStreamReader::EndArray:
+            writer.writeEndArray();
+            break;
+        case QJsonStreamReader::Name:
+            writer.writeName(reader.textView());
+            break;
+        case QJsonStreamReader::String:
+            writer.writeString(reader.textView());
+            break;
+        case QJsonStreamReader::Number:
+            if (reader.isInteger())
+                writer.writeInteger(reader.toInteger());
+            else
+                writer.writeDouble(reader.toDouble());
+            break;
+        case QJsonStreamReader::Bool:
+            writer.writeBool(reader.toBool());
+            break;
+        case QJsonStreamReader::Null:
+            writer.writeNull();
+            break;
+        case QJsonStreamReader::EndDocument:
+            break;
+        default:
+            QFAIL(qPrintable(reader.errorString()));
+        }
+    }
+    QCOMPARE(copy, output);
+}
+
+QTEST_MAIN(tst_QJsonStreamWriter)
+#include "tst_qjsonstreamwriter.moc"
@@ -0,0 +1,506 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QBuffer>
+#include <QCborArray>
+#include <QCborMap>
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <QCborValue>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSignalSpy>
+#include <QtCore/qpropertyserialization.h>
+
+struct Inner
+{
+    Q_GADGET
+    Q_PROPERTY_VISITOR
+    Q_PROPERTY(int id MEMBER id)
+    Q_PROPERTY(QString label MEMBER label)
+public:
+    int id = 0;
+    QString label;
+
+    friend bool operator==(const Inner &a, const Inner &b)
+    { return a.id == b.id && a.label == b.label; }
+    friend bool operator!=(const Inner &a, const Inner &b) { return !(a == b); }
+};
+
+struct Record
+{
+    Q_GADGET
+    Q_PROPERTY_VISITOR
+    Q_PROPERTY(bool flag MEMBER flag)
+    Q_PROPERTY(int i MEMBER i)
+    Q_PROPERTY(uint u MEMBER u)
+    Q_PROPERTY(qint64 big MEMBER big)
+    Q_PROPERTY(quint64 ubig MEMBER ubig)
+    Q_PROPERTY(float f MEMBER f)
+    Q_PROPERTY(double d MEMBER d)
+    Q_PROPERTY(QString text MEMBER text)
+    Q_PROPERTY(QByteArray bytes MEMBER bytes)
+    Q_PROPERTY(QStringList list MEMBER list)
+    Q_PROPERTY(Color color MEMBER color)
+    Q_PROPERTY(Inner inner MEMBER inner)
+    Q_PROPERTY(int accessor READ accessor WRITE setAccessor)
+    Q_PROPERTY(QString computed READ computed)
+    Q_PROPERTY(int transient MEMBER transient STORED false)
+public:
+    enum class Color { Red, Green, Blue };
+    Q_ENUM(Color)
+
+    bool flag = false;
+    int i = 0;
+    uint u = 0;
+    qint64 big = 0;
+    quint64 ubig = 0;
+    float f = 0;
+    double d = 0;
+    QString text;
+    QByteArray bytes;
+    QStringList list;
+    Color color = Color::Red;
+    Inner inner;
+    int transient = 0;
+
+    int accessor() const { return m_accessor; }
+    void setAccessor(int value) { m_accessor = value; ++setterCalls; }
+    QString computed() const { return text + QString::number(i); }
+
+    int m_accessor = 0;
+    int setterCalls = 0;
+
+    static Record sample()
+    {
+        Record r;
+        r.flag = true;
+        r.i = -42;
+        r.u = 4000000000U;
+        r.big = -(Q_INT64_C(1) << 40);
+        r.ubig = Q_UINT64_C(0xfedcba9876543210);
+        r.f = 1.5f;
+        r.d = 3.25;
+        r.text = QStringLiteral("héllo");
+        r.bytes = QByteArray("\x00\xff\xfe", 3);
+        r.list = QStringList{ "a", "bc" };
+        r.color = Color::Blue;
+        r.inner.id = 7;
+        r.inner.label = QStringLiteral("seven");
+        r.m_accessor = 99;
+        r.transient = 5;
+        return r;
+    }
+
+    bool sameStoredValues(const Record &o) const
+    {
+        return flag == o.flag && i == o.i && u == o.u && big == o.big && ubig == o.ubig
+                && f == o.f && d == o.d && text == o.text && bytes == o.bytes && list == o.list
+                && color == o.color && inner == o.inner && m_accessor == o.m_accessor;
+    }
+};
+
+struct Extended : Record
+{
+    Q_GADGET
+    Q_PROPERTY_VISITOR
+    Q_PROPERTY(QString extra MEMBER extra)
+public:
+    QString extra;
+};
+
+class Settings : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY_VISITOR
+    Q_PROPERTY(int volume READ volume WRITE setVolume NOTIFY volumeChanged)
+    Q_PROPERTY(QString name MEMBER m_name NOTIFY nameChanged)
+    Q_PROPERTY(int version MEMBER m_version CONSTANT)
+public:
+    int volume() const { return m_volume; }
+    void setVolume(int volume)
+    {
+        if (m_volume == volume)
+            return;
+        m_volume = volume;
+        emit volumeChanged();
+    }
+
+    int m_volume = 0;
+    QString m_name;
+    int m_version = 1;
+
+signals:
+    void volumeChanged();
+    void nameChanged(const QString &name);
+};
+
+class tst_QPropertySerialization : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void visitOrder();
+    void dataStreamRoundTrip();
+    void dataStreamLayout();
+    void cborRoundTrip();
+    void cborContents();
+    void cborOutOfOrder();
+    void cborErrors();
+    void jsonRoundTrip();
+    void jsonContents();
+    void jsonConversions();
+    void inheritance();
+    void qobjectProperties();
+};
+
+class NameCollector : public QPropertyVisitor
+{
+public:
+    NameCollector() : QPropertyVisitor(false) {}
+
+    bool visit(QLatin1String name, int &) override
+    {
+        names << name + QLatin1String(":int");
+        return false;
+    }
+    bool visit(QLatin1String name, QMetaType type, void *) override
+    {
+        names << name + QLatin1Char(':') + QLatin1String(type.name());
+        return false;
+    }
+    bool visitObject(QLatin1String name, QMetaType, VisitFunction visitProperties,
+                     void *object) override
+    {
+        names << name + QLatin1String(":{");
+        visitProperties(*this, object);
+        names << QStringLiteral("}");
+        return false;
+    }
+
+    QStringList names;
+};
+
+void tst_QPropertySerialization::visitOrder()
+{
+    Record r;
+    NameCollector collector;
+    Record::qt_static_visitProperties(collector, &r);
+    const QStringList expected = {
+        "flag:bool", "i:int", "u:uint", "big:qlonglong", "ubig:qulonglong", "f:float",
+        "d:double", "text:QString", "bytes:QByteArray", "list:QStringList",
+        "color:Record::Color", "inner:{", "id:int", "label:QString", "}",
+        "accessor:int", "computed:QString"
+    };
+    QCOMPARE(collector.names, expected);
+    QCOMPARE(r.setterCalls, 0);
+}
+
+void tst_QPropertySerialization::dataStreamRoundTrip()
+{
+    const Record original = Record::sample();
+    QByteArray data;
+    {
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out << original << Inner{ 1, "trailer" };
+        QCOMPARE(out.status(), QDataStream::Ok);
+    }
+
+    Record copy;
+    Inner trailer;
+    QDataStream in(data);
+    in >> copy >> trailer;
+    QCOMPARE(in.status(), QDataStream::Ok);
+    QVERIFY(in.atEnd());
+    QVERIFY(copy.sameStoredValues(original));
+    QCOMPARE(copy.setterCalls, 1);
+    QCOMPARE(copy.transient, 0);
+    QCOMPARE(trailer.id, 1);
+    QCOMPARE(trailer.label, QStringLiteral("trailer"));
+}
+
+void tst_QPropertySerialization::dataStreamLayout()
+{
+    const Inner inner{ 12, "twelve" };
+    QByteArray generic;
+    QByteArray manual;
+    {
+        QDataStream out(&generic, QIODevice::WriteOnly);
+        out << inner;
+    }
+    QDataStream(&manual, QIODevice::WriteOnly) << inner.id << inner.label;
+    QCOMPARE(generic, manual);
+
+    // truncated input
+    Inner copy;
+    QDataStream in(manual.left(6));
+    in >> copy;
+    QCOMPARE(in.status(), QDataStream::ReadPastEnd);
+}
+
+void tst_QPropertySerialization::cborRoundTrip()
+{
+    const Record original = Record::sample();
+    QByteArray data;
+    {
+        QCborStreamWriter writer(&data);
+        writer.startArray();
+        QtSerialization::toCbor(writer, original);
+        QtSerialization::toCbor(writer, Inner{ 1, "trailer" });
+        writer.endArray();
+    }
+
+    QCborStreamReader reader(data);
+    QVERIFY(reader.enterContainer());
+    Record copy;
+    Inner trailer;
+    QVERIFY(QtSerialization::fromCbor(reader, copy));
+    QVERIFY(QtSerialization::fromCbor(reader, trailer));
+    QCOMPARE(reader.lastError(), QCborError::NoError);
+    QVERIFY(!reader.hasNext());
+    QVERIFY(copy.sameStoredValues(original));
+    QCOMPARE(trailer.label, QStringLiteral("trailer"));
+
+    // same through a device, which can't hand out views into the data
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::ReadOnly);
+    QCborStreamReader deviceReader(&buffer);
+    Record deviceCopy;
+    QVERIFY(deviceReader.enterContainer());
+    QVERIFY(QtSerialization::fromCbor(deviceReader, deviceCopy));
+    QVERIFY(deviceCopy.sameStoredValues(original));
+}
+
+void tst_QPropertySerialization::cborContents()
+{
+    QByteArray data;
+    QCborStreamWriter writer(&data);
+    QtSerialization::toCbor(writer, Record::sample());
+
+    const QCborMap map = QCborValue::fromCbor(data).toMap();
+    QCOMPARE(map.size(), 14);
+    QCOMPARE(map.value(QLatin1String("flag")), QCborValue(true));
+    QCOMPARE(map.value(QLatin1String("i")), QCborValue(-42));
+    QCOMPARE(map.value(QLatin1String("u")), QCborValue(Q_INT64_C(4000000000)));
+    QCOMPARE(map.value(QLatin1String("text")), QCborValue(QStringLiteral("héllo")));
+    QCOMPARE(map.value(QLatin1String("bytes")), QCborValue(QByteArray("\x00\xff\xfe", 3)));
+    QCOMPARE(map.value(QLatin1String("computed")), QCborValue(QStringLiteral("héllo-42")));
+    QVERIFY(!map.contains(QLatin1String("transient")));
+
+    const QCborMap inner = map.value(QLatin1String("inner")).toMap();
+    QCOMPARE(inner.value(QLatin1String("id")), QCborValue(7));
+    QCOMPARE(inner.value(QLatin1String("label")), QCborValue(QStringLiteral("seven")));
+}
+
+void tst_QPropertySerialization::cborOutOfOrder()
+{
+    QCborMap map;
+    map.insert(QLatin1String("unknown"), QCborArray{ 1, 2, 3 });
+    map.insert(QLatin1String("text"), QStringLiteral("text"));
+    map.insert(QLatin1String("inner"), QCborMap{ { QLatin1String("label"), QLatin1String("l") },
+                                                 { QLatin1String("id"), 3 } });
+    map.insert(QLatin1String("d"), 2);              // integer for a double
+    map.insert(QLatin1String("i"), 1.0);            // integral double for an int
+    map.insert(QLatin1String("accessor"), 5);
+
+    const QByteArray data = QCborArray{ map, QStringLiteral("after") }.toCborValue().toCbor();
+
+    Record r;
+    r.flag = true;
+    QCborStreamReader reader(data);
+    QVERIFY(reader.enterContainer());
+    QVERIFY(QtSerialization::fromCbor(reader, r));
+    QCOMPARE(r.text, QStringLiteral("text"));
+    QCOMPARE(r.inner.id, 3);
+    QCOMPARE(r.inner.label, QStringLiteral("l"));
+    QCOMPARE(r.d, 2.);
+    QCOMPARE(r.i, 1);
+    QCOMPARE(r.accessor(), 5);
+    QVERIFY(r.flag);                // missing, left untouched
+
+    // the reader is positioned after the map
+    QVERIFY(reader.isString());
+    QCOMPARE(reader.readString().data, QStringLiteral("after"));
+}
+
+void tst_QPropertySerialization::cborErrors()
+{
+    Inner inner;
+    {
+        QCborStreamReader reader(QCborArray{ 42, true }.toCborValue().toCbor());
+        QVERIFY(reader.enterContainer());
+        QVERIFY(!QtSerialization::fromCbor(reader, inner));
+        // the non-map element is skipped
+        QVERIFY(reader.isBool());
+    }
+    {
+        QCborMap map{ { QLatin1String("id"), QLatin1String("not a number") },
+                      { QLatin1String("label"), QLatin1String("ok") } };
+        QCborStreamReader reader(map.toCborValue().toCbor());
+        QVERIFY(!QtSerialization::fromCbor(reader, inner));
+        QCOMPARE(inner.id, 0);
+        QCOMPARE(inner.label, QStringLiteral("ok"));
+    }
+    {
+        QCborMap map{ { QLatin1String("id"), Q_INT64_C(1) << 40 } };
+        QCborStreamReader reader(map.toCborValue().toCbor());
+        QVERIFY(!QtSerialization::fromCbor(reader, inner));
+        QCOMPARE(inner.id, 0);
+    }
+    {
+        QByteArray data = QCborMap{ { QLatin1String("id"), 1 },
+                                    { QLatin1String("label"), QLatin1String("label") } }
+                .toCborValue().toCbor();
+        data.chop(2);
+        QCborStreamReader reader(data);
+        QVERIFY(!QtSerialization::fromCbor(reader, inner));
+        QCOMPARE(inner.id, 1);
+    }
+}
+
+void tst_QPropertySerialization::jsonRoundTrip()
+{
+    const Record original = Record::sample();
+    const QJsonObject json = QtSerialization::toJson(original);
+
+    Record copy;
+    QVERIFY(QtSerialization::fromJson(json, copy));
+    // 64-bit unsigned values above the qint64 range go through double
+    copy.ubig = original.ubig;
+    QVERIFY(copy.sameStoredValues(original));
+}
+
+void tst_QPropertySerialization::jsonContents()
+{
+    const QJsonObject json = QtSerialization::toJson(Record::sample());
+    QCOMPARE(json.size(), 14);
+    QCOMPARE(json.value(QLatin1String("flag")), QJsonValue(true));
+    QCOMPARE(json.value(QLatin1String("u")), QJsonValue(Q_INT64_C(4000000000)));
+    QCOMPARE(json.value(QLatin1String("big")), QJsonValue(-(Q_INT64_C(1) << 40)));
+    QCOMPARE(json.value(QLatin1String("f")), QJsonValue(1.5));
+    QCOMPARE(json.value(QLatin1String("bytes")), QJsonValue(QLatin1String("AP_-")));
+    QCOMPARE(json.value(QLatin1String("list")), QJsonValue(QJsonArray{ "a", "bc" }));
+    QCOMPARE(json.value(QLatin1String("inner")).toObject(),
+             (QJsonObject{ { "id", 7 }, { "label", "seven" } }));
+    QCOMPARE(json.value(QLatin1String("computed")), QJsonValue(QStringLiteral("héllo-42")));
+    QVERIFY(!json.contains(QLatin1String("transient")));
+
+    // matches what QMetaProperty-based conversion produces for plain types
+    const Record sample = Record::sample();
+    const QMetaObject &mo = Record::staticMetaObject;
+    for (const char *name : { "flag", "i", "u", "big", "d", "text", "list" }) {
+        const QMetaProperty property = mo.property(mo.indexOfProperty(name));
+        QCOMPARE(json.value(QLatin1String(name)),
+                 QJsonValue::fromVariant(property.readOnGadget(&sample)));
+    }
+}
+
+void tst_QPropertySerialization::jsonConversions()
+{
+    Record r;
+    QJsonObject json{ { "i", 2.5 } };
+    QVERIFY(!QtSerialization::fromJson(json, r));
+    QCOMPARE(r.i, 0);
+
+    json = QJsonObject{ { "u", -1 } };
+    QVERIFY(!QtSerialization::fromJson(json, r));
+    QCOMPARE(r.u, 0U);
+
+    json = QJsonObject{ { "bytes", "!!" } };
+    QVERIFY(!QtSerialization::fromJson(json, r));
+    QVERIFY(r.bytes.isEmpty());
+
+    json = QJsonObject{ { "i", 3 }, { "f", 4 }, { "inner", QJsonObject{ { "id", 5 } } },
+                        { "computed", "ignored" } };
+    QVERIFY(QtSerialization::fromJson(json, r));
+    QCOMPARE(r.i, 3);
+    QCOMPARE(r.f, 4.f);
+    QCOMPARE(r.inner.id, 5);
+    QCOMPARE(r.setterCalls, 0);
+
+    json = QJsonObject{ { "inner", 5 } };
+    QVERIFY(!QtSerialization::fromJson(json, r));
+}
+
+void tst_QPropertySerialization::inheritance()
+{
+    Extended original;
+    static_cast<Record &>(original) = Record::sample();
+    original.extra = QStringLiteral("extra");
+
+    const QJsonObject json = QtSerialization::toJson(original);
+    QCOMPARE(json.size(), 15);
+    QCOMPARE(json.value(QLatin1String("extra")), QJsonValue(QLatin1String("extra")));
+
+    QByteArray data;
+    {
+        QDataStream out(&data, QIODevice::WriteOnly);
+        out << original;
+    }
+    Extended copy;
+    QDataStream in(data);
+    in >> copy;
+    QVERIFY(copy.sameStoredValues(original));
+    QCOMPARE(copy.extra, original.extra);
+}
+
+void tst_QPropertySerialization::qobjectProperties()
+{
+    Settings original;
+    original.m_volume = 11;
+    original.m_name = QStringLiteral("name");
+    original.m_version = 2;
+
+    QByteArray data;
+    {
+        QCborStreamWriter writer(&data);
+        QtSerialization::toCbor(writer, original);
+    }
+
+    Settings copy;
+    QSignalSpy volumeSpy(&copy, &Settings::volumeChanged);
+    QSignalSpy nameSpy(&copy, &Settings::nameChanged);
+    QCborStreamReader reader(data);
+    QVERIFY(QtSerialization::fromCbor(reader, copy));
+    QCOMPARE(copy.volume(), 11);
+    QCOMPARE(copy.m_name, QStringLiteral("name"));
+    QCOMPARE(copy.m_version, 1);        // constant
+    QCOMPARE(volumeSpy.count(), 1);
+    QCOMPARE(nameSpy.count(), 1);
+    QCOMPARE(nameSpy.at(0).at(0).toString(), QStringLiteral("name"));
+
+    // unchanged values don't emit
+    QVERIFY(QtSerialization::fromJson(QtSerialization::toJson(original), copy));
+    QCOMPARE(volumeSpy.count(), 1);
+    QCOMPARE(nameSpy.count(), 1);
+}
+
+QTEST_MAIN(tst_QPropertySerialization)
+#include "tst_qpropertyserialization.moc"
@@ -79,6 +79,7 @@ private slots:
     void readLineMaxlen_data();
     void readLineMaxlen();
     void readLinesFromBufferCRCR();
+    void readLinesCRLFAcrossBufferBoundary();
     void readLineInto();
 
     // all
@@ -127,6 +128,8 @@ private slots:
 
     void int_read_with_locale_data();
     void int_read_with_locale();
+    void numbersAcrossBufferBoundary();
+    void unicodeDigits();
 
     void int_write_with_locale_data();
     void int_write_with_locale();
@@ -604,6 +607,27 @@ void tst_QTextStream::readLinesFromBufferCRCR()
     }
 }
 
+void tst_QTextStream::readLinesCRLFAcrossBufferBoundary()
+{
+    // move the "\r\n" across the point where the stream refills its buffer
+    for (int padding = 16380; padding < 16390; ++padding) {
+        QByteArray data(padding, 'x');
+        data += "\r\nsecond\r\n\r\nfourth\r";
+
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QTextStream stream(&buffer);
+        QCOMPARE(stream.readLine().size(), padding);
+        QCOMPARE(stream.readLine(), QString("second"));
+        QString line;
+        QVERIFY(stream.readLineInto(&line));
+        QVERIFY(line.isEmpty());
+        QVERIFY(stream.readLineInto(&line));
+        QCOMPARE(line, QString("fourth"));
+        QVERIFY(stream.atEnd());
+    }
+}
+
 class ErrorDevice : public QIODevice
 {
 protected:
@@ -2983,6 +3007,52 @@ void tst_QTextStream::int_read_with_locale()
     QCOMPARE(result, output);
 }
 
+void tst_QTextStream::numbersAcrossBufferBoundary()
+{
+    // move the numbers across the point where the stream refills its buffer
+    for (int padding = 16370; padding < 16390; ++padding) {
+        QByteArray data(padding, ' ');
+        data += "-1234567890 0x1f 017 08 +4294967295 3.25e2 -0.125\n";
+
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QTextStream stream(&buffer);
+        int i = 0;
+        stream >> i;
+        QCOMPARE(i, -1234567890);
+        stream >> i;
+        QCOMPARE(i, 0x1f);
+        stream >> i;
+        QCOMPARE(i, 017);
+        stream >> i;
+        QCOMPARE(i, 8);
+        qlonglong ll = 0;
+        stream >> ll;
+        QCOMPARE(ll, Q_INT64_C(4294967295));
+        double d = 0;
+        stream >> d;
+        QCOMPARE(d, 325.);
+        stream >> d;
+        QCOMPARE(d, -0.125);
+        QCOMPARE(stream.status(), QTextStream::Ok);
+    }
+}
+
+void tst_QTextStream::unicodeDigits()
+{
+    // non-ASCII digits are still accepted when reading integers
+    QString input = QString::fromUtf16(u"12\u0663\u0664 -\u0665 7");
+    QTextStream stream(&input);
+    int i = 0;
+    stream >> i;
+    QCOMPARE(i, 1234);
+    stream >> i;
+    QCOMPARE(i, -5);
+    stream >> i;
+    QCOMPARE(i, 7);
+    QCOMPARE(stream.status(), QTextStream::Ok);
+}
+
 void tst_QTextStream::int_write_with_locale_data()
 {
     QTest::addColumn<QString>("locale");
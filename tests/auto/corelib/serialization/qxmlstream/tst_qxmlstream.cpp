@@ -39,6 +39,10 @@
 #include <QStack>
 #include <QtGui/private/qzipreader_p.h>
 
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
 #include "qc14n.h"
 
 Q_DECLARE_METATYPE(QXmlStreamReader::ReadElementTextBehaviour)
@@ -585,6 +589,8 @@ private slots:
     void roundTrip_data() const;
 
     void entityExpansionLimit() const;
+    void largeDocument() const;
+    void longIncrementalStream() const;
 
 private:
     static QByteArray readFile(const QString &filename);
@@ -1730,6 +1736,172 @@ void tst_QXmlStream::entityExpansionLimit() const
     }
 }
 
+static QString dumpTokens(QXmlStreamReader &reader)
+{
+    QString dump;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        dump += reader.tokenString();
+        dump += u' ';
+        dump += reader.name();
+        dump += u' ';
+        dump += reader.text();
+        for (const QXmlStreamAttribute &attribute : reader.attributes()) {
+            dump += u' ';
+            dump += attribute.name();
+            dump += u'=';
+            dump += attribute.value();
+        }
+        dump += QString::asprintf(" %lld:%lld:%lld\n", reader.lineNumber(),
+                                  reader.columnNumber(), reader.characterOffset());
+    }
+    if (reader.hasError())
+        dump += reader.errorString();
+    return dump;
+}
+
+void tst_QXmlStream::largeDocument() const
+{
+    // Large enough to be decoded in many pieces, with multi-byte characters,
+    // line breaks and markup-like characters at all possible offsets.
+    const QString text = QStringLiteral("Plain text, \u00e4\u00f6\u00fc \u20ac \U0001F600 ] ]] & more\r\n");
+    QByteArray document = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\r\n<root>\r\n";
+    for (int i = 0; i < 2000; ++i) {
+        const QString escaped = text.left(i % text.size()).toHtmlEscaped().replace(QLatin1String("]]"), QLatin1String("] ]"));
+        document += QStringLiteral("  <item id=\"%1\" note=\"a\tb\r\nc %2\">%2%3</item>\r\n")
+                .arg(i).arg(escaped, QString(i % 17, u' ')).toUtf8();
+    }
+    document += "</root>\r\n";
+
+    QXmlStreamReader fromMemory(document);
+    const QString expected = dumpTokens(fromMemory);
+    QVERIFY2(!fromMemory.hasError(), qPrintable(fromMemory.errorString()));
+    QVERIFY(expected.contains(u"Plain text, \u00e4\u00f6\u00fc \u20ac \U0001F600 ] ]"));
+    QVERIFY(expected.contains(u"note=a b c Plain"));
+
+    QBuffer buffer(&document);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QXmlStreamReader fromDevice(&buffer);
+    QCOMPARE(dumpTokens(fromDevice), expected);
+
+    QXmlStreamReader fromString(QString::fromUtf8(document));
+    QCOMPARE(dumpTokens(fromString), expected);
+
+    // fed in pieces, character data may be reported in several tokens
+    const auto allText = [](QXmlStreamReader &reader, QString *text) {
+        while (!reader.atEnd()) {
+            if (reader.readNext() == QXmlStreamReader::Characters)
+                *text += reader.text();
+        }
+    };
+    QString expectedText;
+    QXmlStreamReader whole(document);
+    allText(whole, &expectedText);
+
+    QXmlStreamReader incremental;
+    QString incrementalText;
+    for (qsizetype pos = 0; pos < document.size(); pos += 997) {
+        incremental.addData(document.mid(pos, 997));
+        allText(incremental, &incrementalText);
+    }
+    QCOMPARE(incrementalText, expectedText);
+    QCOMPARE(incremental.error(), QXmlStreamReader::NoError);
+}
+
+#ifdef Q_OS_LINUX
+static qint64 residentMemory()
+{
+    QFile statm(QStringLiteral("/proc/self/statm"));
+    if (!statm.open(QIODevice::ReadOnly))
+        return -1;
+    const QList<QByteArray> fields = statm.readAll().split(' ');
+    return fields.size() > 1 ? fields.at(1).toLongLong() * sysconf(_SC_PAGESIZE) : -1;
+}
+#endif
+
+void tst_QXmlStream::longIncrementalStream() const
+{
+    // An XMPP-like stream: a root element that stays open, with stanzas that
+    // keep arriving in small pieces. Comments, CDATA sections and character
+    // data, most of them larger than a piece, span many pieces. Set
+    // QT_XMLSTREAM_STREAM_SIZE to the size in MiB.
+    qint64 size = qEnvironmentVariableIntValue("QT_XMLSTREAM_STREAM_SIZE");
+    size = (size > 0 ? size : 1024) * 1024 * 1024;
+    constexpr qsizetype ChunkSize = 1000;
+
+    QByteArray stanzas;
+    qsizetype stanzaTextSize = 0;
+    constexpr int StanzaCount = 32;
+    for (int i = 0; i < StanzaCount; ++i) {
+        const QByteArray text((i + 1) * 97, 'a' + i % 26);
+        const QByteArray data((i + 1) * 613, 'A' + i % 26);
+        stanzas += "<message to='juliet@example.com' id='" + QByteArray::number(i) + "'>"
+                   "<!-- " + QByteArray(i * 211, '-').replace("--", "- ") + " -->"
+                   "<body>" + text + " &amp; more</body>"
+                   "<data><![CDATA[" + data + "]]></data>"
+                   "</message>\n";
+        stanzaTextSize += text.size() + 7 + data.size();
+    }
+
+    QXmlStreamReader reader;
+    reader.addData(QByteArray("<?xml version='1.0'?>"
+                              "<stream:stream xmlns:stream='http://etherx.jabber.org/streams'"
+                              " xmlns='jabber:client'>"));
+
+    qint64 messages = 0;
+    qint64 textSize = 0;
+    bool inContent = false;
+    qint64 fed = 0;
+#ifdef Q_OS_LINUX
+    qint64 initialMemory = -1;
+    qint64 peakMemory = -1;
+#endif
+    while (fed < size) {
+        // read as far as possible after each piece, so that tokens span the input boundaries
+        for (qsizetype pos = 0; pos < stanzas.size(); pos += ChunkSize) {
+            reader.addData(stanzas.mid(pos, ChunkSize));
+            while (!reader.atEnd()) {
+                switch (reader.readNext()) {
+                case QXmlStreamReader::StartElement:
+                    if (reader.name() == QLatin1String("message"))
+                        ++messages;
+                    inContent = reader.name() == QLatin1String("body")
+                            || reader.name() == QLatin1String("data");
+                    break;
+                case QXmlStreamReader::EndElement:
+                    inContent = false;
+                    break;
+                case QXmlStreamReader::Characters:
+                    if (inContent)
+                        textSize += reader.text().size();
+                    break;
+                default:
+                    break;
+                }
+            }
+            QCOMPARE(reader.error(), QXmlStreamReader::PrematureEndOfDocumentError);
+        }
+        fed += stanzas.size();
+
+#ifdef Q_OS_LINUX
+        if (initialMemory < 0 && fed >= size / 16)
+            initialMemory = residentMemory();
+        else if (initialMemory >= 0)
+            peakMemory = qMax(peakMemory, residentMemory());
+#endif
+    }
+
+    QCOMPARE(messages, fed / stanzas.size() * StanzaCount);
+    QCOMPARE(textSize, fed / stanzas.size() * stanzaTextSize);
+#ifdef Q_OS_LINUX
+    // memory use does not depend on the amount of data that went through
+    if (initialMemory > 0 && peakMemory > 0)
+        QVERIFY2(peakMemory - initialMemory < 16 * 1024 * 1024,
+                 qPrintable(QString::fromLatin1("memory use grew from %1 to %2 bytes")
+                            .arg(initialMemory).arg(peakMemory)));
+#endif
+}
+
 void tst_QXmlStream::roundTrip() const
 {
     QFETCH(QString, in);
@@ -35,6 +35,7 @@
 
 #include <qobject.h>
 #include <qregularexpression.h>
+#include <private/qregularexpression_p.h>
 #include <qthread.h>
 
 #include <iostream>
@@ -88,6 +89,8 @@ private slots:
     void QStringAndQStringViewEquivalence();
     void threadSafety_data();
     void threadSafety();
+    void patternCache();
+    void patternCacheThreadSafety();
 
     void returnsViewsIntoOriginalString();
     void wildcard_data();
@@ -2433,6 +2436,96 @@ void tst_QRegularExpression::threadSafety()
     }
 }
 
+void tst_QRegularExpression::patternCache()
+{
+    if (qEnvironmentVariableIsSet("QT_REGEXP_CACHE_SIZE"))
+        QSKIP("The pattern cache size is overridden in the environment");
+
+    qt_regularExpressionPatternCacheClear();
+    qsizetype hits = -1, misses = -1;
+    const auto checkStatistics = [&](qsizetype expectedHits, qsizetype expectedMisses) {
+        qt_regularExpressionPatternCacheStatistics(&hits, &misses);
+        return hits == expectedHits && misses == expectedMisses;
+    };
+    QVERIFY(checkStatistics(0, 0));
+
+    const QString pattern = QStringLiteral("(?<first>\\w+) (\\d+)");
+    QRegularExpression re1(pattern);
+    QVERIFY(re1.isValid());
+    QVERIFY(checkStatistics(0, 1));
+
+    // compiled at most once per object
+    QCOMPARE(re1.captureCount(), 2);
+    QVERIFY(checkStatistics(0, 1));
+
+    // a different object with the same pattern reuses the compiled code
+    QRegularExpression re2(pattern);
+    QCOMPARE(re2.captureCount(), 2);
+    QCOMPARE(re2.namedCaptureGroups(), QStringList({QString(), "first", QString()}));
+    QVERIFY(checkStatistics(1, 1));
+    QRegularExpressionMatch m = re2.match(QStringLiteral("foo bar 42"));
+    QVERIFY(m.hasMatch());
+    QCOMPARE(m.captured("first"), QStringLiteral("bar"));
+    QCOMPARE(m.captured(2), QStringLiteral("42"));
+
+    // ... but not if the options differ
+    QRegularExpression re3(pattern, QRegularExpression::CaseInsensitiveOption);
+    QVERIFY(re3.isValid());
+    QVERIFY(checkStatistics(1, 2));
+    QRegularExpression re4(pattern, QRegularExpression::CaseInsensitiveOption);
+    QVERIFY(re4.isValid());
+    QVERIFY(checkStatistics(2, 2));
+
+    // changing the pattern goes through the cache too
+    re4.setPattern(pattern);
+    re4.setPatternOptions(QRegularExpression::NoPatternOption);
+    QCOMPARE(re4.match(QStringLiteral("foo 42")).captured(2), QStringLiteral("42"));
+    QVERIFY(checkStatistics(3, 2));
+
+    // invalid patterns are not cached
+    QRegularExpression invalid1(QStringLiteral("a(b"));
+    QVERIFY(!invalid1.isValid());
+    QRegularExpression invalid2(QStringLiteral("a(b"));
+    QVERIFY(!invalid2.isValid());
+    QCOMPARE(invalid2.patternErrorOffset(), 3);
+    QVERIFY(checkStatistics(3, 4));
+
+    // the cached code outlives the cache entries
+    qt_regularExpressionPatternCacheClear();
+    QCOMPARE(re1.match(QStringLiteral("foo 42")).captured(2), QStringLiteral("42"));
+    QCOMPARE(re2.match(QStringLiteral("foo 42")).captured(1), QStringLiteral("foo"));
+    QVERIFY(checkStatistics(0, 0));
+}
+
+void tst_QRegularExpression::patternCacheThreadSafety()
+{
+    // Many independently constructed regular expressions with the same
+    // pattern, in many threads, all using the same shared compiled code.
+    const QString pattern = QStringLiteral("(\\w+)@(\\w+)\\.com");
+    const QString subject = QStringLiteral("Write to user@example.com for details");
+    const int threadCount = qMax(QThread::idealThreadCount(), 4);
+
+    QAtomicInt failures = 0;
+    QList<QThread *> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        threads.push_back(QThread::create([&] {
+            for (int j = 0; j < 200; ++j) {
+                const QRegularExpression re(pattern);
+                const QRegularExpressionMatch m = re.match(subject);
+                if (!m.hasMatch() || m.captured(1) != QLatin1String("user")
+                    || m.captured(2) != QLatin1String("example")) {
+                    failures.ref();
+                }
+            }
+        }));
+        threads.back()->start();
+    }
+    for (QThread *thread : std::as_const(threads))
+        QVERIFY(thread->wait());
+    qDeleteAll(threads);
+    QCOMPARE(failures.loadRelaxed(), 0);
+}
+
 void tst_QRegularExpression::returnsViewsIntoOriginalString()
 {
     // https://bugreports.qt.io/browse/QTBUG-98653
@@ -5234,6 +5234,15 @@ void tst_QString::arg()
     QCOMPARE( s4.arg(4294967295UL), QLatin1String("[4294967295]") ); // ULONG_MAX 32
     QCOMPARE( s4.arg(Q_INT64_C(9223372036854775807)), // LLONG_MAX
              QLatin1String("[9223372036854775807]") );
+    QCOMPARE( s4.arg(std::numeric_limits<qlonglong>::min()),
+             QLatin1String("[-9223372036854775808]") );
+    QCOMPARE( s4.arg(std::numeric_limits<qulonglong>::max()),
+             QLatin1String("[18446744073709551615]") );
+    QCOMPARE( s4.arg(-0xbad1dea, 0, 16), QLatin1String("[-bad1dea]") );
+    QCOMPARE( s4.arg(Q_UINT64_C(0xbad1dea), -10, 16, QChar(u'.')),
+             QLatin1String("[bad1dea...]") );
+    QCOMPARE( s4.arg(1295, 0, 36), QLatin1String("[zz]") );
+    QCOMPARE( s8.arg(7).arg(7), QLatin1String("[7 7]") );
 
     QTest::ignoreMessage(QtWarningMsg, "QString::arg: Argument missing: , foo");
     QCOMPARE(QString().arg("foo"), QString());
@@ -44,6 +44,8 @@ private Q_SLOTS:
     void basics_data() const;
     void basics() const;
     void toContainer() const;
+    void byteArrays_data() const { basics_data(); }
+    void byteArrays() const;
 };
 
 static QStringList skipped(const QStringList &sl)
@@ -62,6 +64,11 @@ QString toQString(QStringView str)
     return str.toString();
 }
 
+QString toQString(QByteArrayView str)
+{
+    return QString::fromLatin1(str);
+}
+
 template <typename Container>
 QStringList toQStringList(const Container &c)
 {
@@ -131,6 +138,43 @@ void tst_QStringTokenizer::basics() const
     }
 }
 
+void tst_QStringTokenizer::byteArrays() const
+{
+    QFETCH(const Qt::SplitBehavior, sb);
+    QFETCH(const Qt::CaseSensitivity, cs);
+
+    auto expected = QStringList{"", "a", "b", "c", "d", "e", ""};
+    if (sb & Qt::SkipEmptyParts)
+        expected = skipped(expected);
+    QCOMPARE(toQStringList(qTokenize(QByteArrayView(",a,b,c,d,e,"), ',', sb, cs)), expected);
+    QCOMPARE(toQStringList(qTokenize(QByteArrayView(",a,b,c,d,e,"), QByteArrayView(","), cs, sb)),
+             expected);
+
+    {
+        auto tok = qTokenize(expected.join(u"xY").toLatin1(), QByteArrayView("Xy"),
+                             Qt::CaseInsensitive, sb);
+        // the temporary QByteArray returned from toLatin1() is now destroyed,
+        // but 'tok' should keep it alive
+        QCOMPARE(toQStringList(tok), expected);
+    }
+
+    {
+        const QByteArray haystack = expected.join(u'x').toLatin1();
+        QCOMPARE(toQStringList(qTokenize(haystack, 'X', Qt::CaseInsensitive, sb)), expected);
+        QCOMPARE(toQStringList(qTokenize(haystack, 'X', Qt::CaseSensitive, sb)),
+                 QStringList{QString::fromLatin1(haystack)});
+    }
+
+    {
+        // Latin-1 case folding, like qstrnicmp()
+        const QByteArray haystack = QStringView(u"a\u00e9b\u00c9c").toLatin1();
+        const QStringList expected = cs == Qt::CaseSensitive
+                ? QStringList{QStringView(u"a\u00e9b").toString(), "c"}
+                : QStringList{"a", "b", "c"};
+        QCOMPARE(toQStringList(qTokenize(haystack, char(0xc9), cs)), expected);
+    }
+}
+
 void tst_QStringTokenizer::toContainer() const
 {
     // QStringView value_type:
@@ -145,6 +189,13 @@ void tst_QStringTokenizer::toContainer() const
         auto v = tok.toContainer();
         QVERIFY((std::is_same_v<decltype(v), QList<QLatin1String>>));
     }
+    // QByteArrayView value_type
+    {
+        auto tok = qTokenize(QByteArrayView{"a,b,c"}, ',');
+        auto v = tok.toContainer();
+        QVERIFY((std::is_same_v<decltype(v), QList<QByteArrayView>>));
+        QCOMPARE(v, QList<QByteArrayView>({"a", "b", "c"}));
+    }
 }
 
 QTEST_APPLESS_MAIN(tst_QStringTokenizer)
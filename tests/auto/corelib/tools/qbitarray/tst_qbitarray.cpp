@@ -29,6 +29,7 @@
 #include <QTest>
 #include <QtCore/QBuffer>
 #include <QtCore/QDataStream>
+#include <QtCore/QRandomGenerator>
 
 #include "qbitarray.h"
 
@@ -89,6 +90,11 @@ private slots:
 
     void toUInt32_data();
     void toUInt32();
+    void bitwiseLarge();
+    void indexOf_data();
+    void indexOf();
+    void rankSelect_data();
+    void rankSelect();
 };
 
 void tst_QBitArray::size_data()
@@ -760,5 +766,122 @@ void tst_QBitArray::toUInt32()
     QCOMPARE(ok, check);
 }
 
+// fills one bit in every 'density' on average
+static QBitArray randomBitArray(QRandomGenerator &rng, qsizetype size, int density)
+{
+    QBitArray result(size);
+    for (qsizetype i = 0; i < size; ++i) {
+        if (rng.bounded(density) == 0)
+            result.setBit(i);
+    }
+    return result;
+}
+
+void tst_QBitArray::bitwiseLarge()
+{
+    QRandomGenerator rng(42);
+    const qsizetype sizes[] = { 1, 9, 64, 65, 255, 256, 257, 1000, 4099 };
+    for (qsizetype size1 : sizes) {
+        for (qsizetype size2 : sizes) {
+            const QBitArray a = randomBitArray(rng, size1, 2);
+            const QBitArray b = randomBitArray(rng, size2, 2);
+            const QBitArray andResult = a & b;
+            const QBitArray orResult = a | b;
+            const QBitArray xorResult = a ^ b;
+            const qsizetype size = qMax(size1, size2);
+            QCOMPARE(andResult.size(), size);
+            QCOMPARE(orResult.size(), size);
+            QCOMPARE(xorResult.size(), size);
+            qsizetype ones = 0;
+            for (qsizetype i = 0; i < size; ++i) {
+                const bool bitA = i < size1 && a.testBit(i);
+                const bool bitB = i < size2 && b.testBit(i);
+                QCOMPARE(andResult.testBit(i), bitA && bitB);
+                QCOMPARE(orResult.testBit(i), bitA || bitB);
+                QCOMPARE(xorResult.testBit(i), bitA != bitB);
+                ones += bitA;
+            }
+            QCOMPARE(a.count(true), ones);
+            QCOMPARE((~a).count(true), size1 - ones);
+            QCOMPARE(~~a, a);
+        }
+    }
+}
+
+void tst_QBitArray::indexOf_data()
+{
+    QTest::addColumn<qsizetype>("size");
+    QTest::addColumn<int>("density");
+
+    for (qsizetype size : { 0, 1, 7, 64, 65, 200, 1000, 10000 }) {
+        for (int density : { 1, 2, 100, 5000 })
+            QTest::addRow("%lld-%d", qlonglong(size), density) << size << density;
+    }
+}
+
+void tst_QBitArray::indexOf()
+{
+    QFETCH(const qsizetype, size);
+    QFETCH(const int, density);
+
+    QRandomGenerator rng(size * 31 + density);
+    const QBitArray bits = randomBitArray(rng, size, density);
+    const QBitArray inverted = ~bits;
+
+    for (bool value : { true, false }) {
+        qsizetype expectedNext = -1;
+        for (qsizetype from = size - 1; from >= 0; --from) {
+            if (bits.testBit(from) == value)
+                expectedNext = from;
+            QCOMPARE(bits.indexOf(value, from), expectedNext);
+            // the same search, on the inverted array
+            QCOMPARE(inverted.indexOf(!value, from), expectedNext);
+        }
+        QCOMPARE(bits.indexOf(value, size), -1);
+        QCOMPARE(bits.indexOf(value, -1), size && bits.testBit(size - 1) == value ? size - 1 : -1);
+
+        qsizetype expectedPrevious = -1;
+        for (qsizetype from = 0; from < size; ++from) {
+            if (bits.testBit(from) == value)
+                expectedPrevious = from;
+            QCOMPARE(bits.lastIndexOf(value, from), expectedPrevious);
+            QCOMPARE(inverted.lastIndexOf(!value, from), expectedPrevious);
+        }
+        QCOMPARE(bits.lastIndexOf(value), expectedPrevious);
+        QCOMPARE(bits.lastIndexOf(value, size + 10), expectedPrevious);
+    }
+}
+
+void tst_QBitArray::rankSelect_data()
+{
+    indexOf_data();
+    QTest::newRow("100000-3") << qsizetype(100000) << 3;
+}
+
+void tst_QBitArray::rankSelect()
+{
+    QFETCH(const qsizetype, size);
+    QFETCH(const int, density);
+
+    QRandomGenerator rng(size * 17 + density);
+    const QBitArray bits = randomBitArray(rng, size, density);
+    const QBitArrayRankSelect index(bits);
+    QCOMPARE(index.size(), size);
+    QCOMPARE(index.count(), bits.count(true));
+    QCOMPARE(index.bitArray(), bits);
+
+    qsizetype ones = 0;
+    for (qsizetype i = 0; i < size; ++i) {
+        QCOMPARE(index.rank(i), ones);
+        if (bits.testBit(i)) {
+            QCOMPARE(index.select(ones), i);
+            ++ones;
+        }
+    }
+    QCOMPARE(index.rank(size), ones);
+    QCOMPARE(index.select(ones), -1);
+    QCOMPARE(index.select(-1), -1);
+}
+
 QTEST_APPLESS_MAIN(tst_QBitArray)
 #include "tst_qbitarray.moc"
@@ -0,0 +1,426 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+
+#include <qbtreemap.h>
+
+#include <map>
+#include <random>
+
+class tst_QBTreeMap : public QObject
+{
+    Q_OBJECT
+private slots:
+    void empty();
+    void insertAndLookup();
+    void operatorBracket();
+    void insertAliasingElement();
+    void removeAndTake();
+    void iterators();
+    void bounds();
+    void eraseWhileIterating();
+    void implicitSharing();
+    void equality();
+    void largeKeys();
+    void randomOperations_data();
+    void randomOperations();
+};
+
+// A key large enough to make the nodes hold only a few elements, so that even
+// small maps have several levels.
+struct LargeKey
+{
+    int value = 0;
+    char padding[200] = {};
+
+    LargeKey(int v = 0) : value(v) {}
+    friend bool operator<(const LargeKey &lhs, const LargeKey &rhs) { return lhs.value < rhs.value; }
+    friend bool operator==(const LargeKey &lhs, const LargeKey &rhs) { return lhs.value == rhs.value; }
+};
+
+template <typename Key>
+static bool sameContents(const QBTreeMap<Key, int> &map, const std::map<int, int> &reference)
+{
+    if (map.size() != qsizetype(reference.size()))
+        return false;
+    auto it = map.constBegin();
+    for (const auto &[key, value] : reference) {
+        if (it == map.constEnd() || !(it.key() == Key(key)) || it.value() != value)
+            return false;
+        ++it;
+    }
+    if (it != map.constEnd())
+        return false;
+    // and backwards
+    for (auto r = reference.rbegin(); r != reference.rend(); ++r) {
+        --it;
+        if (!(it.key() == Key(r->first)))
+            return false;
+    }
+    return it == map.constBegin();
+}
+
+void tst_QBTreeMap::empty()
+{
+    QBTreeMap<int, QString> map;
+    QVERIFY(map.isEmpty());
+    QCOMPARE(map.size(), 0);
+    QVERIFY(!map.contains(1));
+    QCOMPARE(map.value(1), QString());
+    QCOMPARE(map.value(1, QStringLiteral("default")), QStringLiteral("default"));
+    QCOMPARE(map.remove(1), 0);
+    QCOMPARE(map.take(1), QString());
+    QVERIFY(map.constBegin() == map.constEnd());
+    QVERIFY(map.constFind(1) == map.constEnd());
+    QVERIFY(map.lowerBound(1) == map.end());
+    QVERIFY(map.keys().isEmpty());
+
+    map.insert(1, QString());
+    QVERIFY(!map.isEmpty());
+    map.clear();
+    QVERIFY(map.isEmpty());
+}
+
+void tst_QBTreeMap::insertAndLookup()
+{
+    QBTreeMap<QString, int> map;
+    const int count = 5000;
+    for (int i = 0; i < count; ++i)
+        map.insert(QString::number(i), i);
+    QCOMPARE(map.size(), count);
+
+    for (int i = 0; i < count; ++i) {
+        QVERIFY(map.contains(QString::number(i)));
+        QCOMPARE(map.value(QString::number(i)), i);
+    }
+    QVERIFY(!map.contains(QStringLiteral("x")));
+
+    // replacing keeps the size
+    map.insert(QStringLiteral("42"), -42);
+    QCOMPARE(map.size(), count);
+    QCOMPARE(map.value(QStringLiteral("42")), -42);
+
+    const QStringList keys = map.keys();
+    QCOMPARE(keys.size(), count);
+    QVERIFY(std::is_sorted(keys.begin(), keys.end()));
+    QCOMPARE(map.firstKey(), QStringLiteral("0"));
+    QCOMPARE(map.lastKey(), QStringLiteral("999"));
+    QCOMPARE(map.first(), 0);
+    QCOMPARE(map.last(), 999);
+    QCOMPARE(map.key(17), QStringLiteral("17"));
+    QCOMPARE(map.key(-1, QStringLiteral("none")), QStringLiteral("none"));
+}
+
+void tst_QBTreeMap::operatorBracket()
+{
+    QBTreeMap<int, int> map;
+    for (int i = 0; i < 1000; ++i)
+        map[i % 100] += i;
+    QCOMPARE(map.size(), 100);
+    QCOMPARE(map[0], 0 + 100 + 200 + 300 + 400 + 500 + 600 + 700 + 800 + 900);
+
+    const auto &constMap = map;
+    QCOMPARE(constMap[1000], 0);
+    QCOMPARE(map.size(), 100);
+}
+
+void tst_QBTreeMap::insertAliasingElement()
+{
+    // the inserted key and value may refer to elements of the map itself,
+    // which splitting a full node moves around
+    QBTreeMap<int, QString> map;
+    for (int i = 0; i < 1000; ++i)
+        map.insert(2 * i, QString::number(2 * i));
+    for (int i = 0; i < 1000; ++i) {
+        const QString &value = map[2 * i];
+        map.insert(2 * i + 1, value);
+    }
+    for (int i = 0; i < 2000; ++i)
+        QCOMPARE(map.value(i), QString::number(i & ~1));
+
+    // when appending
+    QBTreeMap<int, QString> appended;
+    appended.insert(0, QStringLiteral("first"));
+    for (int i = 1; i < 1000; ++i) {
+        QString &previous = appended[i - 1];
+        appended.insert(i, previous);
+    }
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(appended.value(i), QStringLiteral("first"));
+
+    // keys referring to values
+    QBTreeMap<QString, QString> strings;
+    for (int i = 0; i < 1000; ++i)
+        strings.insert(QString::number(2 * i), QString::number(2 * i + 1));
+    for (int i = 0; i < 1000; ++i) {
+        const QString &value = strings[QString::number(2 * i)];
+        strings.insert(value, value);
+    }
+    QCOMPARE(strings.size(), 2000);
+    for (int i = 0; i < 1000; ++i) {
+        const QString odd = QString::number(2 * i + 1);
+        QCOMPARE(strings.value(odd), odd);
+    }
+}
+
+void tst_QBTreeMap::removeAndTake()
+{
+    QBTreeMap<int, QString> map;
+    for (int i = 0; i < 1000; ++i)
+        map.insert(i, QString::number(i));
+
+    for (int i = 0; i < 1000; i += 3)
+        QCOMPARE(map.remove(i), 1);
+    QCOMPARE(map.remove(0), 0);
+    QCOMPARE(map.take(1), QStringLiteral("1"));
+    QCOMPARE(map.take(1), QString());
+    QCOMPARE(map.size(), 1000 - 334 - 1);
+    for (int i = 0; i < 1000; ++i)
+        QCOMPARE(map.contains(i), i % 3 != 0 && i != 1);
+
+    // removing everything leaves a usable map
+    for (int i = 0; i < 1000; ++i)
+        map.remove(i);
+    QVERIFY(map.isEmpty());
+    QVERIFY(map.constBegin() == map.constEnd());
+    map.insert(5, QStringLiteral("5"));
+    QCOMPARE(map.value(5), QStringLiteral("5"));
+}
+
+void tst_QBTreeMap::iterators()
+{
+    QBTreeMap<int, int> map;
+    for (int i = 999; i >= 0; --i)
+        map.insert(i, i * 10);
+
+    int expected = 0;
+    for (auto it = map.cbegin(); it != map.cend(); ++it, ++expected) {
+        QCOMPARE(it.key(), expected);
+        QCOMPARE(*it, expected * 10);
+    }
+    QCOMPARE(expected, 1000);
+
+    for (auto it = map.begin(); it != map.end(); ++it)
+        it.value() += 1;
+    for (auto it = map.cend(); it != map.cbegin();) {
+        --it;
+        --expected;
+        QCOMPARE(it.key(), expected);
+        QCOMPARE(it.value(), expected * 10 + 1);
+    }
+    QCOMPARE(expected, 0);
+
+    QCOMPARE(std::distance(map.keyBegin(), map.keyEnd()), 1000);
+    QVERIFY(std::is_sorted(map.keyBegin(), map.keyEnd()));
+
+    QBTreeMapIterator<int, int> javaIt(map);
+    int count = 0;
+    while (javaIt.hasNext()) {
+        javaIt.next();
+        QCOMPARE(javaIt.key(), count++);
+    }
+    QCOMPARE(count, 1000);
+}
+
+void tst_QBTreeMap::bounds()
+{
+    QBTreeMap<int, int> map;
+    for (int i = 0; i < 1000; ++i)
+        map.insert(i * 2, i);
+
+    QCOMPARE(map.lowerBound(10).key(), 10);
+    QCOMPARE(map.lowerBound(11).key(), 12);
+    QCOMPARE(map.upperBound(10).key(), 12);
+    QCOMPARE(map.lowerBound(-5).key(), 0);
+    QVERIFY(map.lowerBound(1998) != map.end());
+    QVERIFY(map.lowerBound(1999) == map.end());
+    QVERIFY(map.upperBound(1998) == map.end());
+    QVERIFY(map.find(11) == map.end());
+    QCOMPARE(map.find(12).value(), 6);
+
+    const auto &constMap = map;
+    for (int i = -1; i < 2001; ++i) {
+        const auto lower = constMap.lowerBound(i);
+        const int expected = i < 0 ? 0 : (i + 1) / 2 * 2;
+        if (expected > 1998)
+            QVERIFY(lower == constMap.end());
+        else
+            QCOMPARE(lower.key(), expected);
+    }
+}
+
+void tst_QBTreeMap::eraseWhileIterating()
+{
+    QBTreeMap<int, int> map;
+    std::map<int, int> reference;
+    for (int i = 0; i < 3000; ++i) {
+        map.insert(i, i);
+        reference[i] = i;
+    }
+
+    for (auto it = map.begin(); it != map.end();) {
+        if (it.key() % 4 != 1) {
+            reference.erase(it.key());
+            it = map.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    QVERIFY(sameContents(map, reference));
+
+    while (!map.isEmpty())
+        map.erase(map.cbegin());
+    QCOMPARE(map.size(), 0);
+}
+
+void tst_QBTreeMap::implicitSharing()
+{
+    QBTreeMap<int, int> map;
+    for (int i = 0; i < 1000; ++i)
+        map.insert(i, i);
+
+    QBTreeMap<int, int> copy = map;
+    QVERIFY(copy.isSharedWith(map));
+    QVERIFY(!map.isDetached());
+
+    copy.insert(1000, 1000);
+    copy.remove(0);
+    copy[5] = -5;
+    QVERIFY(!copy.isSharedWith(map));
+    QVERIFY(map.isDetached());
+
+    QCOMPARE(map.size(), 1000);
+    QCOMPARE(copy.size(), 1000);
+    QVERIFY(map.contains(0));
+    QVERIFY(!map.contains(1000));
+    QCOMPARE(map.value(5), 5);
+    QCOMPARE(copy.value(5), -5);
+
+    // the deep copy has its own chain of leaves
+    int expected = 1;
+    for (auto it = copy.cbegin(); it != copy.cend(); ++it)
+        QCOMPARE(it.key(), expected++);
+    QCOMPARE(expected, 1001);
+
+    // keys referring into a shared map survive the detach
+    QBTreeMap<int, int> other = map;
+    other.remove(other.firstKey());
+    QVERIFY(!other.contains(0));
+    QVERIFY(map.contains(0));
+}
+
+void tst_QBTreeMap::equality()
+{
+    QBTreeMap<int, int> a = { { 1, 1 }, { 2, 2 }, { 3, 3 } };
+    QBTreeMap<int, int> b;
+    for (int i = 3; i > 0; --i)
+        b.insert(i, i);
+    QVERIFY(a == b);
+    b[2] = 0;
+    QVERIFY(a != b);
+    b.remove(2);
+    QVERIFY(a != b);
+    QVERIFY((QBTreeMap<int, int>() == QBTreeMap<int, int>()));
+}
+
+void tst_QBTreeMap::largeKeys()
+{
+    QBTreeMap<LargeKey, int> map;
+    std::map<int, int> reference;
+    for (int i = 0; i < 2000; ++i) {
+        const int key = (i * 7919) % 2000;
+        map.insert(key, i);
+        reference[key] = i;
+    }
+    QVERIFY(sameContents(map, reference));
+
+    for (int i = 0; i < 2000; i += 2) {
+        map.remove(i);
+        reference.erase(i);
+    }
+    QVERIFY(sameContents(map, reference));
+
+    QBTreeMap<LargeKey, int> copy = map;
+    copy.detach();
+    QVERIFY(sameContents(copy, reference));
+}
+
+void tst_QBTreeMap::randomOperations_data()
+{
+    QTest::addColumn<uint>("seed");
+    QTest::addColumn<int>("keyRange");
+
+    QTest::newRow("dense") << 1u << 200;
+    QTest::newRow("medium") << 2u << 2000;
+    QTest::newRow("sparse") << 3u << 100000;
+}
+
+void tst_QBTreeMap::randomOperations()
+{
+    QFETCH(uint, seed);
+    QFETCH(int, keyRange);
+
+    std::mt19937 rng(seed);
+    QBTreeMap<LargeKey, int> map;
+    std::map<int, int> reference;
+    for (int step = 0; step < 20000; ++step) {
+        const int key = int(rng() % keyRange);
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            map.insert(key, step);
+            reference[key] = step;
+            break;
+        case 2:
+            QCOMPARE(map.remove(key), qsizetype(reference.erase(key)));
+            break;
+        case 3: {
+            auto it = map.lowerBound(key);
+            auto r = reference.lower_bound(key);
+            QCOMPARE(it == map.end(), r == reference.end());
+            if (r != reference.end()) {
+                QCOMPARE(it.key().value, r->first);
+                it = map.erase(it);
+                r = reference.erase(r);
+                QCOMPARE(it == map.end(), r == reference.end());
+                if (r != reference.end())
+                    QCOMPARE(it.key().value, r->first);
+            }
+            break;
+        }
+        }
+        if (step % 1000 == 0)
+            QVERIFY(sameContents(map, reference));
+    }
+    QVERIFY(sameContents(map, reference));
+}
+
+QTEST_APPLESS_MAIN(tst_QBTreeMap)
+#include "tst_qbtreemap.moc"
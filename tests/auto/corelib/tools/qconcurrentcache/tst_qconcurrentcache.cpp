@@ -0,0 +1,326 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QThread>
+#include <QSemaphore>
+#include <QThreadPool>
+
+#include <qconcurrentcache.h>
+
+#include <memory>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+class tst_QConcurrentCache : public QObject
+{
+    Q_OBJECT
+private slots:
+    void empty();
+    void insertAndLookup();
+    void costEviction();
+    void leastRecentlyUsedEviction();
+    void timeToLive();
+    void statistics();
+    void fetch();
+    void fetchSharesPendingLoads();
+    void fetchException();
+    void fetchKeepsNewerInsert();
+    void concurrentAccess();
+};
+
+void tst_QConcurrentCache::empty()
+{
+    QConcurrentCache<int, QString> cache;
+    QVERIFY(cache.isEmpty());
+    QCOMPARE(cache.size(), 0);
+    QCOMPARE(cache.totalCost(), 0);
+    QCOMPARE(cache.maxCost(), 100);
+    QCOMPARE(cache.shardCount(), 16);
+    QVERIFY(!cache.contains(1));
+    QVERIFY(!cache.value(1));
+    QCOMPARE(cache.value(1, QStringLiteral("default")), QStringLiteral("default"));
+    QVERIFY(!cache.remove(1));
+    QVERIFY(!cache.take(1));
+}
+
+void tst_QConcurrentCache::insertAndLookup()
+{
+    QConcurrentCache<QString, int> cache(1000);
+    QVERIFY(cache.insert(QStringLiteral("one"), 1));
+    QVERIFY(cache.insert(QStringLiteral("two"), 2, 5));
+    QCOMPARE(cache.size(), 2);
+    QCOMPARE(cache.totalCost(), 6);
+    QVERIFY(cache.contains(QStringLiteral("one")));
+    QCOMPARE(cache.value(QStringLiteral("two")), 2);
+    QCOMPARE(cache.value(QStringLiteral("two"), -1), 2);
+
+    // insert() replaces
+    QVERIFY(cache.insert(QStringLiteral("two"), 22));
+    QCOMPARE(cache.size(), 2);
+    QCOMPARE(cache.totalCost(), 2);
+    QCOMPARE(cache.value(QStringLiteral("two")), 22);
+
+    QCOMPARE(cache.take(QStringLiteral("two")), 22);
+    QVERIFY(!cache.contains(QStringLiteral("two")));
+    QVERIFY(cache.remove(QStringLiteral("one")));
+    QVERIFY(cache.isEmpty());
+
+    cache.insert(QStringLiteral("three"), 3);
+    cache.clear();
+    QVERIFY(cache.isEmpty());
+}
+
+void tst_QConcurrentCache::costEviction()
+{
+    // a single shard, so that the budget is not split
+    QConcurrentCache<int, int> cache(10, 1);
+    for (int i = 0; i < 10; ++i)
+        QVERIFY(cache.insert(i, i));
+    QCOMPARE(cache.totalCost(), 10);
+
+    // an item that is too expensive is rejected
+    QVERIFY(!cache.insert(100, 100, 11));
+    QVERIFY(!cache.contains(100));
+    QCOMPARE(cache.size(), 10);
+
+    // making room for an expensive item evicts several cheap ones
+    QVERIFY(cache.insert(10, 10, 4));
+    QCOMPARE(cache.totalCost(), 10);
+    QCOMPARE(cache.size(), 7);
+    QCOMPARE(cache.statistics().evictions, 4);
+
+    // lowering the budget evicts, too
+    cache.setMaxCost(5);
+    QVERIFY(cache.totalCost() <= 5);
+    QVERIFY(cache.contains(10));
+}
+
+void tst_QConcurrentCache::leastRecentlyUsedEviction()
+{
+    QConcurrentCache<int, int> cache(3, 1);
+    cache.insert(1, 1);
+    cache.insert(2, 2);
+    cache.insert(3, 3);
+
+    // using 1 makes 2 the least recently used item
+    QCOMPARE(cache.value(1), 1);
+    cache.insert(4, 4);
+    QVERIFY(cache.contains(1));
+    QVERIFY(!cache.contains(2));
+    QVERIFY(cache.contains(3));
+    QVERIFY(cache.contains(4));
+}
+
+void tst_QConcurrentCache::timeToLive()
+{
+    QConcurrentCache<int, int> cache;
+    QCOMPARE(cache.defaultTimeToLive(), -1ms);
+
+    cache.insert(1, 1, 1, 1ms);
+    cache.insert(2, 2, 1, 1h);
+    cache.insert(3, 3);
+    QTest::qSleep(20);
+
+    QVERIFY(!cache.contains(1));
+    QVERIFY(!cache.value(1));
+    QCOMPARE(cache.value(2), 2);
+    QCOMPARE(cache.value(3), 3);
+    QCOMPARE(cache.statistics().expirations, 1);
+    // expired items are dropped when they are found
+    QCOMPARE(cache.size(), 2);
+
+    cache.setDefaultTimeToLive(1ms);
+    cache.insert(4, 4);
+    QTest::qSleep(20);
+    QCOMPARE(cache.value(4, -1), -1);
+    QVERIFY(!cache.take(4));
+}
+
+void tst_QConcurrentCache::statistics()
+{
+    QConcurrentCache<int, int> cache(4, 1);
+    for (int i = 0; i < 6; ++i)
+        cache.insert(i, i);
+    for (int i = 0; i < 6; ++i)
+        cache.value(i);
+
+    const QConcurrentCacheStatistics stats = cache.statistics();
+    QCOMPARE(stats.insertions, 6);
+    QCOMPARE(stats.evictions, 2);
+    QCOMPARE(stats.hits, 4);
+    QCOMPARE(stats.misses, 2);
+    QCOMPARE(stats.expirations, 0);
+
+    cache.resetStatistics();
+    QCOMPARE(cache.statistics().hits, 0);
+    QCOMPARE(cache.statistics().insertions, 0);
+}
+
+void tst_QConcurrentCache::fetch()
+{
+    QConcurrentCache<int, QString> cache;
+    QAtomicInt loads;
+    const auto loader = [&loads](int key) {
+        loads.ref();
+        return QString::number(key);
+    };
+
+    QFuture<QString> future = cache.fetch(42, loader);
+    QCOMPARE(future.result(), QStringLiteral("42"));
+    QCOMPARE(loads.loadRelaxed(), 1);
+    QTRY_VERIFY(cache.contains(42));
+
+    // now it's cached
+    future = cache.fetch(42, loader);
+    QVERIFY(future.isFinished());
+    QCOMPARE(future.result(), QStringLiteral("42"));
+    QCOMPARE(loads.loadRelaxed(), 1);
+}
+
+void tst_QConcurrentCache::fetchSharesPendingLoads()
+{
+    QConcurrentCache<int, int> cache;
+    QSemaphore started;
+    QSemaphore release;
+    QAtomicInt loads;
+    const auto loader = [&](int key) {
+        loads.ref();
+        started.release();
+        release.acquire();
+        return key * 2;
+    };
+
+    QThreadPool pool;
+    QFuture<int> first = cache.fetch(1, loader, 1, &pool);
+    started.acquire();
+    QFuture<int> second = cache.fetch(1, loader, 1, &pool);
+    QVERIFY(!second.isFinished());
+    release.release();
+
+    QCOMPARE(first.result(), 2);
+    QCOMPARE(second.result(), 2);
+    QCOMPARE(loads.loadRelaxed(), 1);
+    QVERIFY(pool.waitForDone());
+}
+
+void tst_QConcurrentCache::fetchException()
+{
+#ifdef QT_NO_EXCEPTIONS
+    QSKIP("This test requires exception support");
+#else
+    QConcurrentCache<int, int> cache;
+    QThreadPool pool;
+    QFuture<int> future = cache.fetch(1, [](int) -> int { throw std::runtime_error("failed"); },
+                                      1, &pool);
+    QVERIFY_THROWS_EXCEPTION(std::runtime_error, future.waitForFinished());
+    QVERIFY(pool.waitForDone());
+    QVERIFY(!cache.contains(1));
+
+    // the failed load is not remembered
+    QCOMPARE(cache.fetch(1, [](int key) { return key; }, 1, &pool).result(), 1);
+#endif
+}
+
+void tst_QConcurrentCache::fetchKeepsNewerInsert()
+{
+    QConcurrentCache<int, int> cache;
+    QSemaphore started;
+    QSemaphore release;
+    const auto loader = [&](int key) {
+        started.release();
+        release.acquire();
+        return key;
+    };
+
+    QThreadPool pool;
+    QFuture<int> future = cache.fetch(1, loader, 1, &pool);
+    started.acquire();
+    QVERIFY(cache.insert(1, 100));
+    release.release();
+
+    // the caller of fetch() gets the loaded value, the cache keeps the newer one
+    QCOMPARE(future.result(), 1);
+    QVERIFY(pool.waitForDone());
+    QCOMPARE(cache.value(1), std::optional<int>(100));
+
+    // same for a key removed while loading
+    future = cache.fetch(2, loader, 1, &pool);
+    started.acquire();
+    QVERIFY(!cache.remove(2));
+    release.release();
+    QCOMPARE(future.result(), 2);
+    QVERIFY(pool.waitForDone());
+    QVERIFY(!cache.contains(2));
+
+    // without interference, the loaded value is stored
+    QCOMPARE(cache.fetch(3, [](int key) { return key; }, 1, &pool).result(), 3);
+    QVERIFY(pool.waitForDone());
+    QCOMPARE(cache.value(3), std::optional<int>(3));
+}
+
+void tst_QConcurrentCache::concurrentAccess()
+{
+    constexpr int ThreadCount = 8;
+    constexpr int KeyCount = 1000;
+    constexpr int Iterations = 20000;
+
+    QConcurrentCache<int, int> cache(KeyCount / 2, 4);
+    QAtomicInt wrongValues;
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back(QThread::create([&, t] {
+            for (int i = 0; i < Iterations; ++i) {
+                const int key = (i * 7919 + t * 31) % KeyCount;
+                // values are a function of the key, so any hit must match
+                if (auto value = cache.value(key)) {
+                    if (*value != key * 3)
+                        wrongValues.ref();
+                } else {
+                    cache.insert(key, key * 3);
+                }
+                if (i % 97 == 0)
+                    cache.remove(key);
+            }
+        }));
+    }
+    for (const auto &thread : threads)
+        thread->start();
+    for (const auto &thread : threads)
+        QVERIFY(thread->wait());
+
+    QCOMPARE(wrongValues.loadRelaxed(), 0);
+    QVERIFY(cache.totalCost() <= KeyCount / 2);
+    const QConcurrentCacheStatistics stats = cache.statistics();
+    QCOMPARE(stats.hits + stats.misses, qint64(ThreadCount) * Iterations);
+}
+
+QTEST_MAIN(tst_QConcurrentCache)
+#include "tst_qconcurrentcache.moc"
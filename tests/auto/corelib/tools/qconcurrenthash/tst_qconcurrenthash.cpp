@@ -0,0 +1,265 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QThread>
+
+#include <qconcurrenthash.h>
+
+#include <memory>
+#include <vector>
+
+class tst_QConcurrentHash : public QObject
+{
+    Q_OBJECT
+private slots:
+    void empty();
+    void shardCount_data();
+    void shardCount();
+    void insertAndLookup();
+    void tryInsert();
+    void update();
+    void removeAndTake();
+    void clear();
+    void forEachAndSnapshot();
+    void concurrentInserts();
+    void concurrentReadersAndWriters();
+};
+
+void tst_QConcurrentHash::empty()
+{
+    QConcurrentHash<int, QString> hash;
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.size(), 0);
+    QCOMPARE(hash.count(), 0);
+    QVERIFY(!hash.contains(1));
+    QCOMPARE(hash.value(1), QString());
+    QCOMPARE(hash.value(1, QStringLiteral("default")), QStringLiteral("default"));
+    QVERIFY(!hash.remove(1));
+    QCOMPARE(hash.take(1), QString());
+    QVERIFY(hash.snapshot().isEmpty());
+}
+
+void tst_QConcurrentHash::shardCount_data()
+{
+    QTest::addColumn<int>("requested");
+    QTest::addColumn<int>("expected");
+
+    QTest::newRow("1") << 1 << 1;
+    QTest::newRow("2") << 2 << 2;
+    QTest::newRow("3") << 3 << 4;
+    QTest::newRow("16") << 16 << 16;
+    QTest::newRow("17") << 17 << 32;
+}
+
+void tst_QConcurrentHash::shardCount()
+{
+    QFETCH(int, requested);
+    QFETCH(int, expected);
+
+    QConcurrentHash<int, int> hash(requested);
+    QCOMPARE(hash.shardCount(), expected);
+
+    for (int i = 0; i < 100; ++i)
+        hash.insert(i, i * 2);
+    QCOMPARE(hash.size(), 100);
+    for (int i = 0; i < 100; ++i)
+        QCOMPARE(hash.value(i, -1), i * 2);
+}
+
+void tst_QConcurrentHash::insertAndLookup()
+{
+    QConcurrentHash<QString, int> hash;
+    QCOMPARE(hash.shardCount(), 16);
+
+    hash.insert(QStringLiteral("one"), 1);
+    hash.insert(QStringLiteral("two"), 2);
+    QVERIFY(!hash.isEmpty());
+    QCOMPARE(hash.size(), 2);
+    QVERIFY(hash.contains(QStringLiteral("one")));
+    QVERIFY(!hash.contains(QStringLiteral("three")));
+    QCOMPARE(hash.value(QStringLiteral("two")), 2);
+
+    // insert() replaces
+    hash.insert(QStringLiteral("two"), 22);
+    QCOMPARE(hash.size(), 2);
+    QCOMPARE(hash.value(QStringLiteral("two")), 22);
+}
+
+void tst_QConcurrentHash::tryInsert()
+{
+    QConcurrentHash<int, int> hash;
+    QVERIFY(hash.tryInsert(1, 10));
+    QVERIFY(!hash.tryInsert(1, 20));
+    QCOMPARE(hash.value(1), 10);
+    QCOMPARE(hash.size(), 1);
+}
+
+void tst_QConcurrentHash::update()
+{
+    QConcurrentHash<int, QStringList> hash;
+    QVERIFY(!hash.update(1, [](QStringList &list) { list << "never"; }));
+    QVERIFY(!hash.contains(1));
+
+    hash.insert(1, {});
+    QVERIFY(hash.update(1, [](QStringList &list) { list << "a"; }));
+    QVERIFY(hash.update(1, [](QStringList &list) { list << "b"; }));
+    QCOMPARE(hash.value(1), QStringList({"a", "b"}));
+}
+
+void tst_QConcurrentHash::removeAndTake()
+{
+    QConcurrentHash<int, QString> hash;
+    hash.insert(1, QStringLiteral("one"));
+    hash.insert(2, QStringLiteral("two"));
+
+    QVERIFY(hash.remove(1));
+    QVERIFY(!hash.remove(1));
+    QVERIFY(!hash.contains(1));
+
+    QCOMPARE(hash.take(2), QStringLiteral("two"));
+    QCOMPARE(hash.take(2), QString());
+    QVERIFY(hash.isEmpty());
+}
+
+void tst_QConcurrentHash::clear()
+{
+    QConcurrentHash<int, int> hash(4);
+    for (int i = 0; i < 1000; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.size(), 1000);
+    hash.clear();
+    QVERIFY(hash.isEmpty());
+    QCOMPARE(hash.size(), 0);
+    hash.insert(1, 1);
+    QCOMPARE(hash.size(), 1);
+}
+
+void tst_QConcurrentHash::forEachAndSnapshot()
+{
+    QConcurrentHash<int, int> hash;
+    QHash<int, int> expected;
+    for (int i = 0; i < 500; ++i) {
+        hash.insert(i, i * i);
+        expected.insert(i, i * i);
+    }
+
+    QHash<int, int> seen;
+    hash.forEach([&](int key, int value) {
+        QVERIFY(!seen.contains(key));
+        seen.insert(key, value);
+    });
+    QCOMPARE(seen, expected);
+    QCOMPARE(hash.snapshot(), expected);
+
+    // the callback may modify the hash: it only sees the copy of each shard
+    hash.forEach([&](int key, int) { hash.remove(key); });
+    QVERIFY(hash.isEmpty());
+}
+
+void tst_QConcurrentHash::concurrentInserts()
+{
+    constexpr int ThreadCount = 8;
+    constexpr int KeysPerThread = 2000;
+
+    QConcurrentHash<int, int> hash;
+    QAtomicInt successfulTryInserts;
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back(QThread::create([&, t] {
+            for (int i = 0; i < KeysPerThread; ++i) {
+                hash.insert(t * KeysPerThread + i, t);
+                // all threads race for the same set of keys
+                if (hash.tryInsert(-1 - i, t))
+                    successfulTryInserts.ref();
+            }
+        }));
+    }
+    for (const auto &thread : threads)
+        thread->start();
+    for (const auto &thread : threads)
+        QVERIFY(thread->wait());
+
+    QCOMPARE(successfulTryInserts.loadRelaxed(), KeysPerThread);
+    QCOMPARE(hash.size(), ThreadCount * KeysPerThread + KeysPerThread);
+    for (int t = 0; t < ThreadCount; ++t) {
+        for (int i = 0; i < KeysPerThread; ++i)
+            QCOMPARE(hash.value(t * KeysPerThread + i, -1), t);
+    }
+}
+
+void tst_QConcurrentHash::concurrentReadersAndWriters()
+{
+    constexpr int ThreadCount = 8;
+    constexpr int KeyCount = 256;
+    constexpr int Iterations = 5000;
+
+    QConcurrentHash<int, int> hash(4);
+    for (int i = 0; i < KeyCount; ++i)
+        hash.insert(i, 0);
+
+    QAtomicInt inconsistencies;
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back(QThread::create([&, t] {
+            for (int i = 0; i < Iterations; ++i) {
+                const int key = (i * 7 + t) % KeyCount;
+                if (t % 2) {
+                    hash.update(key, [](int &value) { ++value; });
+                } else {
+                    // values only ever grow
+                    const int before = hash.value(key, -1);
+                    if (before < 0 || hash.value(key, -1) < before)
+                        inconsistencies.ref();
+                    if (i % 100 == 0)
+                        hash.forEach([&](int, int value) {
+                            if (value < 0)
+                                inconsistencies.ref();
+                        });
+                }
+            }
+        }));
+    }
+    for (const auto &thread : threads)
+        thread->start();
+    for (const auto &thread : threads)
+        QVERIFY(thread->wait());
+
+    QCOMPARE(inconsistencies.loadRelaxed(), 0);
+    QCOMPARE(hash.size(), KeyCount);
+
+    // no increments were lost
+    int total = 0;
+    hash.forEach([&](int, int value) { total += value; });
+    QCOMPARE(total, (ThreadCount / 2) * Iterations);
+}
+
+QTEST_MAIN(tst_QConcurrentHash)
+#include "tst_qconcurrenthash.moc"
@@ -30,6 +30,7 @@
 #include <QtCore/QCoreApplication>
 #include <QTest>
 #include <QScopeGuard>
+#include <QTemporaryFile>
 #include <QCryptographicHash>
 #include <QtCore/QMetaEnum>
 
@@ -56,6 +57,14 @@ private slots:
     void files();
     void hashLength_data();
     void hashLength();
+    void blockBoundaries_data();
+    void blockBoundaries();
+    void hashMany_data();
+    void hashMany();
+    void blake2bTree_data();
+    void blake2bTree();
+    void mappedFile_data();
+    void mappedFile();
     // keep last
     void moreThan4GiBOfData_data();
     void moreThan4GiBOfData();
@@ -366,6 +375,19 @@ void tst_QCryptographicHash::blake2_data()
         "The quick brown fox jumps over the lazy dog.",
         "95bca6e1b761dca1323505cc629949a0e03edf11633cc7935bd8b56f393afcf2");
 
+    // BLAKE2b tree mode
+    ROW("blake2btree_512_empty",
+        QCryptographicHash::Blake2bTree_512,
+        "",
+        "dd8a2639c90f07d7fbf7726dae6317a3279029329be4224329af27a92b8b4014"
+        "efacb93f2891206f9e0601bc7adde163e9aa70f32d33473111f3d66396931919");
+
+    ROW("blake2btree_512_pangram",
+        QCryptographicHash::Blake2bTree_512,
+        "The quick brown fox jumps over the lazy dog",
+        "47677954ec8631502c4469bc5f299b1336d1cc83220bc71f3ab1dd61a6cbe027"
+        "7459ac36ba1ba9cab190c1abd90ad1f4ce10c0596248bfb155c5ee46a0dc76ac");
+
 #undef ROW
 }
 
@@ -426,6 +448,156 @@ void tst_QCryptographicHash::hashLength()
     QCOMPARE(QCryptographicHash::hashLength(algorithm), output.length());
 }
 
+void tst_QCryptographicHash::blockBoundaries_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::addColumn<QByteArray>("expectedResult");
+
+    QTest::newRow("sha1") << QCryptographicHash::Sha1
+                          << QByteArray("557878b8118e7a9bdc75bcfc419f9b082ce073e6");
+    QTest::newRow("sha224") << QCryptographicHash::Sha224
+                            << QByteArray("3fec9f781e81240b2156818fbc9025726ea056576253c641506dd55e");
+    QTest::newRow("sha256") << QCryptographicHash::Sha256
+                            << QByteArray("55af394c980c7a7fb68aa904c4afdd93d76e5f826487105fc06f92a25bab8cbe");
+    QTest::newRow("blake2b_256") << QCryptographicHash::Blake2b_256
+                                 << QByteArray("c78a250eae2dcf122d0452fe67cd4851a975146239a4fbd425869f4773a7916b");
+    QTest::newRow("blake2b_512") << QCryptographicHash::Blake2b_512
+                                 << QByteArray("057b0c61eefff4defa42c7b40ba080e3cde2ec51748fe92abe5e78000bebba0d"
+                                               "8bd016e33aece09d8827794d4bd1bc1f9b66e6045ae8a4176c21b95d80b86614");
+}
+
+// Feeds the same data in chunks of different sizes, so that both complete
+// blocks and partially filled buffers reach the hash functions.
+void tst_QCryptographicHash::blockBoundaries()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+    QFETCH(const QByteArray, expectedResult);
+
+    QByteArray data(100000, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i * 7 + (i >> 8));
+
+    QCOMPARE(QCryptographicHash::hash(data, algorithm).toHex(), expectedResult);
+
+    for (qsizetype chunkSize : {1, 55, 63, 64, 65, 127, 128, 129, 1000, 4099}) {
+        QCryptographicHash hash(algorithm);
+        for (qsizetype i = 0; i < data.size(); i += chunkSize)
+            hash.addData(QByteArrayView(data).sliced(i, qMin(chunkSize, data.size() - i)));
+        QVERIFY2(hash.result().toHex() == expectedResult, QByteArray::number(chunkSize));
+    }
+}
+
+void tst_QCryptographicHash::hashMany_data()
+{
+    hashLength_data();
+}
+
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+
+    QCOMPARE(QCryptographicHash::hashMany({}, algorithm), QList<QByteArray>());
+
+    // lengths around the padding boundaries, in no particular order
+    QByteArray data(5000, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i * 13 + 5);
+    QList<QByteArrayView> buffers;
+    for (qsizetype length = 0; length <= 300; ++length)
+        buffers.append(QByteArrayView(data).first(length));
+    for (qsizetype length : {5000, 1000, 4096, 0, 1023})
+        buffers.append(QByteArrayView(data).last(length));
+
+    const QList<QByteArray> results = QCryptographicHash::hashMany(buffers, algorithm);
+    QCOMPARE(results.size(), buffers.size());
+    for (qsizetype i = 0; i < buffers.size(); ++i)
+        QCOMPARE(results.at(i), QCryptographicHash::hash(buffers.at(i), algorithm));
+
+    const QList<QByteArray> single = QCryptographicHash::hashMany({ buffers.at(100) }, algorithm);
+    QCOMPARE(single, QList<QByteArray>{ results.at(100) });
+}
+
+static QByteArray patternData(qsizetype size)
+{
+    QByteArray data(size, Qt::Uninitialized);
+    for (qsizetype i = 0; i < size; ++i)
+        data[i] = char(i * 7 + (i >> 8));
+    return data;
+}
+
+void tst_QCryptographicHash::blake2bTree_data()
+{
+    QTest::addColumn<qsizetype>("size");
+    QTest::addColumn<QByteArray>("expectedResult");
+
+    constexpr qsizetype MiB = 1024 * 1024;
+    QTest::newRow("one-leaf") << MiB
+        << QByteArray("39492b74f7a7439c89261cd96dcf5ef3756233f5128f438d1cfd11985bd65774"
+                      "aca584570cf5ce6b55a6fa19531b41bf96a6fdc55fba3a3639d1d8a39d3ec033");
+    QTest::newRow("one-leaf-and-a-byte") << MiB + 1
+        << QByteArray("2cbfaac9f2320aa579dbfaaa378d7c338d7dd47fe52761595c3e7fb95e16f437"
+                      "42a006cc536d3f910017c2797311ff1a070d0abda9f5b442a19daa56c0094d68");
+    QTest::newRow("four-leaves") << 3 * MiB + 12345
+        << QByteArray("e7897ba2c44063aabe0bf2637aa01252cd0a0dbc2c94537c44ac8ed7ff46c041"
+                      "c4ebd46d77dad26ea841bd0d42c6450b758cb7eb6ebea0ca7dd9cb076174302d");
+    QTest::newRow("67-leaves") << 66 * MiB + 5
+        << QByteArray("602fbfbc748302b388c742e20fa4b331023dd4bf85bdb1160fe1e0172f76daad"
+                      "42cdf67985a703224c0666164baadea7fd2af9ff6c470b672611dbd5ce4e5ef8");
+}
+
+void tst_QCryptographicHash::blake2bTree()
+{
+    QFETCH(const qsizetype, size);
+    QFETCH(const QByteArray, expectedResult);
+
+    const QByteArray data = patternData(size);
+    QCOMPARE(QCryptographicHash::hash(data, QCryptographicHash::Blake2bTree_512).toHex(),
+             expectedResult);
+
+    // chunks that do and do not line up with the leaves
+    for (qsizetype chunkSize : {4099, 1024 * 1024, 3 * 1024 * 1024 + 1}) {
+        QCryptographicHash hash(QCryptographicHash::Blake2bTree_512);
+        for (qsizetype i = 0; i < data.size(); i += chunkSize)
+            hash.addData(QByteArrayView(data).sliced(i, qMin(chunkSize, data.size() - i)));
+        QVERIFY2(hash.result().toHex() == expectedResult, QByteArray::number(chunkSize));
+    }
+}
+
+void tst_QCryptographicHash::mappedFile_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+
+    QTest::newRow("sha256") << QCryptographicHash::Sha256;
+    QTest::newRow("blake2btree_512") << QCryptographicHash::Blake2bTree_512;
+}
+
+void tst_QCryptographicHash::mappedFile()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+
+    const QByteArray data = patternData(5 * 1024 * 1024 + 17);
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(data), data.size());
+
+    // reading starts at the current position, and ends at the end
+    for (qint64 offset : {0, 1, 4096, 1024 * 1024 + 3, 5 * 1024 * 1024 + 17}) {
+        QVERIFY(file.seek(offset));
+        QCryptographicHash hash(algorithm);
+        QVERIFY(hash.addData(&file));
+        QVERIFY(file.atEnd());
+        QCOMPARE(hash.result(), QCryptographicHash::hash(QByteArrayView(data).sliced(offset),
+                                                         algorithm));
+    }
+
+    // buffered data must not be lost
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.read(10), data.first(10));
+    QCryptographicHash hash(algorithm);
+    QVERIFY(hash.addData(&file));
+    QCOMPARE(hash.result(), QCryptographicHash::hash(QByteArrayView(data).sliced(10), algorithm));
+}
+
 void tst_QCryptographicHash::moreThan4GiBOfData_data()
 {
 #if QT_POINTER_SIZE > 4
@@ -30,15 +30,17 @@
 
 #include <QTest>
 
-#include <private/qflatmap_p.h>
 #include <qbytearray.h>
+#include <qflatmap.h>
 #include <qstring.h>
 #include <qstringview.h>
 #include <qvarlengtharray.h>
 
 #include <algorithm>
 #include <list>
+#include <map>
 #include <tuple>
+#include <vector>
 
 class tst_QFlatMap : public QObject
 {
@@ -47,6 +49,7 @@ private slots:
     void constructing();
     void constAccess();
     void insertion();
+    void bulkInsertion();
     void insertRValuesAndLValues();
     void removal();
     void extraction();
@@ -160,6 +163,50 @@ void tst_QFlatMap::insertion()
     QCOMPARE(m.value("gnampf").data(), "GNAMPF");
 }
 
+void tst_QFlatMap::bulkInsertion()
+{
+    using Map = QFlatMap<int, QByteArray>;
+    Map m{ { 5, "five" }, { 1, "one" }, { 3, "three" } };
+
+    // unsorted, with duplicates among themselves and with the map;
+    // the last of equivalent elements wins
+    const Map::key_container_type keys = { 4, 2, 3, 9, 2, 0 };
+    const Map::mapped_container_type values = { "four", "two", "THREE", "nine", "TWO", "zero" };
+    m.insert(keys, values);
+    QCOMPARE(m.keys(), Map::key_container_type({ 0, 1, 2, 3, 4, 5, 9 }));
+    QCOMPARE(m.values(), Map::mapped_container_type({ "zero", "one", "TWO", "THREE", "four",
+                                                      "five", "nine" }));
+
+    // appending in order doesn't need any sorting
+    m.insert(Map::key_container_type{ 10, 11 }, Map::mapped_container_type{ "ten", "eleven" });
+    QCOMPARE(m.size(), 9);
+    QCOMPARE(m.keys().last(), 11);
+
+    m.insert(Map::key_container_type(), Map::mapped_container_type());
+    QCOMPARE(m.size(), 9);
+
+    // compare against std::map with lots of duplicates
+    std::map<int, int> reference;
+    QFlatMap<int, int> big;
+    std::vector<std::pair<const int, int>> batch;
+    uint seed = 1;
+    for (int round = 0; round < 10; ++round) {
+        batch.clear();
+        for (int i = 0; i < 1000; ++i) {
+            seed = seed * 1103515245 + 12345;
+            const int key = int((seed >> 8) % 3000);
+            batch.emplace_back(key, round * 1000 + i);
+            reference[key] = round * 1000 + i;
+        }
+        big.insert(batch.data(), batch.data() + batch.size());
+        QCOMPARE(big.size(), qsizetype(reference.size()));
+        QVERIFY(std::equal(reference.begin(), reference.end(), big.begin(),
+                           [](const auto &lhs, const auto &rhs) {
+                               return lhs.first == rhs.first && lhs.second == rhs.second;
+                           }));
+    }
+}
+
 void tst_QFlatMap::insertRValuesAndLValues()
 {
     using Map = QFlatMap<QByteArray, QByteArray>;
@@ -426,6 +473,22 @@ void tst_QFlatMap::transparency()
     QCOMPARE(m.lower_bound(sv1).value(), "een");
     QCOMPARE(m.lower_bound(sv2).value(), "twee");
     QCOMPARE(m.lower_bound(sv3).value(), "dree");
+    QCOMPARE(m.find(sv2).value(), "twee");
+    QVERIFY(m.find(QStringView(u"four")) == m.end());
+    QVERIFY(m.contains(sv3));
+    QVERIFY(!m.contains(QStringView(u"on")));
+    QCOMPARE(m.value(sv1), "een");
+    QCOMPARE(m.value(QStringView(u"four")), QString());
+    QCOMPARE(m.value(QStringView(u"four"), QStringLiteral("vier")), "vier");
+
+    // std::less<> compares byte arrays and views directly
+    using ByteArrayMap = QFlatMap<QByteArray, int, std::less<>>;
+    const ByteArrayMap bm{ { "alpha", 1 }, { "beta", 2 }, { "gamma", 3 } };
+    const QByteArray names = "alphabetagamma";
+    QCOMPARE(bm.value(QByteArrayView(names).sliced(5, 4)), 2);
+    QVERIFY(bm.contains(QByteArrayView(names).first(5)));
+    QVERIFY(!bm.contains(QByteArrayView(names).first(4)));
+    QVERIFY(bm.find(QByteArrayView(names).last(5)) != bm.end());
 }
 
 void tst_QFlatMap::try_emplace_and_insert_or_assign()
@@ -32,6 +32,7 @@
 #include <qmap.h>
 
 #include <algorithm>
+#include <limits>
 #include <vector>
 #include <unordered_set>
 #include <string>
@@ -87,6 +88,8 @@ private slots:
     void emplace();
 
     void badHashFunction();
+    void clusteredHashes_data();
+    void clusteredHashes();
     void hashOfHash();
 
     void stdHash();
@@ -2484,6 +2487,83 @@ void tst_QHash::badHashFunction()
 
 }
 
+// Hashes that only differ in their high bits all land in the first few
+// buckets, creating long probe sequences spanning several groups of buckets,
+// while the tags stored for them still differ.
+template <bool Tagged>
+struct ClusteredKey {
+    int k;
+    ClusteredKey(int i) : k(i) {}
+    bool operator==(const ClusteredKey &other) const
+    {
+        return k == other.k;
+    }
+};
+
+template <bool Tagged>
+size_t qHash(ClusteredKey<Tagged> key, size_t)
+{
+    constexpr int HighBits = std::numeric_limits<size_t>::digits - 11;
+    return size_t(key.k % 37) | (size_t(key.k) << HighBits);
+}
+
+Q_DECLARE_HASH_TAG_PROBING(ClusteredKey<true>)
+
+// tag probing is opt-in, and leaves the layout of other hashes alone
+static_assert(sizeof(QHashPrivate::Span<QHashPrivate::Node<ClusteredKey<true>, int>>)
+              == sizeof(QHashPrivate::Span<QHashPrivate::Node<ClusteredKey<false>, int>>)
+                 + QHashPrivate::SpanConstants::NEntries);
+static_assert(sizeof(QHashPrivate::Span<QHashPrivate::Node<QString, int>>)
+              == sizeof(QHashPrivate::Span<QHashPrivate::Node<int, int>>));
+
+void tst_QHash::clusteredHashes_data()
+{
+    QTest::addColumn<bool>("tagged");
+
+    QTest::newRow("plain") << false;
+    QTest::newRow("tagged") << true;
+}
+
+template <typename Key>
+static void testClusteredHashes()
+{
+    QHash<Key, int> hash;
+    for (int i = 0; i < 2000; ++i)
+        hash.insert(i, i);
+    QCOMPARE(hash.size(), 2000);
+
+    for (int i = 0; i < 2000; ++i)
+        QCOMPARE(hash.value(i, -1), i);
+    for (int i = 2000; i < 4000; ++i)
+        QVERIFY(!hash.contains(i));
+
+    // erasing moves entries back across group and span boundaries
+    for (int i = 0; i < 2000; i += 3)
+        QVERIFY(hash.remove(i));
+    for (int i = 0; i < 2000; ++i)
+        QCOMPARE(hash.value(i, -1), i % 3 ? i : -1);
+
+    // copying a hash preserves the tags of the entries
+    QHash<Key, int> copy = hash;
+    copy.insert(1, -1);
+    for (int i = 0; i < 2000; ++i)
+        QCOMPARE(copy.value(i, -1), i % 3 && i != 1 ? i : -1);
+
+    hash.reserve(10000);
+    for (int i = 0; i < 2000; ++i)
+        QCOMPARE(hash.value(i, -1), i % 3 ? i : -1);
+}
+
+void tst_QHash::clusteredHashes()
+{
+    QFETCH(bool, tagged);
+
+    if (tagged)
+        testClusteredHashes<ClusteredKey<true>>();
+    else
+        testClusteredHashes<ClusteredKey<false>>();
+}
+
 void tst_QHash::hashOfHash()
 {
     QHash<int, int> hash;
@@ -0,0 +1,285 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QSignalSpy>
+#include <QSpscRingBuffer>
+#include <QSpscRingBufferDevice>
+#include <QThread>
+
+class tst_QSpscRingBuffer : public QObject
+{
+    Q_OBJECT
+private slots:
+    void capacity();
+    void readWrite_data();
+    void readWrite();
+    void pointers_data();
+    void pointers();
+    void threaded_data();
+    void threaded();
+    void device_data();
+    void device();
+    void deviceOpenMode();
+};
+
+static char patternByte(qint64 i)
+{
+    return char(i * 31 + (i >> 10));
+}
+
+void tst_QSpscRingBuffer::capacity()
+{
+    QSpscRingBuffer heap(1000, QSpscRingBuffer::HeapAllocated);
+    QCOMPARE(heap.capacity(), 1024);
+    QVERIFY(!heap.isDoubleMapped());
+    QCOMPARE(heap.freeSpace(), 1024);
+    QVERIFY(heap.isEmpty());
+
+    QSpscRingBuffer mapped(1000);
+#ifdef Q_OS_LINUX
+    QVERIFY(mapped.isDoubleMapped());
+#endif
+    QVERIFY(mapped.capacity() >= 1024);
+    QCOMPARE(mapped.capacity() & (mapped.capacity() - 1), 0);
+}
+
+void tst_QSpscRingBuffer::readWrite_data()
+{
+    QTest::addColumn<QSpscRingBuffer::MappingMode>("mode");
+    QTest::newRow("heap") << QSpscRingBuffer::HeapAllocated;
+    QTest::newRow("mapped") << QSpscRingBuffer::DoubleMapped;
+}
+
+// Writes and reads chunks of varying sizes, wrapping around many times.
+void tst_QSpscRingBuffer::readWrite()
+{
+    QFETCH(const QSpscRingBuffer::MappingMode, mode);
+    QSpscRingBuffer buffer(4096, mode);
+    const qint64 capacity = buffer.capacity();
+
+    QByteArray chunk(capacity + 10, Qt::Uninitialized);
+    qint64 written = 0;
+    qint64 read = 0;
+    for (int round = 0; round < 200; ++round) {
+        const qint64 toWrite = (round * 577) % (capacity + 10);
+        for (qint64 i = 0; i < toWrite; ++i)
+            chunk[i] = patternByte(written + i);
+        const qint64 expectedWrite = qMin(toWrite, buffer.freeSpace());
+        QCOMPARE(buffer.write(chunk.constData(), toWrite), expectedWrite);
+        written += expectedWrite;
+        QCOMPARE(buffer.size(), written - read);
+        QCOMPARE(buffer.totalWritten(), written);
+
+        const qint64 toRead = (round * 389) % (capacity + 10);
+        const qint64 expectedRead = qMin(toRead, buffer.size());
+        QCOMPARE(buffer.read(chunk.data(), toRead), expectedRead);
+        for (qint64 i = 0; i < expectedRead; ++i)
+            QCOMPARE(chunk.at(i), patternByte(read + i));
+        read += expectedRead;
+    }
+    QVERIFY(!buffer.atEnd());
+    buffer.closeWrite();
+    QCOMPARE(buffer.atEnd(), buffer.isEmpty());
+    buffer.read(chunk.data(), buffer.size());
+    QVERIFY(buffer.atEnd());
+}
+
+void tst_QSpscRingBuffer::pointers_data()
+{
+    readWrite_data();
+}
+
+void tst_QSpscRingBuffer::pointers()
+{
+    QFETCH(const QSpscRingBuffer::MappingMode, mode);
+    QSpscRingBuffer buffer(4096, mode);
+    const qint64 capacity = buffer.capacity();
+
+    // move the positions to three quarters of the buffer
+    qint64 length;
+    char *out = buffer.writePointer(length);
+    QCOMPARE(length, capacity);
+    memset(out, 0, 3 * capacity / 4);
+    buffer.commit(3 * capacity / 4);
+    buffer.free(3 * capacity / 4);
+
+    // the free space now wraps around
+    out = buffer.writePointer(length);
+    QCOMPARE(length, buffer.isDoubleMapped() ? capacity : capacity / 4);
+    for (qint64 i = 0; i < length; ++i)
+        out[i] = patternByte(i);
+    buffer.commit(length);
+    if (!buffer.isDoubleMapped()) {
+        out = buffer.writePointer(length);
+        QCOMPARE(length, 3 * capacity / 4);
+        for (qint64 i = 0; i < length; ++i)
+            out[i] = patternByte(capacity / 4 + i);
+        buffer.commit(length);
+    }
+    QCOMPARE(buffer.size(), capacity);
+    QCOMPARE(buffer.freeSpace(), 0);
+
+    const char *in = buffer.readPointer(length);
+    QCOMPARE(length, buffer.isDoubleMapped() ? capacity : capacity / 4);
+    for (qint64 i = 0; i < length; ++i)
+        QCOMPARE(in[i], patternByte(i));
+    buffer.free(length);
+    if (!buffer.isDoubleMapped()) {
+        in = buffer.readPointer(length);
+        QCOMPARE(length, 3 * capacity / 4);
+        for (qint64 i = 0; i < length; ++i)
+            QCOMPARE(in[i], patternByte(capacity / 4 + i));
+        buffer.free(length);
+    }
+    QVERIFY(buffer.isEmpty());
+}
+
+void tst_QSpscRingBuffer::threaded_data()
+{
+    readWrite_data();
+}
+
+// Streams data through a small buffer, so that both sides have to wait.
+void tst_QSpscRingBuffer::threaded()
+{
+    QFETCH(const QSpscRingBuffer::MappingMode, mode);
+    QSpscRingBuffer buffer(4096, mode);
+    constexpr qint64 Total = 8 * 1024 * 1024;
+
+    QScopedPointer<QThread> producer(QThread::create([&buffer]() {
+        QByteArray chunk(3000, Qt::Uninitialized);
+        qint64 written = 0;
+        for (int round = 0; written < Total; ++round) {
+            const qint64 length = qMin(qint64(1 + (round * 7919) % chunk.size()), Total - written);
+            for (qint64 i = 0; i < length; ++i)
+                chunk[i] = patternByte(written + i);
+            qint64 done = 0;
+            while (done < length) {
+                done += buffer.write(chunk.constData() + done, length - done);
+                if (done < length)
+                    buffer.waitForSpace();
+            }
+            written += length;
+        }
+        buffer.closeWrite();
+    }));
+    producer->start();
+
+    QByteArray chunk(5000, Qt::Uninitialized);
+    qint64 read = 0;
+    bool mismatch = false;
+    while (buffer.waitForData() && !buffer.atEnd()) {
+        const qint64 length = buffer.read(chunk.data(), chunk.size());
+        for (qint64 i = 0; i < length; ++i)
+            mismatch |= chunk.at(i) != patternByte(read + i);
+        read += length;
+    }
+    QVERIFY(producer->wait());
+    QVERIFY(!mismatch);
+    QCOMPARE(read, Total);
+}
+
+void tst_QSpscRingBuffer::device_data()
+{
+    QTest::addColumn<bool>("blocking");
+    QTest::newRow("readyRead") << false;
+    QTest::newRow("waitForReadyRead") << true;
+}
+
+void tst_QSpscRingBuffer::device()
+{
+    QFETCH(const bool, blocking);
+    QSpscRingBuffer buffer(4096);
+    constexpr qint64 Total = 1024 * 1024;
+
+    QScopedPointer<QThread> producer(QThread::create([&buffer]() {
+        QSpscRingBufferDevice writer(&buffer);
+        if (!writer.open(QIODevice::WriteOnly))
+            return;
+        QByteArray chunk(1000, Qt::Uninitialized);
+        for (qint64 written = 0; written < Total; written += chunk.size()) {
+            const qint64 length = qMin(qint64(chunk.size()), Total - written);
+            chunk.resize(length);
+            for (qint64 i = 0; i < length; ++i)
+                chunk[i] = patternByte(written + i);
+            if (writer.write(chunk) != length)
+                return;
+        }
+        // the destructor closes the producer end
+    }));
+
+    QSpscRingBufferDevice reader(&buffer);
+    QVERIFY(reader.open(QIODevice::ReadOnly));
+    QVERIFY(reader.isSequential());
+    QSignalSpy finishedSpy(&reader, &QIODevice::readChannelFinished);
+    QByteArray received;
+    connect(&reader, &QIODevice::readyRead, this, [&]() { received += reader.readAll(); });
+
+    producer->start();
+    if (blocking) {
+        while (!reader.atEnd()) {
+            if (!reader.waitForReadyRead(10000))
+                QVERIFY(reader.atEnd() || !reader.bytesAvailable());
+        }
+        received += reader.readAll();
+    } else {
+        QTRY_COMPARE_WITH_TIMEOUT(finishedSpy.count(), 1, 20000);
+    }
+    QVERIFY(producer->wait());
+    QVERIFY(reader.atEnd());
+    QCOMPARE(received.size(), Total);
+    for (qint64 i = 0; i < Total; ++i) {
+        if (received.at(i) != patternByte(i))
+            QFAIL(qPrintable(QString::number(i)));
+    }
+    QCOMPARE(reader.read(1), QByteArray());
+}
+
+void tst_QSpscRingBuffer::deviceOpenMode()
+{
+    QSpscRingBuffer buffer(4096);
+    QSpscRingBufferDevice device(&buffer);
+    QTest::ignoreMessage(QtWarningMsg, "QSpscRingBufferDevice::open: The device must be opened either ReadOnly or WriteOnly");
+    QVERIFY(!device.open(QIODevice::ReadWrite));
+    QVERIFY(device.open(QIODevice::WriteOnly));
+    QVERIFY(device.openMode() & QIODevice::Unbuffered);
+    QCOMPARE(device.write("abc"), 3);
+    QCOMPARE(device.bytesAvailable(), 0);
+    device.close();
+    QVERIFY(buffer.isWriteClosed());
+
+    QVERIFY(device.open(QIODevice::ReadOnly));
+    QCOMPARE(device.bytesAvailable(), 3);
+    QCOMPARE(device.readAll(), QByteArray("abc"));
+    QVERIFY(device.atEnd());
+}
+
+QTEST_MAIN(tst_QSpscRingBuffer)
+
+#include "tst_qspscringbuffer.moc"
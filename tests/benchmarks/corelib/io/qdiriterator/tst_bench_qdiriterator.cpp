@@ -44,6 +44,10 @@
 
 #include "qfilesystemiterator.h"
 
+#include <qdirwalker.h>
+
+#include <atomic>
+
 #if QT_CONFIG(cxx17_filesystem)
 #include <filesystem>
 #endif
@@ -60,6 +64,10 @@ private slots:
     void diriterator_data() { data(); }
     void fsiterator();
     void fsiterator_data() { data(); }
+    void dirwalker();
+    void dirwalker_data() { data(); }
+    void dirwalkerParallel();
+    void dirwalkerParallel_data() { data(); }
     void stdRecursiveDirectoryIterator();
     void stdRecursiveDirectoryIterator_data() { data(); }
 };
@@ -235,6 +243,39 @@ void tst_QDirIterator::fsiterator()
     qDebug() << count;
 }
 
+static int walkFiles(const QByteArray &dirpath, int threads)
+{
+    std::atomic<int> c = 0;
+    QDirWalker walker(QString::fromLocal8Bit(dirpath), QDir::Files);
+    walker.setMaxThreadCount(threads);
+    walker.walk([&](const QDirWalker::Entry &) { ++c; });
+    return c;
+}
+
+void tst_QDirIterator::dirwalker()
+{
+    QFETCH(QByteArray, dirpath);
+
+    int count = 0;
+
+    QBENCHMARK {
+        count = walkFiles(dirpath, 1);
+    }
+    qDebug() << count;
+}
+
+void tst_QDirIterator::dirwalkerParallel()
+{
+    QFETCH(QByteArray, dirpath);
+
+    int count = 0;
+
+    QBENCHMARK {
+        count = walkFiles(dirpath, 4);
+    }
+    qDebug() << count;
+}
+
 void tst_QDirIterator::stdRecursiveDirectoryIterator()
 {
 #if QT_CONFIG(cxx17_filesystem)
@@ -36,10 +36,24 @@ class tst_QTextStream : public QObject
 {
     Q_OBJECT
 private slots:
+    void initTestCase();
+
     void writeSingleChar_data();
     void writeSingleChar();
 
+    void readLine_data();
+    void readLine();
+    void readLineInto_data() { readLine_data(); }
+    void readLineInto();
+    void readIntegers_data() { readLine_data(); }
+    void readIntegers();
+    void readDoubles_data() { readLine_data(); }
+    void readDoubles();
+
 private:
+    QByteArray lines;
+    QByteArray integers;
+    QByteArray doubles;
 };
 
 enum Output { StringOutput, DeviceOutput };
@@ -48,6 +62,24 @@ Q_DECLARE_METATYPE(Output);
 enum Input { CharStarInput, QStringInput, CharInput, QCharInput };
 Q_DECLARE_METATYPE(Input);
 
+enum Source { DeviceSource, StringSource };
+Q_DECLARE_METATYPE(Source);
+
+// A log file and columns of numbers, each a few MB, as read by tools that
+// process text files line by line or number by number.
+void tst_QTextStream::initTestCase()
+{
+    for (int i = 0; i < 100000; ++i) {
+        lines += "2021-11-03 12:34:56.789 [worker-" + QByteArray::number(i % 16)
+                + "] request " + QByteArray::number(i) + " handled in "
+                + QByteArray::number(i % 1000) + " ms\n";
+    }
+    for (int i = 0; i < 500000; ++i)
+        integers += QByteArray::number(i * 3 - 1000000) + (i % 10 == 9 ? "\n" : " ");
+    for (int i = 0; i < 300000; ++i)
+        doubles += QByteArray::number(i * 0.125 - 1000, 'g', 10) + (i % 4 == 3 ? "\n" : "\t");
+}
+
 void tst_QTextStream::writeSingleChar_data()
 {
     QTest::addColumn<Output>("output");
@@ -115,6 +147,85 @@ void tst_QTextStream::writeSingleChar()
     QCOMPARE(result.left(10), QString("hhhhhhhhhh"));
 }
 
+void tst_QTextStream::readLine_data()
+{
+    QTest::addColumn<Source>("source");
+
+    QTest::newRow("device") << DeviceSource;
+    QTest::newRow("string") << StringSource;
+}
+
+template <typename Function>
+static void benchRead(const QByteArray &data, Source source, Function function)
+{
+    const QString string = QString::fromUtf8(data);
+    QBENCHMARK {
+        QBuffer buffer;
+        QTextStream stream;
+        if (source == DeviceSource) {
+            buffer.setData(data);
+            buffer.open(QIODevice::ReadOnly);
+            stream.setDevice(&buffer);
+        } else {
+            stream.setString(const_cast<QString *>(&string), QIODevice::ReadOnly);
+        }
+        function(stream);
+    }
+}
+
+void tst_QTextStream::readLine()
+{
+    QFETCH(Source, source);
+    qsizetype count = 0;
+    benchRead(lines, source, [&](QTextStream &stream) {
+        count = 0;
+        while (!stream.readLine().isNull())
+            ++count;
+    });
+    QCOMPARE(count, 100000);
+}
+
+void tst_QTextStream::readLineInto()
+{
+    QFETCH(Source, source);
+    qsizetype count = 0;
+    benchRead(lines, source, [&](QTextStream &stream) {
+        count = 0;
+        QString line;
+        while (stream.readLineInto(&line))
+            ++count;
+    });
+    QCOMPARE(count, 100000);
+}
+
+void tst_QTextStream::readIntegers()
+{
+    QFETCH(Source, source);
+    qlonglong sum = 0;
+    benchRead(integers, source, [&](QTextStream &stream) {
+        sum = 0;
+        int i;
+        while (!(stream >> i).atEnd())
+            sum += i;
+        sum += i;
+    });
+    QCOMPARE(sum, -125000750000LL);
+}
+
+void tst_QTextStream::readDoubles()
+{
+    QFETCH(Source, source);
+    double sum = 0;
+    benchRead(doubles, source, [&](QTextStream &stream) {
+        sum = 0;
+        double d;
+        while (!(stream >> d).atEnd())
+            sum += d;
+        sum += d;
+    });
+    QCOMPARE(sum, 5324981250.0);
+}
+
 QTEST_MAIN(tst_QTextStream)
 
 #include "tst_bench_qtextstream.moc"
@@ -28,7 +28,9 @@
 
 #include <QTest>
 #include <qjsondocument.h>
+#include <qjsonarray.h>
 #include <qjsonobject.h>
+#include <qjsonstreamreader.h>
 
 class BenchmarkQtJson: public QObject
 {
@@ -45,6 +47,16 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseLargeDocument_data();
+    void parseLargeDocument();
+    void parseLargeDocumentLazy_data() { parseLargeDocument_data(); }
+    void parseLargeDocumentLazy();
+    void streamLargeDocument_data() { parseLargeDocument_data(); }
+    void streamLargeDocument();
+    void toJsonLargeDocument_data();
+    void toJsonLargeDocument();
+    void toJsonDevice_data() { toJsonLargeDocument_data(); }
+    void toJsonDevice();
 
     void jsonObjectInsert();
     void variantMapInsert();
@@ -117,6 +129,122 @@ void BenchmarkQtJson::parseJsonToVariant()
     }
 }
 
+// Builds a telemetry-like array of records, about 1 KiB each, roughly
+// \a size bytes in total.
+static QByteArray makeLargeDocument(qsizetype size, bool indented, bool escapes)
+{
+    QJsonArray records;
+    const QString message = escapes
+            ? QStringLiteral("line one\n\tline \"two\" with a \\ backslash and caf\u00e9 ")
+            : QStringLiteral("sensor reading within the configured operating range, no action needed ");
+    qsizetype bytes = 0;
+    for (int i = 0; bytes < size; ++i) {
+        QJsonObject record;
+        record.insert(QLatin1String("timestamp"), 1634000000000LL + i * 250);
+        record.insert(QLatin1String("sensor"), QStringLiteral("temperature-sensor-%1").arg(i % 97));
+        record.insert(QLatin1String("value"), 20.0 + (i % 1000) / 64.0);
+        record.insert(QLatin1String("count"), i);
+        record.insert(QLatin1String("ok"), i % 13 != 0);
+        record.insert(QLatin1String("unit"), QLatin1String("celsius"));
+        record.insert(QLatin1String("tags"), QJsonArray{ QLatin1String("building-7"),
+                                                         QLatin1String("floor-3"),
+                                                         QLatin1String("hvac") });
+        record.insert(QLatin1String("message"), message.repeated(8));
+        records.append(record);
+        bytes += 1024;
+    }
+    return QJsonDocument(records).toJson(indented ? QJsonDocument::Indented
+                                                  : QJsonDocument::Compact);
+}
+
+void BenchmarkQtJson::parseLargeDocument_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    constexpr qsizetype Size = 16 * 1024 * 1024;
+    QTest::newRow("compact") << makeLargeDocument(Size, false, false);
+    QTest::newRow("indented") << makeLargeDocument(Size, true, false);
+    QTest::newRow("escapes") << makeLargeDocument(Size, false, true);
+}
+
+void BenchmarkQtJson::parseLargeDocument()
+{
+    QFETCH(QByteArray, json);
+
+    QBENCHMARK {
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+    }
+}
+
+void BenchmarkQtJson::parseLargeDocumentLazy()
+{
+    QFETCH(QByteArray, json);
+
+    QBENCHMARK {
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(json, QJsonDocument::LazyParsing, &error);
+        QCOMPARE(error.error, QJsonParseError::NoError);
+        const QJsonArray records = doc.array();
+        const QJsonObject record = records.at(records.size() / 2).toObject();
+        QVERIFY(!record.value(QLatin1String("sensor")).toString().isEmpty());
+    }
+}
+
+void BenchmarkQtJson::streamLargeDocument()
+{
+    QFETCH(QByteArray, json);
+
+    QBENCHMARK {
+        QJsonStreamReader reader(json);
+        qsizetype textSize = 0;
+        while (!reader.atEnd()) {
+            reader.readNext();
+            textSize += reader.textView().size();
+        }
+        QCOMPARE(reader.error(), QJsonStreamReader::NoError);
+        QVERIFY(textSize > 0);
+    }
+}
+
+void BenchmarkQtJson::toJsonLargeDocument_data()
+{
+    QTest::addColumn<QJsonDocument>("document");
+    QTest::addColumn<QJsonDocument::JsonFormat>("format");
+
+    constexpr qsizetype Size = 16 * 1024 * 1024;
+    const QJsonDocument plain = QJsonDocument::fromJson(makeLargeDocument(Size, false, false));
+    const QJsonDocument escapes = QJsonDocument::fromJson(makeLargeDocument(Size, false, true));
+    QTest::newRow("compact") << plain << QJsonDocument::Compact;
+    QTest::newRow("indented") << plain << QJsonDocument::Indented;
+    QTest::newRow("escapes") << escapes << QJsonDocument::Compact;
+}
+
+void BenchmarkQtJson::toJsonLargeDocument()
+{
+    QFETCH(QJsonDocument, document);
+    QFETCH(QJsonDocument::JsonFormat, format);
+
+    QBENCHMARK {
+        const QByteArray json = document.toJson(format);
+        QVERIFY(!json.isEmpty());
+    }
+}
+
+void BenchmarkQtJson::toJsonDevice()
+{
+    QFETCH(QJsonDocument, document);
+    QFETCH(QJsonDocument::JsonFormat, format);
+
+    QFile null(QFile::exists("/dev/null") ? QString("/dev/null") : QString("nul"));
+    QVERIFY(null.open(QIODevice::WriteOnly));
+
+    QBENCHMARK {
+        QVERIFY(document.toJson(&null, format));
+    }
+}
+
 void BenchmarkQtJson::jsonObjectInsert()
 {
     QJsonObject object;
@@ -0,0 +1,181 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <QCborValue>
+#include <QFile>
+#include <QTemporaryFile>
+
+class tst_QCborStreamReader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void readDevice();
+    void readMapped();
+    void readMappedViews();
+    void fromCborReadAll();
+    void fromCborMapped();
+
+private:
+    QTemporaryFile file;
+};
+
+// A log of records like the ones written by a tracing or telemetry service.
+// Set QT_BENCH_CBOR_LOG_SIZE to the size in MiB to benchmark larger logs.
+void tst_QCborStreamReader::initTestCase()
+{
+    qint64 size = qEnvironmentVariableIntValue("QT_BENCH_CBOR_LOG_SIZE");
+    size = (size > 0 ? size : 64) * 1024 * 1024;
+
+    QVERIFY(file.open());
+    QCborStreamWriter writer(&file);
+    const QByteArray payload(64, '\x5a');
+    writer.startArray();
+    for (qint64 i = 0; file.pos() < size; ++i) {
+        writer.startMap(5);
+        writer.append(QLatin1String("ts"));
+        writer.append(1634000000000LL + i * 7);
+        writer.append(QLatin1String("level"));
+        writer.append(i % 17 ? QLatin1String("info") : QLatin1String("warning"));
+        writer.append(QLatin1String("source"));
+        writer.append(QStringLiteral("worker-%1").arg(i % 64));
+        writer.append(QLatin1String("message"));
+        writer.append(QStringLiteral("request %1 completed after %2 ms with status ok, "
+                                     "cache hit ratio nominal").arg(i).arg(i % 1000));
+        writer.append(QLatin1String("payload"));
+        writer.append(payload);
+        writer.endMap();
+    }
+    writer.endArray();
+    QVERIFY(file.flush());
+}
+
+enum ReadMode { Copy, View };
+
+static void consume(QCborStreamReader &reader, ReadMode mode, qint64 &bytes)
+{
+    while (reader.lastError() == QCborError::NoError && reader.hasNext()) {
+        if (reader.isContainer()) {
+            reader.enterContainer();
+            consume(reader, mode, bytes);
+            reader.leaveContainer();
+        } else if (reader.isString() && mode == Copy) {
+            auto r = reader.readString();
+            for ( ; r.status == QCborStreamReader::Ok; r = reader.readString())
+                bytes += r.data.size();
+        } else if (reader.isString()) {
+            auto r = reader.readUtf8StringView();
+            for ( ; r.status == QCborStreamReader::Ok; r = reader.readUtf8StringView())
+                bytes += r.data.size();
+        } else if (reader.isByteArray() && mode == Copy) {
+            auto r = reader.readByteArray();
+            for ( ; r.status == QCborStreamReader::Ok; r = reader.readByteArray())
+                bytes += r.data.size();
+        } else if (reader.isByteArray()) {
+            auto r = reader.readByteArrayView();
+            for ( ; r.status == QCborStreamReader::Ok; r = reader.readByteArrayView())
+                bytes += r.data.size();
+        } else {
+            reader.next();
+        }
+    }
+}
+
+void tst_QCborStreamReader::readDevice()
+{
+    QBENCHMARK {
+        QVERIFY(file.seek(0));
+        QCborStreamReader reader(&file);
+        qint64 bytes = 0;
+        consume(reader, Copy, bytes);
+        QCOMPARE(reader.lastError(), QCborError::NoError);
+        QVERIFY(bytes > 0);
+    }
+}
+
+void tst_QCborStreamReader::readMapped()
+{
+    const uchar *data = file.map(0, file.size());
+    QVERIFY(data);
+    QBENCHMARK {
+        QCborStreamReader reader(data, file.size());
+        qint64 bytes = 0;
+        consume(reader, Copy, bytes);
+        QCOMPARE(reader.lastError(), QCborError::NoError);
+        QVERIFY(bytes > 0);
+    }
+    file.unmap(const_cast<uchar *>(data));
+}
+
+void tst_QCborStreamReader::readMappedViews()
+{
+    const uchar *data = file.map(0, file.size());
+    QVERIFY(data);
+    QBENCHMARK {
+        QCborStreamReader reader(data, file.size());
+        qint64 bytes = 0;
+        consume(reader, View, bytes);
+        QCOMPARE(reader.lastError(), QCborError::NoError);
+        QVERIFY(bytes > 0);
+    }
+    file.unmap(const_cast<uchar *>(data));
+}
+
+void tst_QCborStreamReader::fromCborReadAll()
+{
+    QBENCHMARK {
+        QVERIFY(file.seek(0));
+        QCborParserError error;
+        const QCborValue value = QCborValue::fromCbor(file.readAll(), &error);
+        QCOMPARE(error.error, QCborError::NoError);
+        QVERIFY(value.isArray());
+    }
+}
+
+void tst_QCborStreamReader::fromCborMapped()
+{
+    const uchar *data = file.map(0, file.size());
+    QVERIFY(data);
+    QBENCHMARK {
+        QCborParserError error;
+        const QCborValue value = QCborValue::fromCbor(data, file.size(), &error);
+        QCOMPARE(error.error, QCborError::NoError);
+        QVERIFY(value.isArray());
+    }
+    file.unmap(const_cast<uchar *>(data));
+}
+
+QTEST_MAIN(tst_QCborStreamReader)
+
+#include "tst_bench_qcborstreamreader.moc"
@@ -0,0 +1,175 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QBuffer>
+#include <QDataStream>
+
+class tst_QDataStream : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void writeList_data();
+    void writeList();
+    void writeElementwise_data() { writeList_data(); }
+    void writeElementwise();
+    void readList_data() { writeList_data(); }
+    void readList();
+    void readElementwise_data() { writeList_data(); }
+    void readElementwise();
+};
+
+// Large numeric arrays, like the samples or coordinates applications keep
+// in a QList and save with QDataStream.
+static constexpr qsizetype ListSize = 4 * 1024 * 1024;
+
+enum ElementType { Int16, Int32, Double };
+Q_DECLARE_METATYPE(ElementType)
+
+void tst_QDataStream::writeList_data()
+{
+    QTest::addColumn<ElementType>("type");
+    QTest::addColumn<QDataStream::ByteOrder>("byteOrder");
+
+    const QDataStream::ByteOrder native = QDataStream::ByteOrder(QSysInfo::ByteOrder);
+    const QDataStream::ByteOrder swapped = native == QDataStream::BigEndian
+            ? QDataStream::LittleEndian : QDataStream::BigEndian;
+
+    QTest::newRow("qint16-native") << Int16 << native;
+    QTest::newRow("qint16-swapped") << Int16 << swapped;
+    QTest::newRow("qint32-native") << Int32 << native;
+    QTest::newRow("qint32-swapped") << Int32 << swapped;
+    QTest::newRow("double-native") << Double << native;
+    QTest::newRow("double-swapped") << Double << swapped;
+}
+
+template <typename T> static QList<T> makeList()
+{
+    QList<T> list(ListSize);
+    for (qsizetype i = 0; i < ListSize; ++i)
+        list[i] = T(i * 7 + 3);
+    return list;
+}
+
+template <typename T> static QByteArray serialize(QDataStream::ByteOrder byteOrder)
+{
+    QByteArray ba;
+    QDataStream stream(&ba, QIODevice::WriteOnly);
+    stream.setByteOrder(byteOrder);
+    stream << makeList<T>();
+    return ba;
+}
+
+template <typename T, bool Elementwise>
+static void benchWrite(QDataStream::ByteOrder byteOrder)
+{
+    const QList<T> list = makeList<T>();
+    QByteArray ba;
+    ba.reserve(sizeof(quint32) + list.size() * sizeof(T));
+
+    QBENCHMARK {
+        QBuffer buffer(&ba);
+        buffer.open(QIODevice::WriteOnly);
+        QDataStream stream(&buffer);
+        stream.setByteOrder(byteOrder);
+        if constexpr (Elementwise) {
+            stream << quint32(list.size());
+            for (T t : list)
+                stream << t;
+        } else {
+            stream << list;
+        }
+    }
+    QCOMPARE(ba, serialize<T>(byteOrder));
+}
+
+template <typename T, bool Elementwise>
+static void benchRead(QDataStream::ByteOrder byteOrder)
+{
+    const QByteArray ba = serialize<T>(byteOrder);
+    QList<T> list;
+
+    QBENCHMARK {
+        QDataStream stream(ba);
+        stream.setByteOrder(byteOrder);
+        if constexpr (Elementwise) {
+            quint32 n;
+            stream >> n;
+            list.clear();
+            list.reserve(n);
+            for (quint32 i = 0; i < n; ++i) {
+                T t;
+                stream >> t;
+                list.append(t);
+            }
+        } else {
+            stream >> list;
+        }
+    }
+    QCOMPARE(list, makeList<T>());
+}
+
+#define DISPATCH(function) \
+    QFETCH(ElementType, type); \
+    QFETCH(QDataStream::ByteOrder, byteOrder); \
+    switch (type) { \
+    case Int16: function<qint16>(byteOrder); break; \
+    case Int32: function<qint32>(byteOrder); break; \
+    case Double: function<double>(byteOrder); break; \
+    }
+
+template <typename T> static void writeBulk(QDataStream::ByteOrder o) { benchWrite<T, false>(o); }
+template <typename T> static void writeEach(QDataStream::ByteOrder o) { benchWrite<T, true>(o); }
+template <typename T> static void readBulk(QDataStream::ByteOrder o) { benchRead<T, false>(o); }
+template <typename T> static void readEach(QDataStream::ByteOrder o) { benchRead<T, true>(o); }
+
+void tst_QDataStream::writeList()
+{
+    DISPATCH(writeBulk)
+}
+
+void tst_QDataStream::writeElementwise()
+{
+    DISPATCH(writeEach)
+}
+
+void tst_QDataStream::readList()
+{
+    DISPATCH(readBulk)
+}
+
+void tst_QDataStream::readElementwise()
+{
+    DISPATCH(readEach)
+}
+
+QTEST_MAIN(tst_QDataStream)
+
+#include "tst_bench_qdatastream.moc"
@@ -0,0 +1,219 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QCborMap>
+#include <QCborStreamReader>
+#include <QCborStreamWriter>
+#include <QCborValue>
+#include <QJsonObject>
+#include <QMetaProperty>
+#include <QtCore/qpropertyserialization.h>
+
+struct Sample
+{
+    Q_GADGET
+    Q_PROPERTY_VISITOR
+    Q_PROPERTY(qint64 timestamp MEMBER timestamp)
+    Q_PROPERTY(QString sensor MEMBER sensor)
+    Q_PROPERTY(QString unit MEMBER unit)
+    Q_PROPERTY(double value MEMBER value)
+    Q_PROPERTY(double minimum MEMBER minimum)
+    Q_PROPERTY(double maximum MEMBER maximum)
+    Q_PROPERTY(int sequence MEMBER sequence)
+    Q_PROPERTY(bool valid MEMBER valid)
+public:
+    qint64 timestamp = 0;
+    QString sensor;
+    QString unit;
+    double value = 0;
+    double minimum = 0;
+    double maximum = 0;
+    int sequence = 0;
+    bool valid = false;
+};
+
+class tst_QPropertySerialization : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void dataStreamVisitor();
+    void dataStreamVariant();
+    void cborVisitor();
+    void cborVariant();
+    void jsonVisitor();
+    void jsonVariant();
+
+private:
+    QList<Sample> samples;
+};
+
+static const QMetaObject &sampleMetaObject = Sample::staticMetaObject;
+
+void tst_QPropertySerialization::initTestCase()
+{
+    samples.resize(10000);
+    for (int i = 0; i < samples.size(); ++i) {
+        Sample &s = samples[i];
+        s.timestamp = 1634000000000LL + i * 250;
+        s.sensor = QStringLiteral("sensor-%1").arg(i % 32);
+        s.unit = QStringLiteral("celsius");
+        s.value = 20 + (i % 100) / 10.;
+        s.minimum = -40;
+        s.maximum = 85;
+        s.sequence = i;
+        s.valid = i % 13 != 0;
+    }
+}
+
+void tst_QPropertySerialization::dataStreamVisitor()
+{
+    QList<Sample> copy(samples.size());
+    QBENCHMARK {
+        QByteArray data;
+        QDataStream out(&data, QIODevice::WriteOnly);
+        for (const Sample &s : qAsConst(samples))
+            out << s;
+
+        QDataStream in(data);
+        for (Sample &s : copy)
+            in >> s;
+    }
+    QCOMPARE(copy.constLast().sensor, samples.constLast().sensor);
+}
+
+void tst_QPropertySerialization::dataStreamVariant()
+{
+    QList<Sample> copy(samples.size());
+    QBENCHMARK {
+        QByteArray data;
+        QDataStream out(&data, QIODevice::WriteOnly);
+        for (const Sample &s : qAsConst(samples)) {
+            for (int i = 0; i < sampleMetaObject.propertyCount(); ++i)
+                out << sampleMetaObject.property(i).readOnGadget(&s);
+        }
+
+        QDataStream in(data);
+        for (Sample &s : copy) {
+            for (int i = 0; i < sampleMetaObject.propertyCount(); ++i) {
+                QVariant v;
+                in >> v;
+                sampleMetaObject.property(i).writeOnGadget(&s, v);
+            }
+        }
+    }
+    QCOMPARE(copy.constLast().sensor, samples.constLast().sensor);
+}
+
+void tst_QPropertySerialization::cborVisitor()
+{
+    QList<Sample> copy(samples.size());
+    QBENCHMARK {
+        QByteArray data;
+        QCborStreamWriter writer(&data);
+        writer.startArray(samples.size());
+        for (const Sample &s : qAsConst(samples))
+            QtSerialization::toCbor(writer, s);
+        writer.endArray();
+
+        QCborStreamReader reader(data);
+        reader.enterContainer();
+        for (Sample &s : copy)
+            QtSerialization::fromCbor(reader, s);
+    }
+    QCOMPARE(copy.constLast().sensor, samples.constLast().sensor);
+}
+
+void tst_QPropertySerialization::cborVariant()
+{
+    QList<Sample> copy(samples.size());
+    QBENCHMARK {
+        QByteArray data;
+        QCborStreamWriter writer(&data);
+        writer.startArray(samples.size());
+        for (const Sample &s : qAsConst(samples)) {
+            QCborMap map;
+            for (int i = 0; i < sampleMetaObject.propertyCount(); ++i) {
+                const QMetaProperty property = sampleMetaObject.property(i);
+                map.insert(QLatin1String(property.name()),
+                           QCborValue::fromVariant(property.readOnGadget(&s)));
+            }
+            map.toCborValue().toCbor(writer);
+        }
+        writer.endArray();
+
+        QCborStreamReader reader(data);
+        reader.enterContainer();
+        for (Sample &s : copy) {
+            const QCborMap map = QCborValue::fromCbor(reader).toMap();
+            for (int i = 0; i < sampleMetaObject.propertyCount(); ++i) {
+                const QMetaProperty property = sampleMetaObject.property(i);
+                property.writeOnGadget(&s, map.value(QLatin1String(property.name())).toVariant());
+            }
+        }
+    }
+    QCOMPARE(copy.constLast().sensor, samples.constLast().sensor);
+}
+
+void tst_QPropertySerialization::jsonVisitor()
+{
+    QList<Sample> copy(samples.size());
+    QBENCHMARK {
+        for (qsizetype i = 0; i < samples.size(); ++i)
+            QtSerialization::fromJson(QtSerialization::toJson(samples.at(i)), copy[i]);
+    }
+    QCOMPARE(copy.constLast().sensor, samples.constLast().sensor);
+}
+
+void tst_QPropertySerialization::jsonVariant()
+{
+    QList<Sample> copy(samples.size());
+    QBENCHMARK {
+        for (qsizetype n = 0; n < samples.size(); ++n) {
+            QJsonObject json;
+            for (int i = 0; i < sampleMetaObject.propertyCount(); ++i) {
+                const QMetaProperty property = sampleMetaObject.property(i);
+                json.insert(QLatin1String(property.name()),
+                            QJsonValue::fromVariant(property.readOnGadget(&samples.at(n))));
+            }
+            for (int i = 0; i < sampleMetaObject.propertyCount(); ++i) {
+                const QMetaProperty property = sampleMetaObject.property(i);
+                property.writeOnGadget(&copy[n],
+                                       json.value(QLatin1String(property.name())).toVariant());
+            }
+        }
+    }
+    QCOMPARE(copy.constLast().sensor, samples.constLast().sensor);
+}
+
+QTEST_MAIN(tst_QPropertySerialization)
+
+#include "tst_bench_qpropertyserialization.moc"
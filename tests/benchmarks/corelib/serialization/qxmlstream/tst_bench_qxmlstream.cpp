@@ -0,0 +1,165 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QBuffer>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+class tst_QXmlStreamReader : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void parse_data();
+    void parse();
+    void parseDevice_data() { parse_data(); }
+    void parseDevice();
+    void parseString_data() { parse_data(); }
+    void parseString();
+
+private:
+    QByteArray textDocument;
+    QByteArray attributeDocument;
+};
+
+// Two documents of roughly 8 MB: one that is mostly character data, like
+// books or message archives, and one that keeps its data in attributes,
+// like configuration files or SVG.
+void tst_QXmlStreamReader::initTestCase()
+{
+    constexpr int Records = 20000;
+    const QString sentence = QStringLiteral(
+            "The quick brown fox jumps over the lazy dog, while the five boxing wizards "
+            "jump quickly and pack my box with five dozen liquor jugs. ");
+
+    {
+        QXmlStreamWriter writer(&textDocument);
+        writer.setAutoFormatting(true);
+        writer.writeStartDocument();
+        writer.writeStartElement(QStringLiteral("archive"));
+        for (int i = 0; i < Records; ++i) {
+            writer.writeStartElement(QStringLiteral("message"));
+            writer.writeAttribute(QStringLiteral("id"), QString::number(i));
+            writer.writeTextElement(QStringLiteral("subject"), QStringLiteral("Message number %1").arg(i));
+            writer.writeTextElement(QStringLiteral("body"), sentence.repeated(1 + i % 5));
+            writer.writeEndElement();
+        }
+        writer.writeEndDocument();
+    }
+
+    {
+        QXmlStreamWriter writer(&attributeDocument);
+        writer.setAutoFormatting(true);
+        writer.writeStartDocument();
+        writer.writeStartElement(QStringLiteral("drawing"));
+        for (int i = 0; i < Records * 3; ++i) {
+            writer.writeStartElement(QStringLiteral("path"));
+            writer.writeAttribute(QStringLiteral("id"), QStringLiteral("path%1").arg(i));
+            writer.writeAttribute(QStringLiteral("style"),
+                                  QStringLiteral("fill:none;stroke:#000000;stroke-width:%1px").arg(i % 7));
+            writer.writeAttribute(QStringLiteral("d"),
+                                  QStringLiteral("M %1,%2 C %2,%3 %3,%1 %1,%1 Z").arg(i).arg(i * 3).arg(i * 7));
+            writer.writeEndElement();
+        }
+        writer.writeEndDocument();
+    }
+}
+
+void tst_QXmlStreamReader::parse_data()
+{
+    QTest::addColumn<QByteArray>("document");
+
+    QTest::newRow("text") << textDocument;
+    QTest::newRow("attributes") << attributeDocument;
+}
+
+static qsizetype consume(QXmlStreamReader &reader)
+{
+    qsizetype size = 0;
+    while (!reader.atEnd()) {
+        switch (reader.readNext()) {
+        case QXmlStreamReader::StartElement:
+            for (const QXmlStreamAttribute &attribute : reader.attributes())
+                size += attribute.value().size();
+            break;
+        case QXmlStreamReader::Characters:
+            size += reader.text().size();
+            break;
+        default:
+            break;
+        }
+    }
+    return reader.hasError() ? -1 : size;
+}
+
+void tst_QXmlStreamReader::parse()
+{
+    QFETCH(QByteArray, document);
+    qsizetype size = 0;
+
+    QBENCHMARK {
+        QXmlStreamReader reader(document);
+        size = consume(reader);
+    }
+    QVERIFY(size > 0);
+}
+
+void tst_QXmlStreamReader::parseDevice()
+{
+    QFETCH(QByteArray, document);
+    qsizetype size = 0;
+
+    QBENCHMARK {
+        QBuffer buffer(&document);
+        buffer.open(QIODevice::ReadOnly);
+        QXmlStreamReader reader(&buffer);
+        size = consume(reader);
+    }
+    QVERIFY(size > 0);
+}
+
+void tst_QXmlStreamReader::parseString()
+{
+    QFETCH(QByteArray, document);
+    const QString string = QString::fromUtf8(document);
+    qsizetype size = 0;
+
+    QBENCHMARK {
+        QXmlStreamReader reader(string);
+        size = consume(reader);
+    }
+    QVERIFY(size > 0);
+}
+
+QTEST_MAIN(tst_QXmlStreamReader)
+
+#include "tst_bench_qxmlstream.moc"
@@ -54,6 +54,21 @@ private Q_SLOTS:
     void toUpper_QLocale_2();
     void toUpper_QString();
     void number_QString();
+    void doubleToString_QLocale_data() { doubleShortest_data(); }
+    void doubleToString_QLocale();
+    void doubleToString_QString_data() { doubleShortest_data(); }
+    void doubleToString_QString();
+    void doubleToString_QByteArray_data() { doubleShortest_data(); }
+    void doubleToString_QByteArray();
+    void stringToDouble_QLocale_data() { doubleShortest_data(); }
+    void stringToDouble_QLocale();
+    void stringToDouble_QString_data() { doubleShortest_data(); }
+    void stringToDouble_QString();
+    void stringToDouble_QByteArray_data() { doubleShortest_data(); }
+    void stringToDouble_QByteArray();
+
+private:
+    void doubleShortest_data();
 };
 
 static QString data()
@@ -392,6 +407,87 @@ void tst_QLocale::number_QString()
     }
 }
 
+void tst_QLocale::doubleShortest_data()
+{
+    QTest::addColumn<double>("number");
+    QTest::addColumn<QString>("string");
+
+    QTest::newRow("zero") << 0.0 << QStringLiteral("0");
+    QTest::newRow("one") << 1.0 << QStringLiteral("1");
+    QTest::newRow("short") << 0.5 << QStringLiteral("0.5");
+    QTest::newRow("price") << 1234.56 << QStringLiteral("1234.56");
+    QTest::newRow("negative") << -0.001234 << QStringLiteral("-0.001234");
+    QTest::newRow("pi") << 3.141592653589793 << QStringLiteral("3.141592653589793");
+    QTest::newRow("third") << 1.0 / 3 << QStringLiteral("0.3333333333333333");
+    QTest::newRow("large") << 6.02214076e23 << QStringLiteral("6.02214076e+23");
+    QTest::newRow("small") << 1.602176634e-19 << QStringLiteral("1.602176634e-19");
+    QTest::newRow("max") << std::numeric_limits<double>::max()
+                         << QStringLiteral("1.7976931348623157e+308");
+}
+
+void tst_QLocale::doubleToString_QLocale()
+{
+    QFETCH(double, number);
+    QFETCH(QString, string);
+    const QLocale locale(QLocale::C);
+    QString s;
+    QBENCHMARK { LOOP(s = locale.toString(number, 'g', QLocale::FloatingPointShortest)) }
+    QCOMPARE(s, string);
+}
+
+void tst_QLocale::doubleToString_QString()
+{
+    QFETCH(double, number);
+    QFETCH(QString, string);
+    QString s;
+    QBENCHMARK { LOOP(s = QString::number(number, 'g', QLocale::FloatingPointShortest)) }
+    QCOMPARE(s, string);
+}
+
+void tst_QLocale::doubleToString_QByteArray()
+{
+    QFETCH(double, number);
+    QFETCH(QString, string);
+    QByteArray s;
+    QBENCHMARK { LOOP(s = QByteArray::number(number, 'g', QLocale::FloatingPointShortest)) }
+    QCOMPARE(s, string.toLatin1());
+}
+
+void tst_QLocale::stringToDouble_QLocale()
+{
+    QFETCH(double, number);
+    QFETCH(QString, string);
+    const QLocale locale(QLocale::C);
+    double d = 0;
+    bool ok = false;
+    QBENCHMARK { LOOP(d = locale.toDouble(string, &ok)) }
+    QVERIFY(ok);
+    QCOMPARE(d, number);
+}
+
+void tst_QLocale::stringToDouble_QString()
+{
+    QFETCH(double, number);
+    QFETCH(QString, string);
+    double d = 0;
+    bool ok = false;
+    QBENCHMARK { LOOP(d = string.toDouble(&ok)) }
+    QVERIFY(ok);
+    QCOMPARE(d, number);
+}
+
+void tst_QLocale::stringToDouble_QByteArray()
+{
+    QFETCH(double, number);
+    QFETCH(QString, string);
+    const QByteArray bytes = string.toLatin1();
+    double d = 0;
+    bool ok = false;
+    QBENCHMARK { LOOP(d = bytes.toDouble(&ok)) }
+    QVERIFY(ok);
+    QCOMPARE(d, number);
+}
+
 QTEST_MAIN(tst_QLocale)
 
 #include "tst_bench_qlocale.moc"
@@ -27,6 +27,7 @@
 ****************************************************************************/
 
 #include <QRegularExpression>
+#include <private/qregularexpression_p.h>
 #include <QTest>
 
 /*!
@@ -59,6 +60,7 @@ private slots:
 
     void matchCustom();
     void matchCustomOptimized();
+    void matchCustomUncached();
 
     void globalMatchDefault();
     void globalMatchDefaultOptimized();
@@ -114,7 +116,8 @@ void tst_QRegularExpressionBenchmark::createAndMoveCustom()
     \internal This benchmark measures the performance of the match() together
     with pattern compilation for a default-constructed object.
     We need to create the object every time, so that the compiled pattern
-    does not get cached.
+    does not get cached in the object (it does get shared via the
+    process-wide pattern cache, though).
 */
 void tst_QRegularExpressionBenchmark::matchDefault()
 {
@@ -148,8 +151,10 @@ void tst_QRegularExpressionBenchmark::matchDefaultOptimized()
     \internal This benchmark measures the performance of the match() together
     with pattern compilation for an object with custom pattern and pattern
     options.
-    We need to create the object every time, so that the compiled pattern
-    does not get cached.
+    We create the object every time, so that the compiled pattern does not
+    get cached in the object; after the first iteration, the code compiled
+    for the pattern is found in the process-wide pattern cache, though.
+    See matchCustomUncached() for the cost of actually compiling it.
 */
 void tst_QRegularExpressionBenchmark::matchCustom()
 {
@@ -295,6 +300,26 @@ void tst_QRegularExpressionBenchmark::iterateThroughGlobalMatchResults()
     }
 }
 
+/*!
+    \internal This benchmark measures the performance of the match() together
+    with pattern compilation for an object with custom pattern and pattern
+    options, when the pattern is not in the process-wide pattern cache.
+    Compare with matchCustom() to see the benefit of the cache.
+*/
+void tst_QRegularExpressionBenchmark::matchCustomUncached()
+{
+    QBENCHMARK {
+        qt_regularExpressionPatternCacheClear();
+        QRegularExpression re(nonEmptyPattern, nonEmptyPatternOptions);
+        auto matchResult = re.match(textToMatch);
+        Q_UNUSED(matchResult);
+    }
+    qsizetype hits, misses;
+    qt_regularExpressionPatternCacheStatistics(&hits, &misses);
+    QCOMPARE(hits, 0);
+    QCOMPARE(misses, 1);
+}
+
 QTEST_MAIN(tst_QRegularExpressionBenchmark)
 
 #include "tst_bench_qregularexpression.moc"
@@ -57,6 +57,11 @@ private slots:
     void number_double_data();
     void number_double();
 
+    void arg_qlonglong_data();
+    void arg_qlonglong();
+    void arg_string();
+    void arg_multiArg();
+
 private:
     void section_data_impl(bool includeRegExOnly = true);
     template <typename RX> void section_impl();
@@ -319,6 +324,75 @@ void tst_QString::number_double()
     QCOMPARE(actual, expected);
 }
 
+void tst_QString::arg_qlonglong_data()
+{
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<qlonglong>("number");
+    QTest::addColumn<int>("fieldWidth");
+    QTest::addColumn<QChar>("fillChar");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("plain") << QStringLiteral("Value: %1 units") << 123456789ll << 0
+                           << QChar(u' ') << QStringLiteral("Value: 123456789 units");
+    QTest::newRow("negative") << QStringLiteral("Value: %1 units") << -123456789ll << 0
+                              << QChar(u' ') << QStringLiteral("Value: -123456789 units");
+    QTest::newRow("padded") << QStringLiteral("[%1]") << 42ll << 6 << QChar(u'_')
+                            << QStringLiteral("[____42]");
+    QTest::newRow("zero-padded") << QStringLiteral("[%1]") << -42ll << 6 << QChar(u'0')
+                                 << QStringLiteral("[-00042]");
+    QTest::newRow("long-format")
+            << QStringLiteral("The quick brown fox jumps over the lazy dog %1 times, "
+                              "then runs away from the hunter and hides behind a tree.")
+            << 1000ll << 0 << QChar(u' ')
+            << QStringLiteral("The quick brown fox jumps over the lazy dog 1000 times, "
+                              "then runs away from the hunter and hides behind a tree.");
+}
+
+void tst_QString::arg_qlonglong()
+{
+    QFETCH(QString, format);
+    QFETCH(qlonglong, number);
+    QFETCH(int, fieldWidth);
+    QFETCH(QChar, fillChar);
+    QFETCH(QString, expected);
+
+    QString actual;
+    QBENCHMARK {
+        actual = format.arg(number, fieldWidth, 10, fillChar);
+    }
+    QCOMPARE(actual, expected);
+}
+
+void tst_QString::arg_string()
+{
+    const QString format = QStringLiteral("%1: the file %2 could not be opened (%3)");
+    const QString a = QStringLiteral("Error");
+    const QString b = QStringLiteral("/tmp/some/file.txt");
+    const QString c = QStringLiteral("permission denied");
+
+    QString actual;
+    QBENCHMARK {
+        actual = format.arg(a).arg(b).arg(c);
+    }
+    QCOMPARE(actual, QStringLiteral("Error: the file /tmp/some/file.txt could not be opened "
+                                    "(permission denied)"));
+}
+
+void tst_QString::arg_multiArg()
+{
+    const QString format = QStringLiteral("%1: the file %2 could not be opened (%3)");
+    const QString a = QStringLiteral("Error");
+    const QString b = QStringLiteral("/tmp/some/file.txt");
+    const QString c = QStringLiteral("permission denied");
+
+    QString actual;
+    QBENCHMARK {
+        actual = format.arg(a, b, c);
+    }
+    QCOMPARE(actual, QStringLiteral("Error: the file /tmp/some/file.txt could not be opened "
+                                    "(permission denied)"));
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "tst_bench_qstring.moc"
@@ -37,6 +37,7 @@ class tst_QStringTokenizer : public QObject
     void tokenize_data() const;
     template <typename T, typename U>
     void tokenize() const;
+    void splitLines_data() const;
 private slots:
     void tokenize_qlatin1string_qlatin1string_data() const { tokenize_data(); }
     void tokenize_qlatin1string_qlatin1string() const { tokenize<QLatin1String, QLatin1String>(); }
@@ -46,6 +47,13 @@ private slots:
     void tokenize_qlatin1string_qstring() const { tokenize<QLatin1String, QString>(); }
     void tokenize_qstring_qlatin1string_data() const { tokenize_data(); }
     void tokenize_qstring_qlatin1string() const { tokenize<QString, QLatin1String>(); }
+    void tokenize_qbytearrayview_qbytearrayview_data() const { tokenize_data(); }
+    void tokenize_qbytearrayview_qbytearrayview() const { tokenize<QByteArrayView, QByteArrayView>(); }
+
+    void splitLines_qbytearray_split_data() const { splitLines_data(); }
+    void splitLines_qbytearray_split() const;
+    void splitLines_qbytearray_tokenize_data() const { splitLines_data(); }
+    void splitLines_qbytearray_tokenize() const;
 };
 
 template<typename T>
@@ -63,6 +71,12 @@ QLatin1String fromByteArray<QLatin1String>(QByteArrayView v)
     return QLatin1String(v.data(), v.size());
 }
 
+template<>
+QByteArrayView fromByteArray<QByteArrayView>(QByteArrayView v)
+{
+    return v;
+}
+
 void tst_QStringTokenizer::tokenize_data() const
 {
     QTest::addColumn<QByteArray>("input");
@@ -140,6 +154,51 @@ void tst_QStringTokenizer::tokenize() const
     }
 }
 
+void tst_QStringTokenizer::splitLines_data() const
+{
+    QTest::addColumn<QByteArray>("input");
+    QTest::addColumn<int>("expectedCount");
+
+    QByteArray log;
+    const int lines = 100000;
+    for (int i = 0; i < lines; ++i) {
+        log += "2021-11-02T12:34:56.789 INFO  [worker-" + QByteArray::number(i % 16)
+                + "] processed request " + QByteArray::number(i) + " in "
+                + QByteArray::number(i % 977) + " ms\n";
+    }
+    QTest::addRow("log-100k-lines") << log << lines + 1;
+}
+
+void tst_QStringTokenizer::splitLines_qbytearray_split() const
+{
+    QFETCH(QByteArray, input);
+    QFETCH(int, expectedCount);
+
+    QBENCHMARK {
+        qsizetype count = 0;
+        for (const QByteArray &line : input.split('\n')) {
+            count++;
+            Q_UNUSED(line);
+        }
+        QCOMPARE(count, expectedCount);
+    }
+}
+
+void tst_QStringTokenizer::splitLines_qbytearray_tokenize() const
+{
+    QFETCH(QByteArray, input);
+    QFETCH(int, expectedCount);
+
+    QBENCHMARK {
+        qsizetype count = 0;
+        for (QByteArrayView line : qTokenize(input, '\n')) {
+            count++;
+            Q_UNUSED(line);
+        }
+        QCOMPARE(count, expectedCount);
+    }
+}
+
 QTEST_MAIN(tst_QStringTokenizer)
 
 #include "tst_bench_qstringtokenizer.moc"
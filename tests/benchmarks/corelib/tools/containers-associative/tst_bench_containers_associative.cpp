@@ -25,6 +25,7 @@
 ** $QT_END_LICENSE$
 **
 ****************************************************************************/
+#include <QFlatMap>
 #include <QString>
 
 #include <qtest.h>
@@ -37,6 +38,10 @@ private slots:
     void insert();
     void lookup_data();
     void lookup();
+    void flatMapBulkInsert_data();
+    void flatMapBulkInsert();
+    void flatMapStringLookup_data();
+    void flatMapStringLookup();
 };
 
 template <typename T>
@@ -126,6 +131,126 @@ void tst_associative_containers::lookup()
     }
 }
 
+enum BulkInsertMethod { MapOneByOne, FlatMapOneByOne, FlatMapRange, FlatMapContainers };
+
+void tst_associative_containers::flatMapBulkInsert_data()
+{
+    QTest::addColumn<int>("method");
+    QTest::addColumn<int>("size");
+
+    for (int size : { 1000, 10000, 100000 }) {
+        const QByteArray sizeString = QByteArray::number(size);
+        QTest::newRow(QByteArray("map-one-by-one--" + sizeString).constData())
+                << int(MapOneByOne) << size;
+        // each insertion moves half of the elements on average
+        if (size <= 10000) {
+            QTest::newRow(QByteArray("flatmap-one-by-one--" + sizeString).constData())
+                    << int(FlatMapOneByOne) << size;
+        }
+        QTest::newRow(QByteArray("flatmap-range--" + sizeString).constData())
+                << int(FlatMapRange) << size;
+        QTest::newRow(QByteArray("flatmap-containers--" + sizeString).constData())
+                << int(FlatMapContainers) << size;
+    }
+}
+
+void tst_associative_containers::flatMapBulkInsert()
+{
+    QFETCH(int, method);
+    QFETCH(int, size);
+
+    // unsorted keys, with about one in ten appearing twice
+    QList<int> keys(size);
+    QList<int> values(size);
+    std::vector<std::pair<const int, int>> pairs;
+    pairs.reserve(size);
+    for (int i = 0; i < size; ++i) {
+        keys[i] = int((uint(i) * 2654435761u) % uint(size + size / 10));
+        values[i] = i;
+        pairs.emplace_back(keys[i], i);
+    }
+
+    qsizetype result = 0;
+    switch (method) {
+    case MapOneByOne:
+        QBENCHMARK {
+            QMap<int, int> map;
+            for (int i = 0; i < size; ++i)
+                map.insert(keys[i], values[i]);
+            result = map.size();
+        }
+        break;
+    case FlatMapOneByOne:
+        QBENCHMARK {
+            QFlatMap<int, int> map;
+            for (int i = 0; i < size; ++i)
+                map.insert(keys[i], values[i]);
+            result = map.size();
+        }
+        break;
+    case FlatMapRange:
+        QBENCHMARK {
+            QFlatMap<int, int> map;
+            map.insert(pairs.data(), pairs.data() + pairs.size());
+            result = map.size();
+        }
+        break;
+    case FlatMapContainers:
+        QBENCHMARK {
+            QFlatMap<int, int> map;
+            map.insert(keys, values);
+            result = map.size();
+        }
+        break;
+    }
+    QVERIFY(result > 0);
+}
+
+void tst_associative_containers::flatMapStringLookup_data()
+{
+    QTest::addColumn<bool>("heterogeneous");
+    QTest::addColumn<int>("size");
+
+    for (int size : { 100, 10000 }) {
+        const QByteArray sizeString = QByteArray::number(size);
+        QTest::newRow(QByteArray("qstring--" + sizeString).constData()) << false << size;
+        QTest::newRow(QByteArray("qstringview--" + sizeString).constData()) << true << size;
+    }
+}
+
+void tst_associative_containers::flatMapStringLookup()
+{
+    QFETCH(bool, heterogeneous);
+    QFETCH(int, size);
+
+    // Looking up words of a text: without heterogeneous lookup, each of the
+    // views has to be turned into a QString first.
+    QFlatMap<QString, int, std::less<>> map;
+    QString text;
+    for (int i = 0; i < size; ++i) {
+        const QString word = QLatin1String("word") + QString::number(i);
+        map.insert(word, i);
+        text += word + QLatin1Char(' ');
+    }
+    const QList<QStringView> words = QStringView(text).split(u' ', Qt::SkipEmptyParts);
+
+    qint64 sum = 0;
+    if (heterogeneous) {
+        QBENCHMARK {
+            sum = 0;
+            for (QStringView word : words)
+                sum += map.value(word);
+        }
+    } else {
+        QBENCHMARK {
+            sum = 0;
+            for (QStringView word : words)
+                sum += map.value(word.toString());
+        }
+    }
+    QCOMPARE(sum, qint64(size) * (size - 1) / 2);
+}
+
 QTEST_MAIN(tst_associative_containers)
 
 #include "tst_bench_containers_associative.moc"
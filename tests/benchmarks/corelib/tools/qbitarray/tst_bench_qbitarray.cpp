@@ -0,0 +1,177 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QBitArray>
+#include <QRandomGenerator>
+#include <QTest>
+
+class tst_QBitArray : public QObject
+{
+    Q_OBJECT
+private slots:
+    void count();
+    void bitwise_data();
+    void bitwise();
+    void indexOf_data();
+    void indexOf();
+    void rank_data();
+    void rank();
+    void select();
+};
+
+static constexpr qsizetype Size = 8 * 1024 * 1024;
+
+// sets one bit in every 'density' on average
+static QBitArray randomBitArray(int density, quint32 seed = 1)
+{
+    QRandomGenerator rng(seed);
+    QBitArray result(Size);
+    for (qsizetype i = 0; i < Size; ++i) {
+        if (rng.bounded(density) == 0)
+            result.setBit(i);
+    }
+    return result;
+}
+
+void tst_QBitArray::count()
+{
+    const QBitArray bits = randomBitArray(2);
+    QBENCHMARK {
+        [[maybe_unused]] auto r = bits.count(true);
+    }
+}
+
+void tst_QBitArray::bitwise_data()
+{
+    QTest::addColumn<char>("op");
+    QTest::newRow("and") << '&';
+    QTest::newRow("or") << '|';
+    QTest::newRow("xor") << '^';
+    QTest::newRow("not") << '~';
+}
+
+void tst_QBitArray::bitwise()
+{
+    QFETCH(char, op);
+    QBitArray bits = randomBitArray(2, 1);
+    const QBitArray other = randomBitArray(2, 2);
+    QBENCHMARK {
+        switch (op) {
+        case '&': bits &= other; break;
+        case '|': bits |= other; break;
+        case '^': bits ^= other; break;
+        case '~': bits = ~bits; break;
+        }
+    }
+}
+
+void tst_QBitArray::indexOf_data()
+{
+    QTest::addColumn<int>("density");
+    QTest::addColumn<bool>("testBit");
+    for (int density : { 8, 1000 }) {
+        QTest::addRow("1-in-%d-testBit", density) << density << true;
+        QTest::addRow("1-in-%d-indexOf", density) << density << false;
+    }
+}
+
+// Visits all set bits.
+void tst_QBitArray::indexOf()
+{
+    QFETCH(int, density);
+    QFETCH(bool, testBit);
+    const QBitArray bits = randomBitArray(density);
+    qsizetype found = 0;
+    if (testBit) {
+        QBENCHMARK {
+            found = 0;
+            for (qsizetype i = 0; i < Size; ++i)
+                found += bits.testBit(i);
+        }
+    } else {
+        QBENCHMARK {
+            found = 0;
+            for (qsizetype i = bits.indexOf(true); i >= 0; i = bits.indexOf(true, i + 1))
+                ++found;
+        }
+    }
+    QCOMPARE(found, bits.count(true));
+}
+
+void tst_QBitArray::rank_data()
+{
+    QTest::addColumn<bool>("index");
+    QTest::newRow("count") << false;
+    QTest::newRow("rank") << true;
+}
+
+// 1000 queries for the number of set bits before a random position.
+void tst_QBitArray::rank()
+{
+    QFETCH(bool, index);
+    const QBitArray bits = randomBitArray(2);
+    const QBitArrayRankSelect rankSelect(bits);
+    QRandomGenerator rng(3);
+    QList<qsizetype> positions;
+    for (int i = 0; i < 1000; ++i)
+        positions.append(rng.bounded(Size));
+
+    if (index) {
+        QBENCHMARK {
+            for (qsizetype pos : positions)
+                [[maybe_unused]] auto r = rankSelect.rank(pos);
+        }
+    } else {
+        QBENCHMARK {
+            for (qsizetype pos : positions) {
+                QBitArray prefix = bits;
+                prefix.truncate(pos);
+                [[maybe_unused]] auto r = prefix.count(true);
+            }
+        }
+    }
+}
+
+// 100000 queries for the position of a random set bit.
+void tst_QBitArray::select()
+{
+    const QBitArrayRankSelect rankSelect(randomBitArray(2));
+    QRandomGenerator rng(4);
+    QList<qsizetype> ranks;
+    for (int i = 0; i < 100000; ++i)
+        ranks.append(rng.bounded(rankSelect.count()));
+
+    QBENCHMARK {
+        for (qsizetype n : ranks)
+            [[maybe_unused]] auto r = rankSelect.select(n);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QBitArray)
+
+#include "tst_bench_qbitarray.moc"
@@ -0,0 +1,137 @@
+/****************************************************************************
+**
+** Copyright (C) 2021 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QCache>
+#include <QConcurrentCache>
+#include <QMutex>
+#include <QTest>
+#include <QThread>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+class tst_QConcurrentCache : public QObject
+{
+    Q_OBJECT
+private slots:
+    void lockedQCache_data() { data(); }
+    void lockedQCache();
+    void qconcurrentcache_data() { data(); }
+    void qconcurrentcache();
+
+private:
+    void data();
+    template <typename Cache> void run(Cache &cache);
+};
+
+namespace {
+// The baseline everyone writes by hand: a QCache protected by a single mutex.
+// QCache stores pointers, so values are copied in and out of heap objects.
+class LockedCache
+{
+public:
+    explicit LockedCache(qsizetype maxCost) : cache(maxCost) {}
+
+    bool insert(int key, int value)
+    {
+        QMutexLocker locker(&mutex);
+        return cache.insert(key, new int(value));
+    }
+    std::optional<int> value(int key) const
+    {
+        QMutexLocker locker(&mutex);
+        if (const int *value = cache.object(key))
+            return *value;
+        return std::nullopt;
+    }
+private:
+    mutable QMutex mutex;
+    QCache<int, int> cache;
+};
+} // unnamed namespace
+
+constexpr int KeyCount = 20000;
+constexpr int CacheSize = KeyCount / 4;
+constexpr int OperationsPerThread = 100000;
+
+void tst_QConcurrentCache::data()
+{
+    QTest::addColumn<int>("threads");
+
+    for (int threads : {1, 2, 4, 8})
+        QTest::addRow("%d-threads", threads) << threads;
+}
+
+template <typename Cache> void tst_QConcurrentCache::run(Cache &cache)
+{
+    QFETCH(int, threads);
+
+    // A read-through workload: look the key up, and insert it on a miss.
+    // Keys are skewed towards small values, so that most lookups hit.
+    const auto worker = [&cache](int seed) {
+        uint state = uint(seed) * 2654435761U + 1;
+        int sum = 0;
+        for (int i = 0; i < OperationsPerThread; ++i) {
+            state = state * 1664525U + 1013904223U;
+            const uint r = (state >> 8) % KeyCount;
+            const int key = int(r * r / KeyCount);
+            if (const auto value = cache.value(key))
+                sum += *value;
+            else
+                cache.insert(key, key);
+        }
+        return sum;
+    };
+
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> pool;
+        for (int t = 0; t < threads; ++t)
+            pool.emplace_back(QThread::create(worker, t));
+        for (const auto &thread : pool)
+            thread->start();
+        for (const auto &thread : pool)
+            thread->wait();
+    }
+}
+
+void tst_QConcurrentCache::lockedQCache()
+{
+    LockedCache cache(CacheSize);
+    run(cache);
+}
+
+void tst_QConcurrentCache::qconcurrentcache()
+{
+    QConcurrentCache<int, int> cache(CacheSize);
+    run(cache);
+}
+
+QTEST_MAIN(tst_QConcurrentCache)
+
+#include "tst_bench_qconcurrentcache.moc"
@@ -31,6 +31,7 @@
 #include <QFile>
 #include <QRandomGenerator>
 #include <QString>
+#include <QTemporaryFile>
 #include <QTest>
 
 #include <time.h>
@@ -50,9 +51,13 @@ private Q_SLOTS:
     void addData();
     void addDataChunked_data() { hash_data(); }
     void addDataChunked();
+    void hashMany_data();
+    void hashMany();
+    void addDataFile_data();
+    void addDataFile();
 };
 
-const int MaxCryptoAlgorithm = QCryptographicHash::Sha3_512;
+const int MaxCryptoAlgorithm = QCryptographicHash::Blake2bTree_512;
 const int MaxBlockSize = 65536;
 
 const char *algoname(int i)
@@ -104,6 +109,8 @@ const char *algoname(int i)
         return "blake2s_224-";
     case QCryptographicHash::Blake2s_256:
         return "blake2s_256-";
+    case QCryptographicHash::Blake2bTree_512:
+        return "blake2btree_512-";
     }
     Q_UNREACHABLE();
     return nullptr;
@@ -183,6 +190,89 @@ void tst_QCryptographicHash::addDataChunked()
     }
 }
 
+void tst_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<int>("algorithm");
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("batch");
+
+    const int algorithms[] = { QCryptographicHash::Sha1, QCryptographicHash::Sha256,
+                               QCryptographicHash::Blake2b_256 };
+    for (int algo : algorithms) {
+        for (int size : { 64, 1024 }) {
+            const QByteArray name = algoname(algo) + QByteArray::number(size);
+            QTest::newRow(name + "-loop") << algo << size << false;
+            QTest::newRow(name + "-batch") << algo << size << true;
+        }
+    }
+}
+
+// Hashes 256 independent buffers, either one by one or in one call.
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(int, algorithm);
+    QFETCH(int, size);
+    QFETCH(bool, batch);
+
+    QList<QByteArrayView> buffers;
+    for (int i = 0; i < 256; ++i)
+        buffers.append(QByteArrayView(blockOfData).sliced(i * 64, size));
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    if (batch) {
+        QBENCHMARK {
+            QCryptographicHash::hashMany(buffers, algo);
+        }
+    } else {
+        QBENCHMARK {
+            for (QByteArrayView buffer : buffers)
+                QCryptographicHash::hash(buffer, algo);
+        }
+    }
+}
+
+void tst_QCryptographicHash::addDataFile_data()
+{
+    QTest::addColumn<int>("algorithm");
+    QTest::addColumn<bool>("device");
+
+    const int algorithms[] = { QCryptographicHash::Sha256, QCryptographicHash::Blake2b_512,
+                               QCryptographicHash::Blake2bTree_512 };
+    for (int algo : algorithms) {
+        QTest::newRow(algoname(algo) + QByteArray("read")) << algo << false;
+        QTest::newRow(algoname(algo) + QByteArray("device")) << algo << true;
+    }
+}
+
+// Hashes a 64 MiB file, by reading it in chunks or with addData(QIODevice *).
+void tst_QCryptographicHash::addDataFile()
+{
+    QFETCH(int, algorithm);
+    QFETCH(bool, device);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    for (int i = 0; i < 64 * 1024 * 1024 / MaxBlockSize; ++i)
+        QCOMPARE(file.write(blockOfData), qint64(MaxBlockSize));
+    QVERIFY(file.flush());
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QCryptographicHash hash(algo);
+    QBENCHMARK {
+        hash.reset();
+        QVERIFY(file.seek(0));
+        if (device) {
+            QVERIFY(hash.addData(&file));
+        } else {
+            char buffer[16384];
+            qint64 length;
+            while ((length = file.read(buffer, sizeof(buffer))) > 0)
+                hash.addData(QByteArrayView(buffer, length));
+        }
+        hash.result();
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QCryptographicHash)
 
 #include "tst_bench_qcryptographichash.moc"
@@ -29,12 +29,20 @@
 
 #include "tst_bench_qhash.h"
 
+#include <QConcurrentHash>
 #include <QFile>
 #include <QHash>
+#include <QReadWriteLock>
 #include <QString>
 #include <QStringList>
 #include <QUuid>
 #include <QTest>
+#include <QThread>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
 
 
 class tst_QHash : public QObject
@@ -61,10 +69,28 @@ private slots:
     void hashing_javaString_data() { data(); }
     void hashing_javaString() { hashing_template<JavaString>(); }
 
+    void lookup_hits_data() { data(); }
+    void lookup_hits();
+    void lookup_misses_data() { data(); }
+    void lookup_misses();
+    void lookup_tagged_hits_data() { data(); }
+    void lookup_tagged_hits();
+    void lookup_tagged_misses_data() { data(); }
+    void lookup_tagged_misses();
+    void lookup_int_data();
+    void lookup_int();
+
+    void concurrent_lockedQHash_data() { concurrentData(); }
+    void concurrent_lockedQHash();
+    void concurrent_qconcurrenthash_data() { concurrentData(); }
+    void concurrent_qconcurrenthash();
+
 private:
     void data();
+    void concurrentData();
     template <typename String> void qhash_template();
     template <typename String> void hashing_template();
+    template <typename Table> void concurrent_template(Table &table);
 
     QStringList smallFilePaths;
     QStringList uuids;
@@ -169,6 +195,194 @@ template <typename String> void tst_QHash::hashing_template()
     }
 }
 
+///////////////////// lookups /////////////////////
+
+template <typename String>
+static void lookupHits()
+{
+    QFETCH(QStringList, items);
+    QHash<String, int> hash;
+    for (int i = 0, n = items.size(); i != n; ++i)
+        hash.insert(items.at(i), i);
+
+    QList<String> keys(items.cbegin(), items.cend());
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const String &item : qAsConst(keys))
+            found += hash.contains(item);
+    }
+    QCOMPARE(found, hash.size());
+}
+
+template <typename String>
+static void lookupMisses()
+{
+    // only every other item is in the hash, and we look up the rest
+    QFETCH(QStringList, items);
+    QHash<String, int> hash;
+    QList<String> absent;
+    for (int i = 0, n = items.size(); i != n; ++i) {
+        if (i % 2)
+            absent.append(items.at(i));
+        else
+            hash.insert(items.at(i), i);
+    }
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const String &item : qAsConst(absent))
+            found += hash.contains(item);
+    }
+    QCOMPARE(found, 0);
+}
+
+void tst_QHash::lookup_hits()
+{
+    lookupHits<QString>();
+}
+
+void tst_QHash::lookup_misses()
+{
+    lookupMisses<QString>();
+}
+
+void tst_QHash::lookup_tagged_hits()
+{
+    lookupHits<TaggedString>();
+}
+
+void tst_QHash::lookup_tagged_misses()
+{
+    lookupMisses<TaggedString>();
+}
+
+void tst_QHash::lookup_int_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("hitPercentage");
+
+    for (int size : {1000, 100000, 1000000}) {
+        for (int hits : {0, 50, 100})
+            QTest::addRow("%d-items-%d%%-hits", size, hits) << size << hits;
+    }
+}
+
+void tst_QHash::lookup_int()
+{
+    QFETCH(int, size);
+    QFETCH(int, hitPercentage);
+
+    // inserted keys are multiples of 4, misses are looked up in between
+    QHash<int, int> hash;
+    hash.reserve(size);
+    for (int i = 0; i < size; ++i)
+        hash.insert(i * 4, i);
+
+    QList<int> keys;
+    keys.reserve(size);
+    qsizetype expected = 0;
+    for (int i = 0; i < size; ++i) {
+        const bool hit = (i % 100) < hitPercentage;
+        keys.append(i * 4 + (hit ? 0 : 1));
+        expected += hit;
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(size));
+
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (int key : qAsConst(keys))
+            found += hash.contains(key);
+    }
+    QCOMPARE(found, expected);
+}
+
+///////////////////// concurrent access /////////////////////
+
+namespace {
+// The baseline everyone writes by hand: a QHash protected by a single lock.
+class LockedHash
+{
+public:
+    void insert(int key, int value)
+    {
+        QWriteLocker locker(&lock);
+        hash.insert(key, value);
+    }
+    int value(int key) const
+    {
+        QReadLocker locker(&lock);
+        return hash.value(key);
+    }
+private:
+    mutable QReadWriteLock lock;
+    QHash<int, int> hash;
+};
+} // unnamed namespace
+
+void tst_QHash::concurrentData()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<int>("writePercentage");
+
+    for (int threads : {1, 4, 8}) {
+        for (int writes : {0, 10, 50}) {
+            QTest::addRow("%d-threads-%d%%-writes", threads, writes)
+                    << threads << writes;
+        }
+    }
+}
+
+template <typename Table> void tst_QHash::concurrent_template(Table &table)
+{
+    QFETCH(int, threads);
+    QFETCH(int, writePercentage);
+
+    constexpr int KeyCount = 10000;
+    constexpr int OperationsPerThread = 100000;
+    for (int i = 0; i < KeyCount; ++i)
+        table.insert(i, i);
+
+    const auto worker = [&table, writePercentage](int seed) {
+        // cheap LCG, so that the benchmark doesn't measure the RNG
+        uint state = uint(seed) * 2654435761U + 1;
+        int sum = 0;
+        for (int i = 0; i < OperationsPerThread; ++i) {
+            state = state * 1664525U + 1013904223U;
+            const int key = int((state >> 8) % KeyCount);
+            if (int(state % 100) < writePercentage)
+                table.insert(key, i);
+            else
+                sum += table.value(key);
+        }
+        return sum;
+    };
+
+    QBENCHMARK {
+        std::vector<std::unique_ptr<QThread>> pool;
+        for (int t = 0; t < threads; ++t)
+            pool.emplace_back(QThread::create(worker, t));
+        for (const auto &thread : pool)
+            thread->start();
+        for (const auto &thread : pool)
+            thread->wait();
+    }
+}
+
+void tst_QHash::concurrent_lockedQHash()
+{
+    LockedHash table;
+    concurrent_template(table);
+}
+
+void tst_QHash::concurrent_qconcurrenthash()
+{
+    QConcurrentHash<int, int> table;
+    concurrent_template(table);
+}
+
 QTEST_MAIN(tst_QHash)
 
 #include "tst_bench_qhash.moc"
@@ -26,6 +26,7 @@
 **
 ****************************************************************************/
 
+#include <QHash>
 #include <QString>
 
 struct Qt4String : QString
@@ -59,3 +60,19 @@ QT_BEGIN_NAMESPACE
 uint qHash(const JavaString &);
 QT_END_NAMESPACE
 
+
+struct TaggedString : QString
+{
+    TaggedString() {}
+    TaggedString(const QString &s) : QString(s) {}
+};
+
+QT_BEGIN_NAMESPACE
+inline size_t qHash(const TaggedString &s, size_t seed = 0)
+{
+    return qHash(static_cast<const QString &>(s), seed);
+}
+QT_END_NAMESPACE
+
+Q_DECLARE_HASH_TAG_PROBING(TaggedString)
+
@@ -26,12 +26,18 @@
 **
 ****************************************************************************/
 
+#include <QBTreeMap>
 #include <QFile>
+#include <QFlatMap>
 #include <QMap>
 #include <QString>
 #include <QTest>
 #include <qdebug.h>
 
+#include <algorithm>
+#include <numeric>
+#include <random>
+
 
 class tst_QMap : public QObject
 {
@@ -62,7 +68,19 @@ private slots:
 
     void insertMap();
 
+    void ordered_insertSequential_data() { orderedData(); }
+    void ordered_insertSequential();
+    void ordered_insertRandom_data();
+    void ordered_insertRandom();
+    void ordered_lookup_data() { orderedData(); }
+    void ordered_lookup();
+    void ordered_lowerBound_data() { orderedData(); }
+    void ordered_lowerBound();
+    void ordered_iteration_data() { orderedData(); }
+    void ordered_iteration();
+
 private:
+    void orderedData();
     QStringList helloEachWorld(int count);
 };
 
@@ -324,6 +342,168 @@ void tst_QMap::insertMap()
     }
 }
 
+// Compare the ordered associative containers: QMap (a red-black tree with a
+// heap node per element), QBTreeMap and QFlatMap (sorted arrays).
+enum OrderedMap { Map, BTreeMap, FlatMap };
+
+using IntFlatMap = QFlatMap<int, int>;
+
+template <typename M>
+static auto lowerBoundOf(const M &map, int key) { return map.lowerBound(key); }
+static auto lowerBoundOf(const IntFlatMap &map, int key) { return map.lower_bound(key); }
+
+static QList<int> shuffledKeys(int size)
+{
+    QList<int> keys(size);
+    for (int i = 0; i < size; ++i)
+        keys[i] = i * 2;
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(size));
+    return keys;
+}
+
+template <typename M>
+static M orderedMap(int size)
+{
+    M map;
+    for (int i = 0; i < size; ++i)
+        map.insert(i * 2, i);
+    return map;
+}
+
+void tst_QMap::orderedData()
+{
+    QTest::addColumn<int>("container");
+    QTest::addColumn<int>("size");
+
+    for (int size : { 1000, 100000, 1000000 }) {
+        QTest::addRow("QMap:%d", size) << int(Map) << size;
+        QTest::addRow("QBTreeMap:%d", size) << int(BTreeMap) << size;
+        QTest::addRow("QFlatMap:%d", size) << int(FlatMap) << size;
+    }
+}
+
+template <typename M>
+static void insertKeys(const QList<int> &keys)
+{
+    QBENCHMARK {
+        M map;
+        for (int key : keys)
+            map.insert(key, key);
+        QCOMPARE(map.size(), keys.size());
+    }
+}
+
+template <typename Function>
+static void dispatch(int container, Function f)
+{
+    switch (container) {
+    case Map:
+        return f(QMap<int, int>());
+    case BTreeMap:
+        return f(QBTreeMap<int, int>());
+    case FlatMap:
+        return f(IntFlatMap());
+    }
+}
+
+void tst_QMap::ordered_insertSequential()
+{
+    QFETCH(int, container);
+    QFETCH(int, size);
+
+    QList<int> keys(size);
+    std::iota(keys.begin(), keys.end(), 0);
+    dispatch(container, [&](auto map) { insertKeys<decltype(map)>(keys); });
+}
+
+void tst_QMap::ordered_insertRandom_data()
+{
+    QTest::addColumn<int>("container");
+    QTest::addColumn<int>("size");
+
+    for (int size : { 1000, 100000, 1000000 }) {
+        QTest::addRow("QMap:%d", size) << int(Map) << size;
+        QTest::addRow("QBTreeMap:%d", size) << int(BTreeMap) << size;
+        // each insertion moves half of the array on average
+        if (size <= 100000)
+            QTest::addRow("QFlatMap:%d", size) << int(FlatMap) << size;
+    }
+}
+
+void tst_QMap::ordered_insertRandom()
+{
+    QFETCH(int, container);
+    QFETCH(int, size);
+
+    const QList<int> keys = shuffledKeys(size);
+    dispatch(container, [&](auto map) { insertKeys<decltype(map)>(keys); });
+}
+
+void tst_QMap::ordered_lookup()
+{
+    QFETCH(int, container);
+    QFETCH(int, size);
+
+    // half of the lookups are misses
+    QList<int> keys = shuffledKeys(size);
+    for (int i = 0; i < size; i += 2)
+        ++keys[i];
+
+    dispatch(container, [&](auto map) {
+        map = orderedMap<decltype(map)>(size);
+        qint64 sum = 0;
+        QBENCHMARK {
+            sum = 0;
+            for (int key : keys)
+                sum += map.value(key, -1);
+        }
+        QVERIFY(sum != 0);
+    });
+}
+
+void tst_QMap::ordered_lowerBound()
+{
+    QFETCH(int, container);
+    QFETCH(int, size);
+
+    QList<int> keys = shuffledKeys(size);
+    for (int i = 0; i < size; i += 2)
+        ++keys[i];
+
+    dispatch(container, [&](auto map) {
+        map = orderedMap<decltype(map)>(size);
+        const auto &constMap = map;
+        qint64 sum = 0;
+        QBENCHMARK {
+            sum = 0;
+            for (int key : keys) {
+                const auto it = lowerBoundOf(constMap, key);
+                if (it != constMap.end())
+                    sum += it.value();
+            }
+        }
+        QVERIFY(sum != 0);
+    });
+}
+
+void tst_QMap::ordered_iteration()
+{
+    QFETCH(int, container);
+    QFETCH(int, size);
+
+    dispatch(container, [&](auto map) {
+        map = orderedMap<decltype(map)>(size);
+        const auto &constMap = map;
+        qint64 sum = 0;
+        QBENCHMARK {
+            sum = 0;
+            for (auto it = constMap.begin(), end = constMap.end(); it != end; ++it)
+                sum += it.value();
+        }
+        QCOMPARE(sum, qint64(size) * (size - 1) / 2);
+    });
+}
+
 QTEST_MAIN(tst_QMap)
 
 #include "tst_bench_qmap.moc"
@@ -28,6 +28,10 @@
 
 #include <private/qringbuffer_p.h>
 #include <QByteArray>
+#include <QMutex>
+#include <QSpscRingBuffer>
+#include <QThread>
+#include <QWaitCondition>
 
 #include <qtest.h>
 
@@ -37,6 +41,8 @@ class tst_QRingBuffer : public QObject
 private slots:
     void reserveAndRead();
     void free();
+    void crossThread_data();
+    void crossThread();
 };
 
 void tst_QRingBuffer::reserveAndRead()
@@ -66,6 +72,85 @@ void tst_QRingBuffer::free()
     }
 }
 
+enum class Transport { MutexRingBuffer, SpscHeap, SpscMapped };
+Q_DECLARE_METATYPE(Transport)
+
+void tst_QRingBuffer::crossThread_data()
+{
+    QTest::addColumn<Transport>("transport");
+    QTest::addColumn<int>("chunkSize");
+
+    for (int chunkSize : { 256, 4096 }) {
+        QTest::addRow("qringbuffer-mutex-%d", chunkSize) << Transport::MutexRingBuffer << chunkSize;
+        QTest::addRow("spsc-heap-%d", chunkSize) << Transport::SpscHeap << chunkSize;
+        QTest::addRow("spsc-mapped-%d", chunkSize) << Transport::SpscMapped << chunkSize;
+    }
+}
+
+// Moves 16 MiB from a producer thread to the consumer, through at most
+// 64 KiB of buffered data.
+void tst_QRingBuffer::crossThread()
+{
+    QFETCH(Transport, transport);
+    QFETCH(int, chunkSize);
+    constexpr qint64 Total = 16 * 1024 * 1024;
+    constexpr qint64 Capacity = 64 * 1024;
+    const QByteArray chunk(chunkSize, 'a');
+    QByteArray in(chunkSize, Qt::Uninitialized);
+
+    QBENCHMARK {
+        qint64 received = 0;
+        if (transport == Transport::MutexRingBuffer) {
+            QRingBuffer ringBuffer;
+            QMutex mutex;
+            QWaitCondition changed;
+            bool done = false;
+            QScopedPointer<QThread> producer(QThread::create([&]() {
+                for (qint64 sent = 0; sent < Total; sent += chunkSize) {
+                    QMutexLocker locker(&mutex);
+                    while (ringBuffer.size() + chunkSize > Capacity)
+                        changed.wait(&mutex);
+                    ringBuffer.append(chunk.constData(), chunkSize);
+                    changed.wakeAll();
+                }
+                QMutexLocker locker(&mutex);
+                done = true;
+                changed.wakeAll();
+            }));
+            producer->start();
+            QMutexLocker locker(&mutex);
+            for (;;) {
+                while (ringBuffer.isEmpty() && !done)
+                    changed.wait(&mutex);
+                if (ringBuffer.isEmpty())
+                    break;
+                received += ringBuffer.read(in.data(), chunkSize);
+                changed.wakeAll();
+            }
+            locker.unlock();
+            producer->wait();
+        } else {
+            QSpscRingBuffer ringBuffer(Capacity, transport == Transport::SpscMapped
+                                                 ? QSpscRingBuffer::DoubleMapped
+                                                 : QSpscRingBuffer::HeapAllocated);
+            QScopedPointer<QThread> producer(QThread::create([&]() {
+                for (qint64 sent = 0; sent < Total; ) {
+                    const qint64 written = ringBuffer.write(chunk.constData(), chunkSize);
+                    if (written == 0)
+                        ringBuffer.waitForSpace();
+                    sent += written;
+                }
+                ringBuffer.closeWrite();
+            }));
+            producer->start();
+            while (ringBuffer.waitForData() && !ringBuffer.atEnd())
+                received += ringBuffer.read(in.data(), chunkSize);
+            producer->wait();
+        }
+        QCOMPARE(received, Total);
+    }
+}
+
 QTEST_MAIN(tst_QRingBuffer)
 
 #include "tst_bench_qringbuffer.moc"